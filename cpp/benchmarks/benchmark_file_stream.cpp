@@ -0,0 +1,133 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <string>
+#include <vector>
+// === third-party includes (if any) ===
+#include <benchmark/benchmark.h>
+// === local includes (if any) ===
+#include <smartspectra/video_source/file_stream/file_stream.hpp>
+#include <smartspectra/video_source/file_stream/frame_filename_matcher.hpp>
+#include <smartspectra/video_source/settings.hpp>
+#include "benchmark_utilities.hpp"
+
+namespace vs = presage::smartspectra::video_source;
+namespace vs_fs = presage::smartspectra::video_source::file_stream;
+namespace sb = presage::smartspectra::benchmarks;
+
+namespace {
+
+constexpr int64_t kFrameIntervalμs = 33'333;
+constexpr char kFrameFilenameMask[] = "frame0000000000000.png";
+
+std::string GetFrameFilename(int64_t i_frame) {
+    char filename[32];
+    std::snprintf(filename, sizeof(filename), "frame%013ld.png", static_cast<long>(i_frame * kFrameIntervalμs));
+    return filename;
+}
+
+class ScannableFileStreamVideoSource : public vs::file_stream::FileStreamVideoSource {
+public:
+    using FileStreamVideoSource::ScanInputDirectory;
+};
+
+// Fills a fresh directory with the given number of (empty) frame files, named like the file_stream samples expect.
+// Returns the wildcard file stream path to use for it.
+std::filesystem::path PopulateFrameDirectory(int64_t frame_count) {
+    const std::filesystem::path directory =
+        sb::kGeneratedDataDirectory / ("file_stream_" + std::to_string(frame_count));
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    for (int64_t i_frame = 0; i_frame < frame_count; i_frame++) {
+        std::ofstream(directory / GetFrameFilename(i_frame));
+    }
+    return directory / kFrameFilenameMask;
+}
+
+void BM_FileStreamScanInputDirectory(benchmark::State& state) {
+    const int64_t frame_count = state.range(0);
+    vs::VideoSourceSettings settings;
+    settings.file_stream_path = PopulateFrameDirectory(frame_count).string();
+    // loop mode doesn't erase the files & scans once up front, rather than waiting for frames to show up
+    settings.erase_read_files = false;
+    settings.loop = true;
+    ScannableFileStreamVideoSource source;
+    if (auto status = source.Initialize(settings); !status.ok()) {
+        state.SkipWithError(status.ToString());
+        return;
+    }
+    for (auto _: state) {
+        auto file_paths = source.ScanInputDirectory();
+        if (static_cast<int64_t>(file_paths.size()) != frame_count) {
+            state.SkipWithError("Scan didn't find every frame file.");
+            break;
+        }
+        benchmark::DoNotOptimize(file_paths);
+    }
+    state.SetItemsProcessed(state.iterations() * frame_count);
+}
+
+// directory entry names, as the scan sees them: mostly frames, plus the odd file that doesn't match
+std::vector<std::string> MakeDirectoryEntryNames(int64_t frame_count) {
+    std::vector<std::string> names;
+    for (int64_t i_frame = 0; i_frame < frame_count; i_frame++) {
+        names.push_back(GetFrameFilename(i_frame));
+        if (i_frame % 100 == 0) {
+            names.push_back(GetFrameFilename(i_frame) + ".tmp");
+        }
+    }
+    names.emplace_back("end_of_stream");
+    return names;
+}
+
+// reference: how frame filenames used to be matched, i.e. against a regular expression built from the mask
+void BM_FrameFilenameRegexMatch(benchmark::State& state) {
+    const std::vector<std::string> names = MakeDirectoryEntryNames(state.range(0));
+    const std::regex frame_filename_regex("frame([0-9]{13})[.]png");
+    for (auto _: state) {
+        int64_t timestamp_sum = 0;
+        for (const std::string& name: names) {
+            std::smatch match;
+            if (std::regex_match(name, match, frame_filename_regex)) {
+                timestamp_sum += std::stoll(match[1].str());
+            }
+        }
+        benchmark::DoNotOptimize(timestamp_sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+}
+
+void BM_FrameFilenameMatcherMatch(benchmark::State& state) {
+    const std::vector<std::string> names = MakeDirectoryEntryNames(state.range(0));
+    auto matcher = vs_fs::FrameFilenameMatcher::FromMask(kFrameFilenameMask);
+    if (!matcher.ok()) {
+        state.SkipWithError(matcher.status().ToString());
+        return;
+    }
+    for (auto _: state) {
+        int64_t timestamp_sum = 0;
+        for (const std::string& name: names) {
+            if (auto timestamp = matcher->Match(name); timestamp.has_value()) {
+                timestamp_sum += *timestamp;
+            }
+        }
+        benchmark::DoNotOptimize(timestamp_sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_FileStreamScanInputDirectory)->ArgName("files")->Arg(10)->Arg(1'000)->Arg(10'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FrameFilenameRegexMatch)->ArgName("files")->Arg(10'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FrameFilenameMatcherMatch)->ArgName("files")->Arg(10'000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,86 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+// === third-party includes (if any) ===
+#include <benchmark/benchmark.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+#include <physiology/modules/messages/metrics.h>
+// === local includes (if any) ===
+#include <smartspectra/gui/opencv_hud.hpp>
+#include <smartspectra/gui/opencv_trace_plotter.hpp>
+#include "benchmark_utilities.hpp"
+
+namespace gui = presage::smartspectra::gui;
+namespace sb = presage::smartspectra::benchmarks;
+namespace physiology = presage::physiology;
+
+namespace {
+
+// same layout as the HUD in the REST samples, drawn over a 720p frame
+constexpr int kImageWidth = 1280;
+constexpr int kImageHeight = 720;
+constexpr int kHudWidth = 1260;
+constexpr int kHudHeight = 400;
+constexpr int kPlotterHeight = 100;
+
+void BM_TracePlotterUpdateTraceWithSampleRange(benchmark::State& state) {
+    physiology::MetricsBuffer metrics_buffer;
+    if (!sb::LoadSampleMetricsBuffer(metrics_buffer)) {
+        state.SkipWithError("Could not load the sample metrics buffer.");
+        return;
+    }
+    const auto& trace = metrics_buffer.pulse().trace();
+    gui::OpenCvTracePlotter plotter(10, 0, kHudWidth, kPlotterHeight);
+    for (auto _: state) {
+        plotter.UpdateTraceWithSampleRange(trace);
+    }
+    state.SetItemsProcessed(state.iterations() * trace.size());
+}
+
+void BM_TracePlotterRender(benchmark::State& state) {
+    physiology::MetricsBuffer metrics_buffer;
+    if (!sb::LoadSampleMetricsBuffer(metrics_buffer)) {
+        state.SkipWithError("Could not load the sample metrics buffer.");
+        return;
+    }
+    gui::OpenCvTracePlotter plotter(10, 0, kHudWidth, kPlotterHeight);
+    plotter.UpdateTraceWithSampleRange(metrics_buffer.pulse().trace());
+    cv::Mat image(kImageHeight, kImageWidth, CV_8UC3, cv::Scalar::all(0));
+    for (auto _: state) {
+        auto status = plotter.Render(image);
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString());
+            break;
+        }
+        benchmark::DoNotOptimize(image.data);
+    }
+}
+
+void BM_HudRender(benchmark::State& state) {
+    physiology::MetricsBuffer metrics_buffer;
+    if (!sb::LoadSampleMetricsBuffer(metrics_buffer)) {
+        state.SkipWithError("Could not load the sample metrics buffer.");
+        return;
+    }
+    gui::OpenCvHud hud(10, 0, kHudWidth, kHudHeight);
+    hud.UpdateWithNewMetrics(metrics_buffer);
+    cv::Mat image(kImageHeight, kImageWidth, CV_8UC3, cv::Scalar::all(0));
+    for (auto _: state) {
+        auto status = hud.Render(image);
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString());
+            break;
+        }
+        benchmark::DoNotOptimize(image.data);
+    }
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_TracePlotterUpdateTraceWithSampleRange);
+BENCHMARK(BM_TracePlotterRender);
+BENCHMARK(BM_HudRender);
@@ -0,0 +1,108 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <cstdint>
+#include <memory>
+// === third-party includes (if any) ===
+#include <benchmark/benchmark.h>
+#include <mediapipe/framework/calculator_framework.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+#include <mediapipe/framework/port/parse_text_proto.h>
+#include <physiology/modules/device_context.h>
+#include <physiology/modules/device_type.h>
+// === local includes (if any) ===
+#include <smartspectra/container/image_frame_pool.hpp>
+#include <smartspectra/container/image_transfer.hpp>
+#include "benchmark_utilities.hpp"
+
+namespace it = presage::smartspectra::container::image_transfer;
+namespace ifp = presage::smartspectra::container::image_frame_pool;
+namespace pi = presage::platform_independence;
+namespace sb = presage::smartspectra::benchmarks;
+
+namespace {
+
+constexpr const char* kInputVideoStream = "input_video";
+constexpr int64_t kFrameIntervalμs = 33'333;
+// let the graph drain every so often (untimed), so that queued packets don't pile up in memory
+constexpr int kIdleWaitFrameInterval = 64;
+
+// stand-in for the Physiology graph: hands input frames straight to an (unobserved) output stream
+constexpr const char* kPassThroughGraph = R"pb(
+    input_stream: "input_video"
+    output_stream: "output_video"
+    node {
+        calculator: "PassThroughCalculator"
+        input_stream: "input_video"
+        output_stream: "output_video"
+    }
+)pb";
+
+void BM_FeedFrameToGraphCpu(benchmark::State& state) {
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    mediapipe::CalculatorGraphConfig config;
+    if (!mediapipe::ParseTextProto(kPassThroughGraph, &config)) {
+        state.SkipWithError("Could not parse the pass-through graph.");
+        return;
+    }
+    mediapipe::CalculatorGraph graph;
+    if (auto status = graph.Initialize(config); !status.ok()) {
+        state.SkipWithError(status.ToString());
+        return;
+    }
+    if (auto status = graph.StartRun({}); !status.ok()) {
+        state.SkipWithError(status.ToString());
+        return;
+    }
+    pi::DeviceContext<pi::DeviceType::Cpu> device_context;
+    ifp::ImageFramePool frame_pool;
+
+    int64_t frame_count = 0;
+    for (auto _: state) {
+        auto frame = frame_pool.Acquire(mediapipe::ImageFormat::SRGB, width, height);
+        auto status = it::FeedFrameToGraph<pi::DeviceType::Cpu>(
+            std::move(frame), graph, device_context, frame_count * kFrameIntervalμs, kInputVideoStream
+        );
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString());
+            break;
+        }
+        frame_count++;
+        if (frame_count % kIdleWaitFrameInterval == 0) {
+            state.PauseTiming();
+            benchmark::DoNotOptimize(graph.WaitUntilIdle());
+            state.ResumeTiming();
+        }
+    }
+    benchmark::DoNotOptimize(graph.CloseAllInputStreams());
+    benchmark::DoNotOptimize(graph.WaitUntilDone());
+    sb::SetFrameCounters(state, width, height, 3);
+}
+
+void BM_GetFrameFromPacketCpu(benchmark::State& state) {
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    auto frame = std::make_unique<mediapipe::ImageFrame>(mediapipe::ImageFormat::SRGB, width, height);
+    const mediapipe::Packet packet = mediapipe::Adopt(frame.release()).At(mediapipe::Timestamp(0));
+    pi::DeviceContext<pi::DeviceType::Cpu> device_context;
+    cv::Mat output_frame_rgb;
+    for (auto _: state) {
+        auto status = it::GetFrameFromPacket<pi::DeviceType::Cpu>(output_frame_rgb, device_context, packet);
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString());
+            break;
+        }
+        benchmark::DoNotOptimize(output_frame_rgb.data);
+    }
+    sb::SetFrameCounters(state, width, height, 3);
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_FeedFrameToGraphCpu)->Apply(sb::FrameResolutionArguments)->UseRealTime();
+BENCHMARK(BM_GetFrameFromPacketCpu)->Apply(sb::FrameResolutionArguments);
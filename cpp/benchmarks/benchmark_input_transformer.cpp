@@ -0,0 +1,45 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+// === third-party includes (if any) ===
+#include <benchmark/benchmark.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/video_source/input_transformer.hpp>
+#include "benchmark_utilities.hpp"
+
+namespace vs = presage::smartspectra::video_source;
+namespace sb = presage::smartspectra::benchmarks;
+
+namespace {
+
+void BM_InputTransformerApply(benchmark::State& state, vs::InputTransformMode mode) {
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    cv::Mat frame(height, width, CV_8UC3);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+    const vs::InputTransformer transformer{mode};
+    for (auto _: state) {
+        cv::Mat transformed_frame = transformer.apply(frame);
+        benchmark::DoNotOptimize(transformed_frame.data);
+    }
+    sb::SetFrameCounters(state, width, height, 3);
+}
+
+} // anonymous namespace
+
+BENCHMARK_CAPTURE(BM_InputTransformerApply, None, vs::InputTransformMode::None)->Apply(sb::FrameResolutionArguments);
+BENCHMARK_CAPTURE(BM_InputTransformerApply, Clockwise90, vs::InputTransformMode::Clockwise90)
+    ->Apply(sb::FrameResolutionArguments);
+BENCHMARK_CAPTURE(BM_InputTransformerApply, Counterclockwise90, vs::InputTransformMode::Counterclockwise90)
+    ->Apply(sb::FrameResolutionArguments);
+BENCHMARK_CAPTURE(BM_InputTransformerApply, Rotate180, vs::InputTransformMode::Rotate180)
+    ->Apply(sb::FrameResolutionArguments);
+BENCHMARK_CAPTURE(BM_InputTransformerApply, MirrorHorizontal, vs::InputTransformMode::MirrorHorizontal)
+    ->Apply(sb::FrameResolutionArguments);
+BENCHMARK_CAPTURE(BM_InputTransformerApply, MirrorVertical, vs::InputTransformMode::MirrorVertical)
+    ->Apply(sb::FrameResolutionArguments);
@@ -0,0 +1,62 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <string>
+// === third-party includes (if any) ===
+#include <benchmark/benchmark.h>
+#include <google/protobuf/util/json_util.h>
+#include <physiology/modules/messages/metrics.h>
+// === local includes (if any) ===
+#include "benchmark_utilities.hpp"
+
+namespace sb = presage::smartspectra::benchmarks;
+namespace physiology = presage::physiology;
+
+namespace {
+
+// what the REST samples do with every metrics buffer that comes out of Core
+void BM_MetricsBufferToJson(benchmark::State& state) {
+    physiology::MetricsBuffer metrics_buffer;
+    if (!sb::LoadSampleMetricsBuffer(metrics_buffer)) {
+        state.SkipWithError("Could not load the sample metrics buffer.");
+        return;
+    }
+    google::protobuf::util::JsonPrintOptions options;
+    std::string metrics_json_string;
+    for (auto _: state) {
+        metrics_json_string.clear();
+        auto status = google::protobuf::util::MessageToJsonString(metrics_buffer, &metrics_json_string, options);
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString());
+            break;
+        }
+        benchmark::DoNotOptimize(metrics_json_string.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(metrics_json_string.size()));
+}
+
+void BM_MetricsBufferFromJson(benchmark::State& state) {
+    const std::string metrics_json_string = sb::ReadFileContents(sb::kSampleMetricsJsonPath);
+    google::protobuf::util::JsonParseOptions options;
+    options.ignore_unknown_fields = true;
+    physiology::MetricsBuffer metrics_buffer;
+    for (auto _: state) {
+        metrics_buffer.Clear();
+        auto status = google::protobuf::util::JsonStringToMessage(metrics_json_string, &metrics_buffer, options);
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString());
+            break;
+        }
+        benchmark::DoNotOptimize(metrics_buffer);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(metrics_json_string.size()));
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_MetricsBufferToJson);
+BENCHMARK(BM_MetricsBufferFromJson);
@@ -0,0 +1,77 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <cstdint>
+#include <vector>
+// === third-party includes (if any) ===
+#include <benchmark/benchmark.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+#include <mediapipe/framework/port/opencv_imgcodecs_inc.h>
+#include <mediapipe/framework/port/opencv_imgproc_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/video_source/camera/mjpeg_decoder.hpp>
+#include "benchmark_utilities.hpp"
+
+namespace vs = presage::smartspectra::video_source;
+namespace mjpeg = presage::smartspectra::video_source::mjpeg;
+namespace sb = presage::smartspectra::benchmarks;
+
+namespace {
+
+// 1080p webcam-like MJPEG frame: smooth gradients plus a little sensor noise, at a typical camera quality setting
+std::vector<uint8_t> EncodeSampleFrame() {
+    cv::Mat frame(1080, 1920, CV_8UC3);
+    for (int i_row = 0; i_row < frame.rows; i_row++) {
+        for (int i_column = 0; i_column < frame.cols; i_column++) {
+            frame.at<cv::Vec3b>(i_row, i_column) = cv::Vec3b(
+                static_cast<uint8_t>(i_column * 255 / frame.cols), static_cast<uint8_t>(i_row * 255 / frame.rows), 128
+            );
+        }
+    }
+    cv::Mat noise(frame.size(), CV_8UC3);
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(16));
+    frame += noise;
+    std::vector<uint8_t> encoded_frame;
+    cv::imencode(".jpg", frame, encoded_frame, {cv::IMWRITE_JPEG_QUALITY, 85});
+    return encoded_frame;
+}
+
+// reference: what the OpenCV capture path does, i.e. full-resolution decode to BGR, then the graph's BGR -> RGB swap
+void BM_MjpegDecodeOpenCvBgrThenSwap(benchmark::State& state) {
+    const std::vector<uint8_t> encoded_frame = EncodeSampleFrame();
+    cv::Mat frame, rgb_frame;
+    for (auto _: state) {
+        cv::imdecode(encoded_frame, cv::IMREAD_COLOR, &frame);
+        cv::cvtColor(frame, rgb_frame, cv::COLOR_BGR2RGB);
+        benchmark::DoNotOptimize(rgb_frame.data);
+    }
+    sb::SetFrameCounters(state, rgb_frame.cols, rgb_frame.rows, 3);
+}
+
+void BM_MjpegDecoderRgb(benchmark::State& state) {
+    const int scale_denominator = static_cast<int>(state.range(0));
+    const std::vector<uint8_t> encoded_frame = EncodeSampleFrame();
+    mjpeg::MjpegDecoder decoder;
+    cv::Mat frame;
+    for (auto _: state) {
+        auto status = decoder.Decode(
+            encoded_frame.data(), encoded_frame.size(), scale_denominator, vs::FrameChannelOrder::Rgb, frame
+        );
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(frame.data);
+    }
+    sb::SetFrameCounters(state, frame.cols, frame.rows, 3);
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_MjpegDecodeOpenCvBgrThenSwap)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MjpegDecoderRgb)->ArgName("scale_denominator")->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,59 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+// === third-party includes (if any) ===
+#include <benchmark/benchmark.h>
+#include <google/protobuf/util/json_util.h>
+#include <physiology/modules/messages/metrics.h>
+// === local includes (if any) ===
+
+namespace presage::smartspectra::benchmarks {
+
+// checked-in test data (see tests/test_data)
+inline const std::filesystem::path kStaticDataDirectory = SMARTSPECTRA_BENCHMARK_STATIC_DATA_DIRECTORY;
+// scratch space for data generated by the benchmarks themselves
+inline const std::filesystem::path kGeneratedDataDirectory = SMARTSPECTRA_BENCHMARK_GENERATED_DATA_DIRECTORY;
+
+inline std::string ReadFileContents(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+// sample metrics buffer recorded from the Physiology REST API (several hundred pulse & breathing trace samples)
+inline const std::filesystem::path kSampleMetricsJsonPath = kStaticDataDirectory / "json" / "metrics_2024-08-28.json";
+
+inline bool LoadSampleMetricsBuffer(presage::physiology::MetricsBuffer& metrics_buffer) {
+    google::protobuf::util::JsonParseOptions options;
+    // the recording carries a few REST envelope fields that aren't part of MetricsBuffer
+    options.ignore_unknown_fields = true;
+    return google::protobuf::util::JsonStringToMessage(
+        ReadFileContents(kSampleMetricsJsonPath), &metrics_buffer, options
+    ).ok();
+}
+
+// frame resolutions that hot-path benchmarks are parameterized over: VGA, 720p, 1080p
+inline void FrameResolutionArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"width", "height"});
+    benchmark->Args({640, 480});
+    benchmark->Args({1280, 720});
+    benchmark->Args({1920, 1080});
+}
+
+// reports per-frame throughput in pixels (as "items") and bytes, next to the timings
+inline void SetFrameCounters(benchmark::State& state, int width, int height, int channel_count) {
+    state.SetItemsProcessed(state.iterations() * width * height);
+    state.SetBytesProcessed(state.iterations() * width * height * channel_count);
+}
+
+} // namespace presage::smartspectra::benchmarks
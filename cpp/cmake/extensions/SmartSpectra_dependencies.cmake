@@ -23,6 +23,11 @@ endif ()
 
 if (LINUX)
     find_package(V4L REQUIRED)
+    # optional: libjpeg-turbo, for faster MJPEG decoding in native V4L2 capture
+    find_package(PkgConfig)
+    if (PKG_CONFIG_FOUND)
+        pkg_check_modules(TURBOJPEG IMPORTED_TARGET libturbojpeg)
+    endif ()
 endif ()
 
 # PhysiologyEdge does not support GPU on Apple machines yet
@@ -56,3 +61,27 @@ if (BUILD_TESTS)
         set(CATCH2_TARGET "Catch2::Catch2")
     endif ()
 endif ()
+
+if (BUILD_BENCHMARKS)
+    if (USE_SYSTEM_BENCHMARK)
+        find_package(benchmark)
+        if (TARGET benchmark::benchmark)
+            message(STATUS "Using installed third-party library Google Benchmark")
+        else ()
+            message(STATUS "Unable to find third-party library Google Benchmark installed on system.
+            Setting USE_SYSTEM_BENCHMARK to OFF and building from source instead.")
+            set(USE_SYSTEM_BENCHMARK OFF)
+        endif ()
+    endif ()
+    if (NOT USE_SYSTEM_BENCHMARK)
+        include(FetchContent)
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+        FetchContent_Declare(
+                benchmark
+                GIT_REPOSITORY https://github.com/google/benchmark.git
+                GIT_TAG v1.9.0
+        )
+        FetchContent_MakeAvailable(benchmark)
+    endif ()
+endif ()
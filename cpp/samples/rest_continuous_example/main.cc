@@ -2,6 +2,7 @@
 #include <string>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 
 // third-party includes
 #include <absl/status/status.h>
@@ -50,6 +51,19 @@ ABSL_FLAG(pcam::CaptureCodec, codec, pcam::CaptureCodec::MJPG,
 ABSL_FLAG(bool, auto_lock, true,
           "If true, will try to use auto-exposure before recording and lock exposure when recording starts. "
           "If false, doesn't do this automatically.");
+ABSL_FLAG(bool, use_native_v4l2_capture, false,
+          "If true, capture straight from the V4L2 driver (Linux only), with mmap'd streaming buffers and driver "
+          "frame timestamps, instead of going through OpenCV's VideoCapture.");
+ABSL_FLAG(int, v4l2_buffer_count, 4,
+          "Number of capture buffers to request from the V4L2 driver when use_native_v4l2_capture is set (the driver "
+          "may adjust it). Fewer buffers keep latency low, more buffers tolerate longer processing hiccups.");
+ABSL_FLAG(int, mjpeg_decode_min_width_px, -1,
+          "Smallest frame width needed downstream when use_native_v4l2_capture decodes MJPEG: larger frames get "
+          "decoded at 1/2, 1/4 or 1/8 scale, whichever still covers it. Non-positive: derived from the graph's input "
+          "scaling when scale_input is set, full resolution otherwise.");
+ABSL_FLAG(int, mjpeg_decode_min_height_px, -1,
+          "Smallest frame height needed downstream when use_native_v4l2_capture decodes MJPEG (see "
+          "mjpeg_decode_min_width_px).");
 ABSL_FLAG(vs::InputTransformMode, input_transform_mode, vs::InputTransformMode::Unspecified_EnumEnd,
           absl::StrCat("Video input transformation mode. Possible values: ", vs::kInputTransformModeNameList));
 ABSL_FLAG(std::string, input_video_path, "",
@@ -59,6 +73,37 @@ ABSL_FLAG(std::string, input_video_time_path, "",
           "Full path of video timestamp txt file, "
           "where each row represents the timestamp of each frame in milliseconds.");
 // endregion ===========================================================================================================
+// region ======================== FILE STREAM SETTINGS ================================================================
+ABSL_FLAG(std::string, file_stream_path, "",
+          "Path to files in file stream, e.g. \"/path/to/files/frame0000000000000.png\". The zero padding signifies "
+          "the digit count in frame timestamp and can be preceded by a non-digit prefix and/or followed by a non-digit "
+          "postfix and extension. The timestamp is assumed to use whole microseconds as units. The extension is "
+          "mandatory. Any extension and its corresponding image codec that is supported by the OpenCV dependency is "
+          "also supported here (commonly, .png and .jpg are among those). Used when input_video_path is empty.");
+ABSL_FLAG(std::string, end_of_stream, "end_of_stream",
+          "This is the file that will be placed as a token signalling \"end of stream\" to preprocessing.");
+ABSL_FLAG(int, file_stream_rescan_delay, 5,
+          "Delay, in milliseconds, before re-scanning the input folder for more frames. Decrease to accommodate faster "
+          "streaming. Conversely, if input streaming is slow, decreasing the delay will just hog the application. "
+          "Only applies when folder change notifications aren't used (see file_stream_watch_directory).");
+ABSL_FLAG(bool, file_stream_watch_directory, true,
+          "If true, pick up new frames from folder change notifications (Linux only) instead of re-scanning the folder "
+          "every file_stream_rescan_delay milliseconds. Set to false for folders that don't deliver such "
+          "notifications, e.g. on network filesystems written to from other machines.");
+ABSL_FLAG(bool, erase_read_files, true,
+          "Erase frame image files that were already read in. Incompatible with ``--loop``.");
+ABSL_FLAG(bool, loop, false,
+          "Loop around the folder. Presumes static input, i.e. folder will not be rescanned. "
+          "Incompatible with ``--erase_read_files``.");
+ABSL_FLAG(int, file_stream_prefetch_depth, 4,
+          "Number of file stream frames to decode ahead of consumption, on background threads. "
+          "0 decodes each frame when it's needed. Not used with ``--loop``.");
+ABSL_FLAG(int, file_stream_prefetch_thread_count, 2,
+          "Number of threads decoding file stream frames ahead (see file_stream_prefetch_depth).");
+ABSL_FLAG(int, file_stream_prefetch_memory_cap_mb, 256,
+          "Cap, in megabytes, on memory taken up by file stream frames decoded ahead; "
+          "limits the prefetch depth further for large frames.");
+// endregion ===========================================================================================================
 // region ======================== GUI / INTERACTION SETTINGS ==========================================================
 ABSL_FLAG(bool, headless, false, "If true, no GUI will be displayed.");
 ABSL_FLAG(bool, also_log_to_stderr, false, "If true, log to stderr as well.");
@@ -110,6 +155,32 @@ ABSL_FLAG(bool, passthrough_video, false,
           "If true, output video will just use the input video frames directly (see destination "
           "documentation), without passing through any processing "
           "(which might contain rendered visual content from the graph).");
+ABSL_FLAG(settings::FramePipelineMode, frame_pipeline_mode, settings::FramePipelineMode::Serial,
+          "How the capture, graph input, and output display stages of the frame loop are scheduled. "
+          "Possible values: " + absl::StrJoin(settings::GetFramePipelineModeNames(), ", ") + ". "
+          "`pipelined` runs capture and graph input on separate threads, connected via bounded queues. "
+          "`offline` (video file input only) feeds frames as fast as the graph processes them, without dropping any.");
+ABSL_FLAG(int, frame_queue_depth, 2,
+          "Capacity of each inter-stage frame queue when frame_pipeline_mode is `pipelined`; maximum number of frames "
+          "in the graph at once when it is `offline`.");
+ABSL_FLAG(settings::FrameDropPolicy, frame_drop_policy, settings::FrameDropPolicy::DropOldest,
+          "What to do when a stage falls behind and its input queue is full when frame_pipeline_mode is `pipelined`. "
+          "Possible values: " + absl::StrJoin(settings::GetFrameDropPolicyNames(), ", ") + ". "
+          "Ignored (always `block`) when reading from a video file.");
+ABSL_FLAG(int, core_telemetry_window_ms, 3000,
+          "Duration, in milliseconds, of the sliding window over which Edge+Core throughput & latency statistics "
+          "are computed when framerate diagnostics are enabled.");
+ABSL_FLAG(bool, enable_pipeline_stage_telemetry, false,
+          "If true, record latency histograms for each stage of the frame processing loop "
+          "(capture, color conversion, graph feed, output fetch, display, etc.) and log them periodically.");
+ABSL_FLAG(std::string, frame_trace_output_path, "",
+          "If not empty, record a per-frame timeline of trace events and write it to this path as Chrome trace-event "
+          "JSON (loadable in Perfetto or chrome://tracing) when the app exits.");
+ABSL_FLAG(bool, enable_graph_profiler, false,
+          "If true, enable MediaPipe's calculator-level profiler and log a per-calculator timing summary on exit.");
+ABSL_FLAG(std::string, graph_profiler_trace_log_path, "",
+          "If not empty (and enable_graph_profiler is set), MediaPipe trace logs are written using this path prefix. "
+          "Requires MediaPipe built with tracing support.");
 // endregion ===========================================================================================================
 // region ========================  CUSTOM SETTINGS (not for container) ================================================
 ABSL_FLAG(bool, save_metrics_to_disk, false, "If true, save metrics to disk.");
@@ -118,6 +189,12 @@ ABSL_FLAG(std::string, output_directory, "out",
           "If it does not exist, the app will attempt to make one.");
 ABSL_FLAG(bool, enable_hud, true, "If true, enables metrics trace plotting & rate display HUD.");
 ABSL_FLAG(bool, enable_framerate_diagnostics, false, "If true, enable framerate diagnostics.");
+ABSL_FLAG(int, metrics_port, -1,
+          "If non-negative, serve runtime metrics (throughput, latency, frame drops, status changes) in OpenMetrics "
+          "text format over HTTP on 127.0.0.1 at this port (0 picks a free port; at most 65535).");
+ABSL_FLAG(std::string, metrics_output_path, "",
+          "If not empty, periodically write runtime metrics in OpenMetrics text format to this file, "
+          "e.g. for node_exporter's textfile collector.");
 // endregion ===========================================================================================================
 
 absl::Status RunRestContinuousEdge(
@@ -252,34 +329,74 @@ absl::Status RunRestContinuousEdge(
     if (enable_framerate_diagnostics) {
         MP_RETURN_IF_ERROR(container.SetOnCorePerformanceTelemetry(
             [&effective_core_throughput, &effective_core_latency, &enable_hud](
-                double effective_core_fps,
-                double effective_core_latency_seconds,
-                int64_t timestamp_microseconds
+                const spectra::container::CorePerformanceTelemetry& telemetry
             ) {
                 if (!enable_hud) {
-                    std::cout << "Effective Edge+Core Throughput: " << effective_core_fps << " FPS / HZ " << std::endl;
-                    std::cout << "Effective Edge+Core Latency: " << effective_core_latency_seconds << " seconds" << std::endl;
+                    std::cout << "Effective Edge+Core Throughput: " << telemetry.effective_core_fps << " FPS / HZ " << std::endl;
+                    std::cout << "Effective Edge+Core Latency: " << telemetry.mean_latency_seconds << " seconds (p50: "
+                              << telemetry.latency_p50_seconds << ", p95: " << telemetry.latency_p95_seconds
+                              << ", p99: " << telemetry.latency_p99_seconds << ")" << std::endl;
                 } else {
-                    effective_core_throughput = effective_core_fps;
-                    effective_core_latency = effective_core_latency_seconds;
+                    effective_core_throughput = telemetry.effective_core_fps;
+                    effective_core_latency = telemetry.mean_latency_seconds;
                 }
                 return absl::OkStatus();
             }
         ));
 
-        MP_RETURN_IF_ERROR(container.SetOnFrameSentThrough(
-            [](
-                bool frame_sent_through,
-                int64_t timestamp_microseconds
-            ) {
-                if(!frame_sent_through){
-                    LOG(INFO) << "Dropped frame at timestamp " << timestamp_microseconds;
+        MP_RETURN_IF_ERROR(container.SetOnFrameAccountingSummary(
+            [](const spectra::container::frame_accounting::FrameAccountingSummary& summary) {
+                if (summary.dropped_count > 0) {
+                    LOG(INFO) << "Dropped " << summary.dropped_count << " of "
+                              << summary.sent_through_count + summary.dropped_count << " frames ("
+                              << summary.drop_rate * 100.0 << "%) in " << summary.drop_run_count
+                              << " run(s); longest run: " << summary.longest_drop_run
+                              << " frames, longest gap: " << summary.longest_gap_μs / 1000.0 << " ms.";
+                }
+                return absl::OkStatus();
+            }
+        ));
+    }
+
+    if (absl::GetFlag(FLAGS_enable_pipeline_stage_telemetry)) {
+        MP_RETURN_IF_ERROR(container.SetOnPipelineStageTelemetry(
+            [](const spectra::container::pipeline_stage_telemetry::PipelineStageTelemetrySnapshot& snapshot) {
+                namespace pst = spectra::container::pipeline_stage_telemetry;
+                for (int i_stage = 0; i_stage < pst::kPipelineStageCount; i_stage++) {
+                    const auto& stage = snapshot.stages[i_stage];
+                    if (stage.count == 0) continue;
+                    LOG(INFO) << "Stage " << pst::GetPipelineStageName(static_cast<pst::PipelineStage>(i_stage))
+                              << ": n=" << stage.count << ", p50=" << stage.p50_seconds * 1000
+                              << " ms, p99=" << stage.p99_seconds * 1000 << " ms, max=" << stage.max_seconds * 1000
+                              << " ms";
                 }
                 return absl::OkStatus();
             }
         ));
     }
 
+    std::unique_ptr<spectra::container::metrics_exporter::MetricsExporter> metrics_exporter;
+    const int metrics_port = absl::GetFlag(FLAGS_metrics_port);
+    if (metrics_port > std::numeric_limits<uint16_t>::max()) {
+        return absl::InvalidArgumentError(
+            "--metrics_port has to be a valid TCP port (0-65535) or negative, got " + std::to_string(metrics_port) + "."
+        );
+    }
+    const std::string metrics_output_path = absl::GetFlag(FLAGS_metrics_output_path);
+    if (metrics_port >= 0 || !metrics_output_path.empty()) {
+        auto runtime_metrics = std::make_shared<spectra::container::metrics_exporter::RuntimeMetrics>();
+        MP_RETURN_IF_ERROR(container.SetRuntimeMetrics(runtime_metrics));
+        metrics_exporter = std::make_unique<spectra::container::metrics_exporter::MetricsExporter>(runtime_metrics);
+        if (metrics_port >= 0) {
+            MP_RETURN_IF_ERROR(metrics_exporter->StartHttpServer(static_cast<uint16_t>(metrics_port)));
+            LOG(INFO) << "Serving runtime metrics at http://127.0.0.1:" << metrics_exporter->GetHttpPort()
+                      << "/metrics";
+        }
+        if (!metrics_output_path.empty()) {
+            MP_RETURN_IF_ERROR(metrics_exporter->StartFileExport(metrics_output_path, std::chrono::seconds(5)));
+        }
+    }
+
     MP_RETURN_IF_ERROR(container.Initialize());
     MP_RETURN_IF_ERROR(container.Run());
 
@@ -312,6 +429,19 @@ int main(int argc, char** argv) {
             absl::GetFlag(FLAGS_input_transform_mode),
             absl::GetFlag(FLAGS_input_video_path),
             absl::GetFlag(FLAGS_input_video_time_path),
+            absl::GetFlag(FLAGS_file_stream_path),
+            absl::GetFlag(FLAGS_end_of_stream),
+            absl::GetFlag(FLAGS_file_stream_rescan_delay),
+            absl::GetFlag(FLAGS_erase_read_files),
+            absl::GetFlag(FLAGS_loop),
+            absl::GetFlag(FLAGS_use_native_v4l2_capture),
+            absl::GetFlag(FLAGS_v4l2_buffer_count),
+            absl::GetFlag(FLAGS_mjpeg_decode_min_width_px),
+            absl::GetFlag(FLAGS_mjpeg_decode_min_height_px),
+            absl::GetFlag(FLAGS_file_stream_watch_directory),
+            absl::GetFlag(FLAGS_file_stream_prefetch_depth),
+            absl::GetFlag(FLAGS_file_stream_prefetch_thread_count),
+            absl::GetFlag(FLAGS_file_stream_prefetch_memory_cap_mb),
         },
         settings::VideoSinkSettings{
             absl::GetFlag(FLAGS_output_video_destination),
@@ -334,6 +464,26 @@ int main(int argc, char** argv) {
         absl::GetFlag(FLAGS_print_graph_contents),
         absl::GetFlag(FLAGS_log_transfer_timing_info),
         absl::GetFlag(FLAGS_verbosity),
+        settings::FramePipelineSettings{
+            absl::GetFlag(FLAGS_frame_pipeline_mode),
+            absl::GetFlag(FLAGS_frame_queue_depth),
+            absl::GetFlag(FLAGS_frame_drop_policy)
+        },
+        /*frame_input=*/settings::FrameInputSettings{},
+        settings::TelemetrySettings{
+            absl::GetFlag(FLAGS_core_telemetry_window_ms),
+            absl::GetFlag(FLAGS_enable_pipeline_stage_telemetry),
+            /*pipeline_stage_report_interval_ms=*/1000,
+            /*enable_frame_tracing=*/!absl::GetFlag(FLAGS_frame_trace_output_path).empty(),
+            /*frame_trace_capacity=*/65536,
+            absl::GetFlag(FLAGS_frame_trace_output_path)
+        },
+        settings::GraphProfilerSettings{
+            absl::GetFlag(FLAGS_enable_graph_profiler),
+            /*histogram_interval_size_μs=*/1000,
+            /*histogram_interval_count=*/100,
+            absl::GetFlag(FLAGS_graph_profiler_trace_log_path)
+        },
         settings::ContinuousSettings{
             absl::GetFlag(FLAGS_buffer_duration)
         },
@@ -48,6 +48,19 @@ ABSL_FLAG(pcam::CaptureCodec, codec, pcam::CaptureCodec::MJPG,
                        pcam::kCaptureCodecNameList));
 ABSL_FLAG(bool, auto_lock, true,
           "If true, will try to use auto-exposure before recording and lock exposure when recording starts. If false, doesn't do this automatically.");
+ABSL_FLAG(bool, use_native_v4l2_capture, false,
+          "If true, capture straight from the V4L2 driver (Linux only), with mmap'd streaming buffers and driver "
+          "frame timestamps, instead of going through OpenCV's VideoCapture.");
+ABSL_FLAG(int, v4l2_buffer_count, 4,
+          "Number of capture buffers to request from the V4L2 driver when use_native_v4l2_capture is set (the driver "
+          "may adjust it). Fewer buffers keep latency low, more buffers tolerate longer processing hiccups.");
+ABSL_FLAG(int, mjpeg_decode_min_width_px, -1,
+          "Smallest frame width needed downstream when use_native_v4l2_capture decodes MJPEG: larger frames get "
+          "decoded at 1/2, 1/4 or 1/8 scale, whichever still covers it. Non-positive: derived from the graph's input "
+          "scaling when scale_input is set, full resolution otherwise.");
+ABSL_FLAG(int, mjpeg_decode_min_height_px, -1,
+          "Smallest frame height needed downstream when use_native_v4l2_capture decodes MJPEG (see "
+          "mjpeg_decode_min_width_px).");
 ABSL_FLAG(vs::InputTransformMode, input_transform_mode, vs::InputTransformMode::Unspecified_EnumEnd,
           absl::StrCat("Video input transformation mode. Possible values: ", vs::kInputTransformModeNameList));
 ABSL_FLAG(std::string, input_video_path, "",
@@ -56,6 +69,37 @@ ABSL_FLAG(std::string, input_video_path, "",
 ABSL_FLAG(std::string, input_video_time_path, "",
           "Full path of video timestamp txt file, where each row represents the timestamp of each frame in milliseconds.");
 // endregion ===========================================================================================================
+// region ======================== FILE STREAM SETTINGS ================================================================
+ABSL_FLAG(std::string, file_stream_path, "",
+          "Path to files in file stream, e.g. \"/path/to/files/frame0000000000000.png\". The zero padding signifies "
+          "the digit count in frame timestamp and can be preceded by a non-digit prefix and/or followed by a non-digit "
+          "postfix and extension. The timestamp is assumed to use whole microseconds as units. The extension is "
+          "mandatory. Any extension and its corresponding image codec that is supported by the OpenCV dependency is "
+          "also supported here (commonly, .png and .jpg are among those). Used when input_video_path is empty.");
+ABSL_FLAG(std::string, end_of_stream, "end_of_stream",
+          "This is the file that will be placed as a token signalling \"end of stream\" to preprocessing.");
+ABSL_FLAG(int, file_stream_rescan_delay, 5,
+          "Delay, in milliseconds, before re-scanning the input folder for more frames. Decrease to accommodate faster "
+          "streaming. Conversely, if input streaming is slow, decreasing the delay will just hog the application. "
+          "Only applies when folder change notifications aren't used (see file_stream_watch_directory).");
+ABSL_FLAG(bool, file_stream_watch_directory, true,
+          "If true, pick up new frames from folder change notifications (Linux only) instead of re-scanning the folder "
+          "every file_stream_rescan_delay milliseconds. Set to false for folders that don't deliver such "
+          "notifications, e.g. on network filesystems written to from other machines.");
+ABSL_FLAG(bool, erase_read_files, true,
+          "Erase frame image files that were already read in. Incompatible with ``--loop``.");
+ABSL_FLAG(bool, loop, false,
+          "Loop around the folder. Presumes static input, i.e. folder will not be rescanned. "
+          "Incompatible with ``--erase_read_files``.");
+ABSL_FLAG(int, file_stream_prefetch_depth, 4,
+          "Number of file stream frames to decode ahead of consumption, on background threads. "
+          "0 decodes each frame when it's needed. Not used with ``--loop``.");
+ABSL_FLAG(int, file_stream_prefetch_thread_count, 2,
+          "Number of threads decoding file stream frames ahead (see file_stream_prefetch_depth).");
+ABSL_FLAG(int, file_stream_prefetch_memory_cap_mb, 256,
+          "Cap, in megabytes, on memory taken up by file stream frames decoded ahead; "
+          "limits the prefetch depth further for large frames.");
+// endregion ===========================================================================================================
 
 ABSL_FLAG(bool, headless, false, "If true, no GUI will be displayed.");
 ABSL_FLAG(bool, also_log_to_stderr, false, "If true, log to stderr as well.");
@@ -97,6 +141,18 @@ ABSL_FLAG(bool, passthrough_video, false,
           "If true, output video will just use the input video frames directly (see destination "
           "documentation), without passing through any processing "
           "(which might contain rendered visual content from the graph).");
+ABSL_FLAG(settings::FramePipelineMode, frame_pipeline_mode, settings::FramePipelineMode::Serial,
+          "How the capture, graph input, and output display stages of the frame loop are scheduled. "
+          "Possible values: " + absl::StrJoin(settings::GetFramePipelineModeNames(), ", ") + ". "
+          "`pipelined` runs capture and graph input on separate threads, connected via bounded queues. "
+          "`offline` (video file input only) feeds frames as fast as the graph processes them, without dropping any.");
+ABSL_FLAG(int, frame_queue_depth, 2,
+          "Capacity of each inter-stage frame queue when frame_pipeline_mode is `pipelined`; maximum number of frames "
+          "in the graph at once when it is `offline`.");
+ABSL_FLAG(settings::FrameDropPolicy, frame_drop_policy, settings::FrameDropPolicy::DropOldest,
+          "What to do when a stage falls behind and its input queue is full when frame_pipeline_mode is `pipelined`. "
+          "Possible values: " + absl::StrJoin(settings::GetFrameDropPolicyNames(), ", ") + ". "
+          "Ignored (always `block`) when reading from a video file.");
 // endregion ===========================================================================================================
 // region ========================  CUSTOM SETTINGS (not for container) ================================================
 ABSL_FLAG(bool, use_gpu, false, "If true, use the GPU for some operations.");
@@ -184,6 +240,19 @@ int main(int argc, char** argv) {
             absl::GetFlag(FLAGS_input_transform_mode),
             absl::GetFlag(FLAGS_input_video_path),
             absl::GetFlag(FLAGS_input_video_time_path),
+            absl::GetFlag(FLAGS_file_stream_path),
+            absl::GetFlag(FLAGS_end_of_stream),
+            absl::GetFlag(FLAGS_file_stream_rescan_delay),
+            absl::GetFlag(FLAGS_erase_read_files),
+            absl::GetFlag(FLAGS_loop),
+            absl::GetFlag(FLAGS_use_native_v4l2_capture),
+            absl::GetFlag(FLAGS_v4l2_buffer_count),
+            absl::GetFlag(FLAGS_mjpeg_decode_min_width_px),
+            absl::GetFlag(FLAGS_mjpeg_decode_min_height_px),
+            absl::GetFlag(FLAGS_file_stream_watch_directory),
+            absl::GetFlag(FLAGS_file_stream_prefetch_depth),
+            absl::GetFlag(FLAGS_file_stream_prefetch_thread_count),
+            absl::GetFlag(FLAGS_file_stream_prefetch_memory_cap_mb),
         },
         settings::VideoSinkSettings{
             absl::GetFlag(FLAGS_output_video_destination),
@@ -205,6 +274,14 @@ int main(int argc, char** argv) {
         absl::GetFlag(FLAGS_print_graph_contents),
         /*log_transfer_timing_info=*/false, // doesn't currently apply to spot mode
         absl::GetFlag(FLAGS_verbosity),
+        settings::FramePipelineSettings{
+            absl::GetFlag(FLAGS_frame_pipeline_mode),
+            absl::GetFlag(FLAGS_frame_queue_depth),
+            absl::GetFlag(FLAGS_frame_drop_policy)
+        },
+        /*frame_input=*/settings::FrameInputSettings{},
+        /*telemetry=*/settings::TelemetrySettings{},
+        /*graph_profiler=*/settings::GraphProfilerSettings{},
         settings::SpotSettings{
             absl::GetFlag(FLAGS_spot_duration)
         },
@@ -0,0 +1,126 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// Replacement global allocation functions that count every heap allocation (see memory_telemetry.hpp), plus a default
+// cv::Mat allocator that counts pixel buffers, which OpenCV allocates with cv::fastMalloc instead of operator new.
+// Only built into the SmartSpectra::AllocationHooks object library: link it into test & benchmark executables to opt in.
+
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include "memory_telemetry.hpp"
+
+namespace mt = presage::smartspectra::container::memory_telemetry;
+
+namespace {
+
+void* Allocate(std::size_t byte_count) {
+    mt::RecordAllocation(byte_count);
+    // malloc(0) may return nullptr, which operator new must not
+    return std::malloc(byte_count > 0 ? byte_count : 1);
+}
+
+void* AllocateAligned(std::size_t byte_count, std::align_val_t alignment) {
+    mt::RecordAllocation(byte_count);
+    void* pointer = nullptr;
+    const auto alignment_bytes = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+    if (::posix_memalign(&pointer, alignment_bytes, byte_count > 0 ? byte_count : 1) != 0) {
+        return nullptr;
+    }
+    return pointer;
+}
+
+void* AllocateOrThrow(std::size_t byte_count) {
+    void* pointer = Allocate(byte_count);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* AllocateAlignedOrThrow(std::size_t byte_count, std::align_val_t alignment) {
+    void* pointer = AllocateAligned(byte_count, alignment);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+/**
+ * Counts the data buffers of cv::Mats allocated by OpenCV itself (e.g. by Mat::create, clone, or as function outputs);
+ * the allocation is left to OpenCV's standard allocator, which also frees the buffer (its UMatData header is allocated
+ * with operator new, so that one is counted by the operator new hooks).
+ */
+class CountingMatAllocator : public cv::MatAllocator {
+public:
+    cv::UMatData* allocate(
+        int dims, const int* sizes, int type, void* data, size_t* step, cv::AccessFlag flags,
+        cv::UMatUsageFlags usage_flags
+    ) const override {
+        cv::UMatData* mat_data =
+            cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usage_flags);
+        // external data is wrapped, not allocated
+        if (mat_data != nullptr && data == nullptr) {
+            mt::RecordAllocation(mat_data->size);
+        }
+        return mat_data;
+    }
+
+    bool allocate(cv::UMatData* mat_data, cv::AccessFlag access_flags, cv::UMatUsageFlags usage_flags) const override {
+        return cv::Mat::getStdAllocator()->allocate(mat_data, access_flags, usage_flags);
+    }
+
+    void deallocate(cv::UMatData* mat_data) const override {
+        cv::Mat::getStdAllocator()->deallocate(mat_data);
+    }
+};
+
+bool InstallHooks() {
+    // never destroyed, since cv::Mats may outlive static destruction
+    static auto* mat_allocator = new CountingMatAllocator();
+    cv::Mat::setDefaultAllocator(mat_allocator);
+    mt::MarkAllocationHooksInstalled();
+    return true;
+}
+
+// runs during static initialization of the executable the hooks are linked into
+[[maybe_unused]] const bool hooks_installed = InstallHooks();
+
+} // anonymous namespace
+
+void* operator new(std::size_t byte_count) { return AllocateOrThrow(byte_count); }
+void* operator new[](std::size_t byte_count) { return AllocateOrThrow(byte_count); }
+void* operator new(std::size_t byte_count, const std::nothrow_t&) noexcept { return Allocate(byte_count); }
+void* operator new[](std::size_t byte_count, const std::nothrow_t&) noexcept { return Allocate(byte_count); }
+void* operator new(std::size_t byte_count, std::align_val_t alignment) {
+    return AllocateAlignedOrThrow(byte_count, alignment);
+}
+void* operator new[](std::size_t byte_count, std::align_val_t alignment) {
+    return AllocateAlignedOrThrow(byte_count, alignment);
+}
+void* operator new(std::size_t byte_count, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(byte_count, alignment);
+}
+void* operator new[](std::size_t byte_count, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(byte_count, alignment);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { std::free(pointer); }
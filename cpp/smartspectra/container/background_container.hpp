@@ -20,10 +20,21 @@
 
 #pragma once
 // === standard library includes (if any) ===
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 // === third-party includes (if any) ===
+#include <absl/types/span.h>
+#include <mediapipe/framework/formats/image_frame.h>
+#include <mediapipe/framework/packet.h>
 #include <mediapipe/framework/port/opencv_core_inc.h>
 // === local includes (if any) ===
 #include "container.hpp"
+#include "yuv_conversion.hpp"
 
 
 namespace presage::smartspectra::container {
@@ -54,16 +65,109 @@ public:
 
     absl::Status AddFrameWithTimestamp(const cv::Mat& frame_rgb, int64_t frame_timestamp_μs);
 
+    /**
+     * Zero-copy variant: takes ownership of an SRGB ImageFrame and sends it into the graph as-is.
+     */
+    absl::Status AddFrameWithTimestamp(std::unique_ptr<mediapipe::ImageFrame> frame_rgb, int64_t frame_timestamp_μs);
+
+    /**
+     * Converts an NV12 / I420 / YUYV frame straight into the graph's input frame (no intermediate RGB buffer).
+     */
+    absl::Status AddFrameWithTimestamp(const yuv_conversion::YuvFrameView& frame_yuv, int64_t frame_timestamp_μs);
+
+    /**
+     * Zero-copy variant for externally-owned RGB buffers: the pixels are wrapped, not copied.
+     * @param pixel_data_rgb interleaved 8-bit RGB pixels; for best performance, data & rows should be 16-byte aligned
+     * @param width_step row stride, in bytes
+     * @param on_frame_released invoked exactly once, when the graph no longer references the pixels (or right away,
+     * if the frame couldn't be added); the caller may only reuse / free the buffer after that.
+     */
+    absl::Status AddFrameWithTimestamp(
+        uint8_t* pixel_data_rgb,
+        int width,
+        int height,
+        int width_step,
+        int64_t frame_timestamp_μs,
+        std::function<void()> on_frame_released
+    );
+
+    /**
+     * Batch variant for offline processing: validates the whole batch up front (nothing is added if any frame or
+     * timestamp is invalid), then feeds all frames under a single lock.
+     * With the Reject backpressure policy, the batch is refused as a whole unless all of it fits into the free frame
+     * slots (so batches larger than max_frames_in_flight are never taken). With Block, the graph stopping mid-batch
+     * cancels the rest: the frames fed before stay in the graph, and the error message says how many.
+     * @param frame_timestamps_μs one per frame, strictly increasing
+     */
+    absl::Status AddFramesWithTimestamps(
+        absl::Span<const cv::Mat> frames_rgb,
+        absl::Span<const int64_t> frame_timestamps_μs
+    );
+
+    /**
+     * Zero-copy batch variant: takes ownership of all frames (the span's elements are left empty on success).
+     */
+    absl::Status AddFramesWithTimestamps(
+        absl::Span<std::unique_ptr<mediapipe::ImageFrame>> frames_rgb,
+        absl::Span<const int64_t> frame_timestamps_μs
+    );
+
     absl::Status SetOnBluetoothCallback(std::function<absl::Status(double)> on_bluetooth);
 
     absl::Status SetOnOutputFrameCallback(std::function<absl::Status(cv::Mat&)> on_output_frame);
 
     physiology::StatusCode GetStatusCode() const { return previous_status_code; };
 
+    /**
+     * Gauge: frames added to the graph that haven't been reported on the frame-sent-through stream yet.
+     * Callers can use it to throttle capture before settings.frame_input.max_frames_in_flight is hit. Only tracked
+     * while a limit is set; always 0 otherwise.
+     */
+    size_t GetFramesInFlight() const { return frames_in_flight_count.load(); };
+
+    // number of frames discarded so far by the ReplaceOldest backpressure policy
+    uint64_t GetReplacedFrameCount() const { return replaced_frame_count.load(); };
+
+    // number of frames reported on the frame-sent-through stream as processed / as dropped by the graph, respectively
+    uint64_t GetFramesSentThroughCount() const { return frames_sent_through_count.load(); };
+    uint64_t GetFramesDroppedInGraphCount() const { return frames_dropped_in_graph_count.load(); };
+
     absl::Status StopGraph();
 
 private:
+    absl::Status CheckFrameInputPreconditions() const;
+    absl::Status AdmitFrame(std::unique_ptr<mediapipe::ImageFrame> input_frame, int64_t frame_timestamp_μs);
+    absl::Status FeedFrameToGraph(std::unique_ptr<mediapipe::ImageFrame> input_frame, int64_t frame_timestamp_μs);
+    absl::Status OnFrameLeftGraph(int64_t frame_timestamp_μs);
+    absl::Status FeedPendingFrameIfSlotFree();
+    [[nodiscard]] bool LimitsFramesInFlight() const;
+    [[nodiscard]] bool IsBelowFramesInFlightLimit() const;
+    [[nodiscard]] bool TryReserveFrameSlot(int64_t frame_timestamp_μs);
+    [[nodiscard]] bool WaitToReserveFrameSlot(int64_t frame_timestamp_μs);
+    void ReleaseFrameSlot(int64_t frame_timestamp_μs);
+    // also updates the frames-in-flight gauge of the runtime metrics, if set
+    void SetFramesInFlightCount(size_t frame_count);
+
     physiology::StatusCode previous_status_code = physiology::StatusCode::PROCESSING_NOT_STARTED;
+
+    // == in-flight frame accounting / backpressure
+    // serializes feeding, so that frames enter the graph in timestamp order; guards the pending frame. Held while
+    // packets are added to the graph, so graph threads (i.e. output observers) must never take it.
+    std::mutex frame_feed_mutex;
+    // frame held back under the ReplaceOldest policy
+    std::unique_ptr<mediapipe::ImageFrame> pending_frame = nullptr;
+    int64_t pending_frame_timestamp = 0;
+    // guards the in-flight frame slots (only used while max_frames_in_flight is set); never held while packets are
+    // added to the graph. Always taken after frame_feed_mutex, if both are needed.
+    std::mutex frame_slot_mutex;
+    std::condition_variable frame_slot_freed;
+    // frames enter the graph in timestamp order, so this stays sorted; unlike a node-based set, a deque doesn't
+    // allocate on every frame
+    std::deque<int64_t> in_flight_frame_timestamps;
+    std::atomic<size_t> frames_in_flight_count{0};
+    std::atomic<uint64_t> replaced_frame_count{0};
+    std::atomic<uint64_t> frames_sent_through_count{0};
+    std::atomic<uint64_t> frames_dropped_in_graph_count{0};
 };
 
 typedef BackgroundContainer<platform_independence::DeviceType::Cpu, settings::OperationMode::Spot, settings::IntegrationMode::Rest> CpuSpotRestBackgroundContainer;
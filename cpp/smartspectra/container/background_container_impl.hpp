@@ -20,6 +20,10 @@
 
 #pragma once
 // === standard library includes (if any) ===
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
 // === third-party includes (if any) ===
 #include <mediapipe/framework/formats/image_frame.h>
 #include <mediapipe/framework/formats/image_frame_opencv.h>
@@ -28,10 +32,13 @@
 // === local includes (if any) ===
 #include "background_container.hpp"
 #include "image_transfer.hpp"
+#include "graph_profiling.hpp"
 
 namespace presage::smartspectra::container {
 namespace it = image_transfer;
 namespace pe = physiology::edge;
+namespace pst = pipeline_stage_telemetry;
+namespace ft = frame_tracer;
 
 template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
 BackgroundContainer<TDeviceType,
@@ -84,6 +91,9 @@ absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>:
                 physiology::StatusCode status = status_packet.Get<physiology::StatusValue>().value();
                 if (status != this->previous_status_code) {
                     this->previous_status_code = status;
+                    if (this->runtime_metrics != nullptr) {
+                        this->runtime_metrics->RecordStatusChange(static_cast<int>(status));
+                    }
                     return this->OnStatusChange(status);
                 }
             }
@@ -100,7 +110,14 @@ absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>:
                 auto metrics_buffer = output_packet.Get<physiology::MetricsBuffer>();
                 auto timestamp = output_packet.Timestamp();
                 MP_RETURN_IF_ERROR(this->ComputeCorePerformanceTelemetry(metrics_buffer));
-                return this->OnCoreMetricsOutput(metrics_buffer, timestamp.Value());
+                {
+                    ft::ScopedTraceSpan span(
+                        this->frame_tracer, "OnCoreMetricsOutput", metrics_buffer.metadata().frame_timestamp()
+                    );
+                    pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::UserCallback);
+                    MP_RETURN_IF_ERROR(this->OnCoreMetricsOutput(metrics_buffer, timestamp.Value()));
+                }
+                return this->ReportPipelineStageTelemetryIfDue();
             }
             return absl::OkStatus();
         }
@@ -117,6 +134,7 @@ absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>:
                 [this](const mediapipe::Packet& output_packet) {
                     if (!output_packet.IsEmpty()) {
                         auto metrics_buffer = output_packet.Get<physiology::Metrics>();
+                        pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::UserCallback);
                         return this->OnEdgeMetricsOutput(metrics_buffer);
                     }
                     return absl::OkStatus();
@@ -130,27 +148,41 @@ absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>:
         physiology::edge::graph::output_streams::kOutputVideo,
         [this](const mediapipe::Packet& output_video_packet) -> absl::Status {
             if (!output_video_packet.IsEmpty()) {
+                auto timestamp = output_video_packet.Timestamp();
+                this->frame_tracer.RecordAsyncEnd("Graph", timestamp.Value());
+                ft::ScopedTraceSpan span(this->frame_tracer, "OutputVideoObserver", timestamp.Value());
                 cv::Mat output_frame_rgb;
-                MP_RETURN_IF_ERROR(it::GetFrameFromPacket<TDeviceType>(output_frame_rgb,
-                                                                       this->device_context,
-                                                                       output_video_packet));
+                {
+                    pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::OutputFrameFetch);
+                    MP_RETURN_IF_ERROR(it::GetFrameFromPacket<TDeviceType>(output_frame_rgb,
+                                                                           this->device_context,
+                                                                           output_video_packet));
+                }
                 // Convert to BGR and display.
-                cv::cvtColor(output_frame_rgb, this->output_frame_bgr, cv::COLOR_RGB2BGR);
-                auto timestamp = output_video_packet.Timestamp();
-                return this->OnVideoOutput(this->output_frame_bgr, timestamp.Value());
+                {
+                    pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::BgrConversion);
+                    cv::cvtColor(output_frame_rgb, this->output_frame_bgr, cv::COLOR_RGB2BGR);
+                }
+                {
+                    ft::ScopedTraceSpan callback_span(this->frame_tracer, "OnVideoOutput", timestamp.Value());
+                    pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::UserCallback);
+                    MP_RETURN_IF_ERROR(this->OnVideoOutput(this->output_frame_bgr, timestamp.Value()));
+                }
+                return this->ReportPipelineStageTelemetryIfDue();
             }
             return absl::OkStatus();
         }
     ));
 
-    MP_RETURN_IF_ERROR(CheckCallbackNotNull("OnFrameSentThrough", this->OnFrameSentThrough));
     MP_RETURN_IF_ERROR(this->graph.ObserveOutputStream(
         pe::graph::output_streams::kFrameSentThrough,
         [this](const mediapipe::Packet& output_packet) {
            if (!output_packet.IsEmpty()) {
                bool frame_sent_through = output_packet.Get<bool>();
                auto timestamp = output_packet.Timestamp();
-               return this->OnFrameSentThrough(frame_sent_through, timestamp.Value());
+               (frame_sent_through ? this->frames_sent_through_count : this->frames_dropped_in_graph_count)++;
+               MP_RETURN_IF_ERROR(this->OnFrameLeftGraph(timestamp.Value()));
+               return this->AccountForFrameLeavingGraph(frame_sent_through, timestamp.Value());
            }
            return absl::OkStatus();
         }
@@ -170,6 +202,13 @@ absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>:
     if (!this->running) {
         return absl::FailedPreconditionError("Graph not started.");
     }
+    {
+        // a frame held back by the ReplaceOldest policy is still owed to the graph
+        std::lock_guard<std::mutex> feed_lock(this->frame_feed_mutex);
+        if (this->pending_frame != nullptr && this->WaitToReserveFrameSlot(this->pending_frame_timestamp)) {
+            MP_RETURN_IF_ERROR(this->FeedFrameToGraph(std::move(this->pending_frame), this->pending_frame_timestamp));
+        }
+    }
     MP_RETURN_IF_ERROR(this->graph.WaitUntilIdle());
     return absl::OkStatus();
 }
@@ -200,37 +239,430 @@ template<platform_independence::DeviceType TDeviceType, settings::OperationMode
 absl::Status BackgroundContainer<TDeviceType,
     TOperationMode,
     TIntegrationMode>::AddFrameWithTimestamp(const cv::Mat& frame_rgb, int64_t frame_timestamp_μs) {
+    MP_RETURN_IF_ERROR(this->CheckFrameInputPreconditions());
+    if (frame_rgb.empty() || frame_rgb.type() != CV_8UC3) {
+        return absl::InvalidArgumentError("Input frame has to be a non-empty, 8-bit, 3-channel RGB image.");
+    }
+    // Wrap Mat into a (recycled) ImageFrame.
+    auto input_frame = this->input_frame_pool.Acquire(mediapipe::ImageFormat::SRGB, frame_rgb.cols, frame_rgb.rows);
+    cv::Mat input_frame_mat = mediapipe::formats::MatView(input_frame.get());
+    // transfer camera_frame data to input_frame
+    {
+        pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::ColorConversion);
+        frame_rgb.copyTo(input_frame_mat);
+    }
+
+    return this->AddFrameWithTimestamp(std::move(input_frame), frame_timestamp_μs);
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::CheckFrameInputPreconditions() const {
     if (!this->initialized) {
         return absl::FailedPreconditionError("Container not initialized.");
     }
     if (!this->running) {
         return absl::FailedPreconditionError("Graph not started.");
     }
-    // Wrap Mat into an ImageFrame.
-    auto input_frame = absl::make_unique<mediapipe::ImageFrame>(
-        mediapipe::ImageFormat::SRGB, frame_rgb.cols, frame_rgb.rows,
-        mediapipe::ImageFrame::kDefaultAlignmentBoundary
-    );
-    cv::Mat input_frame_mat = mediapipe::formats::MatView(input_frame.get());
-    // transfer camera_frame data to input_frame
-    frame_rgb.copyTo(input_frame_mat);
+    return absl::OkStatus();
+}
+
+static absl::Status CheckInputFrame(const std::unique_ptr<mediapipe::ImageFrame>& frame_rgb) {
+    if (frame_rgb == nullptr || frame_rgb->IsEmpty()) {
+        return absl::InvalidArgumentError("Input frame is empty.");
+    }
+    if (frame_rgb->Format() != mediapipe::ImageFormat::SRGB) {
+        return absl::InvalidArgumentError("Input frame has to be in SRGB format.");
+    }
+    return absl::OkStatus();
+}
+
+static absl::Status CheckBatchTimestamps(size_t frame_count, absl::Span<const int64_t> frame_timestamps_μs) {
+    if (frame_count != frame_timestamps_μs.size()) {
+        return absl::InvalidArgumentError(
+            "Frame count (" + std::to_string(frame_count) + ") doesn't match timestamp count (" +
+            std::to_string(frame_timestamps_μs.size()) + ")."
+        );
+    }
+    for (size_t i_frame = 1; i_frame < frame_timestamps_μs.size(); i_frame++) {
+        if (frame_timestamps_μs[i_frame] <= frame_timestamps_μs[i_frame - 1]) {
+            return absl::InvalidArgumentError(
+                "Frame timestamps have to be strictly increasing, got " +
+                std::to_string(frame_timestamps_μs[i_frame]) + " after " +
+                std::to_string(frame_timestamps_μs[i_frame - 1]) + "."
+            );
+        }
+    }
+    return absl::OkStatus();
+}
+
+/**
+ * Adds frame input to graph without copying pixel data. Also, updates the recording status within the graph
+ * (see the cv::Mat overload).
+ * @param frame_rgb SRGB frame; ownership passes to the graph, which releases it once the last packet referencing
+ * it is gone.
+ * @param frame_timestamp_μs frame timestamp in microseconds; preferably, should be based on camera's own shutter clock
+ * @return status of the operation
+ */
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status BackgroundContainer<TDeviceType,
+    TOperationMode,
+    TIntegrationMode>::AddFrameWithTimestamp(
+    std::unique_ptr<mediapipe::ImageFrame> frame_rgb,
+    int64_t frame_timestamp_μs
+) {
+    MP_RETURN_IF_ERROR(this->CheckFrameInputPreconditions());
+    MP_RETURN_IF_ERROR(CheckInputFrame(frame_rgb));
+
+    std::lock_guard<std::mutex> feed_lock(this->frame_feed_mutex);
+    return this->AdmitFrame(std::move(frame_rgb), frame_timestamp_μs);
+}
+
+/**
+ * Adds a batch of frames to the graph (see the single-frame cv::Mat overload). Container state and the batch itself
+ * are validated once, before any frame is copied.
+ * @param frames_rgb 8-bit, 3-channel RGB frames
+ * @param frame_timestamps_μs frame timestamps in microseconds, one per frame, strictly increasing
+ * @return status of the operation
+ */
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::AddFramesWithTimestamps(
+    absl::Span<const cv::Mat> frames_rgb,
+    absl::Span<const int64_t> frame_timestamps_μs
+) {
+    MP_RETURN_IF_ERROR(this->CheckFrameInputPreconditions());
+    MP_RETURN_IF_ERROR(CheckBatchTimestamps(frames_rgb.size(), frame_timestamps_μs));
+    for (const cv::Mat& frame_rgb: frames_rgb) {
+        if (frame_rgb.empty() || frame_rgb.type() != CV_8UC3) {
+            return absl::InvalidArgumentError("Input frames have to be non-empty, 8-bit, 3-channel RGB images.");
+        }
+    }
+    std::vector<std::unique_ptr<mediapipe::ImageFrame>> input_frames;
+    input_frames.reserve(frames_rgb.size());
+    for (const cv::Mat& frame_rgb: frames_rgb) {
+        auto input_frame = this->input_frame_pool.Acquire(mediapipe::ImageFormat::SRGB, frame_rgb.cols, frame_rgb.rows);
+        cv::Mat input_frame_mat = mediapipe::formats::MatView(input_frame.get());
+        {
+            pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::ColorConversion);
+            frame_rgb.copyTo(input_frame_mat);
+        }
+        input_frames.push_back(std::move(input_frame));
+    }
+    return this->AddFramesWithTimestamps(absl::MakeSpan(input_frames), frame_timestamps_μs);
+}
+
+/**
+ * Zero-copy batch variant (see the single-frame ImageFrame overload). The batch is validated as a whole up front,
+ * then fed to the graph under a single acquisition of the frame feed lock, so no other caller's frames can interleave
+ * with it.
+ * Under the Reject policy, capacity is checked for the whole batch before anything is fed, so a batch is either taken
+ * in full or not at all. Under Block, the graph stopping mid-batch leaves the frames fed so far in the graph; the
+ * returned error says how many those were.
+ */
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::AddFramesWithTimestamps(
+    absl::Span<std::unique_ptr<mediapipe::ImageFrame>> frames_rgb,
+    absl::Span<const int64_t> frame_timestamps_μs
+) {
+    MP_RETURN_IF_ERROR(this->CheckFrameInputPreconditions());
+    MP_RETURN_IF_ERROR(CheckBatchTimestamps(frames_rgb.size(), frame_timestamps_μs));
+    for (const auto& frame_rgb: frames_rgb) {
+        MP_RETURN_IF_ERROR(CheckInputFrame(frame_rgb));
+    }
+
+    std::lock_guard<std::mutex> feed_lock(this->frame_feed_mutex);
+    const int max_frames_in_flight = this->settings.frame_input.max_frames_in_flight;
+    if (this->settings.frame_input.backpressure_policy == settings::BackpressurePolicy::Reject &&
+        this->LimitsFramesInFlight()) {
+        // slots can only free up between this check & feeding: other callers wait for the feed lock
+        size_t free_frame_slot_count;
+        {
+            std::lock_guard<std::mutex> slot_lock(this->frame_slot_mutex);
+            free_frame_slot_count =
+                static_cast<size_t>(max_frames_in_flight) -
+                std::min(this->in_flight_frame_timestamps.size(), static_cast<size_t>(max_frames_in_flight));
+        }
+        if (frames_rgb.size() > free_frame_slot_count) {
+            if (this->runtime_metrics != nullptr) {
+                this->runtime_metrics->RecordFramesDroppedBeforeGraph(static_cast<int64_t>(frames_rgb.size()));
+            }
+            return absl::ResourceExhaustedError(
+                "Batch of " + std::to_string(frames_rgb.size()) + " frames doesn't fit into the " +
+                std::to_string(free_frame_slot_count) + " free frame slot(s) (maximum number of frames in flight: " +
+                std::to_string(max_frames_in_flight) + "); no frames were added."
+            );
+        }
+    }
+    for (size_t i_frame = 0; i_frame < frames_rgb.size(); i_frame++) {
+        absl::Status status = this->AdmitFrame(std::move(frames_rgb[i_frame]), frame_timestamps_μs[i_frame]);
+        if (!status.ok()) {
+            return absl::Status(
+                status.code(),
+                std::string(status.message()) + " (" + std::to_string(i_frame) + " of " +
+                std::to_string(frames_rgb.size()) + " frames of the batch were added)"
+            );
+        }
+    }
+    return absl::OkStatus();
+}
+
+// applies the backpressure policy; has to be called with frame_feed_mutex held
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::AdmitFrame(
+    std::unique_ptr<mediapipe::ImageFrame> input_frame,
+    int64_t frame_timestamp_μs
+) {
+    // a frame held back earlier goes first, so that frames enter the graph in timestamp order
+    MP_RETURN_IF_ERROR(this->FeedPendingFrameIfSlotFree());
+    // a pending frame (if any) has dibs on the next free slot
+    if (this->pending_frame == nullptr && this->TryReserveFrameSlot(frame_timestamp_μs)) {
+        return this->FeedFrameToGraph(std::move(input_frame), frame_timestamp_μs);
+    }
+    switch (this->settings.frame_input.backpressure_policy) {
+        case settings::BackpressurePolicy::Block:
+            if (!this->WaitToReserveFrameSlot(frame_timestamp_μs)) {
+                return absl::CancelledError("Graph stopped while waiting for a free frame slot.");
+            }
+            return this->FeedFrameToGraph(std::move(input_frame), frame_timestamp_μs);
+        case settings::BackpressurePolicy::Reject:
+            if (this->runtime_metrics != nullptr) this->runtime_metrics->RecordFramesDroppedBeforeGraph(1);
+            return absl::ResourceExhaustedError(
+                "Maximum number of frames in flight (" +
+                std::to_string(this->settings.frame_input.max_frames_in_flight) + ") reached."
+            );
+        case settings::BackpressurePolicy::ReplaceOldest:
+            if (this->pending_frame != nullptr) {
+                this->replaced_frame_count++;
+                if (this->runtime_metrics != nullptr) this->runtime_metrics->RecordFramesDroppedBeforeGraph(1);
+            }
+            this->pending_frame = std::move(input_frame);
+            this->pending_frame_timestamp = frame_timestamp_μs;
+            return absl::OkStatus();
+        default:
+            return absl::InvalidArgumentError(
+                "Unsupported backpressure policy: " +
+                settings::AbslUnparseFlag(this->settings.frame_input.backpressure_policy)
+            );
+    }
+}
 
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+void BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::SetFramesInFlightCount(size_t frame_count) {
+    this->frames_in_flight_count = frame_count;
+    if (this->runtime_metrics != nullptr) {
+        this->runtime_metrics->SetFramesInFlight(static_cast<int64_t>(frame_count));
+    }
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+bool BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::LimitsFramesInFlight() const {
+    return this->settings.frame_input.max_frames_in_flight > 0;
+}
+
+// has to be called with frame_slot_mutex held
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+bool BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::IsBelowFramesInFlightLimit() const {
+    return this->in_flight_frame_timestamps.size() <
+           static_cast<size_t>(this->settings.frame_input.max_frames_in_flight);
+}
+
+/**
+ * Takes up a frame slot for a frame that's about to be fed, if one is free (always the case without a limit, in which
+ * case nothing is tracked). The slot is taken before feeding, so that the frame-sent-through observer can never see
+ * the frame before its slot exists.
+ */
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+bool BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::TryReserveFrameSlot(
+    int64_t frame_timestamp_μs
+) {
+    if (!this->LimitsFramesInFlight()) {
+        return true;
+    }
+    std::lock_guard<std::mutex> slot_lock(this->frame_slot_mutex);
+    if (!this->IsBelowFramesInFlightLimit()) {
+        return false;
+    }
+    this->in_flight_frame_timestamps.push_back(frame_timestamp_μs);
+    this->SetFramesInFlightCount(this->in_flight_frame_timestamps.size());
+    return true;
+}
+
+// like TryReserveFrameSlot, but waits for a slot to free up; false if the graph was stopped in the meantime
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+bool BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::WaitToReserveFrameSlot(
+    int64_t frame_timestamp_μs
+) {
+    if (!this->LimitsFramesInFlight()) {
+        return this->running;
+    }
+    std::unique_lock<std::mutex> slot_lock(this->frame_slot_mutex);
+    this->frame_slot_freed.wait(slot_lock, [this]() { return this->IsBelowFramesInFlightLimit() || !this->running; });
+    if (!this->running) {
+        return false;
+    }
+    this->in_flight_frame_timestamps.push_back(frame_timestamp_μs);
+    this->SetFramesInFlightCount(this->in_flight_frame_timestamps.size());
+    return true;
+}
+
+// gives back the slot of a frame the graph refused: it never shows up on the frame-sent-through stream
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+void BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::ReleaseFrameSlot(int64_t frame_timestamp_μs) {
+    if (!this->LimitsFramesInFlight()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> slot_lock(this->frame_slot_mutex);
+        // the most recent reservation is the frame's own
+        auto reserved_slot = std::find(
+            this->in_flight_frame_timestamps.rbegin(), this->in_flight_frame_timestamps.rend(), frame_timestamp_μs
+        );
+        if (reserved_slot != this->in_flight_frame_timestamps.rend()) {
+            this->in_flight_frame_timestamps.erase(std::next(reserved_slot).base());
+        }
+        this->SetFramesInFlightCount(this->in_flight_frame_timestamps.size());
+    }
+    this->frame_slot_freed.notify_all();
+}
+
+// has to be called with frame_feed_mutex held
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::FeedPendingFrameIfSlotFree() {
+    if (this->pending_frame == nullptr || !this->running || !this->TryReserveFrameSlot(this->pending_frame_timestamp)) {
+        return absl::OkStatus();
+    }
+    return this->FeedFrameToGraph(std::move(this->pending_frame), this->pending_frame_timestamp);
+}
+
+/**
+ * Called from the frame-sent-through stream observer: frames up to & including the given timestamp are no longer
+ * in flight (the stream may skip timestamps, so everything older is released as well). This runs on a graph thread,
+ * so it only ever takes frame_slot_mutex, which is never held while packets are added to the graph: otherwise, a
+ * feeding thread waiting on a full graph input queue would block the very thread that has to drain it. For the same
+ * reason, a frame held back by the ReplaceOldest policy isn't fed from here: it goes in with the next frame-adding
+ * call (or WaitUntilGraphIsIdle).
+ */
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::OnFrameLeftGraph(
+    int64_t frame_timestamp_μs
+) {
+    if (!this->LimitsFramesInFlight()) {
+        return absl::OkStatus();
+    }
+    {
+        std::lock_guard<std::mutex> slot_lock(this->frame_slot_mutex);
+        if (this->in_flight_frame_timestamps.empty() ||
+            this->in_flight_frame_timestamps.front() > frame_timestamp_μs) {
+            return absl::OkStatus();
+        }
+        while (!this->in_flight_frame_timestamps.empty() &&
+               this->in_flight_frame_timestamps.front() <= frame_timestamp_μs) {
+            this->in_flight_frame_timestamps.pop_front();
+        }
+        this->SetFramesInFlightCount(this->in_flight_frame_timestamps.size());
+    }
+    this->frame_slot_freed.notify_all();
+    return absl::OkStatus();
+}
+
+// has to be called with frame_feed_mutex held, so that frames enter the graph in timestamp order, and with a frame
+// slot already reserved for the frame
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::FeedFrameToGraph(
+    std::unique_ptr<mediapipe::ImageFrame> input_frame,
+    int64_t frame_timestamp_μs
+) {
+    auto input_frame_owner = std::move(input_frame);
     auto frame_timestamp = mediapipe::Timestamp(frame_timestamp_μs);
     this->AddFrameTimestampToBenchmarkingInfo(frame_timestamp);
+    ft::ScopedTraceSpan span(this->frame_tracer, "FeedFrameToGraph", frame_timestamp_μs);
+    pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::GraphFeed);
     // Send recording state to the graph.
-    MP_RETURN_IF_ERROR(
-        this->graph
-            .AddPacketToInputStream(
-                pe::graph::input_streams::kRecording,
-                mediapipe::MakePacket<bool>(this->recording).At(frame_timestamp)
-            )
+    absl::Status status = this->graph.AddPacketToInputStream(
+        pe::graph::input_streams::kRecording,
+        (this->recording ? this->recording_on_packet : this->recording_off_packet).At(frame_timestamp)
     );
     // Send image packet into the graph.
-    MP_RETURN_IF_ERROR(
-        it::FeedFrameToGraph(std::move(input_frame), this->graph, this->device_context, frame_timestamp_μs,
-                             pe::graph::input_streams::kInputVideo)
+    if (status.ok()) {
+        this->frame_tracer.RecordAsyncBegin("Graph", frame_timestamp_μs);
+        status = it::FeedFrameToGraph(std::move(input_frame_owner), this->graph, this->device_context,
+                                      frame_timestamp_μs, pe::graph::input_streams::kInputVideo);
+    }
+    if (!status.ok()) {
+        this->ReleaseFrameSlot(frame_timestamp_μs);
+    }
+    return status;
+}
+
+/**
+ * Adds YUV frame input to graph, converting it to RGB directly inside a (recycled) ImageFrame.
+ * @param frame_yuv NV12, I420, or YUYV frame; only read during the call
+ * @param frame_timestamp_μs frame timestamp in microseconds; preferably, should be based on camera's own shutter clock
+ * @return status of the operation
+ */
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status BackgroundContainer<TDeviceType,
+    TOperationMode,
+    TIntegrationMode>::AddFrameWithTimestamp(
+    const yuv_conversion::YuvFrameView& frame_yuv,
+    int64_t frame_timestamp_μs
+) {
+    // check before spending a pooled frame & a conversion on input that would be refused anyway
+    MP_RETURN_IF_ERROR(this->CheckFrameInputPreconditions());
+    MP_RETURN_IF_ERROR(yuv_conversion::ValidateYuvFrame(frame_yuv));
+    auto input_frame = this->input_frame_pool.Acquire(mediapipe::ImageFormat::SRGB, frame_yuv.width, frame_yuv.height);
+    {
+        pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::ColorConversion);
+        MP_RETURN_IF_ERROR(yuv_conversion::ConvertYuvToRgb(
+            frame_yuv, input_frame->MutablePixelData(), input_frame->WidthStep()
+        ));
+    }
+    return this->AddFrameWithTimestamp(std::move(input_frame), frame_timestamp_μs);
+}
+
+/**
+ * Adds frame input to graph by wrapping (not copying) an externally-owned RGB buffer.
+ * @param on_frame_released called exactly once: when the graph has released the frame, or right away if the frame
+ * could not be added. With OpenGL device type, this happens as soon as the pixels are uploaded to a GPU texture.
+ */
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status BackgroundContainer<TDeviceType,
+    TOperationMode,
+    TIntegrationMode>::AddFrameWithTimestamp(
+    uint8_t* pixel_data_rgb,
+    int width,
+    int height,
+    int width_step,
+    int64_t frame_timestamp_μs,
+    std::function<void()> on_frame_released
+) {
+    constexpr int kRgbChannelCount = 3;
+    absl::Status input_status = this->CheckFrameInputPreconditions();
+    if (!input_status.ok()) {
+        // container state, reported as is
+    } else if (pixel_data_rgb == nullptr) {
+        input_status = absl::InvalidArgumentError("Pixel data pointer is null.");
+    } else if (width <= 0 || height <= 0) {
+        input_status = absl::InvalidArgumentError(
+            "Invalid frame dimensions: " + std::to_string(width) + "x" + std::to_string(height) + "."
+        );
+    } else if (width_step < width * kRgbChannelCount) {
+        input_status = absl::InvalidArgumentError(
+            "Width step (" + std::to_string(width_step) + " bytes) is less than a row of RGB pixels (" +
+            std::to_string(width * kRgbChannelCount) + " bytes)."
+        );
+    }
+    if (!input_status.ok()) {
+        if (on_frame_released) on_frame_released();
+        return input_status;
+    }
+    // from here on, the frame's deleter is responsible for invoking the release callback
+    auto input_frame = absl::make_unique<mediapipe::ImageFrame>(
+        mediapipe::ImageFormat::SRGB, width, height, width_step, pixel_data_rgb,
+        [on_frame_released = std::move(on_frame_released)](uint8_t*) {
+            if (on_frame_released) on_frame_released();
+        }
     );
-    return absl::OkStatus();
+    return this->AddFrameWithTimestamp(std::move(input_frame), frame_timestamp_μs);
 }
 
 template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
@@ -283,14 +715,30 @@ absl::Status BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode>:
         LOG(INFO) << "Graph already stopped.";
         return absl::OkStatus();
     }
+    {
+        // release callers blocked on backpressure
+        std::lock_guard<std::mutex> slot_lock(this->frame_slot_mutex);
+        this->running = false;
+    }
+    this->frame_slot_freed.notify_all();
+    {
+        // drop any frame held back
+        std::lock_guard<std::mutex> feed_lock(this->frame_feed_mutex);
+        this->pending_frame = nullptr;
+    }
     LOG(INFO) << "Closing input streams/packet sources & stopping graph...";
     MP_RETURN_IF_ERROR(this->graph.CloseAllInputStreams());
     MP_RETURN_IF_ERROR(this->graph.CloseAllPacketSources());
     MP_RETURN_IF_ERROR(this->graph.WaitUntilDone());
     this->previous_status_code = physiology::StatusCode::PROCESSING_NOT_STARTED;
-    this->running = false;
+    {
+        std::lock_guard<std::mutex> slot_lock(this->frame_slot_mutex);
+        this->in_flight_frame_timestamps.clear();
+        this->SetFramesInFlightCount(0);
+    }
     LOG(INFO) << "Graph stopped.";
-    return absl::OkStatus();
+    MP_RETURN_IF_ERROR(graph_profiling::ReportCalculatorTimings(this->graph, this->settings.graph_profiler));
+    return this->FlushFrameTraceIfConfigured();
 }
 
 } // namespace presage::smartspectra::container
@@ -0,0 +1,154 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/opencv_imgproc_inc.h>
+#include <mediapipe/framework/port/status_macros.h>
+// === local includes (if any) ===
+#include "color_conversion.hpp"
+
+namespace presage::smartspectra::container::color_conversion {
+
+namespace vs = presage::smartspectra::video_source;
+
+namespace {
+
+constexpr int kDestinationChannelCount = 3;
+// square destination tile size (in pixels) used for rotations, so that the strided source reads stay cache-resident
+constexpr int kTileSize = 32;
+
+/**
+ * Describes where in the source the pixel of destination position (row, col) lives:
+ * source address = origin + row * row_step + col * col_step (steps in bytes, may be negative).
+ */
+struct SourceWalk {
+    const uint8_t* origin;
+    ptrdiff_t row_step;
+    ptrdiff_t col_step;
+};
+
+SourceWalk GetSourceWalk(const cv::Mat& source, vs::InputTransformMode mode) {
+    const auto source_row_step = static_cast<ptrdiff_t>(source.step[0]);
+    const auto channel_count = static_cast<ptrdiff_t>(source.channels());
+    const int last_row = source.rows - 1;
+    const int last_col = source.cols - 1;
+    switch (mode) {
+        case vs::InputTransformMode::MirrorHorizontal:
+            return {source.ptr<uint8_t>(0) + last_col * channel_count, source_row_step, -channel_count};
+        case vs::InputTransformMode::MirrorVertical:
+            return {source.ptr<uint8_t>(last_row), -source_row_step, channel_count};
+        case vs::InputTransformMode::Rotate180:
+            return {source.ptr<uint8_t>(last_row) + last_col * channel_count, -source_row_step, -channel_count};
+        case vs::InputTransformMode::Clockwise90:
+            // destination (r, c) <- source (last_row - c, r)
+            return {source.ptr<uint8_t>(last_row), channel_count, -source_row_step};
+        case vs::InputTransformMode::Counterclockwise90:
+            // destination (r, c) <- source (c, last_col - r)
+            return {source.ptr<uint8_t>(0) + last_col * channel_count, -channel_count, source_row_step};
+        case vs::InputTransformMode::None:
+        default:
+            return {source.ptr<uint8_t>(0), source_row_step, channel_count};
+    }
+}
+
+template<bool kSwapRedAndBlue>
+inline void CopyRowSegment(const uint8_t* source, ptrdiff_t source_pixel_step, uint8_t* destination, int count) {
+    for (int i_pixel = 0; i_pixel < count; i_pixel++) {
+        destination[0] = source[kSwapRedAndBlue ? 2 : 0];
+        destination[1] = source[1];
+        destination[2] = source[kSwapRedAndBlue ? 0 : 2];
+        destination += kDestinationChannelCount;
+        source += source_pixel_step;
+    }
+}
+
+bool IsRotation(vs::InputTransformMode mode) {
+    return mode == vs::InputTransformMode::Clockwise90 || mode == vs::InputTransformMode::Counterclockwise90;
+}
+
+absl::Status CheckFrames(const cv::Mat& source, const cv::Mat& destination, vs::InputTransformMode mode) {
+    if (mode == vs::InputTransformMode::Unspecified_EnumEnd) {
+        return absl::InvalidArgumentError("Input transform mode has to be resolved before color conversion.");
+    }
+    const cv::Size destination_size = GetTransformedSize(source.size(), mode);
+    if (destination.type() != CV_8UC3 || destination.size() != destination_size) {
+        return absl::InvalidArgumentError(
+            "Destination frame has to be pre-allocated as 8-bit, 3-channel, " + std::to_string(destination_size.width) +
+            "x" + std::to_string(destination_size.height) + "."
+        );
+    }
+    return absl::OkStatus();
+}
+
+// copies the source into the destination, applying the transform (which mustn't be None) in the same pass
+template<bool kSwapRedAndBlue>
+void CopyWithTransform(const cv::Mat& source, cv::Mat& destination, vs::InputTransformMode mode) {
+    const SourceWalk walk = GetSourceWalk(source, mode);
+    // rotations read the source column-wise, hence tile those; otherwise whole rows are already sequential
+    const int tile_width = IsRotation(mode) ? kTileSize : destination.cols;
+    const int band_height = kTileSize;
+    const int band_count = (destination.rows + band_height - 1) / band_height;
+
+    cv::parallel_for_(cv::Range(0, band_count), [&](const cv::Range& bands) {
+        for (int i_band = bands.start; i_band < bands.end; i_band++) {
+            const int row_begin = i_band * band_height;
+            const int row_end = std::min(row_begin + band_height, destination.rows);
+            for (int col_begin = 0; col_begin < destination.cols; col_begin += tile_width) {
+                const int col_count = std::min(tile_width, destination.cols - col_begin);
+                for (int row = row_begin; row < row_end; row++) {
+                    CopyRowSegment<kSwapRedAndBlue>(
+                        walk.origin + row * walk.row_step + col_begin * walk.col_step, walk.col_step,
+                        destination.ptr<uint8_t>(row) + col_begin * kDestinationChannelCount, col_count
+                    );
+                }
+            }
+        }
+    });
+}
+
+} // anonymous namespace
+
+cv::Size GetTransformedSize(const cv::Size& size, vs::InputTransformMode mode) {
+    return IsRotation(mode) ? cv::Size(size.height, size.width) : size;
+}
+
+absl::Status ConvertBgrToRgb(const cv::Mat& source_bgr, cv::Mat& destination_rgb, vs::InputTransformMode mode) {
+    if (source_bgr.type() != CV_8UC3 && source_bgr.type() != CV_8UC4) {
+        return absl::InvalidArgumentError("Expected an 8-bit BGR or BGRA source frame.");
+    }
+    MP_RETURN_IF_ERROR(CheckFrames(source_bgr, destination_rgb, mode));
+
+    if (mode == vs::InputTransformMode::None) {
+        // destination already has the right size & type, so OpenCV's (vectorized) conversion writes in place
+        cv::cvtColor(source_bgr, destination_rgb,
+                     source_bgr.channels() == 4 ? cv::COLOR_BGRA2RGB : cv::COLOR_BGR2RGB);
+        return absl::OkStatus();
+    }
+    CopyWithTransform<true>(source_bgr, destination_rgb, mode);
+    return absl::OkStatus();
+}
+
+absl::Status TransformRgb(const cv::Mat& source_rgb, cv::Mat& destination_rgb, vs::InputTransformMode mode) {
+    if (source_rgb.type() != CV_8UC3) {
+        return absl::InvalidArgumentError("Expected an 8-bit RGB source frame.");
+    }
+    MP_RETURN_IF_ERROR(CheckFrames(source_rgb, destination_rgb, mode));
+
+    if (mode == vs::InputTransformMode::None) {
+        // same size & type, so this copies in place
+        source_rgb.copyTo(destination_rgb);
+        return absl::OkStatus();
+    }
+    CopyWithTransform<false>(source_rgb, destination_rgb, mode);
+    return absl::OkStatus();
+}
+
+} // namespace presage::smartspectra::container::color_conversion
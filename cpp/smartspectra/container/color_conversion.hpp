@@ -0,0 +1,49 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/video_source/input_transform.hpp>
+
+namespace presage::smartspectra::container::color_conversion {
+
+/**
+ * @return dimensions of a frame of the given size after the given input transform is applied
+ */
+cv::Size GetTransformedSize(const cv::Size& size, video_source::InputTransformMode mode);
+
+/**
+ * Swaps BGR channel order to RGB and applies the input transform (rotation / mirroring) in a single pass over the
+ * pixels, writing straight into the destination.
+ * @param source_bgr 8-bit BGR (or BGRA, alpha is dropped) frame
+ * @param destination_rgb pre-allocated 8-bit, 3-channel frame of the transformed size (e.g. a MatView of an
+ * ImageFrame); may have padded rows, but must not overlap the source
+ * @param mode input transform to apply
+ */
+absl::Status ConvertBgrToRgb(
+    const cv::Mat& source_bgr,
+    cv::Mat& destination_rgb,
+    video_source::InputTransformMode mode = video_source::InputTransformMode::None
+);
+
+/**
+ * Counterpart of ConvertBgrToRgb for frames that are RGB already (see video_source::FrameChannelOrder): only applies
+ * the input transform, in a single pass over the pixels, writing straight into the destination.
+ * @param source_rgb 8-bit RGB frame
+ * @param destination_rgb pre-allocated 8-bit, 3-channel frame of the transformed size; must not overlap the source
+ * @param mode input transform to apply
+ */
+absl::Status TransformRgb(
+    const cv::Mat& source_rgb,
+    cv::Mat& destination_rgb,
+    video_source::InputTransformMode mode = video_source::InputTransformMode::None
+);
+
+} // namespace presage::smartspectra::container::color_conversion
@@ -22,12 +22,18 @@
 // === configuration header ===
 #include <physiology/modules/configuration.h>
 // === standard library includes ===
+#include <atomic>
 #include <functional>
+#include <limits>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
 // === third-party includes (if any) ===
 #include <absl/status/status.h>
 #include <absl/status/statusor.h>
 #include <mediapipe/framework/calculator_graph.h>
+#include <mediapipe/framework/executor.h>
 #include <mediapipe/framework/port/opencv_core_inc.h>
 #include <physiology/modules/device_type.h>
 #include <physiology/modules/device_context.h>
@@ -36,12 +42,31 @@
 // === local includes (if any) ===
 #include "settings.hpp"
 #include "operation_context.hpp"
+#include "image_frame_pool.hpp"
+#include "frame_accounting.hpp"
+#include "frame_tracer.hpp"
+#include "core_performance_window.hpp"
+#include "memory_telemetry.hpp"
+#include "metrics_exporter.hpp"
+#include "pipeline_stage_telemetry.hpp"
+#include "ring_buffer.hpp"
 
 /**
  * Primary namespace for Container classes, subclasses, and all directly-releated functionality
  */
 namespace presage::smartspectra::container {
 
+// effective Edge + Core performance over the sliding telemetry window (see settings.telemetry)
+struct CorePerformanceTelemetry {
+    double effective_core_fps = 0.0;
+    double mean_latency_seconds = 0.0;
+    double latency_p50_seconds = 0.0;
+    double latency_p95_seconds = 0.0;
+    double latency_p99_seconds = 0.0;
+    // timestamp of the first input frame covered by the latest metrics buffer
+    int64_t input_timestamp = 0;
+};
+
 template<
     platform_independence::DeviceType TDeviceType,
     settings::OperationMode TOperationMode,
@@ -68,34 +93,117 @@ public:
         const std::function<absl::Status(cv::Mat& output_frame, int64_t input_timestamp)>& on_video_output
     );
 
-    // Use for frame drop diagnostics
+    // Use for per-frame drop diagnostics. Optional: when not set, frames leaving the graph are only accounted for in
+    // aggregate (see SetOnFrameAccountingSummary).
     absl::Status SetOnFrameSentThrough(
         const std::function<absl::Status(bool frame_sent_through, int64_t input_timestamp)>& on_dropped_frame
     );
 
+    /**
+     * Sets a callback that receives windowed frame drop statistics (sent-through & dropped counts, drop runs, longest
+     * gap, drop rate) whenever an accounting window (settings.telemetry.frame_accounting_window_ms) completes.
+     */
+    absl::Status SetOnFrameAccountingSummary(
+        const std::function<absl::Status(const frame_accounting::FrameAccountingSummary&)>& on_frame_accounting_summary
+    );
+
+    // frame drop statistics of the last completed accounting window, if any
+    [[nodiscard]] std::optional<frame_accounting::FrameAccountingSummary> GetLastFrameAccountingSummary() const;
+
     absl::Status SetOnCorePerformanceTelemetry(
         const std::function<absl::Status(double, double, int64_t)>& on_effective_core_fps_output
     );
 
+    // same as above, but also reports latency percentiles
+    absl::Status SetOnCorePerformanceTelemetry(
+        const std::function<absl::Status(const CorePerformanceTelemetry&)>& on_core_performance_telemetry
+    );
+
+    /**
+     * Sets a callback that periodically (see settings.telemetry.pipeline_stage_report_interval_ms) receives latency
+     * statistics of each stage of the frame hot path, accumulated since the last reset. Only invoked while pipeline
+     * stage telemetry is enabled.
+     */
+    absl::Status SetOnPipelineStageTelemetry(
+        const std::function<absl::Status(const pipeline_stage_telemetry::PipelineStageTelemetrySnapshot&)>&
+        on_pipeline_stage_telemetry
+    );
+
+    // Turns per-stage latency recording on or off. Safe to call at any time, from any thread.
+    void SetPipelineStageTelemetryEnabled(bool enabled);
+
+    [[nodiscard]] pipeline_stage_telemetry::PipelineStageTelemetrySnapshot GetPipelineStageTelemetrySnapshot() const;
+
+    void ResetPipelineStageTelemetry();
+
+    /**
+     * Heap allocations & bytes allocated per frame fed to the graph since the last reset, along with resident set size.
+     * Allocation figures are process-wide and are only available when SmartSpectra::AllocationHooks is linked in
+     * (test & benchmark builds); see memory_telemetry::IsAllocationTrackingAvailable.
+     */
+    [[nodiscard]] memory_telemetry::MemoryTelemetrySnapshot GetMemoryTelemetrySnapshot() const;
+
+    // starts a new memory telemetry measurement period, e.g. once the graph has warmed up
+    void ResetMemoryTelemetry();
+
+    /**
+     * Feeds runtime statistics (throughput, latency, frame drops, frames in flight, status changes) into the given
+     * metrics, e.g. to have them scraped via metrics_exporter::MetricsExporter. Several containers may share one
+     * instance. Has to be called while the graph isn't running; pass nullptr to stop.
+     */
+    absl::Status SetRuntimeMetrics(std::shared_ptr<metrics_exporter::RuntimeMetrics> runtime_metrics);
+
+    // Turns per-frame trace event recording on or off. Safe to call at any time, from any thread.
+    void SetFrameTracingEnabled(bool enabled);
+
+    /**
+     * Writes the buffered per-frame trace events as Chrome trace-event JSON (loadable in Perfetto or chrome://tracing)
+     * and removes them from the buffer.
+     * @param output_path where to write the trace; if empty, settings.telemetry.frame_trace_output_path is used
+     */
+    absl::Status FlushFrameTrace(const std::string& output_path = "");
+
     virtual absl::Status Initialize();
 
+    /**
+     * Runs the graph's default-executor nodes on the given executor instead of a pool owned by this container, e.g. to
+     * share one size-bounded thread pool among the graphs of several containers. Has to be called before Initialize.
+     */
+    absl::Status SetExecutor(std::shared_ptr<mediapipe::Executor> executor);
+
+    [[nodiscard]] image_frame_pool::ImageFramePoolStatistics GetImageFramePoolStatistics() const;
+
 protected:
     virtual std::string GetThirdGraphFileSuffix() const;
 
     virtual std::string GetGraphFilePrefix() const;
 
-    absl::StatusOr<std::filesystem::path> GetGraphFilePath(bool binary_graph = true) const;
+    virtual absl::StatusOr<std::filesystem::path> GetGraphFilePath(bool binary_graph = true) const;
 
     absl::Status ComputeCorePerformanceTelemetry(const physiology::MetricsBuffer& metrics_buffer);
 
     void AddFrameTimestampToBenchmarkingInfo(const mediapipe::Timestamp& timestamp);
 
+    // invokes OnPipelineStageTelemetry if it's set, telemetry is on, and the report interval has elapsed
+    absl::Status ReportPipelineStageTelemetryIfDue();
+
+    /**
+     * Handles a frame-sent-through-graph packet: aggregates it into frame accounting (invoking
+     * OnFrameAccountingSummary when a window completes) and invokes OnFrameSentThrough, if set.
+     */
+    absl::Status AccountForFrameLeavingGraph(bool frame_sent_through, int64_t input_timestamp);
+
+    // flushes the frame trace to settings.telemetry.frame_trace_output_path, if tracing is on and the path is set
+    absl::Status FlushFrameTraceIfConfigured();
+
 // ==== settings
 // TODO: maybe figure out how to make `settings` `const` again?
     SettingsType settings;
 
 // ==== state
     mediapipe::CalculatorGraph graph;
+    // recycles input frame pixel buffers once the graph is done with them
+    image_frame_pool::ImageFramePool input_frame_pool;
 // == fixed/static after initialization
 
     // if needed, set to a callback that handles preprocessing status changes
@@ -116,19 +224,37 @@ protected:
 
     // if needed, set to a callback that handles frame sent-through-graph / dropped-from-graph events,
     // e.g., logs them somewhere.
-    std::function<absl::Status(bool frame_sent_through, int64_t input_timestamp)> OnFrameSentThrough =
-        [](bool frame_sent_through, int64_t input_timestamp) { return absl::OkStatus(); };
+    std::optional<std::function<absl::Status(bool frame_sent_through, int64_t input_timestamp)>> OnFrameSentThrough =
+        std::nullopt;
+
+    // if needed, set to a callback that handles windowed frame drop statistics
+    std::optional<std::function<absl::Status(const frame_accounting::FrameAccountingSummary&)>>
+        OnFrameAccountingSummary = std::nullopt;
 
     // for benchmarking
-    std::optional<std::function<absl::Status(double fps, double latency_s, int64_t input_timestamp)>>
-        OnCorePerformanceTelemetry = std::nullopt;
+    std::optional<std::function<absl::Status(const CorePerformanceTelemetry&)>> OnCorePerformanceTelemetry =
+        std::nullopt;
+    std::optional<std::function<absl::Status(const pipeline_stage_telemetry::PipelineStageTelemetrySnapshot&)>>
+        OnPipelineStageTelemetry = std::nullopt;
+    pipeline_stage_telemetry::PipelineStageTelemetry pipeline_stage_telemetry;
+    memory_telemetry::MemoryTelemetry memory_telemetry;
+    std::shared_ptr<metrics_exporter::RuntimeMetrics> runtime_metrics = nullptr;
+    frame_tracer::FrameTracer frame_tracer{settings.telemetry.frame_trace_capacity};
+    frame_accounting::FrameAccounting frame_accounting{
+        static_cast<int64_t>(settings.telemetry.frame_accounting_window_ms) * 1000
+    };
 
     platform_independence::DeviceContext<TDeviceType> device_context;
     bool initialized = false;
-    bool running = false;
+    // atomic, since frame-adding callers & graph output observers read it while it may be toggled by StopGraph
+    std::atomic<bool> running{false};
 // == dynamic/changing during runtime
     physiology::StatusCode status_code = physiology::StatusCode::PROCESSING_NOT_STARTED;
-    bool recording = false;
+    // atomic, since it may be toggled from a different thread than the one feeding frames to the graph
+    std::atomic<bool> recording{false};
+    // recording state packets are immutable, so make them once and only re-stamp them for every frame
+    const mediapipe::Packet recording_on_packet = mediapipe::MakePacket<bool>(true);
+    const mediapipe::Packet recording_off_packet = mediapipe::MakePacket<bool>(false);
 
     // for video output (optional)
     cv::Mat output_frame_bgr;
@@ -136,16 +262,27 @@ protected:
 
 private:
     // benchmarking
-    std::set<int64_t> frames_in_graph_timestamps;
-    const int64_t fps_averaging_window_microseconds = 3 * 1000000; // 3 seconds
-    struct MetricsBufferBenchmarkingInfo {
-        int64_t first_timestamp = 0;
-        int64_t last_timestamp = 0;
-        int32_t frame_count = 0;
-        double latency_seconds = 0;
-    };
-    std::vector<MetricsBufferBenchmarkingInfo> metrics_buffer_benchmarking_info_buffer;
+    // guards benchmarking state, which is updated from the frame-feeding thread and read from the output thread(s)
+    std::mutex benchmarking_mutex;
+    // bound for the benchmarking state, in case Core stops responding
+    static constexpr size_t kMaxTrackedFramesInGraph = 4096;
+    // timestamps of frames put into the graph that aren't covered by a metrics buffer yet, in increasing order
+    ring_buffer::RingBuffer<int64_t> frames_in_graph_timestamps{kMaxTrackedFramesInGraph};
+    // metrics buffers within the current window
+    core_performance_window::CorePerformanceWindow core_performance_window;
     std::optional<double> offset_from_system_time = std::nullopt;
+
+    // runtime metrics are always on when set, so they bypass the (locked) benchmarking state above
+    static constexpr int64_t kNoMetricsBufferYet = std::numeric_limits<int64_t>::min();
+    std::atomic<bool> runtime_metrics_clock_offset_set{false};
+    // offset of frame timestamps (in seconds) from system time
+    std::atomic<double> runtime_metrics_clock_offset_seconds{0.0};
+    std::atomic<int64_t> runtime_metrics_last_buffer_timestamp{kNoMetricsBufferYet};
+
+    void RecordCorePerformanceToRuntimeMetrics(const physiology::MetricsBuffer& metrics_buffer);
+
+    // steady clock time (in ns since epoch) after which the next pipeline stage telemetry report is due
+    std::atomic<int64_t> next_pipeline_stage_report_time_ns{0};
 };
 
 } // namespace presage::smartspectra::container
@@ -20,6 +20,8 @@
 
 #pragma once
 // === standard library includes (if any) ===
+#include <chrono>
+#include <cmath>
 // === configuration header ===
 #include "configuration.h"
 // === third-party includes (if any) ===
@@ -53,8 +55,20 @@ Container<TDeviceType, TOperationMode, TIntegrationMode>::Container(Container::S
     settings(std::move(settings)),
     graph(),
     device_context(),
-    operation_context(settings.operation) {};
+    operation_context(settings.operation) {
+    this->pipeline_stage_telemetry.SetEnabled(this->settings.telemetry.enable_pipeline_stage_telemetry);
+    this->frame_tracer.SetEnabled(this->settings.telemetry.enable_frame_tracing);
+};
 
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+image_frame_pool::ImageFramePoolStatistics
+Container<TDeviceType, TOperationMode, TIntegrationMode>::GetImageFramePoolStatistics() const {
+    return this->input_frame_pool.GetStatistics();
+}
 
 template<
     platform_independence::DeviceType TDeviceType,
@@ -84,6 +98,25 @@ absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::Initializ
 }
 
 
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::SetExecutor(
+    std::shared_ptr<mediapipe::Executor> executor
+) {
+    if (this->initialized) {
+        return absl::FailedPreconditionError("Executor has to be set before the container is initialized.");
+    }
+    if (executor == nullptr) {
+        return absl::InvalidArgumentError("Executor cannot be nullptr.");
+    }
+    // The default-executor entry that InitializeGraphConfig adds to the config doesn't conflict with this:
+    // MediaPipe only creates its own default thread pool when none has been supplied via SetExecutor.
+    return this->graph.SetExecutor("", std::move(executor));
+}
+
 template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
 std::string Container<TDeviceType, TOperationMode, TIntegrationMode>::GetThirdGraphFileSuffix() const {
     return settings::AbslUnparseFlag(TIntegrationMode);
@@ -188,6 +221,55 @@ absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::SetOnFram
     return absl::OkStatus();
 }
 
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::SetOnFrameAccountingSummary(
+    const std::function<absl::Status(const frame_accounting::FrameAccountingSummary&)>& on_frame_accounting_summary
+) {
+    MP_RETURN_IF_ERROR(CheckCallbackNotNull(on_frame_accounting_summary));
+    this->OnFrameAccountingSummary = on_frame_accounting_summary;
+    return absl::OkStatus();
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+std::optional<frame_accounting::FrameAccountingSummary>
+Container<TDeviceType, TOperationMode, TIntegrationMode>::GetLastFrameAccountingSummary() const {
+    return this->frame_accounting.GetLastSummary();
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::AccountForFrameLeavingGraph(
+    bool frame_sent_through,
+    int64_t input_timestamp
+) {
+    if (!frame_sent_through) {
+        // dropped frames never make it to the video output
+        this->frame_tracer.RecordAsyncEnd("Graph", input_timestamp);
+    }
+    if (this->runtime_metrics != nullptr) {
+        this->runtime_metrics->RecordFrameLeftGraph(frame_sent_through);
+    }
+    auto summary = this->frame_accounting.Record(frame_sent_through, input_timestamp);
+    if (summary.has_value() && this->OnFrameAccountingSummary.has_value()) {
+        MP_RETURN_IF_ERROR(this->OnFrameAccountingSummary.value()(summary.value()));
+    }
+    if (this->OnFrameSentThrough.has_value()) {
+        MP_RETURN_IF_ERROR(this->OnFrameSentThrough.value()(frame_sent_through, input_timestamp));
+    }
+    return absl::OkStatus();
+}
+
 template<
     platform_independence::DeviceType TDeviceType,
     settings::OperationMode TOperationMode,
@@ -197,10 +279,163 @@ absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::SetOnCore
     const std::function<absl::Status(double, double, int64_t)>& on_effective_core_fps_output
 ) {
     MP_RETURN_IF_ERROR(CheckCallbackNotNull(on_effective_core_fps_output));
-    this->OnCorePerformanceTelemetry = on_effective_core_fps_output;
+    this->OnCorePerformanceTelemetry =
+        [on_effective_core_fps_output](const CorePerformanceTelemetry& telemetry) {
+            return on_effective_core_fps_output(
+                telemetry.effective_core_fps, telemetry.mean_latency_seconds, telemetry.input_timestamp
+            );
+        };
+    return absl::OkStatus();
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::SetOnCorePerformanceTelemetry(
+    const std::function<absl::Status(const CorePerformanceTelemetry&)>& on_core_performance_telemetry
+) {
+    MP_RETURN_IF_ERROR(CheckCallbackNotNull(on_core_performance_telemetry));
+    this->OnCorePerformanceTelemetry = on_core_performance_telemetry;
+    return absl::OkStatus();
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::SetOnPipelineStageTelemetry(
+    const std::function<absl::Status(const pipeline_stage_telemetry::PipelineStageTelemetrySnapshot&)>&
+    on_pipeline_stage_telemetry
+) {
+    MP_RETURN_IF_ERROR(CheckCallbackNotNull(on_pipeline_stage_telemetry));
+    this->OnPipelineStageTelemetry = on_pipeline_stage_telemetry;
+    return absl::OkStatus();
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+void Container<TDeviceType, TOperationMode, TIntegrationMode>::SetPipelineStageTelemetryEnabled(bool enabled) {
+    this->pipeline_stage_telemetry.SetEnabled(enabled);
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+pipeline_stage_telemetry::PipelineStageTelemetrySnapshot
+Container<TDeviceType, TOperationMode, TIntegrationMode>::GetPipelineStageTelemetrySnapshot() const {
+    return this->pipeline_stage_telemetry.Snapshot();
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+void Container<TDeviceType, TOperationMode, TIntegrationMode>::ResetPipelineStageTelemetry() {
+    this->pipeline_stage_telemetry.Reset();
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+memory_telemetry::MemoryTelemetrySnapshot
+Container<TDeviceType, TOperationMode, TIntegrationMode>::GetMemoryTelemetrySnapshot() const {
+    return this->memory_telemetry.Snapshot();
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+void Container<TDeviceType, TOperationMode, TIntegrationMode>::ResetMemoryTelemetry() {
+    this->memory_telemetry.Reset();
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::SetRuntimeMetrics(
+    std::shared_ptr<metrics_exporter::RuntimeMetrics> runtime_metrics
+) {
+    if (this->running) {
+        return absl::FailedPreconditionError("Runtime metrics can't be swapped while the graph is running.");
+    }
+    this->runtime_metrics = std::move(runtime_metrics);
     return absl::OkStatus();
 }
 
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::ReportPipelineStageTelemetryIfDue() {
+    if (!this->OnPipelineStageTelemetry.has_value() || !this->pipeline_stage_telemetry.IsEnabled()) {
+        return absl::OkStatus();
+    }
+    const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+    int64_t next_report_time_ns = this->next_pipeline_stage_report_time_ns.load(std::memory_order_relaxed);
+    if (now_ns < next_report_time_ns) {
+        return absl::OkStatus();
+    }
+    // output callbacks of background containers may race here; only one of them gets to report
+    const int64_t report_interval_ns =
+        static_cast<int64_t>(this->settings.telemetry.pipeline_stage_report_interval_ms) * 1000000;
+    if (!this->next_pipeline_stage_report_time_ns.compare_exchange_strong(
+        next_report_time_ns, now_ns + report_interval_ns, std::memory_order_relaxed
+    )) {
+        return absl::OkStatus();
+    }
+    return this->OnPipelineStageTelemetry.value()(this->pipeline_stage_telemetry.Snapshot());
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+void Container<TDeviceType, TOperationMode, TIntegrationMode>::SetFrameTracingEnabled(bool enabled) {
+    this->frame_tracer.SetEnabled(enabled);
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::FlushFrameTrace(const std::string& output_path) {
+    return this->frame_tracer.Flush(
+        output_path.empty() ? this->settings.telemetry.frame_trace_output_path : output_path
+    );
+}
+
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::FlushFrameTraceIfConfigured() {
+    if (!this->frame_tracer.IsEnabled() || this->settings.telemetry.frame_trace_output_path.empty()) {
+        return absl::OkStatus();
+    }
+    return this->frame_tracer.Flush(this->settings.telemetry.frame_trace_output_path);
+}
+
 
 template<
     platform_independence::DeviceType TDeviceType,
@@ -208,21 +443,70 @@ template<
     settings::IntegrationMode TIntegrationMode
 >
 void Container<TDeviceType, TOperationMode, TIntegrationMode>::AddFrameTimestampToBenchmarkingInfo(const mediapipe::Timestamp& timestamp) {
+    this->memory_telemetry.RecordFrame();
+    if (this->runtime_metrics != nullptr && this->recording &&
+        !this->runtime_metrics_clock_offset_set.load(std::memory_order_acquire)) {
+        // frames racing in before the flag is published would only store a near-identical offset
+        double current_system_seconds =
+            std::chrono::duration<double>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+        this->runtime_metrics_clock_offset_seconds.store(
+            current_system_seconds - timestamp.Seconds(), std::memory_order_relaxed
+        );
+        this->runtime_metrics_clock_offset_set.store(true, std::memory_order_release);
+    }
     if (this->OnCorePerformanceTelemetry.has_value() & this->recording) {
+        std::lock_guard<std::mutex> lock(this->benchmarking_mutex);
         // Calculate the offset of frame capture time from system time
         if (!offset_from_system_time.has_value()) {
             double current_system_seconds =
                 std::chrono::duration<double>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
             offset_from_system_time = current_system_seconds - timestamp.Seconds();
         }
-        this->frames_in_graph_timestamps.insert(timestamp.Value());
+        // if Core stops responding, the oldest timestamps get overwritten instead of piling up
+        this->frames_in_graph_timestamps.PushBack(timestamp.Value());
+    }
+}
+
+/**
+ * Records the framerate since the previous metrics buffer & the latency of the given one to the runtime metrics,
+ * without touching the (locked) benchmarking window.
+ * @param metrics_buffer - last output metrics buffer
+ */
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+void Container<TDeviceType, TOperationMode, TIntegrationMode>::RecordCorePerformanceToRuntimeMetrics(
+    const physiology::MetricsBuffer& metrics_buffer
+) {
+    if (!this->runtime_metrics_clock_offset_set.load(std::memory_order_acquire)) {
+        // no frames recorded yet
+        return;
     }
+    double current_system_seconds =
+        std::chrono::duration<double>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    const int64_t last_buffer_input_timestamp = metrics_buffer.metadata().frame_timestamp();
+    double buffer_latency_seconds = current_system_seconds -
+        (mediapipe::Timestamp(last_buffer_input_timestamp).Seconds() +
+         this->runtime_metrics_clock_offset_seconds.load(std::memory_order_relaxed));
+
+    const int64_t previous_buffer_input_timestamp = this->runtime_metrics_last_buffer_timestamp.exchange(
+        last_buffer_input_timestamp, std::memory_order_relaxed
+    );
+    const int64_t microseconds_since_previous_buffer = last_buffer_input_timestamp - previous_buffer_input_timestamp;
+    const double effective_core_fps =
+        previous_buffer_input_timestamp != kNoMetricsBufferYet && microseconds_since_previous_buffer > 0 ?
+        static_cast<double>(metrics_buffer.metadata().frame_count()) * 1000000.0 /
+        static_cast<double>(microseconds_since_previous_buffer) : 0.0;
+    this->runtime_metrics->RecordCorePerformance(effective_core_fps, buffer_latency_seconds);
 }
 
 /**
- * Computes effective fps if OnEffectiveCoreFpsOutput has been set.
+ * Computes effective fps & latency statistics if OnCorePerformanceTelemetry has been set.
  * Relies on this->frames_in_graph_timestamps with timestamps of every frame put into the graph
- * (AddFrameTimestampToBenchmarkingInfo should be used in child classes at every frame)
+ * (AddFrameTimestampToBenchmarkingInfo should be used in child classes at every frame).
+ * Aggregates over the window are maintained incrementally (see CorePerformanceWindow).
  * @param metrics_buffer - last output metrics buffer
  * @return status
  */
@@ -234,75 +518,59 @@ template<
 absl::Status Container<TDeviceType, TOperationMode, TIntegrationMode>::ComputeCorePerformanceTelemetry(
     const physiology::MetricsBuffer& metrics_buffer
 ) {
+    if (this->runtime_metrics != nullptr) {
+        this->runtime_metrics->RecordMetricsBuffer(metrics_buffer.metadata().frame_count());
+        this->RecordCorePerformanceToRuntimeMetrics(metrics_buffer);
+    }
     if (this->OnCorePerformanceTelemetry.has_value()) {
+        std::unique_lock<std::mutex> lock(this->benchmarking_mutex);
+        if (!offset_from_system_time.has_value()) {
+            // no frames recorded yet
+            return absl::OkStatus();
+        }
         double current_system_seconds =
             std::chrono::duration<double>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
 
-        auto last_buffer_input_timestamp = metrics_buffer.metadata().frame_timestamp();
-        auto last_buffer_input_timestamp_location =
-            this->frames_in_graph_timestamps.find(last_buffer_input_timestamp);
-        auto first_buffer_input_timestamp = *this->frames_in_graph_timestamps.begin();
+        const int64_t last_buffer_input_timestamp = metrics_buffer.metadata().frame_timestamp();
+        const int64_t first_buffer_input_timestamp = this->frames_in_graph_timestamps.Empty() ?
+                                                     last_buffer_input_timestamp :
+                                                     this->frames_in_graph_timestamps.Front();
 
         // want to be using buffer frame count further (which is captured during send/receive),
-        // NOT last_output_timestamp_loc - this->frames_in_graph_timestamps.begin(),
-        // because some input frames may have been dropped.
+        // NOT the number of timestamps popped here, because some input frames may have been dropped.
 
-        // erase all frames associated with this buffer (even dropped ones)
-        this->frames_in_graph_timestamps.erase(this->frames_in_graph_timestamps.begin(),
-                                               last_buffer_input_timestamp_location);
+        // drop all frames associated with this buffer (even dropped ones)
+        while (!this->frames_in_graph_timestamps.Empty() &&
+               this->frames_in_graph_timestamps.Front() < last_buffer_input_timestamp) {
+            this->frames_in_graph_timestamps.PopFront();
+        }
 
         // compute buffer latency
         double absolute_last_output_system_seconds =
             mediapipe::Timestamp(last_buffer_input_timestamp).Seconds() + offset_from_system_time.value();
         double buffer_latency_seconds = current_system_seconds - absolute_last_output_system_seconds;
 
-        // add buffer benchmarking information to buffer to compute averages later
-        this->metrics_buffer_benchmarking_info_buffer.push_back(
-            MetricsBufferBenchmarkingInfo{
+        // add buffer benchmarking information to the window, which also clears out buffers from before it
+        this->core_performance_window.Add(
+            core_performance_window::MetricsBufferSample{
                 first_buffer_input_timestamp,
                 last_buffer_input_timestamp,
                 metrics_buffer.metadata().frame_count(),
-                buffer_latency_seconds
-            }
+                std::llround(buffer_latency_seconds * 1e6)
+            },
+            static_cast<int64_t>(this->settings.telemetry.core_performance_window_ms) * 1000
         );
 
-        // clear out benchmarking information from buffer from before the current window (using window duration)
-        // (approximate, since we use last output timestamp)
-        auto metrics_buffer_benchmarking_info_location =
-            this->metrics_buffer_benchmarking_info_buffer.begin();
-        auto current_window_start = last_buffer_input_timestamp - this->fps_averaging_window_microseconds;
-        while (metrics_buffer_benchmarking_info_location != this->metrics_buffer_benchmarking_info_buffer.end()
-               && metrics_buffer_benchmarking_info_location->last_timestamp < current_window_start) {
-            metrics_buffer_benchmarking_info_location++;
-        }
-        if (metrics_buffer_benchmarking_info_location > this->metrics_buffer_benchmarking_info_buffer.begin() + 1) {
-            this->metrics_buffer_benchmarking_info_buffer.erase(this->metrics_buffer_benchmarking_info_buffer.begin(),
-                                                                metrics_buffer_benchmarking_info_location--);
-        }
-
-        // compute total average framerate
-        int64_t window_total_microseconds =
-            last_buffer_input_timestamp - this->metrics_buffer_benchmarking_info_buffer.begin()->first_timestamp;
-        int32_t window_frame_count = 0;
-        double aggregate_latency_seconds = 0.0;
-        for (const auto& buffer_benchmarking_info: this->metrics_buffer_benchmarking_info_buffer) {
-            window_frame_count += buffer_benchmarking_info.frame_count;
-            aggregate_latency_seconds += buffer_benchmarking_info.latency_seconds;
-        }
-
-        // note: exclude the very last frame from the count, since it's "incomplete" when it's just captured,
-        // and the window ends with it being just captured
-        double effective_core_fps =
-            static_cast<double>(window_frame_count - 1) * 1000000.0 /
-            static_cast<double>(window_total_microseconds);
-
-        double effective_core_latency_seconds =
-            aggregate_latency_seconds / this->metrics_buffer_benchmarking_info_buffer.size();
-
-        MP_RETURN_IF_ERROR(this->OnCorePerformanceTelemetry.value()(
-            effective_core_fps, effective_core_latency_seconds, first_buffer_input_timestamp
-        ));
+        CorePerformanceTelemetry telemetry;
+        telemetry.effective_core_fps = this->core_performance_window.GetEffectiveFps();
+        telemetry.mean_latency_seconds = this->core_performance_window.GetMeanLatencySeconds();
+        telemetry.latency_p50_seconds = this->core_performance_window.GetLatencyQuantileSeconds(0.50);
+        telemetry.latency_p95_seconds = this->core_performance_window.GetLatencyQuantileSeconds(0.95);
+        telemetry.latency_p99_seconds = this->core_performance_window.GetLatencyQuantileSeconds(0.99);
+        telemetry.input_timestamp = first_buffer_input_timestamp;
+        lock.unlock();
 
+        MP_RETURN_IF_ERROR(this->OnCorePerformanceTelemetry.value()(telemetry));
     }
     return absl::OkStatus();
 }
@@ -0,0 +1,80 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "core_performance_window.hpp"
+
+namespace presage::smartspectra::container::core_performance_window {
+
+namespace {
+
+double ToSeconds(int64_t duration_μs) {
+    return static_cast<double>(duration_μs) * 1e-6;
+}
+
+} // anonymous namespace
+
+CorePerformanceWindow::CorePerformanceWindow(size_t max_buffer_count) : samples(max_buffer_count) {}
+
+void CorePerformanceWindow::Add(const MetricsBufferSample& sample, int64_t window_duration_μs) {
+    MetricsBufferSample evicted_sample;
+    if (this->samples.PushBack(sample, &evicted_sample)) {
+        this->Remove(evicted_sample);
+    }
+    this->frame_count += sample.frame_count;
+    this->latency_sum_μs += sample.latency_μs;
+    this->latency_histogram_seconds.Add(ToSeconds(sample.latency_μs));
+
+    // (approximate, since the window is measured from the last frame of the newest buffer)
+    const int64_t window_start = sample.last_timestamp - window_duration_μs;
+    size_t stale_sample_count = 0;
+    while (stale_sample_count < this->samples.Size() &&
+           this->samples[stale_sample_count].last_timestamp < window_start) {
+        stale_sample_count++;
+    }
+    if (stale_sample_count > 1) {
+        for (size_t i_sample = 0; i_sample < stale_sample_count && this->samples.Size() > 1; i_sample++) {
+            this->Remove(this->samples.PopFront());
+        }
+    }
+}
+
+void CorePerformanceWindow::Clear() {
+    this->samples.Clear();
+    this->frame_count = 0;
+    this->latency_sum_μs = 0;
+    this->latency_histogram_seconds.Clear();
+}
+
+double CorePerformanceWindow::GetEffectiveFps() const {
+    if (this->samples.Empty()) {
+        return 0.0;
+    }
+    const int64_t window_span_μs = this->samples.Back().last_timestamp - this->samples.Front().first_timestamp;
+    return window_span_μs > 0 ?
+           static_cast<double>(this->frame_count - 1) * 1000000.0 / static_cast<double>(window_span_μs) : 0.0;
+}
+
+double CorePerformanceWindow::GetMeanLatencySeconds() const {
+    if (this->samples.Empty()) {
+        return 0.0;
+    }
+    return ToSeconds(this->latency_sum_μs) / static_cast<double>(this->samples.Size());
+}
+
+double CorePerformanceWindow::GetLatencyQuantileSeconds(double quantile) const {
+    return this->latency_histogram_seconds.Quantile(quantile);
+}
+
+void CorePerformanceWindow::Remove(const MetricsBufferSample& sample) {
+    this->frame_count -= sample.frame_count;
+    this->latency_sum_μs -= sample.latency_μs;
+    this->latency_histogram_seconds.Remove(ToSeconds(sample.latency_μs));
+}
+
+} // namespace presage::smartspectra::container::core_performance_window
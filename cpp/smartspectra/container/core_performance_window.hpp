@@ -0,0 +1,76 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cstddef>
+#include <cstdint>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "latency_histogram.hpp"
+#include "ring_buffer.hpp"
+
+namespace presage::smartspectra::container::core_performance_window {
+
+// what the core performance telemetry keeps track of per metrics buffer
+struct MetricsBufferSample {
+    // input timestamps (μs) of the first & last frames the buffer covers
+    int64_t first_timestamp = 0;
+    int64_t last_timestamp = 0;
+    int32_t frame_count = 0;
+    // from the last covered frame's capture to the buffer's arrival
+    int64_t latency_μs = 0;
+};
+
+/**
+ * Sliding window over the latest metrics buffers, for effective framerate & latency statistics.
+ * @details Aggregates are maintained incrementally, so adding a buffer is O(1) (quantiles are O(histogram buckets)).
+ * Sums are kept in integers (μs), so that adding & removing the same samples over and over doesn't drift.
+ * Not thread-safe.
+ */
+class CorePerformanceWindow {
+public:
+    // bound on buffers in the window, in case Core delivers them faster than the window duration would suggest
+    static constexpr size_t kDefaultMaxBufferCount = 1024;
+
+    explicit CorePerformanceWindow(size_t max_buffer_count = kDefaultMaxBufferCount);
+
+    /**
+     * Adds the buffer to the window, then trims buffers that ended before window_duration_μs ahead of this one. Like
+     * the original, full-recompute implementation, the trim only happens once at least two buffers have fallen out of
+     * the window, so a single stale buffer may remain at the front; the newest buffer always remains.
+     */
+    void Add(const MetricsBufferSample& sample, int64_t window_duration_μs);
+
+    void Clear();
+
+    [[nodiscard]] size_t GetBufferCount() const { return samples.Size(); }
+
+    // total frame count of the buffers in the window
+    [[nodiscard]] int64_t GetFrameCount() const { return frame_count; }
+
+    /**
+     * Frames per second from the first frame of the oldest buffer to the last frame of the newest one, excluding that
+     * very last frame, which was only just captured. 0 if the window doesn't span any time.
+     */
+    [[nodiscard]] double GetEffectiveFps() const;
+
+    // 0 if the window is empty
+    [[nodiscard]] double GetMeanLatencySeconds() const;
+
+    [[nodiscard]] double GetLatencyQuantileSeconds(double quantile) const;
+
+private:
+    void Remove(const MetricsBufferSample& sample);
+
+    ring_buffer::RingBuffer<MetricsBufferSample> samples;
+    // running aggregates over samples
+    int64_t frame_count = 0;
+    int64_t latency_sum_μs = 0;
+    latency_histogram::LatencyHistogram latency_histogram_seconds;
+};
+
+} // namespace presage::smartspectra::container::core_performance_window
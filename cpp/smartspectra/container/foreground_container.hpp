@@ -22,6 +22,9 @@
 // === configuration header ===
 #include <physiology/modules/configuration.h>
 // === standard library includes (if any) ===
+#include <atomic>
+#include <mutex>
+#include <vector>
 // === third-party includes (if any) ===
 #ifdef WITH_VIDEO_OUTPUT
 #include <mediapipe/framework/port/opencv_video_inc.h>
@@ -29,6 +32,7 @@
 // === local includes (if any) ===
 #include "container.hpp"
 #include "output_stream_poller_wrapper.hpp"
+#include "keyboard_input.hpp"
 #include <smartspectra/video_source/video_source.hpp>
 
 namespace presage::smartspectra::container {
@@ -48,15 +52,46 @@ public:
     virtual absl::Status Run();
 
 protected:
+    struct CapturedFrame {
+        cv::Mat frame;
+        int64_t timestamp = 0;
+    };
 
     presage::smartspectra::container::output_stream_poller_wrapper::OutputStreamPollerWrapper core_metrics_poller;
     presage::smartspectra::container::output_stream_poller_wrapper::OutputStreamPollerWrapper edge_metrics_poller;
+    presage::smartspectra::container::output_stream_poller_wrapper::OutputStreamPollerWrapper output_video_poller;
+    presage::smartspectra::container::output_stream_poller_wrapper::OutputStreamPollerWrapper status_code_poller;
+    presage::smartspectra::container::output_stream_poller_wrapper::OutputStreamPollerWrapper blue_tooth_poller;
+    presage::smartspectra::container::output_stream_poller_wrapper::OutputStreamPollerWrapper frame_sent_through_poller;
 
     virtual absl::Status InitializeOutputDataPollers();
     virtual absl::Status HandleOutputData(int64_t frame_timestamp);
 
+    // Builds the source frames get captured from; by default, the one the video source settings call for.
+    virtual absl::StatusOr<std::unique_ptr<video_source::VideoSource>> BuildVideoSource();
+
+    // == frame loop stages
+    /**
+     * Grabs the next frame from the video source.
+     * @return true if a frame was captured, false if the end of the video / stream has been reached.
+     */
+    virtual absl::StatusOr<bool> CaptureFrame(CapturedFrame& captured_frame);
+    virtual absl::Status FeedFrameToGraph(const CapturedFrame& captured_frame);
+    virtual absl::Status HandleGraphOutput(int64_t frame_timestamp, bool skip_to_latest_video_output);
+    virtual absl::Status HandleUserInput();
+
+    /**
+     * Runs an operation (e.g. an exposure adjustment) on the video source from the output / GUI side of the frame
+     * loop. While the pipelined frame loop's capture thread owns the video source, the operation is handed to that
+     * thread, which runs it before capturing the next frame; otherwise, it runs right away.
+     * @return the operation's status if it ran right away, OK if it was handed off (a handed-off operation's error
+     * stops the capture thread and gets reported by the frame loop).
+     */
+    absl::Status RunOnVideoSource(keyboard_input::VideoSourceOperation operation);
+
     // state
-    bool keep_grabbing_frames;
+    // atomic, since in pipelined mode this is flipped by the output stage and read by the capture & feed stages
+    std::atomic<bool> keep_grabbing_frames;
     std::unique_ptr<video_source::VideoSource> video_source = nullptr;
 #ifdef WITH_VIDEO_OUTPUT
     cv::VideoWriter stream_writer;
@@ -65,10 +100,24 @@ protected:
     // settings
     const bool load_video;
 private:
+    absl::Status RunSerialFrameLoop();
+    absl::Status RunPipelinedFrameLoop();
+    absl::Status RunOfflineFrameLoop();
+    absl::Status RunPendingVideoSourceOperations();
+    absl::Status OnFrameLeftGraph(bool frame_sent_through, int64_t frame_timestamp);
     void ScrollPastTimeOffset();
     static std::string GenerateGuiWindowName();
     static const std::string kWindowName;
 
+    physiology::StatusCode previous_status_code = physiology::StatusCode::PROCESSING_NOT_STARTED;
+    double blue_tooth = 0.0;
+    // timestamp of the latest frame reported on the frame-sent-through stream
+    int64_t last_frame_left_graph_timestamp = 0;
+
+    // video source operations handed to the capture thread (see RunOnVideoSource)
+    std::atomic<bool> capture_thread_owns_video_source{false};
+    std::mutex pending_video_source_operation_mutex;
+    std::vector<keyboard_input::VideoSourceOperation> pending_video_source_operations;
 
 };
 
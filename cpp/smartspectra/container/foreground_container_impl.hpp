@@ -20,7 +20,13 @@
 
 #pragma once
 // === standard library includes (if any) ===
+#include <chrono>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <string>
 #include <thread>
+#include <utility>
 // === third-party includes (if any) ===
 #include <mediapipe/framework/port/opencv_imgproc_inc.h>
 #include <mediapipe/framework/port/opencv_highgui_inc.h>
@@ -31,9 +37,12 @@
 #include "foreground_container.hpp"
 #include "initialization.hpp"
 #include "image_transfer.hpp"
+#include "color_conversion.hpp"
 #include "packet_helpers.hpp"
 #include "benchmarking.hpp"
 #include "keyboard_input.hpp"
+#include "spsc_queue.hpp"
+#include "graph_profiling.hpp"
 #include <smartspectra/video_source/factory.hpp>
 
 
@@ -46,6 +55,9 @@ namespace ph = packet_helpers;
 namespace keys = keyboard_input;
 namespace it = image_transfer;
 namespace bench = benchmarking;
+namespace cc = color_conversion;
+namespace pst = pipeline_stage_telemetry;
+namespace ft = frame_tracer;
 using json = nlohmann::json;
 
 
@@ -90,15 +102,22 @@ absl::Status ForegroundContainer<TDeviceType,
         this->settings.verbosity_level > 2
     ));
     if (got_core_metrics_output) {
-        MP_RETURN_IF_ERROR(this->OnCoreMetricsOutput(metrics_buffer, frame_timestamp));
+        {
+            ft::ScopedTraceSpan span(
+                this->frame_tracer, "OnCoreMetricsOutput", metrics_buffer.metadata().frame_timestamp()
+            );
+            pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::UserCallback);
+            MP_RETURN_IF_ERROR(this->OnCoreMetricsOutput(metrics_buffer, frame_timestamp));
+        }
         if (TOperationMode == settings::OperationMode::Spot) {
             // reset to start state
             this->recording = false;
             if (this->load_video) {
                 keep_grabbing_frames = false;
-            } else if (this->settings.video_source.auto_lock &&
-                       this->video_source->SupportsExposureControls()) {
-                MP_RETURN_IF_ERROR(this->video_source->TurnOnAutoExposure());
+            } else if (this->settings.video_source.auto_lock) {
+                MP_RETURN_IF_ERROR(this->RunOnVideoSource([](video_source::VideoSource& v_source) {
+                    return v_source.SupportsExposureControls() ? v_source.TurnOnAutoExposure() : absl::OkStatus();
+                }));
             }
         } else {
             MP_RETURN_IF_ERROR(this->ComputeCorePerformanceTelemetry(metrics_buffer));
@@ -117,6 +136,7 @@ absl::Status ForegroundContainer<TDeviceType,
                     this->settings.verbosity_level > 2
                 ));
                 if (got_edge_metrics_output) {
+                    pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::UserCallback);
                     MP_RETURN_IF_ERROR(this->OnEdgeMetricsOutput(edge_metrics));
                 }
             } while (got_edge_metrics_output);
@@ -143,11 +163,43 @@ absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>:
     }
 }
 
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::StatusOr<std::unique_ptr<video_source::VideoSource>>
+ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::BuildVideoSource() {
+    video_source::VideoSourceSettings video_source_settings = this->settings.video_source;
+    const bool mjpeg_decode_min_size_set =
+        video_source_settings.mjpeg_decode_min_width_px > 0 && video_source_settings.mjpeg_decode_min_height_px > 0;
+    if (this->settings.scale_input && !mjpeg_decode_min_size_set) {
+        // frames get scaled to the graph's input size anyway, so the source may decode them no larger than that
+        std::optional<cv::Size> input_scaling_size =
+            init::GetInputScalingSize(this->graph.Config(), pe::graph::input_streams::kInputVideo);
+        if (input_scaling_size.has_value()) {
+            const video_source::InputTransformMode transform_mode = video_source_settings.input_transform_mode;
+            if (transform_mode == video_source::InputTransformMode::Clockwise90 ||
+                transform_mode == video_source::InputTransformMode::Counterclockwise90) {
+                // the source decodes before rotating
+                std::swap(input_scaling_size->width, input_scaling_size->height);
+            }
+            video_source_settings.mjpeg_decode_min_width_px = input_scaling_size->width;
+            video_source_settings.mjpeg_decode_min_height_px = input_scaling_size->height;
+        }
+    }
+    return video_source::BuildVideoSource(video_source_settings);
+}
+
 template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
 absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::Initialize() {
     LOG(INFO) << "Begin to initialize preprocessing container.";
     MP_RETURN_IF_ERROR(Base::Initialize());
-    MP_ASSIGN_OR_RETURN(this->video_source, video_source::BuildVideoSource(this->settings.video_source));
+    MP_ASSIGN_OR_RETURN(this->video_source, this->BuildVideoSource());
+    // The graph takes RGB: sources that can produce it directly spare FeedFrameToGraph the channel swap. Passthrough
+    // video output writes captured frames as they are, though, so it needs them in BGR.
+    if (!this->settings.video_sink.passthrough || this->settings.video_sink.destination.empty()) {
+        auto channel_order_status = this->video_source->SetFrameChannelOrder(video_source::FrameChannelOrder::Rgb);
+        if (!channel_order_status.ok() && !absl::IsUnimplemented(channel_order_status)) {
+            return channel_order_status;
+        }
+    }
 
     MP_RETURN_IF_ERROR(init::InitializeGui(this->settings, kWindowName));
     // legacy behavior: assume user wants to start with recording=on when a video file is supplied.
@@ -205,194 +257,271 @@ void ForegroundContainer<TDeviceType,
 }
 
 template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
-absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::Run() {
-    this->operation_context.Reset();
-    if (!this->initialized) {
-        return absl::PermissionDeniedError("Client not initialized.");
+absl::StatusOr<bool> ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::CaptureFrame(
+    CapturedFrame& captured_frame
+) {
+    // Capture frame from camera or video. The input transform (if any) is deferred to FeedFrameToGraph,
+    // where it's fused with the color conversion.
+    ft::ScopedTraceSpan span(this->frame_tracer, "CaptureFrame");
+    {
+        pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::Capture);
+        this->video_source->ProduceUntransformedFrame(captured_frame.frame);
     }
-    this->running = true;
-    LOG(INFO) << "Set up output pollers.";
+#ifdef WITH_VIDEO_OUTPUT
+    if (this->stream_writer.isOpened() && this->settings.video_sink.passthrough && !captured_frame.frame.empty()) {
+        cv::Mat transformed_frame;
+        {
+            pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::InputTransform);
+            video_source::InputTransformer transformer{this->video_source->GetInputTransformMode()};
+            transformed_frame = transformer.apply(captured_frame.frame);
+        }
+        pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::Display);
+        this->stream_writer.write(transformed_frame);
+    }
+#endif
+    if (captured_frame.frame.empty()) {
+        LOG(INFO) << "Encountered empty frame: assuming end of video or stream reached.";
+        return false;
+    }
+    captured_frame.timestamp = this->video_source->GetFrameTimestamp();
+    span.SetFrameTimestamp(captured_frame.timestamp);
+    return true;
+}
 
-    //TODO: check that callbacks aren't nullptr (potentially, move the checks out into container base class and call
-    // from both here and background container's StartGraph, instead of duplicating the code that's already there.)
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::FeedFrameToGraph(
+    const CapturedFrame& captured_frame
+) {
+    ft::ScopedTraceSpan span(this->frame_tracer, "FeedFrameToGraph", captured_frame.timestamp);
+    auto mp_frame_timestamp = mediapipe::Timestamp(captured_frame.timestamp);
+    this->AddFrameTimestampToBenchmarkingInfo(mp_frame_timestamp);
+
+    // Swap to RGB (unless the source produced RGB already) & apply input transform in one pass, straight into a
+    // (recycled) ImageFrame.
+    const video_source::InputTransformMode transform_mode = this->video_source->GetInputTransformMode();
+    const cv::Size input_frame_size = cc::GetTransformedSize(captured_frame.frame.size(), transform_mode);
+    auto input_frame = this->input_frame_pool.Acquire(
+        mediapipe::ImageFormat::SRGB, input_frame_size.width, input_frame_size.height
+    );
+    cv::Mat input_frame_mat = mediapipe::formats::MatView(input_frame.get());
+    {
+        pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::ColorConversion);
+        if (this->video_source->GetFrameChannelOrder() == video_source::FrameChannelOrder::Rgb) {
+            MP_RETURN_IF_ERROR(cc::TransformRgb(captured_frame.frame, input_frame_mat, transform_mode));
+        } else {
+            MP_RETURN_IF_ERROR(cc::ConvertBgrToRgb(captured_frame.frame, input_frame_mat, transform_mode));
+        }
+    }
 
-    MP_ASSIGN_OR_RETURN(mediapipe::OutputStreamPoller output_video_poller,
-                        this->graph.AddOutputStreamPoller(pe::graph::output_streams::kOutputVideo));
-    MP_ASSIGN_OR_RETURN(mediapipe::OutputStreamPoller status_code_poller,
-                        this->graph.AddOutputStreamPoller(pe::graph::output_streams::kStatusCode));
-    MP_ASSIGN_OR_RETURN(mediapipe::OutputStreamPoller blue_tooth_poller,
-                        this->graph.AddOutputStreamPoller(pe::graph::output_streams::kBlueTooth));
+    pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::GraphFeed);
+    // Send recording state to the graph.
+    MP_RETURN_IF_ERROR(
+        this->graph
+            .AddPacketToInputStream(
+                pe::graph::input_streams::kRecording,
+                (this->recording ? this->recording_on_packet : this->recording_off_packet).At(mp_frame_timestamp)
+            )
+    );
+    // Send image packet into the graph.
+    this->frame_tracer.RecordAsyncBegin("Graph", captured_frame.timestamp);
+    return it::FeedFrameToGraph(std::move(input_frame), this->graph, this->device_context, captured_frame.timestamp,
+                                pe::graph::input_streams::kInputVideo);
+}
 
-    // frame rate diagnostics
-    MP_ASSIGN_OR_RETURN(mediapipe::OutputStreamPoller frame_sent_through_poller,
-                        this->graph.AddOutputStreamPoller(pe::graph::output_streams::kFrameSentThrough));
+/**
+ * Polls all graph outputs that are available so far and dispatches them to the appropriate callbacks.
+ * @param frame_timestamp timestamp of the latest frame fed into the graph
+ * @param skip_to_latest_video_output when true, stale output video frames are dropped and only the newest one is
+ * displayed (used when the display can't keep up with the graph)
+ */
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::HandleGraphOutput(
+    int64_t frame_timestamp, bool skip_to_latest_video_output
+) {
+    ft::ScopedTraceSpan span(this->frame_tracer, "HandleGraphOutput", frame_timestamp);
+    // Get the graph video output packet, or stop if that fails.
+    auto& video_poller = this->output_video_poller.Get();
+    if (video_poller.QueueSize() > 0) {
+        mediapipe::Packet output_video_packet;
+        do {
+            if (!video_poller.Next(&output_video_packet)) {
+                this->keep_grabbing_frames = false;
+                return absl::OkStatus();
+            }
+            this->frame_tracer.RecordAsyncEnd("Graph", output_video_packet.Timestamp().Value());
+        } while (skip_to_latest_video_output && video_poller.QueueSize() > 0);
+        cv::Mat output_frame_rgb;
+        {
+            pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::OutputFrameFetch);
+            MP_RETURN_IF_ERROR(it::GetFrameFromPacket<TDeviceType>(output_frame_rgb,
+                                                                   this->device_context,
+                                                                   output_video_packet));
+        }
 
+        // Convert to BGR and display.
+        {
+            pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::BgrConversion);
+            cv::cvtColor(output_frame_rgb, this->output_frame_bgr, cv::COLOR_RGB2BGR);
+        }
 
-    MP_RETURN_IF_ERROR(this->InitializeOutputDataPollers());
+        // Envoke Callback on the video
+        {
+            ft::ScopedTraceSpan callback_span(
+                this->frame_tracer, "OnVideoOutput", output_video_packet.Timestamp().Value()
+            );
+            pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::UserCallback);
+            MP_RETURN_IF_ERROR(this->OnVideoOutput(this->output_frame_bgr, frame_timestamp));
+        }
 
-    MP_RETURN_IF_ERROR(this->operation_context.InitializePollers(this->graph));
+        pst::ScopedStageTimer timer(this->pipeline_stage_telemetry, pst::PipelineStage::Display);
+        // only display output window when we're not in headless mode.
+        if (!this->settings.headless) {
+            cv::imshow(kWindowName, this->output_frame_bgr);
+        }
+#ifdef WITH_VIDEO_OUTPUT
+        if (this->stream_writer.isOpened() && !this->settings.video_sink.passthrough) {
+            this->stream_writer.write(this->output_frame_bgr);
+        }
+#endif
+    }
 
-    LOG(INFO) << "Start running the calculator graph.";
-    MP_RETURN_IF_ERROR(this->graph.StartRun({}));
+    bool got_status_code_packet;
+    physiology::StatusValue status_value;
+    MP_RETURN_IF_ERROR(ph::GetPacketContentsIfAny(
+        status_value, got_status_code_packet, this->status_code_poller.Get(), pe::graph::output_streams::kStatusCode,
+        this->settings.verbosity_level > 2
+    ));
 
-    LOG(INFO) << "Start to grab and process frames.";
-    this->keep_grabbing_frames = true;
+    if (got_status_code_packet) {
+        this->status_code = status_value.value();
+        if (this->status_code != this->previous_status_code) {
+            if (this->runtime_metrics != nullptr) {
+                this->runtime_metrics->RecordStatusChange(static_cast<int>(this->status_code));
+            }
+            MP_RETURN_IF_ERROR(this->OnStatusChange(this->status_code));
+            this->previous_status_code = this->status_code;
+        }
+    }
+
+    bool got_blue_tooth_packet;
+    MP_RETURN_IF_ERROR(ph::GetPacketContentsIfAny(
+        this->blue_tooth, got_blue_tooth_packet, this->blue_tooth_poller.Get(), pe::graph::output_streams::kBlueTooth,
+        this->settings.verbosity_level > 0
+    ));
+
+    bool operation_state_changed;
+    MP_RETURN_IF_ERROR(this->operation_context
+                           .QueryPollers(operation_state_changed, this->settings.verbosity_level > 1));
+
+    bool got_frame_sent_through_packet;
+    bool frame_sent_through;
+    mediapipe::Timestamp frame_sent_through_timestamp;
+    MP_RETURN_IF_ERROR(ph::GetPacketContentsIfAny(
+        frame_sent_through, got_frame_sent_through_packet, this->frame_sent_through_poller.Get(),
+        pe::graph::output_streams::kFrameSentThrough, frame_sent_through_timestamp,
+        this->settings.verbosity_level > 4
+    ));
+    if (got_frame_sent_through_packet) {
+        MP_RETURN_IF_ERROR(this->OnFrameLeftGraph(frame_sent_through, frame_sent_through_timestamp.Value()));
+    }
+
+    MP_RETURN_IF_ERROR(this->HandleOutputData(frame_timestamp));
+    return this->ReportPipelineStageTelemetryIfDue();
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::OnFrameLeftGraph(
+    bool frame_sent_through, int64_t frame_timestamp
+) {
+    this->last_frame_left_graph_timestamp = frame_timestamp;
+    return this->AccountForFrameLeavingGraph(frame_sent_through, frame_timestamp);
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::HandleUserInput() {
+    if (this->settings.headless) {
+        if (!this->load_video) {
+            // if we loaded video, that means we started recording already.
+            // Otherwise, start recording iff status code is OK
+            if (!this->recording && this->status_code == physiology::StatusCode::OK) {
+                if (this->settings.video_source.auto_lock) {
+                    MP_RETURN_IF_ERROR(this->RunOnVideoSource([](video_source::VideoSource& v_source) {
+                        return v_source.SupportsExposureControls() ? v_source.TurnOffAutoExposure() : absl::OkStatus();
+                    }));
+                }
+                this->recording = true;
+                LOG(INFO) << "Recording started.";
+            }
+        }
+    } else {
+        bool grab_frames = this->keep_grabbing_frames;
+        bool recording_on = this->recording;
+        // offline mode is paced by the graph, so only service the GUI briefly instead of waiting out the interframe delay
+        const int key_wait_ms = this->settings.frame_pipeline.mode == settings::FramePipelineMode::Offline ?
+                                1 : this->settings.interframe_delay_ms;
+        MP_RETURN_IF_ERROR(keys::HandleKeyboardInput(
+            grab_frames, recording_on,
+            [this](keys::VideoSourceOperation operation) { return this->RunOnVideoSource(std::move(operation)); },
+            this->settings, this->status_code, key_wait_ms
+        ));
+        // only write back what changed, so that concurrent stage updates aren't clobbered
+        if (grab_frames != this->keep_grabbing_frames) this->keep_grabbing_frames = grab_frames;
+        if (recording_on != this->recording) this->recording = recording_on;
+    }
+    return absl::OkStatus();
+}
 
-    double blue_tooth;
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::RunOnVideoSource(
+    keys::VideoSourceOperation operation
+) {
+    if (this->capture_thread_owns_video_source) {
+        std::lock_guard<std::mutex> lock(this->pending_video_source_operation_mutex);
+        this->pending_video_source_operations.push_back(std::move(operation));
+        return absl::OkStatus();
+    }
+    return operation(*(this->video_source));
+}
 
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::RunPendingVideoSourceOperations() {
+    std::vector<keys::VideoSourceOperation> operations;
+    {
+        std::lock_guard<std::mutex> lock(this->pending_video_source_operation_mutex);
+        operations.swap(this->pending_video_source_operations);
+    }
+    for (const auto& operation: operations) {
+        MP_RETURN_IF_ERROR(operation(*(this->video_source)));
+    }
+    return absl::OkStatus();
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::RunSerialFrameLoop() {
 #ifdef BENCHMARK_CAMERA_CAPTURE
     int64_t i_frame = 0;
     std::chrono::duration<double> interval_capture_time(0.);
     std::chrono::duration<double> interval_frame_time(0.);
     int64 frame_interval = 30;
 #endif
-
-    //TODO: this function needs to be moved into VideoSourceInterface and implemented in related subclasses.
-    // This way, video sources such as CaptureVideoFileSource can do the scrolling, whereas other sources
-    // can ignore the command (still not sure what FileStreamVideoSource should do for scroll behavior).
-    this->ScrollPastTimeOffset();
-
-    physiology::StatusCode previous_status_code = physiology::StatusCode::PROCESSING_NOT_STARTED;
-
     // loop over frames
     while (this->keep_grabbing_frames) {
-        cv::Mat camera_frame_raw;
+        CapturedFrame captured_frame;
 #ifdef BENCHMARK_CAMERA_CAPTURE
         auto frame_loop_start = std::chrono::high_resolution_clock::now();
 #endif
-        // Capture frame from camera or video.
-        *this->video_source >> camera_frame_raw;
-#ifdef WITH_VIDEO_OUTPUT
-        if (this->stream_writer.isOpened() && this->settings.video_sink.passthrough) {
-                  this->stream_writer.write(camera_frame_raw);
-        }
-#endif
+        MP_ASSIGN_OR_RETURN(bool got_frame, this->CaptureFrame(captured_frame));
 #ifdef BENCHMARK_CAMERA_CAPTURE
         auto frame_capture_end = std::chrono::high_resolution_clock::now();
 #endif
-        if (camera_frame_raw.empty()) {
-            LOG(INFO) << "Encountered empty frame: assuming end of video or stream reached.";
+        if (!got_frame) {
             this->keep_grabbing_frames = false;
         } else {
             // === got new frame, now process it and handle output ===
-
-            // compute timestamp
-            int64_t frame_timestamp = this->video_source->GetFrameTimestamp();
-            auto mp_frame_timestamp = mediapipe::Timestamp(frame_timestamp);
-            this->AddFrameTimestampToBenchmarkingInfo(mp_frame_timestamp);
-
-            // === handle output
-            cv::Mat camera_frame;
-            cv::cvtColor(camera_frame_raw, camera_frame, cv::COLOR_BGR2RGB);
-
-            // Wrap Mat into an ImageFrame.
-            auto input_frame = absl::make_unique<mediapipe::ImageFrame>(
-                mediapipe::ImageFormat::SRGB, camera_frame.cols, camera_frame.rows,
-                mediapipe::ImageFrame::kDefaultAlignmentBoundary
-            );
-            cv::Mat input_frame_mat = mediapipe::formats::MatView(input_frame.get());
-            // transfer camera_frame data to input_frame
-            camera_frame.copyTo(input_frame_mat);
-
-            // Send recording state to the graph.
-            MP_RETURN_IF_ERROR(
-                this->graph
-                    .AddPacketToInputStream(
-                        pe::graph::input_streams::kRecording,
-                        mediapipe::MakePacket<bool>(this->recording).At(mp_frame_timestamp)
-                    )
-            );
-            // Send image packet into the graph.
-            MP_RETURN_IF_ERROR(
-                it::FeedFrameToGraph(std::move(input_frame), this->graph, this->device_context, frame_timestamp,
-                                     pe::graph::input_streams::kInputVideo)
-            );
-
-            // region ========================================== HANDLE GRAPH OUTPUT ===================================
-            // Get the graph video output packet, or stop if that fails.
-            mediapipe::Packet output_video_packet;
-            if (output_video_poller.QueueSize() > 0) {
-                if (!output_video_poller.Next(&output_video_packet)) break;
-                cv::Mat output_frame_rgb;
-                MP_RETURN_IF_ERROR(it::GetFrameFromPacket<TDeviceType>(output_frame_rgb,
-                                                                       this->device_context,
-                                                                       output_video_packet));
-
-                // Convert to BGR and display.
-                cv::cvtColor(output_frame_rgb, this->output_frame_bgr, cv::COLOR_RGB2BGR);
-
-                // Envoke Callback on the video
-                MP_RETURN_IF_ERROR(this->OnVideoOutput(this->output_frame_bgr, frame_timestamp));
-
-                // only display output window when we're not in headless mode.
-                if (!this->settings.headless) {
-                    cv::imshow(kWindowName, this->output_frame_bgr);
-                }
-#ifdef WITH_VIDEO_OUTPUT
-                if (this->stream_writer.isOpened() && !this->settings.video_sink.passthrough) {
-                  this->stream_writer.write(output_frame_bgr);
-                }
-#endif
-            }
-
-            bool got_status_code_packet;
-            physiology::StatusValue status_value;
-            MP_RETURN_IF_ERROR(ph::GetPacketContentsIfAny(
-                status_value, got_status_code_packet, status_code_poller, pe::graph::output_streams::kStatusCode,
-                this->settings.verbosity_level > 2
-            ));
-
-            if (got_status_code_packet){
-                this->status_code = status_value.value();
-                if (this->status_code != previous_status_code) {
-                    MP_RETURN_IF_ERROR(this->OnStatusChange(this->status_code));
-                    previous_status_code = this->status_code;
-                }
-            }
-
-            bool got_blue_tooth_packet;
-            MP_RETURN_IF_ERROR(ph::GetPacketContentsIfAny(
-                blue_tooth, got_blue_tooth_packet, blue_tooth_poller, pe::graph::output_streams::kBlueTooth,
-                this->settings.verbosity_level > 0
-            ));
-
-            bool operation_state_changed;
-            MP_RETURN_IF_ERROR(this->operation_context
-                                   .QueryPollers(operation_state_changed, this->settings.verbosity_level > 1));
-
-            bool got_frame_sent_through_packet;
-            bool frame_sent_through;
-            mediapipe::Timestamp frame_sent_through_timestamp;
-            MP_RETURN_IF_ERROR(ph::GetPacketContentsIfAny(
-                frame_sent_through, got_frame_sent_through_packet, frame_sent_through_poller,
-                pe::graph::output_streams::kFrameSentThrough, frame_sent_through_timestamp,
-                this->settings.verbosity_level > 4
-            ));
-            if(got_frame_sent_through_packet){
-                MP_RETURN_IF_ERROR(this->OnFrameSentThrough(frame_sent_through, frame_sent_through_timestamp.Value()));
-            }
-
-            MP_RETURN_IF_ERROR(this->HandleOutputData(frame_timestamp));
-
-            // endregion ===============================================================================================
-            if (this->settings.headless) {
-                if (!this->load_video) {
-                    // if we loaded video, that means we started recording already.
-                    // Otherwise, start recording iff status code is OK
-                    if (!this->recording && this->status_code == physiology::StatusCode::OK) {
-                        if (this->settings.video_source.auto_lock && this->video_source->SupportsExposureControls()) {
-                            return this->video_source->TurnOffAutoExposure();
-                        }
-                        this->recording = true;
-                        LOG(INFO) << "Recording started.";
-                    }
-                }
-            } else {
-                MP_RETURN_IF_ERROR(keys::HandleKeyboardInput(
-                    this->keep_grabbing_frames, this->recording, *(this->video_source), this->settings,
-                    this->status_code
-                ));
-            }
+            MP_RETURN_IF_ERROR(this->FeedFrameToGraph(captured_frame));
+            MP_RETURN_IF_ERROR(this->HandleGraphOutput(captured_frame.timestamp, false));
+            if (!this->keep_grabbing_frames) break;
+            MP_RETURN_IF_ERROR(this->HandleUserInput());
         }
 
 #ifdef BENCHMARK_CAMERA_CAPTURE
@@ -404,6 +533,304 @@ absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>:
         );
 #endif
     }
+    return absl::OkStatus();
+}
+
+/**
+ * Runs capture, graph feeding, and output handling / display concurrently, connected by lock-free SPSC hand-offs:
+ * capture thread -> [frame queue] -> feed thread -> [timestamp queue] -> calling thread (output, GUI, keyboard).
+ * Only the Block drop policy ever makes a stage wait for the next one. With DropOldest, each hand-off only keeps the
+ * latest frame (a newer one replaces whatever wasn't taken yet); with DropNewest, capture discards frames while the
+ * frame queue is full. With either, the feed thread hands the latest fed frame to output handling, so a slow output
+ * stage (e.g. display) only makes it skip frames' outputs, never stalls feeding or capture.
+ * Output handling stays on the calling thread, since HighGUI windows have to be serviced from the thread that
+ * created them. The capture thread is the only one touching the video source while the loop runs: exposure
+ * adjustments requested from the calling thread are queued up for it (see RunOnVideoSource).
+ */
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::RunPipelinedFrameLoop() {
+    const settings::FramePipelineSettings& pipeline_settings = this->settings.frame_pipeline;
+    RET_CHECK(pipeline_settings.queue_depth > 0) << "Frame pipeline queue depth has to be positive, got "
+                                                 << pipeline_settings.queue_depth << ".";
+    const auto queue_depth = static_cast<size_t>(pipeline_settings.queue_depth);
+    settings::FrameDropPolicy drop_policy = pipeline_settings.drop_policy;
+    if (this->load_video && drop_policy != settings::FrameDropPolicy::Block) {
+        // frames of a video file are never "stale", so all of them should make it through
+        LOG(INFO) << "Input video file supplied: frame pipeline will block instead of dropping frames.";
+        drop_policy = settings::FrameDropPolicy::Block;
+    }
+    const bool captured_frame_latest_wins = drop_policy == settings::FrameDropPolicy::DropOldest;
+    const bool fed_frame_latest_wins = drop_policy != settings::FrameDropPolicy::Block;
+    // Block & DropNewest
+    spsc_queue::SpscQueue<CapturedFrame> captured_frames(captured_frame_latest_wins ? 0 : queue_depth);
+    // DropOldest
+    spsc_queue::SpscLatestSlot<CapturedFrame> latest_captured_frame;
+    // Block
+    spsc_queue::SpscQueue<int64_t> fed_frame_timestamps(fed_frame_latest_wins ? 0 : queue_depth);
+    // DropOldest & DropNewest
+    spsc_queue::SpscLatestSlot<int64_t> latest_fed_frame_timestamp;
+
+    std::atomic<bool> capture_done(false);
+    std::atomic<bool> feed_done(false);
+    std::atomic<uint64_t> dropped_frame_count(0);
+    absl::Status capture_status;
+    absl::Status feed_status;
+
+    auto keep_grabbing = [this]() { return this->keep_grabbing_frames.load(); };
+
+    this->capture_thread_owns_video_source = true;
+    std::thread capture_thread([&]() {
+        while (this->keep_grabbing_frames) {
+            capture_status = this->RunPendingVideoSourceOperations();
+            if (!capture_status.ok()) break;
+            CapturedFrame captured_frame;
+            auto got_frame_or_status = this->CaptureFrame(captured_frame);
+            if (!got_frame_or_status.ok()) {
+                capture_status = got_frame_or_status.status();
+                break;
+            }
+            if (!got_frame_or_status.value()) break;
+            bool dropped_frame = false;
+            if (drop_policy == settings::FrameDropPolicy::DropNewest) {
+                dropped_frame = !captured_frames.TryPush(std::move(captured_frame));
+            } else if (drop_policy == settings::FrameDropPolicy::DropOldest) {
+                // replaces the previous frame, if the feed thread hasn't taken it yet
+                dropped_frame = latest_captured_frame.Push(std::move(captured_frame));
+            } else if (!captured_frames.PushWaiting(std::move(captured_frame), keep_grabbing)) {
+                break;
+            }
+            if (dropped_frame) {
+                dropped_frame_count++;
+                if (this->runtime_metrics != nullptr) this->runtime_metrics->RecordFramesDroppedBeforeGraph(1);
+            }
+        }
+        capture_done = true;
+    });
+
+    std::thread feed_thread([&]() {
+        auto keep_waiting_for_frames = [&]() { return this->keep_grabbing_frames && !capture_done; };
+        while (true) {
+            CapturedFrame captured_frame;
+            bool got_frame = captured_frame_latest_wins ?
+                             latest_captured_frame.PopWaiting(captured_frame, keep_waiting_for_frames) :
+                             captured_frames.PopWaiting(captured_frame, keep_waiting_for_frames);
+            // the capture thread may have pushed its last frame right before finishing
+            if (!got_frame && this->keep_grabbing_frames) {
+                got_frame = captured_frame_latest_wins ? latest_captured_frame.TryPop(captured_frame) :
+                            captured_frames.TryPop(captured_frame);
+            }
+            if (!got_frame) break;
+
+            feed_status = this->FeedFrameToGraph(captured_frame);
+            if (!feed_status.ok()) break;
+            int64_t frame_timestamp = captured_frame.timestamp;
+            if (fed_frame_latest_wins) {
+                // output handling is behind: it skips the replaced frame's outputs (they're in the graph regardless)
+                if (latest_fed_frame_timestamp.Push(std::move(frame_timestamp))) dropped_frame_count++;
+            } else if (!fed_frame_timestamps.PushWaiting(std::move(frame_timestamp), keep_grabbing)) {
+                break;
+            }
+        }
+        feed_done = true;
+    });
+
+    absl::Status output_status;
+    auto keep_waiting_for_fed_frames = [&]() { return this->keep_grabbing_frames && !feed_done; };
+    while (true) {
+        int64_t frame_timestamp;
+        bool got_frame = fed_frame_latest_wins ?
+                         latest_fed_frame_timestamp.PopWaiting(frame_timestamp, keep_waiting_for_fed_frames) :
+                         fed_frame_timestamps.PopWaiting(frame_timestamp, keep_waiting_for_fed_frames);
+        if (!got_frame && this->keep_grabbing_frames) {
+            got_frame = fed_frame_latest_wins ? latest_fed_frame_timestamp.TryPop(frame_timestamp) :
+                        fed_frame_timestamps.TryPop(frame_timestamp);
+        }
+        if (!got_frame) break;
+        // only render the freshest output when the feed stage has gotten ahead of us
+        const bool skip_to_latest_video_output = fed_frame_latest_wins && !latest_fed_frame_timestamp.Empty();
+        output_status = this->HandleGraphOutput(frame_timestamp, skip_to_latest_video_output);
+        if (!output_status.ok() || !this->keep_grabbing_frames) break;
+        output_status = this->HandleUserInput();
+        if (!output_status.ok()) break;
+    }
+    this->keep_grabbing_frames = false;
+    capture_thread.join();
+    feed_thread.join();
+    this->capture_thread_owns_video_source = false;
+    // run whatever was requested after the capture thread's last pass (e.g. re-enabling auto-exposure)
+    absl::Status leftover_operation_status = this->RunPendingVideoSourceOperations();
+
+    if (dropped_frame_count > 0) {
+        LOG(INFO) << "Frame pipeline dropped " << dropped_frame_count.load() << " frame(s) ("
+                  << settings::AbslUnparseFlag(drop_policy) << " policy).";
+    }
+    MP_RETURN_IF_ERROR(capture_status);
+    MP_RETURN_IF_ERROR(feed_status);
+    MP_RETURN_IF_ERROR(output_status);
+    return leftover_operation_status;
+}
+
+/**
+ * Processes an input video file as fast as the graph can go. Up to settings.frame_pipeline.queue_depth frames are in
+ * the graph at once, so that its calculators can work on consecutive frames in parallel; once that many are in, the
+ * next frame is only fed after the oldest one has been reported on the frame-sent-through stream. Since the loop
+ * waits instead of dropping frames, the output doesn't depend on machine speed. The wait ends early when the user quits,
+ * and with an error when the graph fails or no frame leaves it for kOfflineGraphStallTimeout. Reports the realtime
+ * factor (seconds of video processed per wall-clock second) at the end.
+ */
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::RunOfflineFrameLoop() {
+    if (!this->load_video) {
+        return absl::FailedPreconditionError(
+            "Offline frame pipeline mode requires video file input (see input_video_path)."
+        );
+    }
+    const int max_frames_in_flight = this->settings.frame_pipeline.queue_depth;
+    RET_CHECK(max_frames_in_flight > 0) << "Frame pipeline queue depth has to be positive, got "
+                                        << max_frames_in_flight << ".";
+    // how long to wait for a frame to leave a full graph before giving up on it
+    constexpr std::chrono::seconds kOfflineGraphStallTimeout(60);
+    constexpr std::chrono::milliseconds kOfflineGraphPollInterval(1);
+    // fed, but not yet reported on the frame-sent-through stream; in timestamp order
+    std::deque<int64_t> in_flight_frame_timestamps;
+    auto release_frames_that_left_graph = [&]() {
+        // the frame-sent-through stream may skip timestamps, so everything older is released as well
+        while (!in_flight_frame_timestamps.empty() &&
+               in_flight_frame_timestamps.front() <= this->last_frame_left_graph_timestamp) {
+            in_flight_frame_timestamps.pop_front();
+        }
+    };
+    this->last_frame_left_graph_timestamp = std::numeric_limits<int64_t>::min();
+
+    const auto processing_start = std::chrono::steady_clock::now();
+    uint64_t frame_count = 0;
+    int64_t first_frame_timestamp = 0;
+    int64_t last_frame_timestamp = 0;
+    bool reached_end_of_video = false;
+    while (this->keep_grabbing_frames) {
+        CapturedFrame captured_frame;
+        MP_ASSIGN_OR_RETURN(bool got_frame, this->CaptureFrame(captured_frame));
+        if (!got_frame) {
+            this->keep_grabbing_frames = false;
+            reached_end_of_video = true;
+            break;
+        }
+        if (frame_count == 0) first_frame_timestamp = captured_frame.timestamp;
+        last_frame_timestamp = captured_frame.timestamp;
+        frame_count++;
+
+        // flow control: wait for a free slot instead of dropping frames. Polls rather than blocking in the poller's
+        // Next(), which wouldn't return if the graph stalled or the user quit in the meantime.
+        release_frames_that_left_graph();
+        auto wait_start = std::chrono::steady_clock::now();
+        while (in_flight_frame_timestamps.size() >= static_cast<size_t>(max_frames_in_flight) &&
+               this->keep_grabbing_frames) {
+            const size_t frames_in_flight_before = in_flight_frame_timestamps.size();
+            // hands out whatever outputs are ready, including frame-sent-through packets (see OnFrameLeftGraph)
+            MP_RETURN_IF_ERROR(this->HandleGraphOutput(in_flight_frame_timestamps.back(), false));
+            release_frames_that_left_graph();
+            if (in_flight_frame_timestamps.size() < frames_in_flight_before) {
+                wait_start = std::chrono::steady_clock::now();
+                continue;
+            }
+            if (this->graph.HasError()) {
+                return absl::UnknownError(
+                    "Graph stopped while waiting for frames to leave it; see the graph's status for details."
+                );
+            }
+            if (std::chrono::steady_clock::now() - wait_start > kOfflineGraphStallTimeout) {
+                return absl::DeadlineExceededError(
+                    "No frame left the graph for " + std::to_string(kOfflineGraphStallTimeout.count()) +
+                    " s while waiting for a free slot."
+                );
+            }
+            MP_RETURN_IF_ERROR(this->HandleUserInput());
+            if (this->settings.headless) {
+                // HandleUserInput doesn't wait on the keyboard here
+                std::this_thread::sleep_for(kOfflineGraphPollInterval);
+            }
+        }
+        if (!this->keep_grabbing_frames) break;
+
+        MP_RETURN_IF_ERROR(this->FeedFrameToGraph(captured_frame));
+        in_flight_frame_timestamps.push_back(captured_frame.timestamp);
+        MP_RETURN_IF_ERROR(this->HandleGraphOutput(captured_frame.timestamp, false));
+        if (!this->keep_grabbing_frames) break;
+        MP_RETURN_IF_ERROR(this->HandleUserInput());
+    }
+    if (reached_end_of_video) {
+        // let the frames still in flight finish, and hand out all of their outputs
+        MP_RETURN_IF_ERROR(this->graph.WaitUntilIdle());
+        while (this->output_video_poller.Get().QueueSize() > 0 ||
+               this->frame_sent_through_poller.Get().QueueSize() > 0 ||
+               this->status_code_poller.Get().QueueSize() > 0) {
+            MP_RETURN_IF_ERROR(this->HandleGraphOutput(last_frame_timestamp, false));
+        }
+    }
+
+    const double processing_duration_s =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - processing_start).count();
+    // count the last frame's own duration as well, assuming an even frame rate
+    const double video_duration_s = frame_count > 1 ?
+                                    static_cast<double>(last_frame_timestamp - first_frame_timestamp) * 1e-6 *
+                                    static_cast<double>(frame_count) / static_cast<double>(frame_count - 1) : 0.0;
+    LOG(INFO) << "Offline processing done: " << frame_count << " frame(s), " << video_duration_s
+              << " s of video in " << processing_duration_s << " s ("
+              << (processing_duration_s > 0.0 ? video_duration_s / processing_duration_s : 0.0)
+              << "x realtime).";
+    return absl::OkStatus();
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>::Run() {
+    this->operation_context.Reset();
+    if (!this->initialized) {
+        return absl::PermissionDeniedError("Client not initialized.");
+    }
+    this->running = true;
+    LOG(INFO) << "Set up output pollers.";
+
+    //TODO: check that callbacks aren't nullptr (potentially, move the checks out into container base class and call
+    // from both here and background container's StartGraph, instead of duplicating the code that's already there.)
+
+    MP_RETURN_IF_ERROR(this->output_video_poller.Initialize(this->graph, pe::graph::output_streams::kOutputVideo));
+    MP_RETURN_IF_ERROR(this->status_code_poller.Initialize(this->graph, pe::graph::output_streams::kStatusCode));
+    MP_RETURN_IF_ERROR(this->blue_tooth_poller.Initialize(this->graph, pe::graph::output_streams::kBlueTooth));
+
+    // frame rate diagnostics
+    MP_RETURN_IF_ERROR(this->frame_sent_through_poller.Initialize(this->graph,
+                                                                  pe::graph::output_streams::kFrameSentThrough));
+
+    MP_RETURN_IF_ERROR(this->InitializeOutputDataPollers());
+
+    MP_RETURN_IF_ERROR(this->operation_context.InitializePollers(this->graph));
+
+    LOG(INFO) << "Start running the calculator graph.";
+    MP_RETURN_IF_ERROR(this->graph.StartRun({}));
+
+    LOG(INFO) << "Start to grab and process frames.";
+    this->keep_grabbing_frames = true;
+    this->previous_status_code = physiology::StatusCode::PROCESSING_NOT_STARTED;
+
+    //TODO: this function needs to be moved into VideoSourceInterface and implemented in related subclasses.
+    // This way, video sources such as CaptureVideoFileSource can do the scrolling, whereas other sources
+    // can ignore the command (still not sure what FileStreamVideoSource should do for scroll behavior).
+    this->ScrollPastTimeOffset();
+
+    switch (this->settings.frame_pipeline.mode) {
+        case settings::FramePipelineMode::Serial:
+            MP_RETURN_IF_ERROR(this->RunSerialFrameLoop());
+            break;
+        case settings::FramePipelineMode::Pipelined:
+            MP_RETURN_IF_ERROR(this->RunPipelinedFrameLoop());
+            break;
+        case settings::FramePipelineMode::Offline:
+            MP_RETURN_IF_ERROR(this->RunOfflineFrameLoop());
+            break;
+        default:
+            return absl::InvalidArgumentError("Unsupported frame pipeline mode: " +
+                                              settings::AbslUnparseFlag(this->settings.frame_pipeline.mode));
+    }
 
     LOG(INFO) << "Shutting down.";
     MP_RETURN_IF_ERROR(this->graph.CloseAllInputStreams());
@@ -415,6 +842,7 @@ absl::Status ForegroundContainer<TDeviceType, TOperationMode, TIntegrationMode>:
 #endif
     MP_RETURN_IF_ERROR(this->graph.WaitUntilDone());
     this->running = false;
-    return absl::OkStatus();
+    MP_RETURN_IF_ERROR(graph_profiling::ReportCalculatorTimings(this->graph, this->settings.graph_profiler));
+    return this->FlushFrameTraceIfConfigured();
 }
 } // namespace presage::smartspectra::container
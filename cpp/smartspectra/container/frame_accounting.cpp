@@ -0,0 +1,80 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <algorithm>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "frame_accounting.hpp"
+
+namespace presage::smartspectra::container::frame_accounting {
+
+FrameAccounting::FrameAccounting(int64_t window_duration_μs) :
+    window_duration_μs(std::max<int64_t>(window_duration_μs, 1)) {}
+
+std::optional<FrameAccountingSummary> FrameAccounting::Record(bool frame_sent_through, int64_t frame_timestamp) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->current_window_started) {
+        this->current_window = FrameAccountingSummary{};
+        this->current_window.window_start_timestamp = frame_timestamp;
+        this->current_window_started = true;
+    }
+    FrameAccountingSummary& window = this->current_window;
+    window.window_end_timestamp = frame_timestamp;
+    if (frame_sent_through) {
+        window.sent_through_count++;
+        this->total_sent_through_count++;
+        if (this->last_sent_through_timestamp.has_value()) {
+            window.longest_gap_μs =
+                std::max(window.longest_gap_μs, frame_timestamp - this->last_sent_through_timestamp.value());
+        }
+        this->last_sent_through_timestamp = frame_timestamp;
+        this->current_drop_run = 0;
+    } else {
+        window.dropped_count++;
+        this->total_dropped_count++;
+        if (this->current_drop_run == 0) {
+            window.drop_run_count++;
+        }
+        this->current_drop_run++;
+        window.longest_drop_run = std::max(window.longest_drop_run, this->current_drop_run);
+    }
+
+    if (frame_timestamp - window.window_start_timestamp < this->window_duration_μs) {
+        return std::nullopt;
+    }
+    window.drop_rate = static_cast<double>(window.dropped_count) /
+                       static_cast<double>(window.sent_through_count + window.dropped_count);
+    window.total_sent_through_count = this->total_sent_through_count;
+    window.total_dropped_count = this->total_dropped_count;
+    this->last_summary = window;
+    this->current_window_started = false;
+    // a drop run spanning windows gets counted again in the next one
+    this->current_drop_run = 0;
+    return this->last_summary;
+}
+
+std::optional<FrameAccountingSummary> FrameAccounting::GetLastSummary() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->last_summary;
+}
+
+double FrameAccounting::GetDropRate() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->last_summary.has_value() ? this->last_summary->drop_rate : 0.0;
+}
+
+void FrameAccounting::Reset() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->current_window_started = false;
+    this->last_summary = std::nullopt;
+    this->last_sent_through_timestamp = std::nullopt;
+    this->current_drop_run = 0;
+    this->total_sent_through_count = 0;
+    this->total_dropped_count = 0;
+}
+
+} // namespace presage::smartspectra::container::frame_accounting
@@ -0,0 +1,73 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cstdint>
+#include <mutex>
+#include <optional>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+
+namespace presage::smartspectra::container::frame_accounting {
+
+// frame sent-through / dropped statistics over one accounting window
+struct FrameAccountingSummary {
+    // input timestamps (μs) of the first & last frames accounted for in the window
+    int64_t window_start_timestamp = 0;
+    int64_t window_end_timestamp = 0;
+    int64_t sent_through_count = 0;
+    int64_t dropped_count = 0;
+    // number of runs of consecutive dropped frames
+    int64_t drop_run_count = 0;
+    // length of the longest run of consecutive dropped frames, in frames
+    int64_t longest_drop_run = 0;
+    // longest interval between consecutive sent-through frames, in μs of input time
+    int64_t longest_gap_μs = 0;
+    // dropped_count / (sent_through_count + dropped_count)
+    double drop_rate = 0.0;
+    // since the accounting was created / reset
+    int64_t total_sent_through_count = 0;
+    int64_t total_dropped_count = 0;
+};
+
+/**
+ * Aggregates frame sent-through / dropped events into windowed counters, so that frame drops can be monitored without
+ * handling every frame individually. Windows are measured in input (frame timestamp) time, which makes accounting
+ * independent of how fast frames are processed, e.g., when reading from a file.
+ * @details Thread-safe.
+ */
+class FrameAccounting {
+public:
+    explicit FrameAccounting(int64_t window_duration_μs = 5'000'000);
+
+    /**
+     * Accounts for one frame leaving the graph. Frames have to be recorded in timestamp order.
+     * @return the summary of the window that this frame completed, if any
+     */
+    std::optional<FrameAccountingSummary> Record(bool frame_sent_through, int64_t frame_timestamp);
+
+    // summary of the last completed window, if any
+    [[nodiscard]] std::optional<FrameAccountingSummary> GetLastSummary() const;
+
+    // drop rate of the last completed window (0 if there is none yet)
+    [[nodiscard]] double GetDropRate() const;
+
+    void Reset();
+
+private:
+    const int64_t window_duration_μs;
+    mutable std::mutex mutex;
+    FrameAccountingSummary current_window;
+    bool current_window_started = false;
+    std::optional<FrameAccountingSummary> last_summary;
+    std::optional<int64_t> last_sent_through_timestamp;
+    int64_t current_drop_run = 0;
+    int64_t total_sent_through_count = 0;
+    int64_t total_dropped_count = 0;
+};
+
+} // namespace presage::smartspectra::container::frame_accounting
@@ -0,0 +1,174 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/logging.h>
+#include <nlohmann/json.hpp>
+// === local includes (if any) ===
+#include "frame_tracer.hpp"
+
+namespace presage::smartspectra::container::frame_tracer {
+
+namespace {
+
+// small, stable per-thread ids read better in trace viewers than hashed std::thread::id values
+uint32_t GetCurrentThreadTraceId() {
+    static std::atomic<uint32_t> next_thread_id{1};
+    thread_local const uint32_t thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+    return thread_id;
+}
+
+constexpr int kTraceProcessId = 1;
+constexpr const char* kTraceCategory = "frame";
+
+// the first flush goes to the output path itself, later ones get numbered: trace.json, trace.1.json, trace.2.json, ...
+std::string GetFlushOutputPath(const std::string& output_path, uint64_t i_flush) {
+    if (i_flush == 0) {
+        return output_path;
+    }
+    const std::filesystem::path path(output_path);
+    return (path.parent_path() /
+            (path.stem().string() + "." + std::to_string(i_flush) + path.extension().string())).string();
+}
+
+} // anonymous namespace
+
+FrameTracer::FrameTracer(size_t capacity) : events(capacity) {}
+
+int64_t FrameTracer::NowMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+void FrameTracer::Record(const TraceEvent& event) {
+    std::lock_guard<std::mutex> lock(this->events_mutex);
+    if (this->events.PushBack(event)) {
+        this->overwritten_event_count++;
+    }
+}
+
+void FrameTracer::RecordSpan(const char* name, int64_t start_μs, int64_t end_μs, int64_t frame_timestamp) {
+    if (!this->IsEnabled()) return;
+    this->Record({name, 'X', start_μs, end_μs - start_μs, GetCurrentThreadTraceId(), frame_timestamp});
+}
+
+void FrameTracer::RecordInstant(const char* name, int64_t frame_timestamp) {
+    if (!this->IsEnabled()) return;
+    this->Record({name, 'i', NowMicroseconds(), 0, GetCurrentThreadTraceId(), frame_timestamp});
+}
+
+void FrameTracer::RecordAsyncBegin(const char* name, int64_t frame_timestamp) {
+    if (!this->IsEnabled()) return;
+    this->Record({name, 'b', NowMicroseconds(), 0, GetCurrentThreadTraceId(), frame_timestamp});
+}
+
+void FrameTracer::RecordAsyncEnd(const char* name, int64_t frame_timestamp) {
+    if (!this->IsEnabled()) return;
+    this->Record({name, 'e', NowMicroseconds(), 0, GetCurrentThreadTraceId(), frame_timestamp});
+}
+
+std::vector<TraceEvent> FrameTracer::CopyEvents() const {
+    std::lock_guard<std::mutex> lock(this->events_mutex);
+    return this->CopyEventsLocked();
+}
+
+std::vector<TraceEvent> FrameTracer::CopyEventsLocked() const {
+    std::vector<TraceEvent> event_copies;
+    event_copies.reserve(this->events.Size());
+    for (size_t i_event = 0; i_event < this->events.Size(); i_event++) {
+        event_copies.push_back(this->events[i_event]);
+    }
+    return event_copies;
+}
+
+std::string FrameTracer::SerializeEvents(const std::vector<TraceEvent>& events) {
+    nlohmann::json trace_events = nlohmann::json::array();
+    for (const TraceEvent& event: events) {
+        nlohmann::json event_json = {
+            {"name", event.name},
+            {"cat", kTraceCategory},
+            {"ph", std::string(1, event.phase)},
+            {"ts", event.start_μs},
+            {"pid", kTraceProcessId},
+            {"tid", event.thread_id},
+            {"args", {{"frame_timestamp", event.frame_timestamp}}}
+        };
+        switch (event.phase) {
+            case 'X':
+                event_json["dur"] = event.duration_μs;
+                break;
+            case 'i':
+                // thread-scoped instant
+                event_json["s"] = "t";
+                break;
+            case 'b':
+            case 'e':
+                event_json["id"] = std::to_string(event.frame_timestamp);
+                break;
+            default:
+                break;
+        }
+        trace_events.push_back(std::move(event_json));
+    }
+    nlohmann::json trace = {
+        {"traceEvents", std::move(trace_events)},
+        {"displayTimeUnit", "ms"}
+    };
+    return trace.dump();
+}
+
+std::string FrameTracer::ExportJson() const {
+    return SerializeEvents(this->CopyEvents());
+}
+
+absl::Status FrameTracer::Flush(const std::string& output_path) {
+    if (output_path.empty()) {
+        return absl::InvalidArgumentError("Frame trace output path is empty.");
+    }
+    // take the events out first (in one go, so that none recorded meanwhile get lost), so that recording isn't held up
+    // by serialization & file I/O
+    std::vector<TraceEvent> flushed_events;
+    uint64_t flushed_overwritten_event_count;
+    std::string flush_output_path;
+    {
+        std::lock_guard<std::mutex> lock(this->events_mutex);
+        flushed_events = this->CopyEventsLocked();
+        this->events.Clear();
+        flushed_overwritten_event_count = this->overwritten_event_count;
+        this->overwritten_event_count = 0;
+        flush_output_path = GetFlushOutputPath(output_path, this->flush_counts_by_path[output_path]++);
+    }
+    std::ofstream output_file(flush_output_path);
+    if (!output_file) {
+        return absl::UnavailableError("Could not open frame trace output file: " + flush_output_path);
+    }
+    output_file << SerializeEvents(flushed_events);
+    output_file.close();
+    if (!output_file) {
+        return absl::InternalError("Could not write frame trace output file: " + flush_output_path);
+    }
+    LOG(INFO) << "Frame trace (" << flushed_events.size() << " events, " << flushed_overwritten_event_count
+              << " overwritten) written to file: " << flush_output_path;
+    return absl::OkStatus();
+}
+
+size_t FrameTracer::GetEventCount() const {
+    std::lock_guard<std::mutex> lock(this->events_mutex);
+    return this->events.Size();
+}
+
+uint64_t FrameTracer::GetOverwrittenEventCount() const {
+    std::lock_guard<std::mutex> lock(this->events_mutex);
+    return this->overwritten_event_count;
+}
+
+} // namespace presage::smartspectra::container::frame_tracer
@@ -0,0 +1,119 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+// === local includes (if any) ===
+#include "ring_buffer.hpp"
+
+namespace presage::smartspectra::container::frame_tracer {
+
+struct TraceEvent {
+    // has to have static storage duration, e.g. a string literal
+    const char* name = "";
+    // Chrome trace event phase: 'X' (complete span), 'i' (instant), 'b' / 'e' (async span begin / end)
+    char phase = 'X';
+    int64_t start_μs = 0;
+    int64_t duration_μs = 0;
+    uint32_t thread_id = 0;
+    // mediapipe timestamp of the frame the event belongs to; also the id of async spans
+    int64_t frame_timestamp = 0;
+};
+
+/**
+ * Collects per-frame trace events in a bounded in-memory ring buffer (oldest events get overwritten) and writes them
+ * out as Chrome trace-event JSON, which can be loaded in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ * Every event carries the mediapipe timestamp of its frame, so all spans of one frame can be linked up.
+ * @details Thread-safe. When disabled, recording costs a single relaxed atomic load.
+ */
+class FrameTracer {
+public:
+    static constexpr size_t kDefaultCapacity = 65536;
+
+    explicit FrameTracer(size_t capacity = kDefaultCapacity);
+
+    void SetEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+
+    [[nodiscard]] bool IsEnabled() const { return this->enabled.load(std::memory_order_relaxed); }
+
+    // steady clock time in microseconds, the time base of all events
+    static int64_t NowMicroseconds();
+
+    void RecordSpan(const char* name, int64_t start_μs, int64_t end_μs, int64_t frame_timestamp);
+
+    void RecordInstant(const char* name, int64_t frame_timestamp);
+
+    // async spans may begin and end on different threads; they are matched up by name & frame timestamp
+    void RecordAsyncBegin(const char* name, int64_t frame_timestamp);
+
+    void RecordAsyncEnd(const char* name, int64_t frame_timestamp);
+
+    // serializes buffered events (oldest first) as a trace-event JSON document
+    [[nodiscard]] std::string ExportJson() const;
+
+    /**
+     * Writes buffered events to the given file as trace-event JSON and removes them from the buffer.
+     * @details Repeated flushes to the same path don't overwrite each other: the second one goes to
+     * <stem>.1<extension> (e.g. frame_trace.1.json), the third to <stem>.2<extension>, and so on.
+     */
+    absl::Status Flush(const std::string& output_path);
+
+    [[nodiscard]] size_t GetEventCount() const;
+
+    // number of events lost to overwriting since the last flush
+    [[nodiscard]] uint64_t GetOverwrittenEventCount() const;
+
+private:
+    void Record(const TraceEvent& event);
+    [[nodiscard]] std::vector<TraceEvent> CopyEvents() const;
+    // has to be called with events_mutex held
+    [[nodiscard]] std::vector<TraceEvent> CopyEventsLocked() const;
+    static std::string SerializeEvents(const std::vector<TraceEvent>& events);
+
+    std::atomic<bool> enabled{false};
+    mutable std::mutex events_mutex;
+    ring_buffer::RingBuffer<TraceEvent> events;
+    uint64_t overwritten_event_count = 0;
+    // number of flushes to each output path so far
+    std::map<std::string, uint64_t> flush_counts_by_path;
+};
+
+/**
+ * Records the enclosing scope as a complete span, if tracing is enabled when the span is created.
+ */
+class ScopedTraceSpan {
+public:
+    ScopedTraceSpan(FrameTracer& tracer, const char* name, int64_t frame_timestamp = 0) :
+        tracer(tracer), name(name), frame_timestamp(frame_timestamp), active(tracer.IsEnabled()),
+        start_μs(active ? FrameTracer::NowMicroseconds() : 0) {}
+
+    ~ScopedTraceSpan() {
+        if (active) tracer.RecordSpan(name, start_μs, FrameTracer::NowMicroseconds(), frame_timestamp);
+    }
+
+    // for spans that only learn which frame they belong to midway, e.g. capture
+    void SetFrameTimestamp(int64_t timestamp) { this->frame_timestamp = timestamp; }
+
+    ScopedTraceSpan(const ScopedTraceSpan&) = delete;
+    ScopedTraceSpan& operator=(const ScopedTraceSpan&) = delete;
+
+private:
+    FrameTracer& tracer;
+    const char* const name;
+    int64_t frame_timestamp;
+    const bool active;
+    const int64_t start_μs;
+};
+
+} // namespace presage::smartspectra::container::frame_tracer
@@ -0,0 +1,213 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <tuple>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SMARTSPECTRA_GRAPH_CONFIG_CACHE_USE_MMAP
+#endif
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <mediapipe/framework/port/file_helpers.h>
+#include <mediapipe/framework/port/parse_text_proto.h>
+#include <mediapipe/framework/port/status_macros.h>
+#include <physiology/modules/graph_tweaks.h>
+// === local includes (if any) ===
+#include "graph_config_cache.hpp"
+
+namespace presage::smartspectra::container::graph_config_cache {
+
+namespace {
+
+struct Key {
+    std::string path;
+    int64_t modification_time;
+    uintmax_t file_size;
+    bool scale_input;
+    bool binary_graph;
+
+    bool operator<(const Key& other) const {
+        return std::tie(path, modification_time, file_size, scale_input, binary_graph) <
+               std::tie(other.path, other.modification_time, other.file_size, other.scale_input, other.binary_graph);
+    }
+};
+
+struct Cache {
+    std::mutex mutex;
+    std::map<Key, std::shared_ptr<const mediapipe::CalculatorGraphConfig>> configs;
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+};
+
+Cache& GetCache() {
+    static Cache cache;
+    return cache;
+}
+
+#ifdef SMARTSPECTRA_GRAPH_CONFIG_CACHE_USE_MMAP
+// read-only mapping of a whole file, unmapped on destruction
+class MappedFile {
+public:
+    static absl::StatusOr<std::unique_ptr<MappedFile>> Open(const std::string& path) {
+        const int file_descriptor = ::open(path.c_str(), O_RDONLY);
+        if (file_descriptor < 0) {
+            return absl::NotFoundError("Could not open graph file: " + path);
+        }
+        struct stat file_status{};
+        if (::fstat(file_descriptor, &file_status) != 0) {
+            ::close(file_descriptor);
+            return absl::InternalError("Could not stat graph file: " + path);
+        }
+        const auto size = static_cast<size_t>(file_status.st_size);
+        void* data = nullptr;
+        if (size > 0) {
+            data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        }
+        // the mapping stays valid after the descriptor is closed
+        ::close(file_descriptor);
+        if (data == MAP_FAILED) {
+            return absl::InternalError("Could not memory-map graph file: " + path);
+        }
+        return std::unique_ptr<MappedFile>(new MappedFile(static_cast<const char*>(data), size));
+    }
+
+    ~MappedFile() {
+        if (data != nullptr) {
+            ::munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* const data;
+    const size_t size;
+
+private:
+    MappedFile(const char* data, size_t size) : data(data), size(size) {}
+};
+#endif
+
+absl::StatusOr<std::string> ReadTextGraph(const std::string& graph_file_path) {
+#ifdef SMARTSPECTRA_GRAPH_CONFIG_CACHE_USE_MMAP
+    MP_ASSIGN_OR_RETURN(auto mapped_file, MappedFile::Open(graph_file_path));
+    return std::string(mapped_file->data, mapped_file->size);
+#else
+    std::string contents;
+    MP_RETURN_IF_ERROR(mediapipe::file::GetContents(graph_file_path, &contents, /*read_as_binary=*/false));
+    return contents;
+#endif
+}
+
+absl::Status ParseBinaryGraph(const std::string& graph_file_path, mediapipe::CalculatorGraphConfig& config) {
+#ifdef SMARTSPECTRA_GRAPH_CONFIG_CACHE_USE_MMAP
+    // parse straight from the mapped pages, without copying the file into a string first
+    MP_ASSIGN_OR_RETURN(auto mapped_file, MappedFile::Open(graph_file_path));
+    const bool parsed = config.ParseFromArray(mapped_file->data, static_cast<int>(mapped_file->size));
+#else
+    std::string contents;
+    MP_RETURN_IF_ERROR(mediapipe::file::GetContents(graph_file_path, &contents, /*read_as_binary=*/true));
+    const bool parsed = config.ParseFromArray(contents.data(), static_cast<int>(contents.size()));
+#endif
+    if (!parsed) {
+        return absl::InvalidArgumentError("Could not parse binary graph file: " + graph_file_path);
+    }
+    return absl::OkStatus();
+}
+
+absl::StatusOr<std::shared_ptr<const mediapipe::CalculatorGraphConfig>> LoadGraphConfig(
+    const std::string& graph_file_path,
+    bool scale_input,
+    bool binary_graph
+) {
+    auto config = std::make_shared<mediapipe::CalculatorGraphConfig>();
+    if (binary_graph) {
+        MP_RETURN_IF_ERROR(ParseBinaryGraph(graph_file_path, *config));
+    } else {
+        MP_ASSIGN_OR_RETURN(std::string contents, ReadTextGraph(graph_file_path));
+        if (!scale_input) {
+            // get rid of input scaling
+            presage::graph_tweaks::SetOutputWidthAndHeightToZeroIfPresent(contents);
+        }
+        if (!mediapipe::ParseTextProto(contents, config.get())) {
+            return absl::InvalidArgumentError("Could not parse text graph file: " + graph_file_path);
+        }
+    }
+    return config;
+}
+
+} // anonymous namespace
+
+absl::StatusOr<std::shared_ptr<const mediapipe::CalculatorGraphConfig>> GetGraphConfig(
+    const std::string& graph_file_path,
+    bool scale_input,
+    bool binary_graph
+) {
+    std::error_code error_code;
+    const auto modification_time = std::filesystem::last_write_time(graph_file_path, error_code);
+    const auto file_size = error_code ? 0 : std::filesystem::file_size(graph_file_path, error_code);
+    if (error_code) {
+        return absl::NotFoundError("Could not access graph file " + graph_file_path + ": " + error_code.message());
+    }
+    const Key key{
+        graph_file_path, static_cast<int64_t>(modification_time.time_since_epoch().count()), file_size, scale_input,
+        binary_graph
+    };
+
+    Cache& cache = GetCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto entry = cache.configs.find(key);
+        if (entry != cache.configs.end()) {
+            cache.hit_count++;
+            return entry->second;
+        }
+    }
+    // load outside the lock, so that unrelated lookups don't wait on file I/O & parsing
+    MP_ASSIGN_OR_RETURN(auto config, LoadGraphConfig(graph_file_path, scale_input, binary_graph));
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.miss_count++;
+    // drop entries for older versions of the same file
+    for (auto entry = cache.configs.begin(); entry != cache.configs.end();) {
+        const Key& entry_key = entry->first;
+        if (entry_key.path == key.path &&
+            (entry_key.modification_time != key.modification_time || entry_key.file_size != key.file_size)) {
+            entry = cache.configs.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+    // if another thread loaded the same config in the meantime, keep theirs
+    return cache.configs.emplace(key, std::move(config)).first->second;
+}
+
+GraphConfigCacheStatistics GetGraphConfigCacheStatistics() {
+    Cache& cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    GraphConfigCacheStatistics statistics;
+    statistics.hit_count = cache.hit_count;
+    statistics.miss_count = cache.miss_count;
+    statistics.entry_count = cache.configs.size();
+    return statistics;
+}
+
+void ClearGraphConfigCache() {
+    Cache& cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.configs.clear();
+    cache.hit_count = 0;
+    cache.miss_count = 0;
+}
+
+} // namespace presage::smartspectra::container::graph_config_cache
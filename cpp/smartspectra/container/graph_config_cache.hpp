@@ -0,0 +1,42 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cstdint>
+#include <memory>
+#include <string>
+// === third-party includes (if any) ===
+#include <absl/status/statusor.h>
+#include <mediapipe/framework/calculator.pb.h>
+// === local includes (if any) ===
+
+namespace presage::smartspectra::container::graph_config_cache {
+
+struct GraphConfigCacheStatistics {
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+    size_t entry_count = 0;
+};
+
+/**
+ * Returns the parsed graph config for the given file, loading & parsing it only on the first request.
+ * @details Process-wide and thread-safe. Entries are keyed by path, file modification time & size, and the settings
+ * that change the parsed result, so an edited graph file gets reloaded. Files are read via mmap where available.
+ * @param scale_input if false, input scaling is stripped out of text (.pbtxt) graphs
+ * @param binary_graph whether the file is a serialized (.binarypb) or text (.pbtxt) config
+ */
+absl::StatusOr<std::shared_ptr<const mediapipe::CalculatorGraphConfig>> GetGraphConfig(
+    const std::string& graph_file_path,
+    bool scale_input,
+    bool binary_graph
+);
+
+[[nodiscard]] GraphConfigCacheStatistics GetGraphConfigCacheStatistics();
+
+void ClearGraphConfigCache();
+
+} // namespace presage::smartspectra::container::graph_config_cache
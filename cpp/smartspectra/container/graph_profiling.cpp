@@ -0,0 +1,161 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/logging.h>
+#include <mediapipe/framework/port/status_macros.h>
+#include <mediapipe/framework/profiler/graph_profiler.h>
+#include <nlohmann/json.hpp>
+// === local includes (if any) ===
+#include "graph_profiling.hpp"
+#include "json_file_io.hpp"
+
+namespace presage::smartspectra::container::graph_profiling {
+
+namespace {
+
+struct HistogramStatistics {
+    int64_t count = 0;
+    double mean_μs = 0.0;
+    double p95_μs = 0.0;
+};
+
+// the last histogram interval is open-ended, so quantiles falling into it are reported at its lower bound
+HistogramStatistics ComputeHistogramStatistics(const mediapipe::TimeHistogram& histogram) {
+    HistogramStatistics statistics;
+    for (const int64_t interval_count: histogram.count()) {
+        statistics.count += interval_count;
+    }
+    if (statistics.count == 0) {
+        return statistics;
+    }
+    statistics.mean_μs = static_cast<double>(histogram.total()) / static_cast<double>(statistics.count);
+    const auto p95_rank = static_cast<int64_t>(std::ceil(0.95 * static_cast<double>(statistics.count)));
+    int64_t cumulative_count = 0;
+    for (int i_interval = 0; i_interval < histogram.count_size(); i_interval++) {
+        cumulative_count += histogram.count(i_interval);
+        if (cumulative_count >= p95_rank) {
+            const bool is_last_interval = i_interval == histogram.count_size() - 1;
+            statistics.p95_μs = static_cast<double>(histogram.interval_size_usec()) *
+                                (is_last_interval ? i_interval : i_interval + 1);
+            break;
+        }
+    }
+    return statistics;
+}
+
+} // anonymous namespace
+
+void ApplyGraphProfilerSettings(
+    mediapipe::CalculatorGraphConfig& config,
+    const settings::GraphProfilerSettings& profiler_settings
+) {
+    if (!profiler_settings.enable) {
+        return;
+    }
+    mediapipe::ProfilerConfig* profiler_config = config.mutable_profiler_config();
+    profiler_config->set_enable_profiler(true);
+    // needed for input queue times
+    profiler_config->set_enable_stream_latency(true);
+    profiler_config->set_histogram_interval_size_usec(profiler_settings.histogram_interval_size_μs);
+    profiler_config->set_num_histogram_intervals(profiler_settings.histogram_interval_count);
+    if (!profiler_settings.trace_log_path.empty()) {
+        profiler_config->set_trace_enabled(true);
+        profiler_config->set_trace_log_path(profiler_settings.trace_log_path);
+    }
+}
+
+std::vector<CalculatorTimingSummary> SummarizeCalculatorProfiles(
+    const std::vector<mediapipe::CalculatorProfile>& calculator_profiles
+) {
+    std::vector<CalculatorTimingSummary> summaries;
+    summaries.reserve(calculator_profiles.size());
+    for (const auto& profile: calculator_profiles) {
+        CalculatorTimingSummary summary;
+        summary.calculator_name = profile.name();
+        const HistogramStatistics process_statistics = ComputeHistogramStatistics(profile.process_runtime());
+        summary.process_call_count = process_statistics.count;
+        summary.total_process_time_μs = static_cast<double>(profile.process_runtime().total());
+        summary.mean_process_time_μs = process_statistics.mean_μs;
+        summary.p95_process_time_μs = process_statistics.p95_μs;
+        const HistogramStatistics queue_statistics = ComputeHistogramStatistics(profile.process_input_latency());
+        summary.mean_queue_time_μs = queue_statistics.mean_μs;
+        summary.p95_queue_time_μs = queue_statistics.p95_μs;
+        summaries.push_back(std::move(summary));
+    }
+    std::sort(summaries.begin(), summaries.end(), [](const auto& a, const auto& b) {
+        return a.total_process_time_μs > b.total_process_time_μs;
+    });
+    return summaries;
+}
+
+absl::StatusOr<std::vector<CalculatorTimingSummary>> SummarizeCalculatorProfiles(mediapipe::CalculatorGraph& graph) {
+    if (graph.profiler() == nullptr) {
+        return absl::FailedPreconditionError("Graph has no profiler.");
+    }
+    std::vector<mediapipe::CalculatorProfile> calculator_profiles;
+    MP_RETURN_IF_ERROR(graph.profiler()->GetCalculatorProfiles(&calculator_profiles));
+    return SummarizeCalculatorProfiles(calculator_profiles);
+}
+
+std::string FormatCalculatorTimingSummaries(const std::vector<CalculatorTimingSummary>& summaries) {
+    size_t name_width = std::string("calculator").size();
+    for (const auto& summary: summaries) {
+        name_width = std::max(name_width, summary.calculator_name.size());
+    }
+    std::ostringstream table;
+    table << std::left << std::setw(static_cast<int>(name_width)) << "calculator" << std::right
+          << std::setw(10) << "calls" << std::setw(12) << "total ms" << std::setw(12) << "mean us"
+          << std::setw(12) << "p95 us" << std::setw(14) << "queue mean us" << std::setw(13) << "queue p95 us"
+          << '\n';
+    table << std::fixed << std::setprecision(1);
+    for (const auto& summary: summaries) {
+        table << std::left << std::setw(static_cast<int>(name_width)) << summary.calculator_name << std::right
+              << std::setw(10) << summary.process_call_count
+              << std::setw(12) << summary.total_process_time_μs / 1000.0
+              << std::setw(12) << summary.mean_process_time_μs
+              << std::setw(12) << summary.p95_process_time_μs
+              << std::setw(14) << summary.mean_queue_time_μs
+              << std::setw(13) << summary.p95_queue_time_μs << '\n';
+    }
+    return table.str();
+}
+
+absl::Status ReportCalculatorTimings(
+    mediapipe::CalculatorGraph& graph,
+    const settings::GraphProfilerSettings& profiler_settings
+) {
+    if (!profiler_settings.enable) {
+        return absl::OkStatus();
+    }
+    MP_ASSIGN_OR_RETURN(auto summaries, SummarizeCalculatorProfiles(graph));
+    LOG(INFO) << "Per-calculator timing summary:\n" << FormatCalculatorTimingSummaries(summaries);
+    if (!profiler_settings.summary_output_path.empty()) {
+        nlohmann::json summaries_json = nlohmann::json::array();
+        for (const auto& summary: summaries) {
+            summaries_json.push_back({
+                {"calculator", summary.calculator_name},
+                {"process_call_count", summary.process_call_count},
+                {"total_process_time_us", summary.total_process_time_μs},
+                {"mean_process_time_us", summary.mean_process_time_μs},
+                {"p95_process_time_us", summary.p95_process_time_μs},
+                {"mean_queue_time_us", summary.mean_queue_time_μs},
+                {"p95_queue_time_us", summary.p95_queue_time_μs}
+            });
+        }
+        json_file_io::WriteJsonDataToFile(
+            summaries_json, profiler_settings.summary_output_path, "per-calculator timing summary"
+        );
+    }
+    return absl::OkStatus();
+}
+
+} // namespace presage::smartspectra::container::graph_profiling
@@ -0,0 +1,63 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cstdint>
+#include <string>
+#include <vector>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <absl/status/statusor.h>
+#include <mediapipe/framework/calculator.pb.h>
+#include <mediapipe/framework/calculator_graph.h>
+#include <mediapipe/framework/calculator_profile.pb.h>
+// === local includes (if any) ===
+#include "settings.hpp"
+
+namespace presage::smartspectra::container::graph_profiling {
+
+struct CalculatorTimingSummary {
+    std::string calculator_name;
+    int64_t process_call_count = 0;
+    double total_process_time_μs = 0.0;
+    double mean_process_time_μs = 0.0;
+    double p95_process_time_μs = 0.0;
+    // time packets spend waiting in the calculator's input queues before Process is invoked
+    double mean_queue_time_μs = 0.0;
+    double p95_queue_time_μs = 0.0;
+};
+
+/**
+ * Sets up the config's profiler_config according to the given settings. Does nothing if the profiler isn't enabled.
+ */
+void ApplyGraphProfilerSettings(
+    mediapipe::CalculatorGraphConfig& config,
+    const settings::GraphProfilerSettings& profiler_settings
+);
+
+/**
+ * @return one summary per calculator, sorted by total process time, longest first
+ */
+std::vector<CalculatorTimingSummary> SummarizeCalculatorProfiles(
+    const std::vector<mediapipe::CalculatorProfile>& calculator_profiles
+);
+
+absl::StatusOr<std::vector<CalculatorTimingSummary>> SummarizeCalculatorProfiles(mediapipe::CalculatorGraph& graph);
+
+// formats the summaries as a human-readable table
+std::string FormatCalculatorTimingSummaries(const std::vector<CalculatorTimingSummary>& summaries);
+
+/**
+ * Logs the per-calculator timing summary of the graph and, if summary_output_path is set, writes it there as JSON.
+ * Does nothing if the profiler isn't enabled.
+ */
+absl::Status ReportCalculatorTimings(
+    mediapipe::CalculatorGraph& graph,
+    const settings::GraphProfilerSettings& profiler_settings
+);
+
+} // namespace presage::smartspectra::container::graph_profiling
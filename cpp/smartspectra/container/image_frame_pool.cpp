@@ -0,0 +1,164 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <map>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <vector>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "image_frame_pool.hpp"
+
+namespace presage::smartspectra::container::image_frame_pool {
+
+namespace {
+
+uint8_t* AllocateBuffer(size_t byte_count, uint32_t alignment_boundary) {
+    return static_cast<uint8_t*>(::operator new[](byte_count, std::align_val_t(alignment_boundary)));
+}
+
+void FreeBuffer(uint8_t* buffer, uint32_t alignment_boundary) {
+    ::operator delete[](buffer, std::align_val_t(alignment_boundary));
+}
+
+} // anonymous namespace
+
+struct ImageFramePool::State {
+    struct Key {
+        int format;
+        int width;
+        int height;
+        uint32_t alignment_boundary;
+
+        bool operator<(const Key& other) const {
+            return std::tie(format, width, height, alignment_boundary) <
+                   std::tie(other.format, other.width, other.height, other.alignment_boundary);
+        }
+    };
+
+    explicit State(size_t max_idle_buffers_per_key) : max_idle_buffers_per_key(max_idle_buffers_per_key) {}
+
+    ~State() {
+        ClearIdleBuffers();
+    }
+
+    void ClearIdleBuffers() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& [key, idle_buffers]: idle_buffers_by_key) {
+            const size_t byte_count = GetByteCount(key);
+            for (uint8_t* buffer: idle_buffers) {
+                FreeBuffer(buffer, key.alignment_boundary);
+                allocated_byte_count -= byte_count;
+            }
+            idle_buffer_count -= idle_buffers.size();
+            idle_buffers.clear();
+        }
+    }
+
+    void Release(const Key& key, uint8_t* buffer) {
+        std::lock_guard<std::mutex> lock(mutex);
+        outstanding_buffer_count--;
+        auto& idle_buffers = idle_buffers_by_key[key];
+        if (idle_buffers.size() < max_idle_buffers_per_key) {
+            idle_buffers.push_back(buffer);
+            idle_buffer_count++;
+        } else {
+            FreeBuffer(buffer, key.alignment_boundary);
+            allocated_byte_count -= GetByteCount(key);
+            discard_count++;
+        }
+    }
+
+    static int GetWidthStep(const Key& key) {
+        const int unaligned_width_step =
+            key.width *
+            mediapipe::ImageFrame::NumberOfChannelsForFormat(static_cast<mediapipe::ImageFormat::Format>(key.format)) *
+            mediapipe::ImageFrame::ByteDepthForFormat(static_cast<mediapipe::ImageFormat::Format>(key.format));
+        const auto alignment_boundary = static_cast<int>(key.alignment_boundary);
+        return (unaligned_width_step + alignment_boundary - 1) / alignment_boundary * alignment_boundary;
+    }
+
+    static size_t GetByteCount(const Key& key) {
+        return static_cast<size_t>(GetWidthStep(key)) * static_cast<size_t>(key.height);
+    }
+
+    const size_t max_idle_buffers_per_key;
+    mutable std::mutex mutex;
+    std::map<Key, std::vector<uint8_t*>> idle_buffers_by_key;
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+    uint64_t discard_count = 0;
+    size_t outstanding_buffer_count = 0;
+    size_t idle_buffer_count = 0;
+    size_t allocated_byte_count = 0;
+};
+
+ImageFramePool::ImageFramePool(size_t max_idle_buffers_per_key) :
+    state(std::make_shared<State>(max_idle_buffers_per_key)) {}
+
+ImageFramePool::~ImageFramePool() = default;
+
+std::unique_ptr<mediapipe::ImageFrame> ImageFramePool::Acquire(
+    mediapipe::ImageFormat::Format format,
+    int width,
+    int height,
+    uint32_t alignment_boundary
+) {
+    const State::Key key{static_cast<int>(format), width, height, alignment_boundary};
+    uint8_t* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        auto& idle_buffers = state->idle_buffers_by_key[key];
+        if (!idle_buffers.empty()) {
+            buffer = idle_buffers.back();
+            idle_buffers.pop_back();
+            state->idle_buffer_count--;
+            state->hit_count++;
+        } else {
+            // reserve up front, so that returning buffers later never reallocates
+            idle_buffers.reserve(state->max_idle_buffers_per_key);
+            state->miss_count++;
+            state->allocated_byte_count += State::GetByteCount(key);
+        }
+        state->outstanding_buffer_count++;
+    }
+    if (buffer == nullptr) {
+        buffer = AllocateBuffer(State::GetByteCount(key), alignment_boundary);
+    }
+
+    std::weak_ptr<State> weak_state = state;
+    return std::make_unique<mediapipe::ImageFrame>(
+        format, width, height, State::GetWidthStep(key), buffer,
+        [weak_state, key](uint8_t* released_buffer) {
+            if (auto pool_state = weak_state.lock()) {
+                pool_state->Release(key, released_buffer);
+            } else {
+                // pool is gone, nowhere to return the buffer to
+                FreeBuffer(released_buffer, key.alignment_boundary);
+            }
+        }
+    );
+}
+
+ImageFramePoolStatistics ImageFramePool::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    ImageFramePoolStatistics statistics;
+    statistics.hit_count = state->hit_count;
+    statistics.miss_count = state->miss_count;
+    statistics.discard_count = state->discard_count;
+    statistics.outstanding_buffer_count = state->outstanding_buffer_count;
+    statistics.idle_buffer_count = state->idle_buffer_count;
+    statistics.allocated_byte_count = state->allocated_byte_count;
+    return statistics;
+}
+
+void ImageFramePool::Clear() {
+    state->ClearIdleBuffers();
+}
+
+} // namespace presage::smartspectra::container::image_frame_pool
@@ -0,0 +1,72 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/formats/image_frame.h>
+// === local includes (if any) ===
+
+namespace presage::smartspectra::container::image_frame_pool {
+
+struct ImageFramePoolStatistics {
+    // Acquire calls served with a recycled buffer
+    uint64_t hit_count = 0;
+    // Acquire calls that had to allocate a new buffer
+    uint64_t miss_count = 0;
+    // buffers released by their ImageFrame while the pool was already holding its maximum of idle buffers
+    uint64_t discard_count = 0;
+    // buffers currently owned by live ImageFrames
+    size_t outstanding_buffer_count = 0;
+    // buffers currently idle in the pool, ready for reuse
+    size_t idle_buffer_count = 0;
+    // total bytes across outstanding and idle buffers
+    size_t allocated_byte_count = 0;
+};
+
+/**
+ * Hands out mediapipe::ImageFrame instances whose pixel storage is recycled: when the graph releases the last packet
+ * holding a frame, the ImageFrame deleter returns the buffer to the pool instead of freeing it.
+ * @details Buffers are keyed by (format, width, height, alignment boundary). Once the pool has warmed up, a steady
+ * stream of same-sized frames does no large heap allocations. The pool may be destroyed before the frames it handed
+ * out; those frames then free their buffers normally. Thread-safe.
+ */
+class ImageFramePool {
+public:
+    /**
+     * @param max_idle_buffers_per_key maximum number of idle buffers retained per (format, width, height, alignment)
+     * combination; buffers released beyond that are freed.
+     */
+    explicit ImageFramePool(size_t max_idle_buffers_per_key = 8);
+    ~ImageFramePool();
+
+    ImageFramePool(const ImageFramePool&) = delete;
+    ImageFramePool& operator=(const ImageFramePool&) = delete;
+
+    /**
+     * @return an ImageFrame with uninitialized pixel data, backed by a pooled buffer
+     */
+    std::unique_ptr<mediapipe::ImageFrame> Acquire(
+        mediapipe::ImageFormat::Format format,
+        int width,
+        int height,
+        uint32_t alignment_boundary = mediapipe::ImageFrame::kDefaultAlignmentBoundary
+    );
+
+    [[nodiscard]] ImageFramePoolStatistics GetStatistics() const;
+
+    // frees all idle buffers (outstanding ones are unaffected)
+    void Clear();
+
+private:
+    struct State;
+    std::shared_ptr<State> state;
+};
+
+} // namespace presage::smartspectra::container::image_frame_pool
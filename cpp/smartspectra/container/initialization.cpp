@@ -4,7 +4,9 @@
 //
 
 // === standard library includes (if any) ===
+#include <algorithm>
 // === third-party includes (if any) ===
+#include <mediapipe/calculators/image/image_transformation_calculator.pb.h>
 #include <physiology/modules/configuration.h>
 // === local includes (if any) ===
 #include "initialization_impl.hpp"
@@ -12,6 +14,58 @@
 
 
 namespace presage::smartspectra::container::initialization {
+
+namespace {
+
+// strips the "TAG:" / "TAG:index:" prefix off a node's stream entry
+std::string GetStreamName(const std::string& stream_entry) {
+    const size_t name_start = stream_entry.rfind(':');
+    return name_start == std::string::npos ? stream_entry : stream_entry.substr(name_start + 1);
+}
+
+std::optional<mediapipe::ImageTransformationCalculatorOptions> GetImageTransformationOptions(
+    const mediapipe::CalculatorGraphConfig::Node& node
+) {
+    // options come either as a proto2 extension (legacy) or as google.protobuf.Any (node_options)
+    if (node.has_options() && node.options().HasExtension(mediapipe::ImageTransformationCalculatorOptions::ext)) {
+        return node.options().GetExtension(mediapipe::ImageTransformationCalculatorOptions::ext);
+    }
+    for (const auto& node_options: node.node_options()) {
+        mediapipe::ImageTransformationCalculatorOptions options;
+        if (node_options.UnpackTo(&options)) {
+            return options;
+        }
+    }
+    return std::nullopt;
+}
+
+} // anonymous namespace
+
+std::optional<cv::Size> GetInputScalingSize(
+    const mediapipe::CalculatorGraphConfig& config,
+    const std::string& input_stream_name
+) {
+    for (const auto& node: config.node()) {
+        if (node.calculator() != "ImageTransformationCalculator") {
+            continue;
+        }
+        const bool consumes_input_stream = std::any_of(
+            node.input_stream().begin(), node.input_stream().end(),
+            [&input_stream_name](const std::string& stream_entry) {
+                return GetStreamName(stream_entry) == input_stream_name;
+            }
+        );
+        if (!consumes_input_stream) {
+            continue;
+        }
+        auto options = GetImageTransformationOptions(node);
+        if (options.has_value() && options->output_width() > 0 && options->output_height() > 0) {
+            return cv::Size(options->output_width(), options->output_height());
+        }
+    }
+    return std::nullopt;
+}
+
 // region ====== CPU ======
 
 // *** Spot ***
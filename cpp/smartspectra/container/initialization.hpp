@@ -19,6 +19,9 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
+// === standard library includes (if any) ===
+#include <optional>
+#include <string>
 // === configuration header ===
 #include <physiology/modules/configuration.h>
 // === third-party includes (if any) ===
@@ -61,4 +64,15 @@ absl::Status InitializeVideoSink(
 template<bool TLog = true>
 absl::Status InitializeGui(const settings::GeneralSettings& settings, const std::string& window_name);
 
+/**
+ * Finds the size the graph scales frames on the given input stream to, i.e. the output_width & output_height of the
+ * ImageTransformationCalculator consuming that stream directly.
+ * @param config graph config, with subgraphs expanded (e.g. CalculatorGraph::Config() of an initialized graph)
+ * @return nothing if no such calculator has a fixed, positive output size
+ */
+std::optional<cv::Size> GetInputScalingSize(
+    const mediapipe::CalculatorGraphConfig& config,
+    const std::string& input_stream_name
+);
+
 } // presage::smartspectra::container::initialization
@@ -23,19 +23,18 @@
 #include <string>
 #include <regex>
 // === third-party includes (if any) ===
-#include <physiology/modules/graph_tweaks.h>
 #include <physiology/graph/stream_and_packet_names.h>
 #include <physiology/modules/geometry.hpp>
 #include <mediapipe/framework/port/logging.h>
-#include <mediapipe/framework/port/file_helpers.h>
 #include <mediapipe/framework/port/status_macros.h>
-#include <mediapipe/framework/port/parse_text_proto.h>
 #include <mediapipe/framework/calculator.pb.h>
 #include <absl/status/statusor.h>
 #include <opencv2/highgui.hpp>
 // === local includes (if any) ===
 #include "initialization.hpp"
 #include "configuration.h"
+#include "graph_config_cache.hpp"
+#include "graph_profiling.hpp"
 // @formatter:off
 #ifdef __linux__
 #include <smartspectra/video_source/camera/camera_v4l2.hpp>
@@ -78,35 +77,24 @@ inline absl::StatusOr<mediapipe::CalculatorGraphConfig> InitializeGraphConfig(
     const settings::Settings<TOperationMode, TIntegrationMode>& settings,
     bool binary_graph
 ) {
-    std::string calculator_graph_config_contents;
-    MP_RETURN_IF_ERROR(
-        mediapipe::file::GetContents(
-            graph_file_path,
-            &calculator_graph_config_contents,
-            /*read_as_binary=*/binary_graph
-        )
-    );
     if (TLog) {
         LOG(INFO) << "Scaling input in graph: " << (settings.scale_input ? "true" : "false");
     }
-    mediapipe::CalculatorGraphConfig config;
-    if (binary_graph) {
-        RET_CHECK(config.ParseFromArray(calculator_graph_config_contents.c_str(),
-                                        calculator_graph_config_contents.length()));
-    } else {
-        if (!settings.scale_input) {
-            // get rid of input scaling
-            presage::graph_tweaks::SetOutputWidthAndHeightToZeroIfPresent(calculator_graph_config_contents);
-        }
-        if (TLog) {
-            if (settings.print_graph_contents) {
-                LOG(INFO) << "Get calculator graph config contents: " << calculator_graph_config_contents;
-            }
+    // parsed configs are cached process-wide, so re-creating a container doesn't re-read & re-parse the graph
+    MP_ASSIGN_OR_RETURN(
+        auto cached_config,
+        graph_config_cache::GetGraphConfig(graph_file_path, settings.scale_input, binary_graph)
+    );
+    mediapipe::CalculatorGraphConfig config = *cached_config;
+    if (TLog) {
+        if (!binary_graph && settings.print_graph_contents) {
+            LOG(INFO) << "Get calculator graph config contents: " << config.DebugString();
         }
-        config = mediapipe::ParseTextProtoOrDie<mediapipe::CalculatorGraphConfig>(calculator_graph_config_contents);
     }
 
     config.add_executor();
+    // binary graphs are parsed into a config too, so this works regardless of graph format
+    graph_profiling::ApplyGraphProfilerSettings(config, settings.graph_profiler);
 
     return config;
 }
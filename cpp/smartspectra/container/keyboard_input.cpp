@@ -22,7 +22,33 @@ absl::Status HandleKeyboardInput(
     const settings::GeneralSettings& settings,
     StatusCode status_code
 ) {
-    const int pressed_key = cv::waitKey(settings.interframe_delay_ms);
+    return HandleKeyboardInput(grab_frames, recording, v_source, settings, status_code, settings.interframe_delay_ms);
+}
+
+absl::Status HandleKeyboardInput(
+    bool& grab_frames,
+    bool& recording,
+    video_source::VideoSource& v_source,
+    const settings::GeneralSettings& settings,
+    StatusCode status_code,
+    int key_wait_ms
+) {
+    return HandleKeyboardInput(
+        grab_frames, recording,
+        [&v_source](const VideoSourceOperation& operation) { return operation(v_source); },
+        settings, status_code, key_wait_ms
+    );
+}
+
+absl::Status HandleKeyboardInput(
+    bool& grab_frames,
+    bool& recording,
+    const VideoSourceOperationRunner& run_on_video_source,
+    const settings::GeneralSettings& settings,
+    StatusCode status_code,
+    int key_wait_ms
+) {
+    const int pressed_key = cv::waitKey(key_wait_ms);
     if (pressed_key != -1) {
         switch (pressed_key) {
             case 'q':
@@ -30,26 +56,39 @@ absl::Status HandleKeyboardInput(
                 grab_frames = false;
                 break;
             case 'e':
-                return v_source.ToggleAutoExposure();
+                return run_on_video_source([](video_source::VideoSource& v_source) {
+                    return v_source.ToggleAutoExposure();
+                });
             case '-':
-                return v_source.DecreaseExposure();
+                return run_on_video_source([](video_source::VideoSource& v_source) {
+                    return v_source.DecreaseExposure();
+                });
             case '=':
-                return v_source.IncreaseExposure();
+                return run_on_video_source([](video_source::VideoSource& v_source) {
+                    return v_source.IncreaseExposure();
+                });
             case 's':
                 if (status_code == StatusCode::OK || status_code == StatusCode::PROCESSING_NOT_STARTED) {
                     recording = !recording;
                     LOG(INFO) << (recording ? "Recording started." : "Recording stopped.");
+                    const bool auto_lock = settings.video_source.auto_lock;
                     if (recording) {
                         // lock exposure when recording commences (if it's supported by this video source)
-                        if (settings.video_source.auto_lock && v_source.SupportsExposureControls()) {
-                            return v_source.TurnOffAutoExposure();
-                        }
+                        return run_on_video_source([auto_lock](video_source::VideoSource& v_source) {
+                            if (auto_lock && v_source.SupportsExposureControls()) {
+                                return v_source.TurnOffAutoExposure();
+                            }
+                            return absl::OkStatus();
+                        });
                     } else {
                         // turn on auto-exposure after recording (if it's supported by this video source)
-                        auto auto_exposure_on_status = v_source.TurnOnAutoExposure();
-                        if (settings.video_source.auto_lock && v_source.SupportsExposureControls()) {
-                            return v_source.TurnOnAutoExposure();
-                        }
+                        return run_on_video_source([auto_lock](video_source::VideoSource& v_source) {
+                            auto auto_exposure_on_status = v_source.TurnOnAutoExposure();
+                            if (auto_lock && v_source.SupportsExposureControls()) {
+                                return v_source.TurnOnAutoExposure();
+                            }
+                            return absl::OkStatus();
+                        });
                     }
                 } else {
                     LOG(INFO) << "Not ready to start recording. Preprocessing input issue detected: " << status_code;
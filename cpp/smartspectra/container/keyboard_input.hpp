@@ -20,6 +20,7 @@
 
 #pragma once
 // === standard library includes (if any) ===
+#include <functional>
 // === third-party includes (if any) ===
 #include <mediapipe/framework/port/opencv_video_inc.h>
 #include <absl/status/status.h>
@@ -30,6 +31,11 @@
 
 namespace presage::smartspectra::container::keyboard_input {
 
+// an action on the video source, e.g. an exposure adjustment
+using VideoSourceOperation = std::function<absl::Status(video_source::VideoSource&)>;
+// runs (or hands off for running) an operation on the video source
+using VideoSourceOperationRunner = std::function<absl::Status(VideoSourceOperation)>;
+
 absl::Status HandleKeyboardInput(
     bool& grab_frames,
     bool& recording,
@@ -38,5 +44,25 @@ absl::Status HandleKeyboardInput(
     physiology::StatusCode error_code
 );
 
+// same as above, but waits for a key press for key_wait_ms instead of settings.interframe_delay_ms
+absl::Status HandleKeyboardInput(
+    bool& grab_frames,
+    bool& recording,
+    video_source::VideoSource& v_source,
+    const settings::GeneralSettings& settings,
+    physiology::StatusCode error_code,
+    int key_wait_ms
+);
+
+// same as above, but all video source actions go through run_on_video_source, e.g. so that they execute on
+// whichever thread currently owns the video source
+absl::Status HandleKeyboardInput(
+    bool& grab_frames,
+    bool& recording,
+    const VideoSourceOperationRunner& run_on_video_source,
+    const settings::GeneralSettings& settings,
+    physiology::StatusCode error_code,
+    int key_wait_ms
+);
 
 } // namespace presage::smartspectra::container::keyboard_input
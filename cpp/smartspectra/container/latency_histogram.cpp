@@ -0,0 +1,107 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <cmath>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "latency_histogram.hpp"
+
+namespace presage::smartspectra::container::latency_histogram {
+
+// === LogarithmicBuckets ===
+
+LogarithmicBuckets::LogarithmicBuckets(double min_value, double max_value, double relative_precision) :
+    min_value(min_value),
+    max_value(max_value),
+    // reporting the geometric center of a bucket is off by at most sqrt(base) - 1 relative to any value in it
+    bucket_base((1.0 + relative_precision) * (1.0 + relative_precision)),
+    inverse_log_bucket_base(1.0 / std::log(bucket_base)),
+    bucket_count(static_cast<size_t>(std::ceil(std::log(max_value / min_value) * inverse_log_bucket_base)) + 1) {}
+
+size_t LogarithmicBuckets::GetBucketIndex(double value) const {
+    const double clamped_value = std::clamp(value, min_value, max_value);
+    const auto bucket_index = static_cast<size_t>(std::log(clamped_value / min_value) * inverse_log_bucket_base);
+    return std::min(bucket_index, bucket_count - 1);
+}
+
+double LogarithmicBuckets::GetBucketValue(size_t bucket_index) const {
+    return min_value * std::pow(bucket_base, static_cast<double>(bucket_index) + 0.5);
+}
+
+// === LatencyHistogram ===
+
+LatencyHistogram::LatencyHistogram(double min_value, double max_value, double relative_precision) :
+    LatencyHistogram(LogarithmicBuckets(min_value, max_value, relative_precision)) {}
+
+LatencyHistogram::LatencyHistogram(const LogarithmicBuckets& buckets) :
+    buckets(buckets), bucket_counts(buckets.GetBucketCount(), 0) {}
+
+void LatencyHistogram::Add(double value) {
+    bucket_counts[buckets.GetBucketIndex(value)]++;
+    count++;
+}
+
+void LatencyHistogram::Remove(double value) {
+    uint64_t& bucket_count = bucket_counts[buckets.GetBucketIndex(value)];
+    if (bucket_count > 0) {
+        bucket_count--;
+        count--;
+    }
+}
+
+void LatencyHistogram::Clear() {
+    std::fill(bucket_counts.begin(), bucket_counts.end(), 0);
+    count = 0;
+}
+
+double LatencyHistogram::Quantile(double quantile) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    // rank of the requested sample, 1-based
+    const auto target_rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count)))
+    );
+    uint64_t cumulative_count = 0;
+    for (size_t bucket_index = 0; bucket_index < bucket_counts.size(); bucket_index++) {
+        cumulative_count += bucket_counts[bucket_index];
+        if (cumulative_count >= target_rank) {
+            return std::clamp(buckets.GetBucketValue(bucket_index), buckets.GetMinValue(), buckets.GetMaxValue());
+        }
+    }
+    return buckets.GetMaxValue();
+}
+
+// === AtomicLatencyHistogram ===
+
+AtomicLatencyHistogram::AtomicLatencyHistogram(double min_value, double max_value, double relative_precision) :
+    buckets(min_value, max_value, relative_precision),
+    bucket_counts(std::make_unique<std::atomic<uint64_t>[]>(buckets.GetBucketCount())) {
+    Clear();
+}
+
+void AtomicLatencyHistogram::Add(double value) {
+    bucket_counts[buckets.GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AtomicLatencyHistogram::Clear() {
+    for (size_t bucket_index = 0; bucket_index < buckets.GetBucketCount(); bucket_index++) {
+        bucket_counts[bucket_index].store(0, std::memory_order_relaxed);
+    }
+}
+
+LatencyHistogram AtomicLatencyHistogram::Snapshot() const {
+    LatencyHistogram snapshot(buckets);
+    for (size_t bucket_index = 0; bucket_index < buckets.GetBucketCount(); bucket_index++) {
+        snapshot.bucket_counts[bucket_index] = bucket_counts[bucket_index].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.bucket_counts[bucket_index];
+    }
+    return snapshot;
+}
+
+} // namespace presage::smartspectra::container::latency_histogram
@@ -0,0 +1,111 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+
+namespace presage::smartspectra::container::latency_histogram {
+
+/**
+ * Bucket layout shared by the histograms below: bucket i covers [min_value * base^i, min_value * base^(i+1)), with the
+ * base picked so that the geometric center of a bucket is within the given relative precision of any value in it.
+ */
+class LogarithmicBuckets {
+public:
+    LogarithmicBuckets(double min_value, double max_value, double relative_precision);
+
+    // values outside [min_value, max_value] are clamped
+    [[nodiscard]] size_t GetBucketIndex(double value) const;
+    [[nodiscard]] double GetBucketValue(size_t bucket_index) const;
+
+    [[nodiscard]] size_t GetBucketCount() const { return bucket_count; }
+    [[nodiscard]] double GetMinValue() const { return min_value; }
+    [[nodiscard]] double GetMaxValue() const { return max_value; }
+
+private:
+    double min_value;
+    double max_value;
+    double bucket_base;
+    double inverse_log_bucket_base;
+    size_t bucket_count;
+};
+
+class AtomicLatencyHistogram;
+
+/**
+ * Streaming quantile sketch for latencies: a histogram with logarithmically-spaced buckets, so that every quantile
+ * is reported within a fixed relative error, using constant memory regardless of sample count.
+ * @details Add and Remove are O(1), which makes the sketch usable over a sliding window (remove samples as they
+ * leave the window). Quantile is O(bucket count). Values outside [min_value, max_value] are clamped. Not thread-safe.
+ */
+class LatencyHistogram {
+public:
+    /**
+     * @param min_value smallest distinguishable value (e.g. seconds)
+     * @param max_value largest distinguishable value
+     * @param relative_precision maximum relative error of reported quantiles
+     */
+    explicit LatencyHistogram(double min_value = 1e-5, double max_value = 1e3, double relative_precision = 0.01);
+
+    void Add(double value);
+
+    // removes a value previously passed to Add
+    void Remove(double value);
+
+    void Clear();
+
+    [[nodiscard]] uint64_t Count() const { return count; }
+
+    /**
+     * @param quantile in [0, 1], e.g. 0.95 for the 95th percentile
+     * @return estimated value at the given quantile, or 0 if the histogram is empty
+     */
+    [[nodiscard]] double Quantile(double quantile) const;
+
+private:
+    friend class AtomicLatencyHistogram;
+
+    explicit LatencyHistogram(const LogarithmicBuckets& buckets);
+
+    const LogarithmicBuckets buckets;
+    std::vector<uint64_t> bucket_counts;
+    uint64_t count = 0;
+};
+
+/**
+ * Same sketch as LatencyHistogram, but with lock-free recording: Add may be called concurrently from any thread.
+ * Values can't be removed; quantiles are read off of a (non-atomic) snapshot.
+ */
+class AtomicLatencyHistogram {
+public:
+    explicit AtomicLatencyHistogram(
+        double min_value = 1e-5,
+        double max_value = 1e3,
+        double relative_precision = 0.01
+    );
+
+    void Add(double value);
+
+    void Clear();
+
+    /**
+     * May run concurrently with Add, in which case values added meanwhile may or may not be included.
+     * @return copy of the current counts
+     */
+    [[nodiscard]] LatencyHistogram Snapshot() const;
+
+private:
+    const LogarithmicBuckets buckets;
+    std::unique_ptr<std::atomic<uint64_t>[]> bucket_counts;
+};
+
+} // namespace presage::smartspectra::container::latency_histogram
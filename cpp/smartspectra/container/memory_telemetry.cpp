@@ -0,0 +1,134 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <cstdlib>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "memory_telemetry.hpp"
+
+namespace presage::smartspectra::container::memory_telemetry {
+
+namespace {
+
+// constant-initialized, so that they're usable by allocations that happen before main
+std::atomic<bool> allocation_hooks_installed{false};
+std::atomic<uint64_t> allocation_count{0};
+std::atomic<uint64_t> allocated_bytes{0};
+
+} // anonymous namespace
+
+bool IsAllocationTrackingAvailable() {
+    return allocation_hooks_installed.load(std::memory_order_relaxed);
+}
+
+AllocationCounters GetAllocationCounters() {
+    AllocationCounters counters;
+    counters.allocation_count = allocation_count.load(std::memory_order_relaxed);
+    counters.allocated_bytes = allocated_bytes.load(std::memory_order_relaxed);
+    return counters;
+}
+
+void RecordAllocation(size_t byte_count) noexcept {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(byte_count, std::memory_order_relaxed);
+}
+
+void MarkAllocationHooksInstalled() noexcept {
+    allocation_hooks_installed.store(true, std::memory_order_relaxed);
+}
+
+int64_t GetPeakResidentSetSizeBytes() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage{};
+    if (::getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+#ifdef __APPLE__
+    // reported in bytes on macOS...
+    return static_cast<int64_t>(usage.ru_maxrss);
+#else
+    // ...and in kilobytes on Linux
+    return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+    return -1;
+#endif
+}
+
+int64_t GetCurrentResidentSetSizeBytes() {
+#if defined(__APPLE__)
+    mach_task_basic_info_data_t info{};
+    mach_msg_type_number_t info_count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &info_count) !=
+        KERN_SUCCESS) {
+        return -1;
+    }
+    return static_cast<int64_t>(info.resident_size);
+#elif defined(__linux__)
+    // "size resident shared text lib data dt", in pages; read into a stack buffer, so that sampling doesn't allocate
+    const int file_descriptor = ::open("/proc/self/statm", O_RDONLY);
+    if (file_descriptor < 0) {
+        return -1;
+    }
+    char contents[128];
+    const ssize_t byte_count = ::read(file_descriptor, contents, sizeof(contents) - 1);
+    ::close(file_descriptor);
+    if (byte_count <= 0) {
+        return -1;
+    }
+    contents[byte_count] = '\0';
+    char* resident_begin = nullptr;
+    std::strtoll(contents, &resident_begin, 10);
+    char* resident_end = nullptr;
+    const long long resident_pages = std::strtoll(resident_begin, &resident_end, 10);
+    if (resident_end == resident_begin) {
+        return -1;
+    }
+    return static_cast<int64_t>(resident_pages) * static_cast<int64_t>(::sysconf(_SC_PAGESIZE));
+#else
+    return -1;
+#endif
+}
+
+MemoryTelemetry::MemoryTelemetry() {
+    Reset();
+}
+
+MemoryTelemetrySnapshot MemoryTelemetry::Snapshot() const {
+    const AllocationCounters counters = GetAllocationCounters();
+    MemoryTelemetrySnapshot snapshot;
+    snapshot.allocation_tracking_available = IsAllocationTrackingAvailable();
+    snapshot.frame_count = frame_count.load(std::memory_order_relaxed);
+    snapshot.allocation_count = counters.allocation_count - baseline_allocation_count.load(std::memory_order_relaxed);
+    snapshot.allocated_bytes = counters.allocated_bytes - baseline_allocated_bytes.load(std::memory_order_relaxed);
+    if (snapshot.frame_count > 0) {
+        snapshot.allocations_per_frame =
+            static_cast<double>(snapshot.allocation_count) / static_cast<double>(snapshot.frame_count);
+        snapshot.bytes_per_frame =
+            static_cast<double>(snapshot.allocated_bytes) / static_cast<double>(snapshot.frame_count);
+    }
+    snapshot.peak_resident_set_size_bytes = GetPeakResidentSetSizeBytes();
+    snapshot.current_resident_set_size_bytes = GetCurrentResidentSetSizeBytes();
+    return snapshot;
+}
+
+void MemoryTelemetry::Reset() {
+    const AllocationCounters counters = GetAllocationCounters();
+    baseline_allocation_count.store(counters.allocation_count, std::memory_order_relaxed);
+    baseline_allocated_bytes.store(counters.allocated_bytes, std::memory_order_relaxed);
+    frame_count.store(0, std::memory_order_relaxed);
+}
+
+} // namespace presage::smartspectra::container::memory_telemetry
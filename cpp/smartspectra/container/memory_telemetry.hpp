@@ -0,0 +1,80 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+
+namespace presage::smartspectra::container::memory_telemetry {
+
+// process-wide heap allocation totals since startup
+struct AllocationCounters {
+    uint64_t allocation_count = 0;
+    uint64_t allocated_bytes = 0;
+};
+
+/**
+ * Whether heap allocations are being counted, i.e. whether the global operator new hooks
+ * (SmartSpectra::AllocationHooks, meant for test & benchmark builds) are linked into the executable.
+ * @details The hooks count operator new and cv::Mat buffers allocated by OpenCV; direct malloc / posix_memalign
+ * calls (e.g. pixel buffers MediaPipe allocates for ImageFrames on its own) go uncounted.
+ */
+[[nodiscard]] bool IsAllocationTrackingAvailable();
+
+// all zeros if allocation tracking isn't available
+[[nodiscard]] AllocationCounters GetAllocationCounters();
+
+// called by the operator new hooks; must not allocate
+void RecordAllocation(size_t byte_count) noexcept;
+
+void MarkAllocationHooksInstalled() noexcept;
+
+// peak resident set size of the process so far, in bytes, or -1 if unsupported on this platform
+[[nodiscard]] int64_t GetPeakResidentSetSizeBytes();
+
+// current resident set size of the process, in bytes, or -1 if unsupported on this platform
+[[nodiscard]] int64_t GetCurrentResidentSetSizeBytes();
+
+struct MemoryTelemetrySnapshot {
+    bool allocation_tracking_available = false;
+    // frames fed to the graph since the last reset
+    uint64_t frame_count = 0;
+    // process-wide heap allocations since the last reset (all threads, including the graph's)
+    uint64_t allocation_count = 0;
+    uint64_t allocated_bytes = 0;
+    double allocations_per_frame = 0.0;
+    double bytes_per_frame = 0.0;
+    int64_t peak_resident_set_size_bytes = -1;
+    int64_t current_resident_set_size_bytes = -1;
+};
+
+/**
+ * Relates process-wide heap allocations to the number of frames processed since the last reset, to expose per-frame
+ * heap churn, and samples the resident set size.
+ * @details Thread-safe. RecordFrame is a single relaxed atomic increment.
+ */
+class MemoryTelemetry {
+public:
+    MemoryTelemetry();
+
+    void RecordFrame() { frame_count.fetch_add(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] MemoryTelemetrySnapshot Snapshot() const;
+
+    // starts a new measurement period, e.g. after warm-up
+    void Reset();
+
+private:
+    std::atomic<uint64_t> frame_count{0};
+    std::atomic<uint64_t> baseline_allocation_count{0};
+    std::atomic<uint64_t> baseline_allocated_bytes{0};
+};
+
+} // namespace presage::smartspectra::container::memory_telemetry
@@ -0,0 +1,355 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/logging.h>
+#include <mediapipe/framework/port/status_macros.h>
+// === local includes (if any) ===
+#include "metrics_exporter.hpp"
+
+namespace presage::smartspectra::container::metrics_exporter {
+
+namespace {
+
+constexpr double kMicrosecondsPerSecond = 1e6;
+// how often the server thread checks whether it should stop
+constexpr int kHttpPollTimeoutMs = 100;
+constexpr int kMaxHttpRequestSize = 8192;
+
+void WriteFamilyHeader(std::ostringstream& output, const std::string& name, const char* type, const char* help) {
+    output << "# TYPE " << name << " " << type << "\n";
+    output << "# HELP " << name << " " << help << "\n";
+}
+
+void WriteCounter(
+    std::ostringstream& output, const std::string& name, const char* help, uint64_t value
+) {
+    WriteFamilyHeader(output, name, "counter", help);
+    output << name << "_total " << value << "\n";
+}
+
+template<typename TValue>
+void WriteGauge(std::ostringstream& output, const std::string& name, const char* help, TValue value) {
+    WriteFamilyHeader(output, name, "gauge", help);
+    output << name << " " << value << "\n";
+}
+
+// OpenMetrics wants canonical floats in "le" labels, e.g. "1.0" rather than "1"
+std::string FormatBucketBound(double bound) {
+    std::ostringstream output;
+    output << bound;
+    std::string formatted = output.str();
+    if (formatted.find_first_of(".e") == std::string::npos) {
+        formatted += ".0";
+    }
+    return formatted;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// a scraper hanging up mid-response mustn't kill the process with SIGPIPE
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+// e.g. macOS: SIGPIPE is suppressed per socket instead (see SuppressSigPipe)
+constexpr int kSendFlags = 0;
+#endif
+
+void SuppressSigPipe([[maybe_unused]] int socket) {
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+    const int no_sigpipe = 1;
+    ::setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+}
+
+void SendAll(int socket, const std::string& data) {
+    size_t sent_byte_count = 0;
+    while (sent_byte_count < data.size()) {
+        const ssize_t result =
+            ::send(socket, data.data() + sent_byte_count, data.size() - sent_byte_count, kSendFlags);
+        if (result <= 0) {
+            if (result < 0 && errno == EINTR) continue;
+            return;
+        }
+        sent_byte_count += static_cast<size_t>(result);
+    }
+}
+#endif
+
+} // anonymous namespace
+
+// === RuntimeMetrics ===
+
+void RuntimeMetrics::RecordFrameLeftGraph(bool frame_sent_through) {
+    (frame_sent_through ? frames_sent_through_count : frames_dropped_in_graph_count)
+        .fetch_add(1, std::memory_order_relaxed);
+}
+
+void RuntimeMetrics::RecordFramesDroppedBeforeGraph(uint64_t frame_count) {
+    frames_dropped_before_graph_count.fetch_add(frame_count, std::memory_order_relaxed);
+}
+
+void RuntimeMetrics::SetFramesInFlight(int64_t frame_count) {
+    frames_in_flight.store(frame_count, std::memory_order_relaxed);
+}
+
+void RuntimeMetrics::RecordMetricsBuffer(int64_t frame_count) {
+    metrics_buffer_count.fetch_add(1, std::memory_order_relaxed);
+    metrics_buffer_frame_count.fetch_add(static_cast<uint64_t>(std::max<int64_t>(frame_count, 0)),
+                                         std::memory_order_relaxed);
+}
+
+void RuntimeMetrics::RecordCorePerformance(double effective_core_fps, double latency_seconds) {
+    this->effective_core_fps.store(effective_core_fps, std::memory_order_relaxed);
+    const double clamped_latency_seconds = std::max(latency_seconds, 0.0);
+    const auto bucket = std::lower_bound(
+        kLatencyBucketBounds.begin(), kLatencyBucketBounds.end(), clamped_latency_seconds
+    );
+    latency_bucket_counts[bucket - kLatencyBucketBounds.begin()].fetch_add(1, std::memory_order_relaxed);
+    latency_sum_μs.fetch_add(
+        static_cast<uint64_t>(std::llround(clamped_latency_seconds * kMicrosecondsPerSecond)), std::memory_order_relaxed
+    );
+}
+
+void RuntimeMetrics::RecordStatusChange(int status_code) {
+    this->status_code.store(status_code, std::memory_order_relaxed);
+    status_change_counts[std::clamp(status_code, 0, kMaxTrackedStatusCode)].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string RuntimeMetrics::FormatOpenMetrics(const std::string& prefix) const {
+    std::ostringstream output;
+    const std::string name_prefix = prefix.empty() ? "" : prefix + "_";
+
+    const uint64_t sent_through = frames_sent_through_count.load(std::memory_order_relaxed);
+    const uint64_t dropped_in_graph = frames_dropped_in_graph_count.load(std::memory_order_relaxed);
+    WriteCounter(output, name_prefix + "frames_sent_through", "Frames sent through the graph.", sent_through);
+    WriteCounter(output, name_prefix + "frames_dropped_in_graph", "Frames dropped by the graph.", dropped_in_graph);
+    WriteCounter(
+        output, name_prefix + "frames_dropped_before_graph",
+        "Frames dropped before reaching the graph (capture pipeline overflow or backpressure).",
+        frames_dropped_before_graph_count.load(std::memory_order_relaxed)
+    );
+    const uint64_t frames_left_graph = sent_through + dropped_in_graph;
+    WriteGauge(
+        output, name_prefix + "frame_drop_ratio", "Fraction of frames dropped by the graph since startup.",
+        frames_left_graph > 0 ? static_cast<double>(dropped_in_graph) / static_cast<double>(frames_left_graph) : 0.0
+    );
+    WriteGauge(
+        output, name_prefix + "frames_in_flight", "Frames fed to the graph that haven't left it yet.",
+        frames_in_flight.load(std::memory_order_relaxed)
+    );
+    WriteCounter(
+        output, name_prefix + "metrics_buffers", "Metrics buffers received from Core.",
+        metrics_buffer_count.load(std::memory_order_relaxed)
+    );
+    WriteCounter(
+        output, name_prefix + "metrics_buffer_frames", "Input frames covered by metrics buffers received from Core.",
+        metrics_buffer_frame_count.load(std::memory_order_relaxed)
+    );
+    WriteGauge(
+        output, name_prefix + "effective_core_fps", "Effective Core framerate over the telemetry window.",
+        effective_core_fps.load(std::memory_order_relaxed)
+    );
+
+    const std::string latency_name = name_prefix + "core_latency_seconds";
+    WriteFamilyHeader(output, latency_name, "histogram", "Latency from frame capture to metrics buffer output.");
+    uint64_t cumulative_count = 0;
+    for (size_t i_bucket = 0; i_bucket < kLatencyBucketBounds.size(); i_bucket++) {
+        cumulative_count += latency_bucket_counts[i_bucket].load(std::memory_order_relaxed);
+        output << latency_name << "_bucket{le=\"" << FormatBucketBound(kLatencyBucketBounds[i_bucket]) << "\"} "
+               << cumulative_count << "\n";
+    }
+    cumulative_count += latency_bucket_counts.back().load(std::memory_order_relaxed);
+    output << latency_name << "_bucket{le=\"+Inf\"} " << cumulative_count << "\n";
+    output << latency_name << "_count " << cumulative_count << "\n";
+    output << latency_name << "_sum "
+           << static_cast<double>(latency_sum_μs.load(std::memory_order_relaxed)) / kMicrosecondsPerSecond << "\n";
+
+    WriteGauge(
+        output, name_prefix + "status_code", "Current imaging status code (-1 before the first status).",
+        status_code.load(std::memory_order_relaxed)
+    );
+    const std::string status_changes_name = name_prefix + "status_changes";
+    WriteFamilyHeader(output, status_changes_name, "counter", "Transitions into each imaging status code.");
+    for (int code = 0; code <= kMaxTrackedStatusCode; code++) {
+        const uint64_t count = status_change_counts[code].load(std::memory_order_relaxed);
+        if (count > 0) {
+            output << status_changes_name << "_total{code=\"" << code << "\"} " << count << "\n";
+        }
+    }
+    output << "# EOF\n";
+    return output.str();
+}
+
+// === MetricsExporter ===
+
+MetricsExporter::MetricsExporter(std::shared_ptr<const RuntimeMetrics> metrics, std::string prefix) :
+    metrics(std::move(metrics)), prefix(std::move(prefix)) {}
+
+MetricsExporter::~MetricsExporter() {
+    Stop();
+}
+
+absl::Status MetricsExporter::StartHttpServer(uint16_t port) {
+#if defined(__unix__) || defined(__APPLE__)
+    if (this->http_thread.joinable()) {
+        return absl::FailedPreconditionError("Metrics HTTP server is already running.");
+    }
+    const int server_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (server_socket < 0) {
+        return absl::InternalError("Could not create metrics server socket: " + std::string(std::strerror(errno)));
+    }
+    const int reuse_address = 1;
+    ::setsockopt(server_socket, SOL_SOCKET, SO_REUSEADDR, &reuse_address, sizeof(reuse_address));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    // loopback only: metrics are meant to be scraped by a local agent / sidecar
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (::bind(server_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(server_socket, SOMAXCONN) != 0) {
+        const std::string error = std::strerror(errno);
+        ::close(server_socket);
+        return absl::UnavailableError("Could not listen on 127.0.0.1:" + std::to_string(port) + ": " + error);
+    }
+    socklen_t address_length = sizeof(address);
+    ::getsockname(server_socket, reinterpret_cast<sockaddr*>(&address), &address_length);
+
+    this->http_socket = server_socket;
+    this->http_port = ntohs(address.sin_port);
+    this->stop_requested = false;
+    this->http_thread = std::thread(&MetricsExporter::ServeHttp, this);
+    return absl::OkStatus();
+#else
+    return absl::UnimplementedError(
+        "Metrics HTTP server isn't supported on this platform; use file export (StartFileExport) instead."
+    );
+#endif
+}
+
+void MetricsExporter::ServeHttp() {
+#if defined(__unix__) || defined(__APPLE__)
+    pollfd server_poll_descriptor{this->http_socket, POLLIN, 0};
+    while (!this->stop_requested) {
+        const int ready_count = ::poll(&server_poll_descriptor, 1, kHttpPollTimeoutMs);
+        if (ready_count <= 0) continue;
+        const int client_socket = ::accept(this->http_socket, nullptr, nullptr);
+        if (client_socket < 0) continue;
+        SuppressSigPipe(client_socket);
+
+        // read the request head; a scrape is a single small GET, so one short wait is enough
+        std::string request;
+        char buffer[1024];
+        pollfd client_poll_descriptor{client_socket, POLLIN, 0};
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < kMaxHttpRequestSize &&
+               ::poll(&client_poll_descriptor, 1, kHttpPollTimeoutMs * 10) > 0) {
+            const ssize_t received_byte_count = ::recv(client_socket, buffer, sizeof(buffer), 0);
+            if (received_byte_count <= 0) break;
+            request.append(buffer, static_cast<size_t>(received_byte_count));
+        }
+
+        std::string response;
+        if (request.rfind("GET ", 0) == 0) {
+            const std::string body = this->metrics->FormatOpenMetrics(this->prefix);
+            response = "HTTP/1.1 200 OK\r\n"
+                       "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                       "Connection: close\r\n\r\n" + body;
+        } else {
+            response = "HTTP/1.1 405 Method Not Allowed\r\n"
+                       "Allow: GET\r\n"
+                       "Content-Length: 0\r\n"
+                       "Connection: close\r\n\r\n";
+        }
+        SendAll(client_socket, response);
+        ::close(client_socket);
+    }
+#endif
+}
+
+absl::Status MetricsExporter::WriteToFile(const std::string& output_path) const {
+    // write next to the target & rename, so that the file is replaced atomically
+    const std::string temporary_path = output_path + ".tmp";
+    {
+        std::ofstream output(temporary_path, std::ios::trunc);
+        if (!output) {
+            return absl::InternalError("Could not open metrics file for writing: " + temporary_path);
+        }
+        output << this->metrics->FormatOpenMetrics(this->prefix);
+        if (!output) {
+            return absl::InternalError("Could not write metrics file: " + temporary_path);
+        }
+    }
+    std::error_code error_code;
+    std::filesystem::rename(temporary_path, output_path, error_code);
+    if (error_code) {
+        return absl::InternalError("Could not replace metrics file " + output_path + ": " + error_code.message());
+    }
+    return absl::OkStatus();
+}
+
+absl::Status MetricsExporter::StartFileExport(const std::string& output_path, std::chrono::milliseconds interval) {
+    if (this->file_export_thread.joinable()) {
+        return absl::FailedPreconditionError("Periodic metrics file export is already running.");
+    }
+    if (interval.count() <= 0) {
+        return absl::InvalidArgumentError("Metrics file export interval has to be positive.");
+    }
+    // fail early on unwritable paths
+    MP_RETURN_IF_ERROR(this->WriteToFile(output_path));
+    this->stop_requested = false;
+    this->file_export_thread = std::thread(&MetricsExporter::ExportToFilePeriodically, this, output_path, interval);
+    return absl::OkStatus();
+}
+
+void MetricsExporter::ExportToFilePeriodically(std::string output_path, std::chrono::milliseconds interval) {
+    std::unique_lock<std::mutex> lock(this->stop_mutex);
+    while (!this->stop_condition.wait_for(lock, interval, [this] { return this->stop_requested.load(); })) {
+        auto status = this->WriteToFile(output_path);
+        if (!status.ok()) {
+            LOG(ERROR) << "Metrics file export failed: " << status.message();
+        }
+    }
+    // final state, so that the file reflects the whole run
+    this->WriteToFile(output_path).IgnoreError();
+}
+
+void MetricsExporter::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(this->stop_mutex);
+        this->stop_requested = true;
+    }
+    this->stop_condition.notify_all();
+    if (this->http_thread.joinable()) {
+        this->http_thread.join();
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    if (this->http_socket >= 0) {
+        ::close(this->http_socket);
+        this->http_socket = -1;
+        this->http_port = 0;
+    }
+#endif
+    if (this->file_export_thread.joinable()) {
+        this->file_export_thread.join();
+    }
+}
+
+} // namespace presage::smartspectra::container::metrics_exporter
@@ -0,0 +1,122 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+// === local includes (if any) ===
+
+namespace presage::smartspectra::container::metrics_exporter {
+
+/**
+ * Container runtime statistics (throughput, latency, frame drops, queue depth, status-code transitions), kept as
+ * lock-free counters, gauges and histograms, so that they can be scraped at any time.
+ * @details Thread-safe. Every Record* / Set* call costs a handful of relaxed atomic operations.
+ */
+class RuntimeMetrics {
+public:
+    // upper bounds of the core latency histogram buckets, in seconds (there's an implicit +Inf bucket)
+    static constexpr std::array<double, 10> kLatencyBucketBounds{0.05, 0.1, 0.25, 0.5, 1.0, 2.0, 3.0, 5.0, 10.0, 30.0};
+    // status codes at or above this value are counted together
+    static constexpr int kMaxTrackedStatusCode = 64;
+
+    // a frame left the graph, either sent through to the output or dropped by it
+    void RecordFrameLeftGraph(bool frame_sent_through);
+
+    // frames that never made it into the graph, e.g. dropped by the capture pipeline or replaced under backpressure
+    void RecordFramesDroppedBeforeGraph(uint64_t frame_count);
+
+    void SetFramesInFlight(int64_t frame_count);
+
+    // a metrics buffer came out of Core, covering the given number of input frames
+    void RecordMetricsBuffer(int64_t frame_count);
+
+    // effective Core framerate since the previous metrics buffer & the latency of the latest one
+    void RecordCorePerformance(double effective_core_fps, double latency_seconds);
+
+    void RecordStatusChange(int status_code);
+
+    /**
+     * Renders all metrics in OpenMetrics text exposition format (terminated by "# EOF").
+     * @param prefix prepended to every metric family name, e.g. "smartspectra"
+     */
+    [[nodiscard]] std::string FormatOpenMetrics(const std::string& prefix = "smartspectra") const;
+
+private:
+    std::atomic<uint64_t> frames_sent_through_count{0};
+    std::atomic<uint64_t> frames_dropped_in_graph_count{0};
+    std::atomic<uint64_t> frames_dropped_before_graph_count{0};
+    std::atomic<int64_t> frames_in_flight{0};
+    std::atomic<uint64_t> metrics_buffer_count{0};
+    std::atomic<uint64_t> metrics_buffer_frame_count{0};
+    std::atomic<double> effective_core_fps{0.0};
+    std::array<std::atomic<uint64_t>, kLatencyBucketBounds.size() + 1> latency_bucket_counts{};
+    // in microseconds, so that it can be accumulated with a plain fetch_add
+    std::atomic<uint64_t> latency_sum_μs{0};
+    std::atomic<int> status_code{-1};
+    std::array<std::atomic<uint64_t>, kMaxTrackedStatusCode + 1> status_change_counts{};
+};
+
+/**
+ * Serves the OpenMetrics rendering of RuntimeMetrics to scrapers over loopback HTTP and/or periodically writes it to a
+ * file (e.g. for node_exporter's textfile collector). Rendering happens on the exporter's own threads, off the frame
+ * hot path.
+ */
+class MetricsExporter {
+public:
+    explicit MetricsExporter(std::shared_ptr<const RuntimeMetrics> metrics, std::string prefix = "smartspectra");
+
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * Starts serving GET requests (any path) with the metrics on 127.0.0.1. Only available on POSIX platforms
+     * (Linux, macOS); elsewhere, returns an absl::UnimplementedError status.
+     * @param port TCP port to listen on; 0 picks a free one (see GetHttpPort)
+     */
+    absl::Status StartHttpServer(uint16_t port);
+
+    // port the HTTP server listens on, or 0 if it isn't running
+    [[nodiscard]] uint16_t GetHttpPort() const { return http_port.load(); }
+
+    // (Re)writes the metrics file every interval; the file is replaced atomically, so readers never see partial output.
+    absl::Status StartFileExport(const std::string& output_path, std::chrono::milliseconds interval);
+
+    absl::Status WriteToFile(const std::string& output_path) const;
+
+    // stops the HTTP server & periodic file export, if running
+    void Stop();
+
+private:
+    void ServeHttp();
+    void ExportToFilePeriodically(std::string output_path, std::chrono::milliseconds interval);
+
+    const std::shared_ptr<const RuntimeMetrics> metrics;
+    const std::string prefix;
+
+    std::atomic<bool> stop_requested{false};
+    std::mutex stop_mutex;
+    std::condition_variable stop_condition;
+
+    int http_socket = -1;
+    std::atomic<uint16_t> http_port{0};
+    std::thread http_thread;
+    std::thread file_export_thread;
+};
+
+} // namespace presage::smartspectra::container::metrics_exporter
@@ -0,0 +1,20 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "multi_stream_host_impl.hpp"
+
+namespace presage::smartspectra::container::multi_stream_host {
+template class MultiStreamHost<platform_independence::DeviceType::Cpu, settings::OperationMode::Spot, settings::IntegrationMode::Rest>;
+template class MultiStreamHost<platform_independence::DeviceType::Cpu, settings::OperationMode::Continuous, settings::IntegrationMode::Rest>;
+template class MultiStreamHost<platform_independence::DeviceType::Cpu, settings::OperationMode::Continuous, settings::IntegrationMode::Grpc>;
+#ifdef WITH_OPENGL
+template class MultiStreamHost<platform_independence::DeviceType::OpenGl, settings::OperationMode::Spot, settings::IntegrationMode::Rest>;
+#endif
+
+} // namespace presage::smartspectra::container::multi_stream_host
@@ -0,0 +1,132 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <absl/status/statusor.h>
+#include <mediapipe/framework/executor.h>
+#include <mediapipe/framework/formats/image_frame.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include "background_container.hpp"
+#include "settings.hpp"
+
+namespace presage::smartspectra::container::multi_stream_host {
+
+struct MultiStreamHostSettings {
+    // threads in the executor shared by the graphs of all streams; <= 0 means one per hardware thread
+    int executor_thread_count = 0;
+    // per-stream cap on frames in flight, so that no single stream can flood the shared executor; <= 0 means no cap
+    int max_frames_in_flight_per_stream = 2;
+    // what happens to a frame added to a stream that's at its cap
+    settings::BackpressurePolicy backpressure_policy = settings::BackpressurePolicy::ReplaceOldest;
+};
+
+struct StreamThroughput {
+    size_t stream_index = 0;
+    // frames accepted by AddFrameWithTimestamp
+    uint64_t frames_submitted = 0;
+    // frames refused because the stream was at its cap (Reject policy)
+    uint64_t frames_rejected = 0;
+    // accepted frames superseded by a newer one before they got into the graph (ReplaceOldest policy)
+    uint64_t frames_replaced = 0;
+    // frames processed by the graph
+    uint64_t frames_sent_through = 0;
+    // frames dropped inside the graph
+    uint64_t frames_dropped_in_graph = 0;
+    // frames fed to the graph that haven't left it yet (only tracked while max_frames_in_flight_per_stream is set)
+    size_t frames_in_flight = 0;
+    // rate of frames sent through since the previous report (or since StartAll, for the first one)
+    double sent_through_fps = 0.0;
+};
+
+/**
+ * Runs several BackgroundContainers (one per camera / stream) side by side, with all of their graphs scheduled on one
+ * shared, size-bounded thread pool instead of a pool per graph, so that adding streams doesn't oversubscribe cores.
+ * @details Fairness: the shared executor runs tasks from all graphs in FIFO order, and each stream is capped at
+ * max_frames_in_flight_per_stream frames, so a stream that's being fed faster than it can be processed sheds its own
+ * frames instead of crowding out the others.
+ * Streams have to be added (and their callbacks set, via GetStream) before StartAll. AddFrameWithTimestamp may be
+ * called concurrently for different streams.
+ */
+template<
+    platform_independence::DeviceType TDeviceType,
+    settings::OperationMode TOperationMode,
+    settings::IntegrationMode TIntegrationMode
+>
+class MultiStreamHost {
+public:
+    typedef BackgroundContainer<TDeviceType, TOperationMode, TIntegrationMode> ContainerType;
+    typedef typename ContainerType::SettingsType SettingsType;
+
+    explicit MultiStreamHost(MultiStreamHostSettings host_settings = {});
+    virtual ~MultiStreamHost();
+
+    MultiStreamHost(const MultiStreamHost&) = delete;
+    MultiStreamHost& operator=(const MultiStreamHost&) = delete;
+
+    /**
+     * Creates & initializes a container for a new stream. The frame_input settings of stream_settings get overridden
+     * with the host's per-stream cap & backpressure policy.
+     * @return index of the new stream
+     */
+    absl::StatusOr<size_t> AddStream(SettingsType stream_settings);
+
+    absl::StatusOr<ContainerType*> GetStream(size_t stream_index);
+
+    size_t GetStreamCount() const { return streams.size(); };
+
+    absl::Status StartAll();
+
+    absl::Status AddFrameWithTimestamp(size_t stream_index, const cv::Mat& frame_rgb, int64_t frame_timestamp_μs);
+
+    absl::Status AddFrameWithTimestamp(
+        size_t stream_index,
+        std::unique_ptr<mediapipe::ImageFrame> frame_rgb,
+        int64_t frame_timestamp_μs
+    );
+
+    std::vector<StreamThroughput> GetThroughputReport();
+
+    absl::Status StopAll();
+
+protected:
+    // builds the (uninitialized) container for a new stream; can be overridden, e.g. to run a different graph
+    virtual std::unique_ptr<ContainerType> CreateContainer(SettingsType stream_settings);
+
+private:
+    struct Stream {
+        std::unique_ptr<ContainerType> container;
+        std::atomic<uint64_t> frames_submitted{0};
+        std::atomic<uint64_t> frames_rejected{0};
+        uint64_t frames_sent_through_at_last_report = 0;
+    };
+
+    absl::StatusOr<Stream*> GetStartedStream(size_t stream_index);
+    absl::Status CountSubmission(Stream& stream, absl::Status add_frame_status);
+
+    const MultiStreamHostSettings host_settings;
+    std::shared_ptr<mediapipe::Executor> executor = nullptr;
+    std::vector<std::unique_ptr<Stream>> streams;
+    bool started = false;
+
+    // guards throughput report state
+    std::mutex report_mutex;
+    std::chrono::steady_clock::time_point last_report_time;
+};
+
+typedef MultiStreamHost<platform_independence::DeviceType::Cpu, settings::OperationMode::Continuous, settings::IntegrationMode::Rest> CpuContinuousRestMultiStreamHost;
+typedef MultiStreamHost<platform_independence::DeviceType::Cpu, settings::OperationMode::Continuous, settings::IntegrationMode::Grpc> CpuContinuousGrpcMultiStreamHost;
+
+} // namespace presage::smartspectra::container::multi_stream_host
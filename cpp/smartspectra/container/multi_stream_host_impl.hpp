@@ -0,0 +1,189 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <string>
+#include <thread>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/logging.h>
+#include <mediapipe/framework/port/status_macros.h>
+#include <mediapipe/framework/thread_pool_executor.h>
+// === local includes (if any) ===
+#include "multi_stream_host.hpp"
+
+namespace presage::smartspectra::container::multi_stream_host {
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::MultiStreamHost(MultiStreamHostSettings host_settings) :
+    host_settings(host_settings) {}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::~MultiStreamHost() {
+    auto status = this->StopAll();
+    if (!status.ok()) {
+        LOG(ERROR) << "Failed to stop all streams: " << status;
+    }
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::StatusOr<size_t> MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::AddStream(
+    SettingsType stream_settings
+) {
+    if (this->started) {
+        return absl::FailedPreconditionError("Streams have to be added before the host is started.");
+    }
+    if (this->executor == nullptr) {
+        const int thread_count = this->host_settings.executor_thread_count > 0 ?
+                                 this->host_settings.executor_thread_count :
+                                 std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        MP_ASSIGN_OR_RETURN(mediapipe::Executor* thread_pool, mediapipe::ThreadPoolExecutor::Create(thread_count));
+        this->executor = std::shared_ptr<mediapipe::Executor>(thread_pool);
+        LOG(INFO) << "Created executor with " << thread_count << " thread(s), shared by all streams.";
+    }
+    stream_settings.frame_input.max_frames_in_flight = this->host_settings.max_frames_in_flight_per_stream;
+    stream_settings.frame_input.backpressure_policy = this->host_settings.backpressure_policy;
+
+    auto stream = std::make_unique<Stream>();
+    stream->container = this->CreateContainer(std::move(stream_settings));
+    MP_RETURN_IF_ERROR(stream->container->SetExecutor(this->executor));
+    MP_RETURN_IF_ERROR(stream->container->Initialize());
+    this->streams.push_back(std::move(stream));
+    return this->streams.size() - 1;
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+std::unique_ptr<typename MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::ContainerType>
+MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::CreateContainer(SettingsType stream_settings) {
+    return std::make_unique<ContainerType>(std::move(stream_settings));
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::StatusOr<typename MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::ContainerType*>
+MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::GetStream(size_t stream_index) {
+    if (stream_index >= this->streams.size()) {
+        return absl::OutOfRangeError(
+            "Stream index " + std::to_string(stream_index) + " out of range, host has " +
+            std::to_string(this->streams.size()) + " stream(s)."
+        );
+    }
+    return this->streams[stream_index]->container.get();
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::StartAll() {
+    if (this->started) {
+        return absl::OkStatus();
+    }
+    if (this->streams.empty()) {
+        return absl::FailedPreconditionError("No streams added.");
+    }
+    for (auto& stream: this->streams) {
+        MP_RETURN_IF_ERROR(stream->container->StartGraph());
+    }
+    this->started = true;
+    std::lock_guard<std::mutex> lock(this->report_mutex);
+    this->last_report_time = std::chrono::steady_clock::now();
+    return absl::OkStatus();
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::StatusOr<typename MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::Stream*>
+MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::GetStartedStream(size_t stream_index) {
+    if (!this->started) {
+        return absl::FailedPreconditionError("Host not started.");
+    }
+    if (stream_index >= this->streams.size()) {
+        return absl::OutOfRangeError("Stream index " + std::to_string(stream_index) + " out of range.");
+    }
+    return this->streams[stream_index].get();
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::CountSubmission(
+    Stream& stream,
+    absl::Status add_frame_status
+) {
+    if (add_frame_status.ok()) {
+        stream.frames_submitted++;
+    } else if (absl::IsResourceExhausted(add_frame_status)) {
+        stream.frames_rejected++;
+    }
+    return add_frame_status;
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::AddFrameWithTimestamp(
+    size_t stream_index,
+    const cv::Mat& frame_rgb,
+    int64_t frame_timestamp_μs
+) {
+    MP_ASSIGN_OR_RETURN(Stream* stream, this->GetStartedStream(stream_index));
+    return this->CountSubmission(*stream, stream->container->AddFrameWithTimestamp(frame_rgb, frame_timestamp_μs));
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::AddFrameWithTimestamp(
+    size_t stream_index,
+    std::unique_ptr<mediapipe::ImageFrame> frame_rgb,
+    int64_t frame_timestamp_μs
+) {
+    MP_ASSIGN_OR_RETURN(Stream* stream, this->GetStartedStream(stream_index));
+    return this->CountSubmission(
+        *stream, stream->container->AddFrameWithTimestamp(std::move(frame_rgb), frame_timestamp_μs)
+    );
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+std::vector<StreamThroughput> MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::GetThroughputReport() {
+    std::lock_guard<std::mutex> lock(this->report_mutex);
+    const auto report_time = std::chrono::steady_clock::now();
+    const double interval_s = std::chrono::duration<double>(report_time - this->last_report_time).count();
+    this->last_report_time = report_time;
+
+    std::vector<StreamThroughput> report;
+    report.reserve(this->streams.size());
+    for (size_t i_stream = 0; i_stream < this->streams.size(); i_stream++) {
+        Stream& stream = *this->streams[i_stream];
+        const ContainerType& container = *stream.container;
+        StreamThroughput throughput;
+        throughput.stream_index = i_stream;
+        throughput.frames_submitted = stream.frames_submitted.load();
+        throughput.frames_rejected = stream.frames_rejected.load();
+        throughput.frames_replaced = container.GetReplacedFrameCount();
+        throughput.frames_sent_through = container.GetFramesSentThroughCount();
+        throughput.frames_dropped_in_graph = container.GetFramesDroppedInGraphCount();
+        throughput.frames_in_flight = container.GetFramesInFlight();
+        if (this->started && interval_s > 0.0) {
+            throughput.sent_through_fps =
+                static_cast<double>(throughput.frames_sent_through - stream.frames_sent_through_at_last_report) /
+                interval_s;
+        }
+        stream.frames_sent_through_at_last_report = throughput.frames_sent_through;
+        report.push_back(throughput);
+    }
+    return report;
+}
+
+template<platform_independence::DeviceType TDeviceType, settings::OperationMode TOperationMode, settings::IntegrationMode TIntegrationMode>
+absl::Status MultiStreamHost<TDeviceType, TOperationMode, TIntegrationMode>::StopAll() {
+    if (!this->started) {
+        return absl::OkStatus();
+    }
+    // try to stop every stream even if some fail, report the first failure
+    absl::Status first_error = absl::OkStatus();
+    for (auto& stream: this->streams) {
+        auto status = stream->container->StopGraph();
+        if (!status.ok() && first_error.ok()) {
+            first_error = status;
+        }
+    }
+    this->started = false;
+    return first_error;
+}
+
+} // namespace presage::smartspectra::container::multi_stream_host
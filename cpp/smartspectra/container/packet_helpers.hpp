@@ -55,13 +55,16 @@ inline absl::Status GetPacketContentsIfAny(
             if (!packet.IsEmpty()) {
                 nonempty_packet_received = true;
                 contents = packet.Get<TPacketContentsType>();
-                std::string extra_information = "";
                 timestamp = packet.Timestamp();
-                if (TPrintTimestamp) {
-                    extra_information = " (timestamp: " + std::to_string(timestamp.Value()) + ")";
-                }
+                // stream the message pieces only when actually reporting, so that the per-packet path doesn't
+                // build (and allocate) strings that get thrown away
                 if (report_if()) {
-                    LOG(INFO) << "Got " + std::string(stream_name) + " packet: " << contents << extra_information;
+                    if constexpr (TPrintTimestamp) {
+                        LOG(INFO) << "Got " << stream_name << " packet: " << contents
+                                  << " (timestamp: " << timestamp.Value() << ")";
+                    } else {
+                        LOG(INFO) << "Got " << stream_name << " packet: " << contents;
+                    }
                 }
             }
         }
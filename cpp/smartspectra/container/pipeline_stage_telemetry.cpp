@@ -0,0 +1,116 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <limits>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "pipeline_stage_telemetry.hpp"
+
+namespace presage::smartspectra::container::pipeline_stage_telemetry {
+
+std::string GetPipelineStageName(PipelineStage stage) {
+    switch (stage) {
+        case PipelineStage::Capture:
+            return "capture";
+        case PipelineStage::ColorConversion:
+            return "color_conversion";
+        case PipelineStage::InputTransform:
+            return "input_transform";
+        case PipelineStage::GraphFeed:
+            return "graph_feed";
+        case PipelineStage::OutputFrameFetch:
+            return "output_frame_fetch";
+        case PipelineStage::BgrConversion:
+            return "bgr_conversion";
+        case PipelineStage::UserCallback:
+            return "user_callback";
+        case PipelineStage::Display:
+            return "display";
+        default:
+            return "unknown";
+    }
+}
+
+namespace {
+
+constexpr double kNanosecondsPerSecond = 1e9;
+
+} // anonymous namespace
+
+// === StageLatencyHistogram ===
+
+StageLatencyHistogram::StageLatencyHistogram() :
+    quantile_histogram(1.0 / kNanosecondsPerSecond, kMaxQuantileDurationSeconds, kQuantileRelativePrecision),
+    min_ns(std::numeric_limits<uint64_t>::max()) {}
+
+void StageLatencyHistogram::Record(uint64_t duration_ns) {
+    quantile_histogram.Add(static_cast<double>(duration_ns) / kNanosecondsPerSecond);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+    uint64_t current_min_ns = min_ns.load(std::memory_order_relaxed);
+    while (duration_ns < current_min_ns &&
+           !min_ns.compare_exchange_weak(current_min_ns, duration_ns, std::memory_order_relaxed)) {}
+    uint64_t current_max_ns = max_ns.load(std::memory_order_relaxed);
+    while (duration_ns > current_max_ns &&
+           !max_ns.compare_exchange_weak(current_max_ns, duration_ns, std::memory_order_relaxed)) {}
+}
+
+StageLatencySummary StageLatencyHistogram::Summarize() const {
+    StageLatencySummary summary;
+    // work off of a snapshot, so that concurrent recording doesn't skew the quantiles relative to each other
+    const latency_histogram::LatencyHistogram snapshot = quantile_histogram.Snapshot();
+    if (snapshot.Count() == 0) {
+        return summary;
+    }
+    summary.count = snapshot.Count();
+    summary.min_seconds = static_cast<double>(min_ns.load(std::memory_order_relaxed)) / kNanosecondsPerSecond;
+    summary.max_seconds = static_cast<double>(max_ns.load(std::memory_order_relaxed)) / kNanosecondsPerSecond;
+    summary.mean_seconds = static_cast<double>(total_ns.load(std::memory_order_relaxed)) /
+                           static_cast<double>(std::max<uint64_t>(count.load(std::memory_order_relaxed), 1)) /
+                           kNanosecondsPerSecond;
+    // bucket centers may fall outside the observed range for sparse data
+    auto get_quantile_seconds = [&snapshot, &summary](double quantile) {
+        return std::clamp(snapshot.Quantile(quantile), summary.min_seconds, summary.max_seconds);
+    };
+    summary.p50_seconds = get_quantile_seconds(0.5);
+    summary.p90_seconds = get_quantile_seconds(0.9);
+    summary.p99_seconds = get_quantile_seconds(0.99);
+    summary.p999_seconds = get_quantile_seconds(0.999);
+    return summary;
+}
+
+void StageLatencyHistogram::Reset() {
+    quantile_histogram.Clear();
+    count.store(0, std::memory_order_relaxed);
+    total_ns.store(0, std::memory_order_relaxed);
+    min_ns.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    max_ns.store(0, std::memory_order_relaxed);
+}
+
+// === PipelineStageTelemetry ===
+
+void PipelineStageTelemetry::Record(PipelineStage stage, std::chrono::steady_clock::duration duration) {
+    const auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    histograms[static_cast<int>(stage)].Record(duration_ns > 0 ? static_cast<uint64_t>(duration_ns) : 0);
+}
+
+PipelineStageTelemetrySnapshot PipelineStageTelemetry::Snapshot() const {
+    PipelineStageTelemetrySnapshot snapshot;
+    for (int i_stage = 0; i_stage < kPipelineStageCount; i_stage++) {
+        snapshot.stages[i_stage] = histograms[i_stage].Summarize();
+    }
+    return snapshot;
+}
+
+void PipelineStageTelemetry::Reset() {
+    for (auto& histogram: histograms) {
+        histogram.Reset();
+    }
+}
+
+} // namespace presage::smartspectra::container::pipeline_stage_telemetry
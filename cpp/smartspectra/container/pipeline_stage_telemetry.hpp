@@ -0,0 +1,129 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "latency_histogram.hpp"
+
+namespace presage::smartspectra::container::pipeline_stage_telemetry {
+
+// stages of the container's per-frame hot path
+enum class PipelineStage : int {
+    Capture,            // grabbing a frame from the video source (foreground container only)
+    ColorConversion,    // BGR->RGB / YUV->RGB / copy into the graph's input frame (fused with the input transform if any)
+    InputTransform,     // stand-alone input transform, e.g. for the pass-through video sink
+    GraphFeed,          // adding the recording state & frame packets to the graph
+    OutputFrameFetch,   // getting the output video frame out of its packet (GetFrameFromPacket)
+    BgrConversion,      // RGB->BGR conversion of the output video frame
+    UserCallback,       // time spent in user-supplied output callbacks
+    Display,            // GUI window & video sink updates (foreground container only)
+    Unknown_EnumEnd
+};
+
+constexpr int kPipelineStageCount = static_cast<int>(PipelineStage::Unknown_EnumEnd);
+
+std::string GetPipelineStageName(PipelineStage stage);
+
+struct StageLatencySummary {
+    uint64_t count = 0;
+    double min_seconds = 0.0;
+    double mean_seconds = 0.0;
+    double p50_seconds = 0.0;
+    double p90_seconds = 0.0;
+    double p99_seconds = 0.0;
+    double p999_seconds = 0.0;
+    double max_seconds = 0.0;
+};
+
+struct PipelineStageTelemetrySnapshot {
+    std::array<StageLatencySummary, kPipelineStageCount> stages{};
+
+    [[nodiscard]] const StageLatencySummary& operator[](PipelineStage stage) const {
+        return stages[static_cast<int>(stage)];
+    }
+};
+
+/**
+ * Lock-free latency histogram of a single stage: quantiles come from a latency_histogram::AtomicLatencyHistogram
+ * (~1.5% relative precision from 1 ns up to ~18 minutes), while count, mean, min & max are tracked exactly.
+ * @details Record may be called concurrently from any thread; Summarize may run concurrently with Record, in which
+ * case it sees a slightly out-of-date, but still consistent-enough, view.
+ */
+class StageLatencyHistogram {
+public:
+    StageLatencyHistogram();
+
+    void Record(uint64_t duration_ns);
+
+    [[nodiscard]] StageLatencySummary Summarize() const;
+
+    void Reset();
+
+    // longer durations are clamped in the quantiles (but not in min, max & mean)
+    static constexpr double kMaxQuantileDurationSeconds = 1100.0;
+    static constexpr double kQuantileRelativePrecision = 0.015;
+
+private:
+    latency_histogram::AtomicLatencyHistogram quantile_histogram;
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> min_ns;
+    std::atomic<uint64_t> max_ns{0};
+};
+
+/**
+ * Per-stage latency histograms, which can be switched on & off at runtime. When off, recording a stage costs a
+ * single relaxed atomic load (no clock reads).
+ */
+class PipelineStageTelemetry {
+public:
+    void SetEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+
+    [[nodiscard]] bool IsEnabled() const { return this->enabled.load(std::memory_order_relaxed); }
+
+    void Record(PipelineStage stage, std::chrono::steady_clock::duration duration);
+
+    [[nodiscard]] PipelineStageTelemetrySnapshot Snapshot() const;
+
+    void Reset();
+
+private:
+    std::atomic<bool> enabled{false};
+    std::array<StageLatencyHistogram, kPipelineStageCount> histograms;
+};
+
+/**
+ * Times the enclosing scope as the given stage, if telemetry is enabled when the timer is created.
+ */
+class ScopedStageTimer {
+public:
+    ScopedStageTimer(PipelineStageTelemetry& telemetry, PipelineStage stage) :
+        telemetry(telemetry), stage(stage), active(telemetry.IsEnabled()) {
+        if (active) start = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedStageTimer() {
+        if (active) telemetry.Record(stage, std::chrono::steady_clock::now() - start);
+    }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    PipelineStageTelemetry& telemetry;
+    const PipelineStage stage;
+    const bool active;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace presage::smartspectra::container::pipeline_stage_telemetry
@@ -0,0 +1,88 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+
+namespace presage::smartspectra::container::ring_buffer {
+
+/**
+ * Fixed-capacity FIFO: pushing onto a full buffer overwrites the oldest element. Not thread-safe.
+ * @details Storage is allocated once, at construction time.
+ * @tparam TElement element type; has to be default-constructible and copy- or move-assignable.
+ */
+template<typename TElement>
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity) : elements(capacity > 0 ? capacity : 1) {}
+
+    /**
+     * @param evicted if the buffer was full, receives the overwritten (oldest) element
+     * @return true if an element had to be evicted to make room
+     */
+    bool PushBack(TElement element, TElement* evicted = nullptr) {
+        const bool full = Full();
+        const size_t back_index = (front_index + count) % elements.size();
+        if (full) {
+            if (evicted != nullptr) *evicted = std::move(elements[back_index]);
+            front_index = (front_index + 1) % elements.size();
+        } else {
+            count++;
+        }
+        elements[back_index] = std::move(element);
+        return full;
+    }
+
+    TElement PopFront() {
+        assert(!Empty());
+        TElement front = std::move(elements[front_index]);
+        front_index = (front_index + 1) % elements.size();
+        count--;
+        return front;
+    }
+
+    [[nodiscard]] const TElement& Front() const {
+        assert(!Empty());
+        return elements[front_index];
+    }
+
+    [[nodiscard]] const TElement& Back() const {
+        assert(!Empty());
+        return elements[(front_index + count - 1) % elements.size()];
+    }
+
+    // i-th element from the front
+    [[nodiscard]] const TElement& operator[](size_t index) const {
+        assert(index < count);
+        return elements[(front_index + index) % elements.size()];
+    }
+
+    void Clear() {
+        front_index = 0;
+        count = 0;
+    }
+
+    [[nodiscard]] size_t Size() const { return count; }
+
+    [[nodiscard]] size_t Capacity() const { return elements.size(); }
+
+    [[nodiscard]] bool Empty() const { return count == 0; }
+
+    [[nodiscard]] bool Full() const { return count == elements.size(); }
+
+private:
+    std::vector<TElement> elements;
+    size_t front_index = 0;
+    size_t count = 0;
+};
+
+} // namespace presage::smartspectra::container::ring_buffer
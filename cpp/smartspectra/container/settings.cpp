@@ -122,6 +122,124 @@ std::vector<std::string> GetVideoSinkModeNames() {
     return names;
 }
 
+bool AbslParseFlag(absl::string_view text, FramePipelineMode* mode, std::string* error) {
+    if (text == "serial" || text == "SERIAL" || text == "Serial") {
+        *mode = FramePipelineMode::Serial;
+        return true;
+    }
+    if (text == "pipelined" || text == "PIPELINED" || text == "Pipelined") {
+        *mode = FramePipelineMode::Pipelined;
+        return true;
+    }
+    if (text == "offline" || text == "OFFLINE" || text == "Offline") {
+        *mode = FramePipelineMode::Offline;
+        return true;
+    }
+    *error = "unknown value for enumeration";
+    return false;
+}
 
+std::string AbslUnparseFlag(FramePipelineMode mode) {
+    switch (mode) {
+        case FramePipelineMode::Serial:
+            return "serial";
+        case FramePipelineMode::Pipelined:
+            return "pipelined";
+        case FramePipelineMode::Offline:
+            return "offline";
+        default:
+            return absl::StrCat(mode);
+    }
+}
+
+std::vector<std::string> GetFramePipelineModeNames() {
+    std::vector<std::string> names;
+    for (int mode = static_cast<int>(FramePipelineMode::Serial);
+         mode < static_cast<int>(FramePipelineMode::Unknown_EnumEnd);
+         ++mode) {
+        names.push_back(AbslUnparseFlag(static_cast<FramePipelineMode>(mode)));
+    }
+    return names;
+}
+
+bool AbslParseFlag(absl::string_view text, FrameDropPolicy* policy, std::string* error) {
+    if (text == "block" || text == "BLOCK" || text == "Block") {
+        *policy = FrameDropPolicy::Block;
+        return true;
+    }
+    if (text == "drop_newest" || text == "DROP_NEWEST" || text == "DropNewest" || text == "newest") {
+        *policy = FrameDropPolicy::DropNewest;
+        return true;
+    }
+    if (text == "drop_oldest" || text == "DROP_OLDEST" || text == "DropOldest" || text == "oldest") {
+        *policy = FrameDropPolicy::DropOldest;
+        return true;
+    }
+    *error = "unknown value for enumeration";
+    return false;
+}
+
+std::string AbslUnparseFlag(FrameDropPolicy policy) {
+    switch (policy) {
+        case FrameDropPolicy::Block:
+            return "block";
+        case FrameDropPolicy::DropNewest:
+            return "drop_newest";
+        case FrameDropPolicy::DropOldest:
+            return "drop_oldest";
+        default:
+            return absl::StrCat(policy);
+    }
+}
+
+std::vector<std::string> GetFrameDropPolicyNames() {
+    std::vector<std::string> names;
+    for (int policy = static_cast<int>(FrameDropPolicy::Block);
+         policy < static_cast<int>(FrameDropPolicy::Unknown_EnumEnd);
+         ++policy) {
+        names.push_back(AbslUnparseFlag(static_cast<FrameDropPolicy>(policy)));
+    }
+    return names;
+}
+
+bool AbslParseFlag(absl::string_view text, BackpressurePolicy* policy, std::string* error) {
+    if (text == "block" || text == "BLOCK" || text == "Block") {
+        *policy = BackpressurePolicy::Block;
+        return true;
+    }
+    if (text == "reject" || text == "REJECT" || text == "Reject") {
+        *policy = BackpressurePolicy::Reject;
+        return true;
+    }
+    if (text == "replace_oldest" || text == "REPLACE_OLDEST" || text == "ReplaceOldest") {
+        *policy = BackpressurePolicy::ReplaceOldest;
+        return true;
+    }
+    *error = "unknown value for enumeration";
+    return false;
+}
+
+std::string AbslUnparseFlag(BackpressurePolicy policy) {
+    switch (policy) {
+        case BackpressurePolicy::Block:
+            return "block";
+        case BackpressurePolicy::Reject:
+            return "reject";
+        case BackpressurePolicy::ReplaceOldest:
+            return "replace_oldest";
+        default:
+            return absl::StrCat(policy);
+    }
+}
+
+std::vector<std::string> GetBackpressurePolicyNames() {
+    std::vector<std::string> names;
+    for (int policy = static_cast<int>(BackpressurePolicy::Block);
+         policy < static_cast<int>(BackpressurePolicy::Unknown_EnumEnd);
+         ++policy) {
+        names.push_back(AbslUnparseFlag(static_cast<BackpressurePolicy>(policy)));
+    }
+    return names;
+}
 
 } // namespace presage::smartspectra::container::settings
@@ -114,6 +114,100 @@ struct VideoSinkSettings {
     bool passthrough;
 };
 // endregion ===========================================================================================================
+// region =============================== Frame Pipeline Settings ======================================================
+enum class FramePipelineMode : int {
+    // capture, graph feed, and output handling / display all run one after another on the calling thread
+    Serial,
+    // capture, graph feed, and output handling / display run as separate stages (threads),
+    // connected via bounded single-producer / single-consumer queues
+    Pipelined,
+    // video-file input only: frames are fed as fast as the graph finishes them (no wall-clock pacing, no drops)
+    Offline,
+    Unknown_EnumEnd
+};
+std::vector<std::string> GetFramePipelineModeNames();
+bool AbslParseFlag(absl::string_view text, FramePipelineMode* mode, std::string* error);
+std::string AbslUnparseFlag(FramePipelineMode mode);
+
+enum class FrameDropPolicy : int {
+    // producing stage waits for room in the queue (lossless, but a slow downstream stage stalls capture)
+    Block,
+    // incoming frame is discarded when the queue is full
+    DropNewest,
+    // only the most recent frame is kept: a new frame replaces the one the consuming stage hasn't taken yet
+    DropOldest,
+    Unknown_EnumEnd
+};
+std::vector<std::string> GetFrameDropPolicyNames();
+bool AbslParseFlag(absl::string_view text, FrameDropPolicy* policy, std::string* error);
+std::string AbslUnparseFlag(FrameDropPolicy policy);
+
+struct FramePipelineSettings {
+    FramePipelineMode mode = FramePipelineMode::Serial;
+    // capacity of each inter-stage queue, in frames (pipelined mode); maximum number of frames in the graph at once
+    // (offline mode)
+    int queue_depth = 2;
+    // what to do when an inter-stage queue is full (only used in pipelined mode)
+    FrameDropPolicy drop_policy = FrameDropPolicy::DropOldest;
+};
+// endregion ===========================================================================================================
+// region =============================== Frame Input Settings =========================================================
+enum class BackpressurePolicy : int {
+    // caller waits until a frame in flight has made it through the graph
+    Block,
+    // frame is rejected with an absl::ResourceExhaustedError status
+    Reject,
+    // frame is held back as pending (replacing any older pending frame) and fed by the first frame-adding call (or
+    // WaitUntilGraphIsIdle) after a slot frees up
+    ReplaceOldest,
+    Unknown_EnumEnd
+};
+std::vector<std::string> GetBackpressurePolicyNames();
+bool AbslParseFlag(absl::string_view text, BackpressurePolicy* policy, std::string* error);
+std::string AbslUnparseFlag(BackpressurePolicy policy);
+
+struct FrameInputSettings {
+    // maximum number of frames added to the graph, but not yet reported on the frame-sent-through stream;
+    // 0 or less means no limit
+    int max_frames_in_flight = 0;
+    // what to do with a new frame when max_frames_in_flight is reached
+    BackpressurePolicy backpressure_policy = BackpressurePolicy::Block;
+};
+// endregion ===========================================================================================================
+// region =============================== Telemetry Settings ===========================================================
+struct TelemetrySettings {
+    // length of the sliding window over which effective core throughput & latency are computed, in milliseconds
+    int core_performance_window_ms = 3000;
+    // record per-stage latency histograms of the frame hot path; can also be toggled at runtime
+    bool enable_pipeline_stage_telemetry = false;
+    // how often the pipeline stage telemetry callback (if set) gets invoked, in milliseconds
+    int pipeline_stage_report_interval_ms = 1000;
+    // record a per-frame timeline of trace events (see Container::FlushFrameTrace); can also be toggled at runtime
+    bool enable_frame_tracing = false;
+    // maximum number of buffered trace events; the oldest ones get overwritten
+    size_t frame_trace_capacity = 65536;
+    // if not empty, the frame trace is written here (as Chrome trace-event JSON) when the graph is stopped; if the trace
+    // was flushed to this path before, the file name gets numbered instead (see FrameTracer::Flush)
+    std::string frame_trace_output_path;
+    // duration (in input frame time) of the windows over which frame drops are aggregated, in milliseconds
+    int frame_accounting_window_ms = 5000;
+};
+// endregion ===========================================================================================================
+// region =============================== Graph Profiler Settings ==========================================================
+// MediaPipe's calculator-level profiler, injected into the graph config as its profiler_config
+struct GraphProfilerSettings {
+    bool enable = false;
+    // width of each bucket of the per-calculator timing histograms, in microseconds
+    int64_t histogram_interval_size_μs = 1000;
+    // number of buckets of the per-calculator timing histograms (the last one collects everything beyond)
+    int64_t histogram_interval_count = 100;
+    // if not empty, MediaPipe's trace logs are written using this path prefix
+    // (requires MediaPipe built with tracing support, i.e., MEDIAPIPE_PROFILING=1)
+    std::string trace_log_path;
+    // if not empty, the per-calculator timing summary is also written here as JSON when the graph is stopped
+    std::string summary_output_path;
+};
+// endregion ===========================================================================================================
 // region ------------------------------- General Settings -------------------------------------------------------------
 struct GeneralSettings {
     video_source::VideoSourceSettings video_source;
@@ -135,6 +229,10 @@ struct GeneralSettings {
     bool print_graph_contents = false;
     bool log_transfer_timing_info = false;
     int verbosity_level = 0;
+    FramePipelineSettings frame_pipeline; // foreground-container only
+    FrameInputSettings frame_input; // background-container only
+    TelemetrySettings telemetry;
+    GraphProfilerSettings graph_profiler;
 };
 // endregion ===========================================================================================================
 template<OperationMode, IntegrationMode>
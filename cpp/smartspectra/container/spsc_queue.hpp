@@ -0,0 +1,232 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+
+namespace presage::smartspectra::container::spsc_queue {
+
+// spins briefly, then yields, then sleeps, depending on how many times a wait has been retried
+inline void Backoff(int attempt) {
+    constexpr int kSpinAttempts = 64;
+    constexpr int kYieldAttempts = 128;
+    if (attempt < kSpinAttempts) {
+        return;
+    } else if (attempt < kYieldAttempts) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+}
+
+/**
+ * Bounded, lock-free single-producer / single-consumer ring buffer.
+ * @details Exactly one thread may call the Push* methods and exactly one (other) thread may call the Pop* methods.
+ * Slots are pre-allocated at construction time, so steady-state pushing / popping never touches the heap
+ * (aside from whatever the element type itself does on move-assignment).
+ * @tparam TElement element type; has to be default-constructible and move-assignable.
+ */
+template<typename TElement>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) :
+        slots(capacity + 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * Producer-side. Moves the element into the queue, unless the queue is full.
+     * @return true if the element was enqueued, false if the queue was full (element is left untouched).
+     */
+    bool TryPush(TElement&& element) {
+        const size_t current_tail = tail.load(std::memory_order_relaxed);
+        const size_t next_tail = Increment(current_tail);
+        if (next_tail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slots[current_tail] = std::move(element);
+        tail.store(next_tail, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer-side. Moves the oldest element out of the queue, if there is any.
+     * @return true if an element was dequeued, false if the queue was empty.
+     */
+    bool TryPop(TElement& element) {
+        const size_t current_head = head.load(std::memory_order_relaxed);
+        if (current_head == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        element = std::move(slots[current_head]);
+        head.store(Increment(current_head), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer-side. Moves the newest element out of the queue, discarding all older elements.
+     * @param skipped_element_count number of older elements that were discarded
+     * @return true if an element was dequeued, false if the queue was empty.
+     */
+    bool TryPopLatest(TElement& element, size_t& skipped_element_count) {
+        skipped_element_count = 0;
+        if (!TryPop(element)) {
+            return false;
+        }
+        while (TryPop(element)) {
+            skipped_element_count++;
+        }
+        return true;
+    }
+
+    /**
+     * Producer-side. Waits (spinning briefly, then backing off) until there is space in the queue.
+     * @param keep_waiting predicate, queried while waiting; the wait is abandoned as soon as it returns false
+     * @return true if the element was enqueued, false if the wait was abandoned.
+     */
+    template<typename TKeepWaitingPredicate>
+    bool PushWaiting(TElement&& element, TKeepWaitingPredicate&& keep_waiting) {
+        int attempt = 0;
+        while (!TryPush(std::move(element))) {
+            if (!keep_waiting()) {
+                return false;
+            }
+            Backoff(attempt++);
+        }
+        return true;
+    }
+
+    /**
+     * Consumer-side. Waits (spinning briefly, then backing off) until there is an element in the queue.
+     * @param keep_waiting predicate, queried while waiting; the wait is abandoned as soon as it returns false
+     * @return true if an element was dequeued, false if the wait was abandoned.
+     */
+    template<typename TKeepWaitingPredicate>
+    bool PopWaiting(TElement& element, TKeepWaitingPredicate&& keep_waiting) {
+        int attempt = 0;
+        while (!TryPop(element)) {
+            if (!keep_waiting()) {
+                return false;
+            }
+            Backoff(attempt++);
+        }
+        return true;
+    }
+
+    // approximate, unless called from the producer or consumer thread while the other side is idle
+    [[nodiscard]] size_t Size() const {
+        const size_t current_head = head.load(std::memory_order_acquire);
+        const size_t current_tail = tail.load(std::memory_order_acquire);
+        return current_tail >= current_head ? current_tail - current_head
+                                            : slots.size() - current_head + current_tail;
+    }
+
+    [[nodiscard]] bool Empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] size_t Capacity() const { return slots.size() - 1; }
+
+private:
+    [[nodiscard]] size_t Increment(size_t index) const {
+        return index + 1 == slots.size() ? 0 : index + 1;
+    }
+
+    std::vector<TElement> slots;
+    // keep the indices on separate cache lines to avoid false sharing between the producer and consumer
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+/**
+ * Lock-free single-producer / single-consumer hand-off of the latest element only (a triple buffer): pushing never
+ * waits, it replaces the element the consumer hasn't taken yet, if any.
+ * @details Same threading rules as SpscQueue. Each side owns one buffer and the third one is swapped between them, so
+ * no element is ever touched by both threads at once. Buffers are reused, not freed: a replaced element lingers
+ * (moved-from or not) until its buffer is written to again.
+ * @tparam TElement element type; has to be default-constructible and move-assignable.
+ */
+template<typename TElement>
+class SpscLatestSlot {
+public:
+    SpscLatestSlot() = default;
+
+    SpscLatestSlot(const SpscLatestSlot&) = delete;
+    SpscLatestSlot& operator=(const SpscLatestSlot&) = delete;
+
+    /**
+     * Producer-side. Moves the element into the slot.
+     * @return true if this replaced an element the consumer hadn't taken yet (i.e. that element is dropped).
+     */
+    bool Push(TElement&& element) {
+        buffers[producer_buffer_index] = std::move(element);
+        const uint8_t previous_shared_state =
+            shared_state.exchange(producer_buffer_index | kFreshFlag, std::memory_order_acq_rel);
+        producer_buffer_index = previous_shared_state & kBufferIndexMask;
+        return (previous_shared_state & kFreshFlag) != 0;
+    }
+
+    /**
+     * Consumer-side. Moves the latest element out of the slot, if there is a new one since the last pop.
+     * @return true if an element was taken, false if the slot was empty.
+     */
+    bool TryPop(TElement& element) {
+        // only the consumer clears the flag, so it can't go away between this check & the exchange
+        if ((shared_state.load(std::memory_order_acquire) & kFreshFlag) == 0) {
+            return false;
+        }
+        consumer_buffer_index =
+            shared_state.exchange(consumer_buffer_index, std::memory_order_acq_rel) & kBufferIndexMask;
+        element = std::move(buffers[consumer_buffer_index]);
+        return true;
+    }
+
+    /**
+     * Consumer-side. Waits (spinning briefly, then backing off) until there is a new element in the slot.
+     * @param keep_waiting predicate, queried while waiting; the wait is abandoned as soon as it returns false
+     * @return true if an element was taken, false if the wait was abandoned.
+     */
+    template<typename TKeepWaitingPredicate>
+    bool PopWaiting(TElement& element, TKeepWaitingPredicate&& keep_waiting) {
+        int attempt = 0;
+        while (!TryPop(element)) {
+            if (!keep_waiting()) {
+                return false;
+            }
+            Backoff(attempt++);
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool Empty() const {
+        return (shared_state.load(std::memory_order_acquire) & kFreshFlag) == 0;
+    }
+
+private:
+    static constexpr uint8_t kBufferIndexMask = 0b011;
+    // set while the shared buffer holds an element the consumer hasn't taken yet
+    static constexpr uint8_t kFreshFlag = 0b100;
+
+    std::array<TElement, 3> buffers{};
+    // owned by the producer & consumer thread, respectively
+    uint8_t producer_buffer_index = 0;
+    uint8_t consumer_buffer_index = 1;
+    // index of the buffer in between the two, plus kFreshFlag
+    alignas(64) std::atomic<uint8_t> shared_state{2};
+};
+
+} // namespace presage::smartspectra::container::spsc_queue
@@ -0,0 +1,449 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <algorithm>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include "yuv_conversion.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SMARTSPECTRA_YUV_CONVERSION_X86
+#include <immintrin.h>
+#define SMARTSPECTRA_TARGET_SSE41 __attribute__((target("sse4.1"), always_inline)) inline
+#define SMARTSPECTRA_TARGET_AVX2 __attribute__((target("avx2"), always_inline)) inline
+#endif
+
+namespace presage::smartspectra::container::yuv_conversion {
+
+namespace {
+
+// BT.601 limited-range YUV -> RGB, fixed point; identical to the constants used by OpenCV's cvtColor
+constexpr int kShift = 20;
+constexpr int kHalf = 1 << (kShift - 1);
+constexpr int kCoefficientY = 1220542;
+constexpr int kCoefficientUB = 2116026;
+constexpr int kCoefficientUG = -409993;
+constexpr int kCoefficientVG = -852492;
+constexpr int kCoefficientVR = 1673527;
+
+constexpr int kRgbChannelCount = 3;
+// pixels converted per SIMD iteration
+constexpr int kSimdBlockWidth = 16;
+
+/**
+ * Pointers into a single row of source data. Pixel x has luma at y[x * y_step];
+ * pixel pair i shares chroma at u[i * uv_step], v[i * uv_step].
+ */
+struct RowSource {
+    const uint8_t* y;
+    const uint8_t* u;
+    const uint8_t* v;
+    int y_step;
+    int uv_step;
+};
+
+RowSource GetRowSource(const YuvFrameView& frame, int row) {
+    switch (frame.format) {
+        case YuvFormat::Nv12: {
+            const uint8_t* uv = frame.planes[1] + (row / 2) * frame.strides[1];
+            return {frame.planes[0] + row * frame.strides[0], uv, uv + 1, 1, 2};
+        }
+        case YuvFormat::I420:
+            return {
+                frame.planes[0] + row * frame.strides[0],
+                frame.planes[1] + (row / 2) * frame.strides[1],
+                frame.planes[2] + (row / 2) * frame.strides[2],
+                1, 1
+            };
+        case YuvFormat::Yuyv:
+        default: {
+            const uint8_t* packed = frame.planes[0] + row * frame.strides[0];
+            return {packed, packed + 1, packed + 3, 2, 4};
+        }
+    }
+}
+
+inline uint8_t ShiftAndSaturate(int value) {
+    value >>= kShift;
+    return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// converts pixels [x_begin, width) of a row; x_begin & width have to be even
+void ConvertRowScalar(const RowSource& source, uint8_t* destination, int x_begin, int width) {
+    for (int x = x_begin; x < width; x += 2) {
+        const int i_pair = x / 2;
+        const int u = static_cast<int>(source.u[i_pair * source.uv_step]) - 128;
+        const int v = static_cast<int>(source.v[i_pair * source.uv_step]) - 128;
+        const int ruv = kHalf + kCoefficientVR * v;
+        const int guv = kHalf + kCoefficientVG * v + kCoefficientUG * u;
+        const int buv = kHalf + kCoefficientUB * u;
+        for (int i_pixel = 0; i_pixel < 2; i_pixel++) {
+            const int y = std::max(0, static_cast<int>(source.y[(x + i_pixel) * source.y_step]) - 16) * kCoefficientY;
+            uint8_t* rgb = destination + (x + i_pixel) * kRgbChannelCount;
+            rgb[0] = ShiftAndSaturate(y + ruv);
+            rgb[1] = ShiftAndSaturate(y + guv);
+            rgb[2] = ShiftAndSaturate(y + buv);
+        }
+    }
+}
+
+#ifdef SMARTSPECTRA_YUV_CONVERSION_X86
+// byte shuffle masks that interleave 16 R, 16 G, and 16 B bytes into 48 bytes of RGB triplets:
+// output vector [i_output] gathers channel [i_channel] via kInterleaveMasks.masks[i_output][i_channel]
+struct InterleaveMasks {
+    alignas(16) int8_t masks[3][3][16];
+};
+
+constexpr InterleaveMasks MakeInterleaveMasks() {
+    InterleaveMasks interleave_masks{};
+    for (int i_output = 0; i_output < 3; i_output++) {
+        for (int i_channel = 0; i_channel < 3; i_channel++) {
+            for (int i_byte = 0; i_byte < 16; i_byte++) {
+                const int stream_index = 16 * i_output + i_byte;
+                interleave_masks.masks[i_output][i_channel][i_byte] =
+                    stream_index % 3 == i_channel ? static_cast<int8_t>(stream_index / 3) : static_cast<int8_t>(-128);
+            }
+        }
+    }
+    return interleave_masks;
+}
+
+constexpr InterleaveMasks kInterleaveMasks = MakeInterleaveMasks();
+
+SMARTSPECTRA_TARGET_SSE41 __m128i LoadMask(int i_output, int i_channel) {
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(kInterleaveMasks.masks[i_output][i_channel]));
+}
+
+SMARTSPECTRA_TARGET_SSE41 void StoreInterleavedRgb(__m128i r, __m128i g, __m128i b, uint8_t* destination) {
+    for (int i_output = 0; i_output < 3; i_output++) {
+        const __m128i rgb = _mm_or_si128(
+            _mm_or_si128(_mm_shuffle_epi8(r, LoadMask(i_output, 0)), _mm_shuffle_epi8(g, LoadMask(i_output, 1))),
+            _mm_shuffle_epi8(b, LoadMask(i_output, 2))
+        );
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 16 * i_output), rgb);
+    }
+}
+
+/**
+ * Loads 16 luma samples and the 8 chroma pairs that go with them (in the low halves of u & v).
+ */
+template<YuvFormat TFormat>
+SMARTSPECTRA_TARGET_SSE41 void LoadBlock(const RowSource& source, int x, __m128i& y, __m128i& u, __m128i& v) {
+    if constexpr (TFormat == YuvFormat::Nv12) {
+        y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.y + x));
+        const __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.u + x));
+        u = _mm_shuffle_epi8(uv, _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1));
+        v = _mm_shuffle_epi8(uv, _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+    } else if constexpr (TFormat == YuvFormat::I420) {
+        y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.y + x));
+        u = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source.u + x / 2));
+        v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source.v + x / 2));
+    } else {
+        // source.y points at the start of the packed row
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.y + 2 * x));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.y + 2 * x + 16));
+        const __m128i even_bytes = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1);
+        y = _mm_unpacklo_epi64(_mm_shuffle_epi8(first, even_bytes), _mm_shuffle_epi8(second, even_bytes));
+        u = _mm_or_si128(
+            _mm_shuffle_epi8(first, _mm_setr_epi8(1, 5, 9, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+            _mm_shuffle_epi8(second, _mm_setr_epi8(-1, -1, -1, -1, 1, 5, 9, 13, -1, -1, -1, -1, -1, -1, -1, -1))
+        );
+        v = _mm_or_si128(
+            _mm_shuffle_epi8(first, _mm_setr_epi8(3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+            _mm_shuffle_epi8(second, _mm_setr_epi8(-1, -1, -1, -1, 3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1))
+        );
+    }
+}
+
+// y, u, v: 4 x int32 samples (u, v already replicated per pixel); r, g, b: 4 x int32, not yet saturated
+SMARTSPECTRA_TARGET_SSE41 void ConvertQuadSse41(__m128i y, __m128i u, __m128i v, __m128i& r, __m128i& g, __m128i& b) {
+    const __m128i half = _mm_set1_epi32(kHalf);
+    const __m128i chroma_offset = _mm_set1_epi32(128);
+    y = _mm_mullo_epi32(_mm_max_epi32(_mm_sub_epi32(y, _mm_set1_epi32(16)), _mm_setzero_si128()),
+                        _mm_set1_epi32(kCoefficientY));
+    u = _mm_sub_epi32(u, chroma_offset);
+    v = _mm_sub_epi32(v, chroma_offset);
+    const __m128i ruv = _mm_add_epi32(half, _mm_mullo_epi32(v, _mm_set1_epi32(kCoefficientVR)));
+    const __m128i guv = _mm_add_epi32(
+        _mm_add_epi32(half, _mm_mullo_epi32(v, _mm_set1_epi32(kCoefficientVG))),
+        _mm_mullo_epi32(u, _mm_set1_epi32(kCoefficientUG))
+    );
+    const __m128i buv = _mm_add_epi32(half, _mm_mullo_epi32(u, _mm_set1_epi32(kCoefficientUB)));
+    r = _mm_srai_epi32(_mm_add_epi32(y, ruv), kShift);
+    g = _mm_srai_epi32(_mm_add_epi32(y, guv), kShift);
+    b = _mm_srai_epi32(_mm_add_epi32(y, buv), kShift);
+}
+
+template<YuvFormat TFormat>
+__attribute__((target("sse4.1"))) void ConvertRowSse41(const RowSource& source, uint8_t* destination, int width) {
+    int x = 0;
+    for (; x + kSimdBlockWidth <= width; x += kSimdBlockWidth) {
+        __m128i y, u, v;
+        LoadBlock<TFormat>(source, x, y, u, v);
+        const __m128i u_per_pixel = _mm_unpacklo_epi8(u, u);
+        const __m128i v_per_pixel = _mm_unpacklo_epi8(v, v);
+        __m128i r[4], g[4], b[4];
+        ConvertQuadSse41(_mm_cvtepu8_epi32(y), _mm_cvtepu8_epi32(u_per_pixel), _mm_cvtepu8_epi32(v_per_pixel),
+                         r[0], g[0], b[0]);
+        ConvertQuadSse41(_mm_cvtepu8_epi32(_mm_srli_si128(y, 4)), _mm_cvtepu8_epi32(_mm_srli_si128(u_per_pixel, 4)),
+                         _mm_cvtepu8_epi32(_mm_srli_si128(v_per_pixel, 4)), r[1], g[1], b[1]);
+        ConvertQuadSse41(_mm_cvtepu8_epi32(_mm_srli_si128(y, 8)), _mm_cvtepu8_epi32(_mm_srli_si128(u_per_pixel, 8)),
+                         _mm_cvtepu8_epi32(_mm_srli_si128(v_per_pixel, 8)), r[2], g[2], b[2]);
+        ConvertQuadSse41(_mm_cvtepu8_epi32(_mm_srli_si128(y, 12)), _mm_cvtepu8_epi32(_mm_srli_si128(u_per_pixel, 12)),
+                         _mm_cvtepu8_epi32(_mm_srli_si128(v_per_pixel, 12)), r[3], g[3], b[3]);
+        // saturating packs reproduce the clamp to [0, 255]
+        StoreInterleavedRgb(
+            _mm_packus_epi16(_mm_packs_epi32(r[0], r[1]), _mm_packs_epi32(r[2], r[3])),
+            _mm_packus_epi16(_mm_packs_epi32(g[0], g[1]), _mm_packs_epi32(g[2], g[3])),
+            _mm_packus_epi16(_mm_packs_epi32(b[0], b[1]), _mm_packs_epi32(b[2], b[3])),
+            destination + x * kRgbChannelCount
+        );
+    }
+    ConvertRowScalar(source, destination, x, width);
+}
+
+SMARTSPECTRA_TARGET_AVX2 void ConvertOctetAvx2(
+    __m256i y, __m256i u, __m256i v, __m256i& r, __m256i& g, __m256i& b
+) {
+    const __m256i half = _mm256_set1_epi32(kHalf);
+    const __m256i chroma_offset = _mm256_set1_epi32(128);
+    y = _mm256_mullo_epi32(_mm256_max_epi32(_mm256_sub_epi32(y, _mm256_set1_epi32(16)), _mm256_setzero_si256()),
+                           _mm256_set1_epi32(kCoefficientY));
+    u = _mm256_sub_epi32(u, chroma_offset);
+    v = _mm256_sub_epi32(v, chroma_offset);
+    const __m256i ruv = _mm256_add_epi32(half, _mm256_mullo_epi32(v, _mm256_set1_epi32(kCoefficientVR)));
+    const __m256i guv = _mm256_add_epi32(
+        _mm256_add_epi32(half, _mm256_mullo_epi32(v, _mm256_set1_epi32(kCoefficientVG))),
+        _mm256_mullo_epi32(u, _mm256_set1_epi32(kCoefficientUG))
+    );
+    const __m256i buv = _mm256_add_epi32(half, _mm256_mullo_epi32(u, _mm256_set1_epi32(kCoefficientUB)));
+    r = _mm256_srai_epi32(_mm256_add_epi32(y, ruv), kShift);
+    g = _mm256_srai_epi32(_mm256_add_epi32(y, guv), kShift);
+    b = _mm256_srai_epi32(_mm256_add_epi32(y, buv), kShift);
+}
+
+// packs 2 x 8 int32 values into 16 saturated uint8 values, preserving order
+SMARTSPECTRA_TARGET_AVX2 __m128i PackToBytesAvx2(__m256i low, __m256i high) {
+    // packs_epi32 interleaves 128-bit lanes; restore the order before narrowing further
+    const __m256i packed_16 = _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8);
+    return _mm_packus_epi16(_mm256_castsi256_si128(packed_16), _mm256_extracti128_si256(packed_16, 1));
+}
+
+template<YuvFormat TFormat>
+__attribute__((target("avx2"))) void ConvertRowAvx2(const RowSource& source, uint8_t* destination, int width) {
+    int x = 0;
+    for (; x + kSimdBlockWidth <= width; x += kSimdBlockWidth) {
+        __m128i y, u, v;
+        LoadBlock<TFormat>(source, x, y, u, v);
+        const __m128i u_per_pixel = _mm_unpacklo_epi8(u, u);
+        const __m128i v_per_pixel = _mm_unpacklo_epi8(v, v);
+        __m256i r_low, g_low, b_low, r_high, g_high, b_high;
+        ConvertOctetAvx2(_mm256_cvtepu8_epi32(y), _mm256_cvtepu8_epi32(u_per_pixel),
+                         _mm256_cvtepu8_epi32(v_per_pixel), r_low, g_low, b_low);
+        ConvertOctetAvx2(_mm256_cvtepu8_epi32(_mm_srli_si128(y, 8)),
+                         _mm256_cvtepu8_epi32(_mm_srli_si128(u_per_pixel, 8)),
+                         _mm256_cvtepu8_epi32(_mm_srli_si128(v_per_pixel, 8)), r_high, g_high, b_high);
+        StoreInterleavedRgb(
+            PackToBytesAvx2(r_low, r_high), PackToBytesAvx2(g_low, g_high), PackToBytesAvx2(b_low, b_high),
+            destination + x * kRgbChannelCount
+        );
+    }
+    ConvertRowScalar(source, destination, x, width);
+}
+#endif // SMARTSPECTRA_YUV_CONVERSION_X86
+
+typedef void (* RowConverter)(const RowSource& source, uint8_t* destination, int width);
+
+void ConvertRowScalarFromStart(const RowSource& source, uint8_t* destination, int width) {
+    ConvertRowScalar(source, destination, 0, width);
+}
+
+RowConverter GetRowConverter(YuvFormat format, InstructionSet instruction_set) {
+#ifdef SMARTSPECTRA_YUV_CONVERSION_X86
+    switch (instruction_set) {
+        case InstructionSet::Avx2:
+            switch (format) {
+                case YuvFormat::Nv12: return ConvertRowAvx2<YuvFormat::Nv12>;
+                case YuvFormat::I420: return ConvertRowAvx2<YuvFormat::I420>;
+                default: return ConvertRowAvx2<YuvFormat::Yuyv>;
+            }
+        case InstructionSet::Sse41:
+            switch (format) {
+                case YuvFormat::Nv12: return ConvertRowSse41<YuvFormat::Nv12>;
+                case YuvFormat::I420: return ConvertRowSse41<YuvFormat::I420>;
+                default: return ConvertRowSse41<YuvFormat::Yuyv>;
+            }
+        default:
+            break;
+    }
+#endif
+    return ConvertRowScalarFromStart;
+}
+
+InstructionSet DetectBestSupportedInstructionSet() {
+#ifdef SMARTSPECTRA_YUV_CONVERSION_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return InstructionSet::Avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return InstructionSet::Sse41;
+    }
+#endif
+    return InstructionSet::Scalar;
+}
+
+} // anonymous namespace
+
+std::string AbslUnparseFlag(YuvFormat format) {
+    switch (format) {
+        case YuvFormat::Nv12:
+            return "nv12";
+        case YuvFormat::I420:
+            return "i420";
+        case YuvFormat::Yuyv:
+            return "yuyv";
+        default:
+            return "unknown";
+    }
+}
+
+std::string AbslUnparseFlag(InstructionSet instruction_set) {
+    switch (instruction_set) {
+        case InstructionSet::Scalar:
+            return "scalar";
+        case InstructionSet::Sse41:
+            return "sse4.1";
+        case InstructionSet::Avx2:
+            return "avx2";
+        default:
+            return "unknown";
+    }
+}
+
+YuvFrameView YuvFrameView::Nv12(
+    const uint8_t* y, int y_stride, const uint8_t* uv, int uv_stride, int width, int height
+) {
+    return {YuvFormat::Nv12, width, height, {y, uv, nullptr}, {y_stride, uv_stride, 0}};
+}
+
+YuvFrameView YuvFrameView::I420(
+    const uint8_t* y, int y_stride,
+    const uint8_t* u, int u_stride,
+    const uint8_t* v, int v_stride,
+    int width, int height
+) {
+    return {YuvFormat::I420, width, height, {y, u, v}, {y_stride, u_stride, v_stride}};
+}
+
+YuvFrameView YuvFrameView::Yuyv(const uint8_t* yuyv, int stride, int width, int height) {
+    return {YuvFormat::Yuyv, width, height, {yuyv, nullptr, nullptr}, {stride, 0, 0}};
+}
+
+absl::Status ValidateYuvFrame(const YuvFrameView& frame) {
+    if (frame.width <= 0 || frame.height <= 0) {
+        return absl::InvalidArgumentError(
+            "Invalid YUV frame dimensions: " + std::to_string(frame.width) + "x" + std::to_string(frame.height) + "."
+        );
+    }
+    if (frame.width % 2 != 0) {
+        return absl::InvalidArgumentError("YUV frame width has to be even, got " + std::to_string(frame.width) + ".");
+    }
+    int plane_count;
+    // minimum row size, in bytes, for each plane
+    std::array<int, 3> minimum_strides{};
+    switch (frame.format) {
+        case YuvFormat::Nv12:
+            plane_count = 2;
+            minimum_strides = {frame.width, frame.width, 0};
+            break;
+        case YuvFormat::I420:
+            plane_count = 3;
+            minimum_strides = {frame.width, frame.width / 2, frame.width / 2};
+            break;
+        case YuvFormat::Yuyv:
+            plane_count = 1;
+            minimum_strides = {frame.width * 2, 0, 0};
+            break;
+        default:
+            return absl::InvalidArgumentError("Unsupported YUV format.");
+    }
+    if (frame.format != YuvFormat::Yuyv && frame.height % 2 != 0) {
+        return absl::InvalidArgumentError(
+            "4:2:0 YUV frame height has to be even, got " + std::to_string(frame.height) + "."
+        );
+    }
+    for (int i_plane = 0; i_plane < plane_count; i_plane++) {
+        if (frame.planes[i_plane] == nullptr) {
+            return absl::InvalidArgumentError(
+                "Plane " + std::to_string(i_plane) + " of " + AbslUnparseFlag(frame.format) + " frame is null."
+            );
+        }
+        if (frame.strides[i_plane] < minimum_strides[i_plane]) {
+            return absl::InvalidArgumentError(
+                "Stride of plane " + std::to_string(i_plane) + " of " + AbslUnparseFlag(frame.format) +
+                " frame is " + std::to_string(frame.strides[i_plane]) + " bytes, expected at least " +
+                std::to_string(minimum_strides[i_plane]) + "."
+            );
+        }
+    }
+    return absl::OkStatus();
+}
+
+bool IsInstructionSetSupported(InstructionSet instruction_set) {
+    return static_cast<int>(instruction_set) <= static_cast<int>(GetBestSupportedInstructionSet());
+}
+
+InstructionSet GetBestSupportedInstructionSet() {
+    static const InstructionSet best_supported_instruction_set = DetectBestSupportedInstructionSet();
+    return best_supported_instruction_set;
+}
+
+absl::Status ConvertYuvToRgb(const YuvFrameView& source, uint8_t* destination_rgb, int destination_width_step) {
+    return ConvertYuvToRgb(source, destination_rgb, destination_width_step, GetBestSupportedInstructionSet());
+}
+
+absl::Status ConvertYuvToRgb(
+    const YuvFrameView& source,
+    uint8_t* destination_rgb,
+    int destination_width_step,
+    InstructionSet instruction_set
+) {
+    auto status = ValidateYuvFrame(source);
+    if (!status.ok()) {
+        return status;
+    }
+    if (destination_rgb == nullptr) {
+        return absl::InvalidArgumentError("Destination RGB buffer is null.");
+    }
+    if (destination_width_step < source.width * kRgbChannelCount) {
+        return absl::InvalidArgumentError(
+            "Destination width step (" + std::to_string(destination_width_step) +
+            " bytes) is less than a row of RGB pixels (" + std::to_string(source.width * kRgbChannelCount) + " bytes)."
+        );
+    }
+    if (!IsInstructionSetSupported(instruction_set)) {
+        return absl::UnavailableError(
+            "Instruction set " + AbslUnparseFlag(instruction_set) + " is not supported by this CPU."
+        );
+    }
+
+    const RowConverter convert_row = GetRowConverter(source.format, instruction_set);
+    cv::parallel_for_(cv::Range(0, source.height), [&](const cv::Range& rows) {
+        for (int row = rows.start; row < rows.end; row++) {
+            convert_row(
+                GetRowSource(source, row),
+                destination_rgb + static_cast<ptrdiff_t>(row) * destination_width_step,
+                source.width
+            );
+        }
+    });
+    return absl::OkStatus();
+}
+
+} // namespace presage::smartspectra::container::yuv_conversion
@@ -0,0 +1,88 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <array>
+#include <cstdint>
+#include <string>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+// === local includes (if any) ===
+
+namespace presage::smartspectra::container::yuv_conversion {
+
+enum class YuvFormat : int {
+    // full-resolution Y plane, followed by a half-resolution plane of interleaved U/V pairs (4:2:0)
+    Nv12,
+    // full-resolution Y plane, half-resolution U plane, half-resolution V plane (4:2:0)
+    I420,
+    // single packed plane of Y0 U Y1 V macro-pixels (4:2:2)
+    Yuyv,
+    Unknown_EnumEnd
+};
+
+std::string AbslUnparseFlag(YuvFormat format);
+
+/**
+ * Non-owning description of a YUV frame in one of the supported layouts. Use the named constructors.
+ * @details Strides are in bytes. Widths have to be even; for 4:2:0 formats, so do heights.
+ */
+struct YuvFrameView {
+    YuvFormat format = YuvFormat::Unknown_EnumEnd;
+    int width = 0;
+    int height = 0;
+    std::array<const uint8_t*, 3> planes{nullptr, nullptr, nullptr};
+    std::array<int, 3> strides{0, 0, 0};
+
+    static YuvFrameView Nv12(const uint8_t* y, int y_stride, const uint8_t* uv, int uv_stride, int width, int height);
+    static YuvFrameView I420(
+        const uint8_t* y, int y_stride,
+        const uint8_t* u, int u_stride,
+        const uint8_t* v, int v_stride,
+        int width, int height
+    );
+    static YuvFrameView Yuyv(const uint8_t* yuyv, int stride, int width, int height);
+};
+
+absl::Status ValidateYuvFrame(const YuvFrameView& frame);
+
+enum class InstructionSet : int {
+    Scalar,
+    Sse41,
+    Avx2
+};
+
+std::string AbslUnparseFlag(InstructionSet instruction_set);
+
+bool IsInstructionSetSupported(InstructionSet instruction_set);
+
+/**
+ * @return the fastest instruction set supported by the running CPU (detected once, at first call)
+ */
+InstructionSet GetBestSupportedInstructionSet();
+
+/**
+ * Converts a YUV frame to interleaved 8-bit RGB, writing straight into the destination buffer
+ * (e.g. the pixel data of an SRGB ImageFrame).
+ * @details Uses BT.601 limited-range coefficients in the same fixed-point arithmetic as OpenCV's
+ * cv::cvtColor(..., COLOR_YUV2RGB_NV12 / _I420 / _YUYV), so results match it. The row kernel is picked at runtime
+ * based on CPU support (AVX2, SSE4.1, or portable scalar code).
+ * @param destination_width_step destination row stride, in bytes; has to be at least 3 * width
+ */
+absl::Status ConvertYuvToRgb(const YuvFrameView& source, uint8_t* destination_rgb, int destination_width_step);
+
+/**
+ * Same as above, but forces the given instruction set (for testing & benchmarking).
+ */
+absl::Status ConvertYuvToRgb(
+    const YuvFrameView& source,
+    uint8_t* destination_rgb,
+    int destination_width_step,
+    InstructionSet instruction_set
+);
+
+} // namespace presage::smartspectra::container::yuv_conversion
@@ -0,0 +1,141 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <string>
+// === third-party includes (if any) ===
+// @formatter:off
+#ifdef SMARTSPECTRA_HAVE_TURBOJPEG
+#include <turbojpeg.h>
+#else
+#include <mediapipe/framework/port/opencv_imgcodecs_inc.h>
+#include <mediapipe/framework/port/opencv_imgproc_inc.h>
+#endif
+// @formatter:on
+// === local includes (if any) ===
+#include "mjpeg_decoder.hpp"
+
+namespace presage::smartspectra::video_source::mjpeg {
+
+namespace {
+
+bool IsSupportedScaleDenominator(int scale_denominator) {
+    for (int supported_denominator: kScaleDenominators) {
+        if (scale_denominator == supported_denominator) return true;
+    }
+    return false;
+}
+
+#ifndef SMARTSPECTRA_HAVE_TURBOJPEG
+int GetReducedColorReadMode(int scale_denominator) {
+    switch (scale_denominator) {
+        case 2:
+            return cv::IMREAD_REDUCED_COLOR_2;
+        case 4:
+            return cv::IMREAD_REDUCED_COLOR_4;
+        case 8:
+            return cv::IMREAD_REDUCED_COLOR_8;
+        default:
+            return cv::IMREAD_COLOR;
+    }
+}
+#endif
+
+} // anonymous namespace
+
+int ChooseScaleDenominator(const cv::Size& capture_size, const cv::Size& minimum_size) {
+    if (minimum_size.width <= 0 || minimum_size.height <= 0) {
+        return 1;
+    }
+    int chosen_denominator = 1;
+    for (int scale_denominator: kScaleDenominators) {
+        const cv::Size scaled_size = GetScaledSize(capture_size, scale_denominator);
+        if (scaled_size.width >= minimum_size.width && scaled_size.height >= minimum_size.height) {
+            chosen_denominator = scale_denominator;
+        }
+    }
+    return chosen_denominator;
+}
+
+cv::Size GetScaledSize(const cv::Size& size, int scale_denominator) {
+    // same rounding as libjpeg: up
+    return {
+        (size.width + scale_denominator - 1) / scale_denominator,
+        (size.height + scale_denominator - 1) / scale_denominator
+    };
+}
+
+#ifdef SMARTSPECTRA_HAVE_TURBOJPEG
+MjpegDecoder::MjpegDecoder() : turbojpeg_handle(tjInitDecompress()) {}
+
+MjpegDecoder::~MjpegDecoder() {
+    if (this->turbojpeg_handle != nullptr) {
+        tjDestroy(this->turbojpeg_handle);
+    }
+}
+
+absl::Status MjpegDecoder::Decode(
+    const uint8_t* data,
+    size_t size,
+    int scale_denominator,
+    FrameChannelOrder channel_order,
+    cv::Mat& frame
+) {
+    if (!IsSupportedScaleDenominator(scale_denominator)) {
+        return absl::InvalidArgumentError("Unsupported JPEG scale: 1/" + std::to_string(scale_denominator));
+    }
+    if (this->turbojpeg_handle == nullptr) {
+        return absl::InternalError(std::string("Could not initialize TurboJPEG: ") + tjGetErrorStr2(nullptr));
+    }
+    int width, height, subsampling, colorspace;
+    if (tjDecompressHeader3(
+        this->turbojpeg_handle, data, static_cast<unsigned long>(size), &width, &height, &subsampling, &colorspace
+    ) != 0) {
+        return absl::InvalidArgumentError(
+            std::string("Could not read JPEG header: ") + tjGetErrorStr2(this->turbojpeg_handle)
+        );
+    }
+    const cv::Size scaled_size = GetScaledSize({width, height}, scale_denominator);
+    frame.create(scaled_size, CV_8UC3);
+    // TurboJPEG picks the DCT scaling factor from the requested output dimensions
+    if (tjDecompress2(
+        this->turbojpeg_handle, data, static_cast<unsigned long>(size), frame.data, scaled_size.width,
+        static_cast<int>(frame.step[0]), scaled_size.height,
+        channel_order == FrameChannelOrder::Rgb ? TJPF_RGB : TJPF_BGR, 0
+    ) != 0 && tjGetErrorCode(this->turbojpeg_handle) != TJERR_WARNING) {
+        // warnings (e.g. a truncated frame from a USB hiccup) still leave a usable image
+        return absl::DataLossError(std::string("Could not decode JPEG: ") + tjGetErrorStr2(this->turbojpeg_handle));
+    }
+    return absl::OkStatus();
+}
+#else
+MjpegDecoder::MjpegDecoder() = default;
+
+MjpegDecoder::~MjpegDecoder() = default;
+
+absl::Status MjpegDecoder::Decode(
+    const uint8_t* data,
+    size_t size,
+    int scale_denominator,
+    FrameChannelOrder channel_order,
+    cv::Mat& frame
+) {
+    if (!IsSupportedScaleDenominator(scale_denominator)) {
+        return absl::InvalidArgumentError("Unsupported JPEG scale: 1/" + std::to_string(scale_denominator));
+    }
+    const cv::Mat compressed(1, static_cast<int>(size), CV_8UC1, const_cast<uint8_t*>(data));
+    cv::imdecode(compressed, GetReducedColorReadMode(scale_denominator), &frame);
+    if (frame.empty()) {
+        return absl::DataLossError("Could not decode JPEG.");
+    }
+    if (channel_order == FrameChannelOrder::Rgb) {
+        cv::cvtColor(frame, frame, cv::COLOR_BGR2RGB);
+    }
+    return absl::OkStatus();
+}
+#endif
+
+} // namespace presage::smartspectra::video_source::mjpeg
@@ -0,0 +1,68 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cstddef>
+#include <cstdint>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/video_source/video_source.hpp>
+
+namespace presage::smartspectra::video_source::mjpeg {
+
+// DCT-domain scaling supported by the decoder: output dimensions are the JPEG's, divided by one of these (rounded up)
+constexpr int kScaleDenominators[] = {1, 2, 4, 8};
+
+/**
+ * Picks the coarsest DCT scaling (1/8, 1/4, 1/2) that still yields frames at least as large as the given minimum
+ * size, i.e. the size the frames get scaled to downstream anyway. Minimum sizes that aren't positive turn scaling off.
+ * @return scale denominator, one of kScaleDenominators
+ */
+int ChooseScaleDenominator(const cv::Size& capture_size, const cv::Size& minimum_size);
+
+// dimensions of a frame of the given size decoded at 1 / scale_denominator scale
+cv::Size GetScaledSize(const cv::Size& size, int scale_denominator);
+
+/**
+ * Decodes (M)JPEG frames straight to 8-bit, 3-channel BGR or RGB, optionally downscaled in the DCT domain, which skips
+ * most of the inverse DCT & upsampling work instead of decoding at full resolution and resizing afterwards.
+ * @details Uses libjpeg-turbo's TurboJPEG API when available (SMARTSPECTRA_HAVE_TURBOJPEG), and OpenCV's reduced-size
+ * decoding followed by a channel swap (for RGB) otherwise. Not thread-safe; use one decoder per thread.
+ */
+class MjpegDecoder {
+public:
+    MjpegDecoder();
+
+    ~MjpegDecoder();
+
+    MjpegDecoder(const MjpegDecoder&) = delete;
+
+    MjpegDecoder& operator=(const MjpegDecoder&) = delete;
+
+    /**
+     * @param data compressed frame, e.g. a driver buffer (read only)
+     * @param size size of the compressed frame, in bytes
+     * @param scale_denominator one of kScaleDenominators
+     * @param channel_order channel order of the decoded frame
+     * @param frame decoded frame; reallocated only if it doesn't have the decoded size & type already
+     */
+    absl::Status Decode(
+        const uint8_t* data,
+        size_t size,
+        int scale_denominator,
+        FrameChannelOrder channel_order,
+        cv::Mat& frame
+    );
+
+private:
+    // tjhandle, when decoding with TurboJPEG
+    void* turbojpeg_handle = nullptr;
+};
+
+} // namespace presage::smartspectra::video_source::mjpeg
@@ -0,0 +1,344 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <utility>
+// === third-party includes (if any) ===
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <mediapipe/framework/port/logging.h>
+#include <mediapipe/framework/port/opencv_imgproc_inc.h>
+#include <mediapipe/framework/port/status_macros.h>
+// === local includes (if any) ===
+#include "v4l2_streaming_video_source.hpp"
+
+namespace presage::smartspectra::video_source::v4l2 {
+
+namespace {
+
+constexpr int kDefaultCaptureWidth = 1280;
+constexpr int kDefaultCaptureHeight = 720;
+constexpr int kMinimumBufferCount = 2;
+
+// retries ioctl calls interrupted by signals
+int IoctlRetryingOnInterrupt(V4l2Device& device, int file_descriptor, unsigned long request, void* argument) {
+    int result;
+    do {
+        result = device.Ioctl(file_descriptor, request, argument);
+    } while (result == -1 && errno == EINTR);
+    return result;
+}
+
+absl::Status IoctlError(const std::string& request_name) {
+    return absl::UnavailableError(request_name + " failed: " + std::strerror(errno));
+}
+
+int64_t GetClockMicroseconds(clockid_t clock_id) {
+    timespec time{};
+    clock_gettime(clock_id, &time);
+    return static_cast<int64_t>(time.tv_sec) * 1'000'000 + time.tv_nsec / 1'000;
+}
+
+} // anonymous namespace
+
+// region ======================================== system device =======================================================
+int SystemV4l2Device::Open(const std::string& path, int flags) {
+    return open(path.c_str(), flags);
+}
+
+int SystemV4l2Device::Close(int file_descriptor) {
+    return close(file_descriptor);
+}
+
+int SystemV4l2Device::Ioctl(int file_descriptor, unsigned long request, void* argument) {
+    return ioctl(file_descriptor, request, argument);
+}
+
+void* SystemV4l2Device::MemoryMap(size_t length, int protection, int flags, int file_descriptor, off_t offset) {
+    return mmap(nullptr, length, protection, flags, file_descriptor, offset);
+}
+
+int SystemV4l2Device::MemoryUnmap(void* address, size_t length) {
+    return munmap(address, length);
+}
+// endregion ===========================================================================================================
+
+V4l2StreamingVideoSource::V4l2StreamingVideoSource(std::shared_ptr<V4l2Device> device) : device(std::move(device)) {}
+
+V4l2StreamingVideoSource::~V4l2StreamingVideoSource() {
+    this->StopStreaming();
+}
+
+absl::Status V4l2StreamingVideoSource::Initialize(const VideoSourceSettings& settings) {
+    MP_RETURN_IF_ERROR(VideoSource::Initialize(settings));
+    const std::string device_path = "/dev/video" + std::to_string(settings.device_index);
+    this->file_descriptor = this->device->Open(device_path, O_RDWR);
+    if (this->file_descriptor == -1) {
+        return absl::NotFoundError("Failed to open video device at " + device_path + ": " + std::strerror(errno));
+    }
+
+    v4l2_capability capability{};
+    if (IoctlRetryingOnInterrupt(*this->device, this->file_descriptor, VIDIOC_QUERYCAP, &capability) == -1) {
+        return IoctlError("VIDIOC_QUERYCAP");
+    }
+    const uint32_t capabilities =
+        (capability.capabilities & V4L2_CAP_DEVICE_CAPS) ? capability.device_caps : capability.capabilities;
+    if (!(capabilities & V4L2_CAP_VIDEO_CAPTURE) || !(capabilities & V4L2_CAP_STREAMING)) {
+        return absl::FailedPreconditionError(
+            device_path + " (" + reinterpret_cast<const char*>(capability.card) +
+            ") does not support video capture with streaming I/O."
+        );
+    }
+    LOG(INFO) << "Camera name: " << reinterpret_cast<const char*>(capability.card);
+
+    MP_RETURN_IF_ERROR(this->SetFormat(settings));
+    MP_RETURN_IF_ERROR(this->MapBuffers(settings.v4l2_buffer_count));
+    return this->StartStreaming();
+}
+
+absl::Status V4l2StreamingVideoSource::SetFormat(const VideoSourceSettings& settings) {
+    int requested_width = kDefaultCaptureWidth;
+    int requested_height = kDefaultCaptureHeight;
+    if (settings.resolution_selection_mode == ResolutionSelectionMode::Range) {
+        LOG(WARNING) << "Native V4L2 capture does not support range resolution selection. Requesting "
+                     << requested_width << "x" << requested_height << " instead.";
+    } else if (settings.resolution_selection_mode == ResolutionSelectionMode::Exact ||
+               (settings.capture_width_px > 0 && settings.capture_height_px > 0)) {
+        requested_width = settings.capture_width_px;
+        requested_height = settings.capture_height_px;
+    }
+    if (requested_width <= 0 || requested_height <= 0) {
+        return absl::FailedPreconditionError(
+            "Both `capture_width_px` and `capture_height_px` must be set to positive, nonzero values when using "
+            "the `exact` resolution selection mode. Got: " + std::to_string(requested_width) + " x " +
+            std::to_string(requested_height) + "."
+        );
+    }
+
+    v4l2_format format{};
+    format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    format.fmt.pix.width = requested_width;
+    format.fmt.pix.height = requested_height;
+    format.fmt.pix.pixelformat = settings.codec == camera::CaptureCodec::UYVY ? V4L2_PIX_FMT_UYVY : V4L2_PIX_FMT_MJPEG;
+    format.fmt.pix.field = V4L2_FIELD_NONE;
+    if (IoctlRetryingOnInterrupt(*this->device, this->file_descriptor, VIDIOC_S_FMT, &format) == -1) {
+        return IoctlError("VIDIOC_S_FMT");
+    }
+    if (format.fmt.pix.pixelformat != V4L2_PIX_FMT_UYVY && format.fmt.pix.pixelformat != V4L2_PIX_FMT_MJPEG) {
+        return absl::FailedPreconditionError(
+            "The camera does not support the " + camera::AbslUnparseFlag(settings.codec) + " codec."
+        );
+    }
+    this->pixel_format = format.fmt.pix.pixelformat;
+    this->bytes_per_line = format.fmt.pix.bytesperline;
+    const cv::Size capture_size(static_cast<int>(format.fmt.pix.width), static_cast<int>(format.fmt.pix.height));
+    LOG(INFO) << "Camera set to resolution: " << capture_size.width << " x " << capture_size.height;
+    if (this->pixel_format == V4L2_PIX_FMT_MJPEG) {
+        this->mjpeg_scale_denominator = mjpeg::ChooseScaleDenominator(
+            capture_size, {settings.mjpeg_decode_min_width_px, settings.mjpeg_decode_min_height_px}
+        );
+    }
+    const cv::Size frame_size = mjpeg::GetScaledSize(capture_size, this->mjpeg_scale_denominator);
+    if (this->mjpeg_scale_denominator > 1) {
+        LOG(INFO) << "Decoding MJPEG frames at 1/" << this->mjpeg_scale_denominator << " scale: " << frame_size.width
+                  << " x " << frame_size.height;
+    }
+    this->width = frame_size.width;
+    this->height = frame_size.height;
+    return absl::OkStatus();
+}
+
+absl::Status V4l2StreamingVideoSource::MapBuffers(int requested_buffer_count) {
+    v4l2_requestbuffers request{};
+    request.count = std::max(requested_buffer_count, kMinimumBufferCount);
+    request.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    request.memory = V4L2_MEMORY_MMAP;
+    if (IoctlRetryingOnInterrupt(*this->device, this->file_descriptor, VIDIOC_REQBUFS, &request) == -1) {
+        return IoctlError("VIDIOC_REQBUFS");
+    }
+    if (request.count < static_cast<uint32_t>(kMinimumBufferCount)) {
+        return absl::ResourceExhaustedError(
+            "The camera driver allocated only " + std::to_string(request.count) + " capture buffer(s)."
+        );
+    }
+    LOG(INFO) << "V4L2 capture queue depth: " << request.count << " buffers (requested " << requested_buffer_count
+              << ").";
+
+    for (uint32_t i_buffer = 0; i_buffer < request.count; i_buffer++) {
+        v4l2_buffer buffer{};
+        buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buffer.memory = V4L2_MEMORY_MMAP;
+        buffer.index = i_buffer;
+        if (IoctlRetryingOnInterrupt(*this->device, this->file_descriptor, VIDIOC_QUERYBUF, &buffer) == -1) {
+            return IoctlError("VIDIOC_QUERYBUF");
+        }
+        void* start = this->device->MemoryMap(
+            buffer.length, PROT_READ | PROT_WRITE, MAP_SHARED, this->file_descriptor, buffer.m.offset
+        );
+        if (start == MAP_FAILED) {
+            return absl::ResourceExhaustedError(std::string("Failed to map capture buffer: ") + std::strerror(errno));
+        }
+        this->buffers.push_back({start, buffer.length});
+    }
+    return absl::OkStatus();
+}
+
+absl::Status V4l2StreamingVideoSource::StartStreaming() {
+    for (uint32_t i_buffer = 0; i_buffer < this->buffers.size(); i_buffer++) {
+        v4l2_buffer buffer{};
+        buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buffer.memory = V4L2_MEMORY_MMAP;
+        buffer.index = i_buffer;
+        if (IoctlRetryingOnInterrupt(*this->device, this->file_descriptor, VIDIOC_QBUF, &buffer) == -1) {
+            return IoctlError("VIDIOC_QBUF");
+        }
+    }
+    v4l2_buf_type buffer_type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (IoctlRetryingOnInterrupt(*this->device, this->file_descriptor, VIDIOC_STREAMON, &buffer_type) == -1) {
+        return IoctlError("VIDIOC_STREAMON");
+    }
+    this->streaming = true;
+    return absl::OkStatus();
+}
+
+void V4l2StreamingVideoSource::StopStreaming() {
+    if (this->file_descriptor == -1) {
+        return;
+    }
+    if (this->streaming) {
+        v4l2_buf_type buffer_type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        IoctlRetryingOnInterrupt(*this->device, this->file_descriptor, VIDIOC_STREAMOFF, &buffer_type);
+        this->streaming = false;
+    }
+    for (const auto& buffer: this->buffers) {
+        this->device->MemoryUnmap(buffer.start, buffer.length);
+    }
+    if (!this->buffers.empty()) {
+        // release the driver's buffers
+        v4l2_requestbuffers request{};
+        request.count = 0;
+        request.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        request.memory = V4L2_MEMORY_MMAP;
+        IoctlRetryingOnInterrupt(*this->device, this->file_descriptor, VIDIOC_REQBUFS, &request);
+        this->buffers.clear();
+    }
+    this->device->Close(this->file_descriptor);
+    this->file_descriptor = -1;
+}
+
+int64_t V4l2StreamingVideoSource::ConvertDriverTimestamp(int64_t driver_timestamp_μs, uint32_t buffer_flags) {
+    if ((buffer_flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) != V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+        // the driver doesn't say what its timestamps mean; fall back to wall time at dequeue
+        return GetClockMicroseconds(CLOCK_REALTIME);
+    }
+    if (!this->monotonic_to_epoch_offset_set) {
+        this->monotonic_to_epoch_offset_μs =
+            GetClockMicroseconds(CLOCK_REALTIME) - GetClockMicroseconds(CLOCK_MONOTONIC);
+        this->monotonic_to_epoch_offset_set = true;
+    }
+    return driver_timestamp_μs + this->monotonic_to_epoch_offset_μs;
+}
+
+void V4l2StreamingVideoSource::ProducePreTransformFrame(cv::Mat& frame) {
+    while (this->streaming) {
+        v4l2_buffer buffer{};
+        buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buffer.memory = V4L2_MEMORY_MMAP;
+        if (IoctlRetryingOnInterrupt(*this->device, this->file_descriptor, VIDIOC_DQBUF, &buffer) == -1) {
+            LOG(ERROR) << IoctlError("VIDIOC_DQBUF").message() << " Ending the stream.";
+            break;
+        }
+        if (buffer.index >= this->buffers.size()) {
+            LOG(ERROR) << "VIDIOC_DQBUF returned buffer index " << buffer.index << ", but only "
+                       << this->buffers.size() << " buffers are mapped. Ending the stream.";
+            break;
+        }
+        const MappedBuffer& mapped_buffer = this->buffers[buffer.index];
+        bool frame_corrupt = (buffer.flags & V4L2_BUF_FLAG_ERROR) != 0 || buffer.bytesused == 0;
+        if (!frame_corrupt && this->pixel_format == V4L2_PIX_FMT_UYVY) {
+            // a truncated frame would get read past the data the driver filled in
+            const size_t frame_byte_count =
+                (this->bytes_per_line > 0 ? this->bytes_per_line : static_cast<size_t>(this->width) * 2) *
+                this->height;
+            if (buffer.bytesused < frame_byte_count || mapped_buffer.length < frame_byte_count) {
+                LOG(WARNING) << "Camera delivered a UYVY frame of " << buffer.bytesused << " bytes, "
+                             << frame_byte_count << " expected.";
+                frame_corrupt = true;
+            }
+        }
+        if (!frame_corrupt) {
+            // decode / convert straight out of the driver's buffer, which goes back into the queue right after
+            const bool rgb = this->frame_channel_order == FrameChannelOrder::Rgb;
+            if (this->pixel_format == V4L2_PIX_FMT_UYVY) {
+                const cv::Mat uyvy(
+                    this->height, this->width, CV_8UC2, mapped_buffer.start,
+                    this->bytes_per_line > 0 ? this->bytes_per_line : cv::Mat::AUTO_STEP
+                );
+                cv::cvtColor(uyvy, frame, rgb ? cv::COLOR_YUV2RGB_UYVY : cv::COLOR_YUV2BGR_UYVY);
+            } else {
+                auto decode_status = this->mjpeg_decoder.Decode(
+                    static_cast<const uint8_t*>(mapped_buffer.start), buffer.bytesused, this->mjpeg_scale_denominator,
+                    this->frame_channel_order, frame
+                );
+                if (!decode_status.ok()) {
+                    LOG(WARNING) << decode_status.message();
+                    frame_corrupt = true;
+                }
+            }
+            this->frame_timestamp = this->ConvertDriverTimestamp(
+                static_cast<int64_t>(buffer.timestamp.tv_sec) * 1'000'000 + buffer.timestamp.tv_usec, buffer.flags
+            );
+        }
+        if (IoctlRetryingOnInterrupt(*this->device, this->file_descriptor, VIDIOC_QBUF, &buffer) == -1) {
+            LOG(ERROR) << IoctlError("VIDIOC_QBUF").message();
+        }
+        if (!frame_corrupt && !frame.empty()) {
+            return;
+        }
+        LOG(WARNING) << "Dropped a corrupt frame from the camera.";
+    }
+    // signals the end of the stream
+    frame = cv::Mat();
+}
+
+bool V4l2StreamingVideoSource::SupportsExactFrameTimestamp() const {
+    return true;
+}
+
+int64_t V4l2StreamingVideoSource::GetFrameTimestamp() const {
+    return this->frame_timestamp;
+}
+
+int V4l2StreamingVideoSource::GetWidth() {
+    return this->width;
+}
+
+int V4l2StreamingVideoSource::GetHeight() {
+    return this->height;
+}
+
+InputTransformMode V4l2StreamingVideoSource::GetDefaultInputTransformMode() {
+    return InputTransformMode::MirrorHorizontal;
+}
+
+absl::Status V4l2StreamingVideoSource::SetFrameChannelOrder(FrameChannelOrder order) {
+    // both the MJPEG decoder & the UYVY conversion produce either order directly
+    this->frame_channel_order = order;
+    return absl::OkStatus();
+}
+
+int V4l2StreamingVideoSource::GetBufferCount() const {
+    return static_cast<int>(this->buffers.size());
+}
+
+} // namespace presage::smartspectra::video_source::v4l2
@@ -0,0 +1,118 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/video_source/video_source.hpp>
+#include <smartspectra/video_source/settings.hpp>
+#include <smartspectra/video_source/camera/mjpeg_decoder.hpp>
+
+namespace presage::smartspectra::video_source::v4l2 {
+
+/**
+ * The system calls the V4L2 streaming source makes, behind an interface, so that the source can be tested against a
+ * fake device. Same semantics (return values, errno) as the system calls of the same names.
+ */
+class V4l2Device {
+public:
+    virtual ~V4l2Device() = default;
+    virtual int Open(const std::string& path, int flags) = 0;
+    virtual int Close(int file_descriptor) = 0;
+    virtual int Ioctl(int file_descriptor, unsigned long request, void* argument) = 0;
+    virtual void* MemoryMap(size_t length, int protection, int flags, int file_descriptor, off_t offset) = 0;
+    virtual int MemoryUnmap(void* address, size_t length) = 0;
+};
+
+// V4L2 device backed by the actual system calls
+class SystemV4l2Device : public V4l2Device {
+public:
+    int Open(const std::string& path, int flags) override;
+    int Close(int file_descriptor) override;
+    int Ioctl(int file_descriptor, unsigned long request, void* argument) override;
+    void* MemoryMap(size_t length, int protection, int flags, int file_descriptor, off_t offset) override;
+    int MemoryUnmap(void* address, size_t length) override;
+};
+
+/**
+ * Linux camera source that streams straight from the V4L2 driver, bypassing cv::VideoCapture: frames are captured into
+ * a configurable number of mmap'd driver buffers (VIDIOC_REQBUFS / VIDIOC_QBUF / VIDIOC_DQBUF), decoded (MJPG) or
+ * color-converted (UYVY) directly out of the dequeued buffer into the output frame, and stamped with the driver's
+ * capture timestamp (v4l2_buffer.timestamp, converted to microseconds since the Unix epoch). Frames can be produced
+ * as RGB right away (see SetFrameChannelOrder), and MJPEG frames can be downscaled in the DCT domain while decoding
+ * (see VideoSourceSettings::mjpeg_decode_min_width_px & camera/mjpeg_decoder.hpp); GetWidth & GetHeight report the
+ * produced frame size.
+ * @details Fewer buffers mean lower latency (frames wait less in the driver queue), more buffers tolerate longer
+ * processing hiccups without the driver dropping frames. Exposure controls aren't supported (yet). Range resolution
+ * selection isn't supported either: exact resolutions are requested as is, otherwise 1280x720 is requested, and the
+ * driver picks the closest resolution it supports.
+ */
+class V4l2StreamingVideoSource : public VideoSource {
+public:
+    explicit V4l2StreamingVideoSource(std::shared_ptr<V4l2Device> device = std::make_shared<SystemV4l2Device>());
+
+    ~V4l2StreamingVideoSource() override;
+
+    absl::Status Initialize(const VideoSourceSettings& settings) override;
+
+    [[nodiscard]] bool SupportsExactFrameTimestamp() const override;
+
+    [[nodiscard]] int64_t GetFrameTimestamp() const override;
+
+    int GetWidth() override;
+
+    int GetHeight() override;
+
+    InputTransformMode GetDefaultInputTransformMode() override;
+
+    absl::Status SetFrameChannelOrder(FrameChannelOrder order) override;
+
+    // number of buffers the driver actually allocated, which may differ from the requested count
+    [[nodiscard]] int GetBufferCount() const;
+
+protected:
+    void ProducePreTransformFrame(cv::Mat& frame) override;
+
+private:
+    struct MappedBuffer {
+        void* start = nullptr;
+        size_t length = 0;
+    };
+
+    absl::Status SetFormat(const VideoSourceSettings& settings);
+    absl::Status MapBuffers(int requested_buffer_count);
+    absl::Status StartStreaming();
+    void StopStreaming();
+    int64_t ConvertDriverTimestamp(int64_t driver_timestamp_μs, uint32_t buffer_flags);
+
+    std::shared_ptr<V4l2Device> device;
+    int file_descriptor = -1;
+    std::vector<MappedBuffer> buffers;
+    bool streaming = false;
+    uint32_t pixel_format = 0;
+    // produced frame size, i.e. after MJPEG DCT scaling (if any)
+    int width = -1;
+    int height = -1;
+    // row stride of captured UYVY frames, as reported by the driver (rows may be padded); 0: rows aren't padded
+    size_t bytes_per_line = 0;
+    mjpeg::MjpegDecoder mjpeg_decoder;
+    int mjpeg_scale_denominator = 1;
+    int64_t frame_timestamp = 0;
+    // added to monotonic driver timestamps to get Unix epoch time; computed once, when the first frame comes in
+    int64_t monotonic_to_epoch_offset_μs = 0;
+    bool monotonic_to_epoch_offset_set = false;
+};
+
+} // namespace presage::smartspectra::video_source::v4l2
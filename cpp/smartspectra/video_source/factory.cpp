@@ -10,6 +10,11 @@
 #include "factory.hpp"
 #include "camera/capture_video_source.hpp"
 #include "file_stream/file_stream.hpp"
+// @formatter:off
+#ifdef __linux__
+#include "camera/v4l2_streaming_video_source.hpp"
+#endif
+// @formatter:on
 
 namespace presage::smartspectra::video_source {
 
@@ -24,6 +29,10 @@ absl::StatusOr<std::unique_ptr<VideoSource>> BuildVideoSource(const VideoSourceS
         }
     } else if (!settings.file_stream_path.empty()) {
         video_source = std::make_unique<file_stream::FileStreamVideoSource>();
+#ifdef __linux__
+    } else if (settings.use_native_v4l2_capture) {
+        video_source = std::make_unique<v4l2::V4l2StreamingVideoSource>();
+#endif
     } else {
         video_source = std::make_unique<capture::CaptureCameraSource>();
     }
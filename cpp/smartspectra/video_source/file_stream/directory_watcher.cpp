@@ -0,0 +1,113 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+// @formatter:off
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+// @formatter:on
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "directory_watcher.hpp"
+
+namespace presage::smartspectra::video_source::file_stream {
+
+DirectoryWatcher::~DirectoryWatcher() {
+    this->Stop();
+}
+
+bool DirectoryWatcher::IsWatching() const {
+    return this->inotify_file_descriptor >= 0;
+}
+
+#ifdef __linux__
+
+absl::Status DirectoryWatcher::Watch(const std::filesystem::path& directory) {
+    this->Stop();
+    this->inotify_file_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (this->inotify_file_descriptor < 0) {
+        return absl::UnavailableError(std::string("Could not initialize inotify: ") + std::strerror(errno));
+    }
+    if (inotify_add_watch(
+        this->inotify_file_descriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR
+    ) < 0) {
+        const int watch_errno = errno;
+        this->Stop();
+        return absl::UnavailableError(
+            "Could not watch directory " + directory.string() + ": " + std::strerror(watch_errno)
+        );
+    }
+    return absl::OkStatus();
+}
+
+absl::StatusOr<DirectoryEvents> DirectoryWatcher::WaitForEvents(int timeout_ms) {
+    if (!this->IsWatching()) {
+        return absl::FailedPreconditionError("Directory watcher isn't watching any directory.");
+    }
+    DirectoryEvents events;
+    pollfd poll_descriptor{this->inotify_file_descriptor, POLLIN, 0};
+    const int ready_count = poll(&poll_descriptor, 1, timeout_ms);
+    if (ready_count < 0) {
+        if (errno == EINTR) return events;
+        return absl::InternalError(std::string("Could not wait for inotify events: ") + std::strerror(errno));
+    }
+    if (ready_count == 0) {
+        return events;
+    }
+
+    alignas(inotify_event) char buffer[16 * 1024];
+    while (true) {
+        const ssize_t read_size = read(this->inotify_file_descriptor, buffer, sizeof(buffer));
+        if (read_size < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            if (errno == EINTR) continue;
+            return absl::InternalError(std::string("Could not read inotify events: ") + std::strerror(errno));
+        }
+        for (char* position = buffer; position < buffer + read_size;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(position);
+            position += sizeof(inotify_event) + event->len;
+            if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                events.overflowed = true;
+            } else if ((event->mask & IN_IGNORED) != 0) {
+                // watch removed by the kernel, e.g. the directory was deleted or its filesystem unmounted
+                this->Stop();
+                return absl::UnavailableError("Watched directory is gone.");
+            } else if ((event->mask & IN_ISDIR) == 0 && event->len > 0) {
+                events.completed_filenames.emplace_back(event->name);
+            }
+        }
+    }
+    return events;
+}
+
+void DirectoryWatcher::Stop() {
+    if (this->inotify_file_descriptor >= 0) {
+        // closing the descriptor removes its watches as well
+        close(this->inotify_file_descriptor);
+        this->inotify_file_descriptor = -1;
+    }
+}
+
+#else
+
+absl::Status DirectoryWatcher::Watch(const std::filesystem::path& directory) {
+    return absl::UnimplementedError("Directory watching is only supported on Linux.");
+}
+
+absl::StatusOr<DirectoryEvents> DirectoryWatcher::WaitForEvents(int timeout_ms) {
+    return absl::FailedPreconditionError("Directory watcher isn't watching any directory.");
+}
+
+void DirectoryWatcher::Stop() {}
+
+#endif
+
+} // namespace presage::smartspectra::video_source::file_stream
@@ -0,0 +1,59 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <filesystem>
+#include <string>
+#include <vector>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <absl/status/statusor.h>
+// === local includes (if any) ===
+
+namespace presage::smartspectra::video_source::file_stream {
+
+struct DirectoryEvents {
+    // names of files that were written & closed in, or moved into, the directory
+    std::vector<std::string> completed_filenames;
+    // the kernel's event queue overflowed, so some events were lost: rescan the directory to catch up
+    bool overflowed = false;
+};
+
+/**
+ * Watches a directory for files that are done being written to it, via inotify (IN_CLOSE_WRITE & IN_MOVED_TO), so that
+ * file streams can wait for new frames without polling & rescanning the directory. Linux only: elsewhere, Watch
+ * returns an Unimplemented error, and callers are expected to fall back to polling.
+ */
+class DirectoryWatcher {
+public:
+    DirectoryWatcher() = default;
+
+    ~DirectoryWatcher();
+
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+    // Starts watching the directory. Events that happen from this point on get reported by WaitForEvents.
+    absl::Status Watch(const std::filesystem::path& directory);
+
+    [[nodiscard]] bool IsWatching() const;
+
+    /**
+     * Waits until at least one event comes in or the timeout elapses, then returns all events that are in.
+     * @param timeout_ms how long to wait, at most; negative: indefinitely
+     * @return events (possibly none, on timeout); an error if the watch broke, e.g. because the directory got deleted
+     */
+    absl::StatusOr<DirectoryEvents> WaitForEvents(int timeout_ms);
+
+    void Stop();
+
+private:
+    int inotify_file_descriptor = -1;
+};
+
+} // namespace presage::smartspectra::video_source::file_stream
@@ -4,12 +4,17 @@
 //
 
 // === standard library includes (if any) ===
+#include <algorithm>
 #include <exception>
 #include <filesystem>
+#include <limits>
 #include <map>
+#include <optional>
 #include <string>
 #include <thread>
+#include <utility>
 // === third-party includes (if any) ===
+#include <mediapipe/framework/port/logging.h>
 #include <mediapipe/framework/port/status_macros.h>
 #include <physiology/modules/filesystem_absl.h>
 // === local includes (if any) ===
@@ -34,81 +39,125 @@ void FileStreamVideoSource::ProducePreTransformFrame(cv::Mat& frame) {
         this->current_frame_timestamp = this->current_frame_data->first;
         std::this_thread::sleep_for(std::chrono::milliseconds(this->retry_delay_ms));
     } else {
-        bool confirmed_next_frame_or_end_of_stream_written = false;
-
-        while (!confirmed_next_frame_or_end_of_stream_written) {
-            std::map<int64_t, std::filesystem::path> file_paths = this->ScanInputDirectory();
-            int64_t latest_frame_present_timestamp = -1;
-            if (file_paths.empty() || (this->current_frame_timestamp == kTimestampNotYetSet && file_paths.size() == 1)) {
-                // folder empty or only the first frame being written, wait and retry
-                std::this_thread::sleep_for(std::chrono::milliseconds(this->retry_delay_ms));
-            } else {
-                latest_frame_present_timestamp = std::prev(file_paths.end())->first;
-                std::map<int64_t, std::filesystem::path>::iterator frame_data_pair;
-
-                if (this->current_frame_timestamp == kTimestampNotYetSet) {
-                    // just began processing, first frame not guaranteed to have 0 timestamp,
-                    // start with first frame found -- so long as there is more than one frame written
-                    frame_data_pair = file_paths.begin();
-                } else {
-                    frame_data_pair = std::next(file_paths.find(this->current_frame_timestamp));
+        while (true) {
+            if (this->frame_prefetcher != nullptr) {
+                // keep decoding ahead: pick up frames that came in meanwhile
+                this->UpdateFrameIndex(false);
+                this->ScheduleFramePrefetching();
+            }
+            if (this->PopNextFrame(frame)) {
+                return;
+            }
+            if (this->frame_index.IsExhausted()) {
+                // no more frames left, but end_of_stream token:
+                // write empty cv::Mat to signify end of stream, erase the token file.
+                frame = cv::Mat();
+                this->current_frame_timestamp = std::numeric_limits<int64_t>::max();
+                if (this->erase_read_files) {
+                    this->EraseReadFrameFile({});
+                    // erase end-of-stream marker for good measure
+                    std::filesystem::remove(this->end_of_stream_path);
                 }
+                return;
+            }
+            this->UpdateFrameIndex(true);
+        }
+    }
+}
 
-                if (frame_data_pair != file_paths.end()) {
-                    // If we have frames left, it's safe to assume the current one was written entirely
-                    // and can be read. Likewise for end_of_stream token, which is assumed to have been written after all
-                    // the frames (if any).
-                    if (latest_frame_present_timestamp > frame_data_pair->first || end_of_stream_encountered) {
-                        this->current_frame_timestamp = frame_data_pair->first;
-                        frame = cv::imread(frame_data_pair->second.string(), cv::IMREAD_UNCHANGED);
-                        confirmed_next_frame_or_end_of_stream_written = true;
-                    } else {
-                        // need to wait to read current frame.
-                        std::this_thread::sleep_for(std::chrono::milliseconds(this->retry_delay_ms));
-                    }
-                } else if (end_of_stream_encountered) {
-                    // no more frames left, but end_of_stream token:
-                    // write empty cv::Mat to signify end of stream, erase the token file.
-                    frame = cv::Mat();
-                    // have to max out the current timestamp for erasure to work correctly
-                    this->current_frame_timestamp = std::numeric_limits<int64_t>::max();
-                    if (this->erase_read_files) {
-                        // erase end-of-stream marker for good measure
-                        std::filesystem::remove(this->end_of_stream_path);
-                    }
-                    confirmed_next_frame_or_end_of_stream_written = true;
-                } else {
-                    // no frames or end-of-stream token in folder yet
-                    std::this_thread::sleep_for(std::chrono::milliseconds(this->retry_delay_ms));
-                }
+bool FileStreamVideoSource::PopNextFrame(cv::Mat& frame) {
+    if (this->frame_prefetcher != nullptr) {
+        if (!this->frame_prefetcher->HasScheduledFrames()) {
+            return false;
+        }
+        PrefetchedFrame prefetched_frame = this->frame_prefetcher->PopNextFrame();
+        this->current_frame_timestamp = prefetched_frame.timestamp;
+        frame = std::move(prefetched_frame.image);
+        this->EraseReadFrameFile(prefetched_frame.path);
+        // refill the slot right away, so that decoding goes on while the frame is processed
+        this->ScheduleFramePrefetching();
+        return true;
+    }
+    std::optional<FrameIndex::Frame> next_frame = this->frame_index.PopNextReadableFrame();
+    if (!next_frame.has_value()) {
+        return false;
+    }
+    this->current_frame_timestamp = next_frame->timestamp;
+    frame = cv::imread(next_frame->path.string(), cv::IMREAD_UNCHANGED);
+    this->EraseReadFrameFile(next_frame->path);
+    return true;
+}
 
-                if (this->erase_read_files) {
-                    // erase everything up to the current frame
-                    for (auto frame_data_pair = file_paths.begin();
-                         frame_data_pair != file_paths.end() && frame_data_pair->first < this->current_frame_timestamp;
-                         frame_data_pair++) {
-                        std::filesystem::remove(frame_data_pair->second);
-                    }
+void FileStreamVideoSource::ScheduleFramePrefetching() {
+    while (this->frame_prefetcher->CanSchedule()) {
+        std::optional<FrameIndex::Frame> next_frame = this->frame_index.PopNextReadableFrame();
+        if (!next_frame.has_value()) {
+            return;
+        }
+        this->frame_prefetcher->Schedule(std::move(*next_frame));
+    }
+}
+
+void FileStreamVideoSource::UpdateFrameIndex(bool wait) {
+    if (this->directory_watcher.IsWatching()) {
+        auto events = this->directory_watcher.WaitForEvents(wait ? this->retry_delay_ms : 0);
+        if (events.ok()) {
+            for (const std::string& filename: events->completed_filenames) {
+                if (filename == this->end_of_stream_filename) {
+                    this->end_of_stream_encountered = true;
+                    this->frame_index.MarkEndOfStream();
+                } else if (auto timestamp = this->frame_filename_matcher.Match(filename); timestamp.has_value()) {
+                    // the writer is done with the file, so it can be read right away
+                    this->IndexFrameFile(*timestamp, this->directory / filename, true);
                 }
             }
+            if (!events->overflowed) {
+                return;
+            }
+            LOG(WARNING) << "Missed file stream directory events, rescanning " << this->directory << ".";
+        } else {
+            LOG(WARNING) << events.status().message() << " Rescanning " << this->directory
+                         << " for frames from now on.";
         }
+    } else if (wait) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(this->retry_delay_ms));
+    } else {
+        // rescanning isn't worth it when not waiting for frames anyway
+        return;
     }
+    this->IndexScannedFrameFiles(this->ScanInputDirectory());
 }
 
-absl::StatusOr<std::regex> FileStreamVideoSource::BuildFrameFileNameRegex(const std::string& wildcard_filename_mask) {
-    std::regex wildcard_mask_parse("([^0-9]+)?([0-9]+)([^0-9]+)?[.](.+)");
-    std::cmatch match;
-    if (!std::regex_match(wildcard_filename_mask.c_str(), match, wildcard_mask_parse)) {
-        return absl::InvalidArgumentError(
-            "Invalid wildcard filename mask: " + wildcard_filename_mask +
-            ". Expected the filename mask to be in following form: <optional_prefix>0[0...]<optional_postfix>.<extension>"
-        );
+void FileStreamVideoSource::IndexFrameFile(int64_t timestamp, const std::filesystem::path& path, bool known_complete) {
+    // Frames the index turns down were either handed out already (e.g. picked up again by a rescan) or showed up
+    // after later frames were streamed. Only the latter, older than the last frame consumed, are safe to erase here:
+    // the last frame consumed is erased once the next one is, and frames past it may still be waiting to be decoded
+    // in the prefetcher.
+    if (!this->frame_index.Add(timestamp, path, known_complete) && this->erase_read_files &&
+        timestamp < this->current_frame_timestamp) {
+        std::filesystem::remove(path);
+    }
+}
+
+void FileStreamVideoSource::IndexScannedFrameFiles(const std::map<int64_t, std::filesystem::path>& file_paths) {
+    for (const auto& [timestamp, path]: file_paths) {
+        // can't tell whether the writer is done with these (yet)
+        this->IndexFrameFile(timestamp, path, false);
+    }
+    if (this->end_of_stream_encountered) {
+        this->frame_index.MarkEndOfStream();
     }
-    std::string prefix = match[1].str();
-    size_t number_of_digits = match[2].str().size();
-    std::string postfix = match[3].str();
-    std::string extension = match[4].str();
-    return std::regex(prefix + "([0-9]{" + std::to_string(number_of_digits) + "})" + postfix + "[.]" + extension);
+}
+
+void FileStreamVideoSource::EraseReadFrameFile(const std::filesystem::path& path) {
+    if (!this->erase_read_files) {
+        return;
+    }
+    // the previous frame is done with as soon as the next one is read in
+    if (!this->last_read_frame_path.empty()) {
+        std::filesystem::remove(this->last_read_frame_path);
+    }
+    this->last_read_frame_path = path;
 }
 
 bool FileStreamVideoSource::SupportsExactFrameTimestamp() const {
@@ -122,13 +171,14 @@ int64_t FileStreamVideoSource::GetFrameTimestamp() const {
 absl::Status FileStreamVideoSource::Initialize(const VideoSourceSettings& settings) {
     MP_RETURN_IF_ERROR(VideoSource::Initialize(settings));
     MP_ASSIGN_OR_RETURN(
-        this->frame_filename_regex,
-        BuildFrameFileNameRegex(std::filesystem::path(settings.file_stream_path).filename())
+        this->frame_filename_matcher,
+        FrameFilenameMatcher::FromMask(std::filesystem::path(settings.file_stream_path).filename().string())
     );
     this->directory = std::filesystem::path(settings.file_stream_path).parent_path();
     this->end_of_stream_filename = settings.end_of_stream_filename;
     this->retry_delay_ms = settings.rescan_retry_delay_ms;
     this->erase_read_files = settings.erase_read_files;
+    this->watch_directory = settings.watch_file_stream_directory;
     this->end_of_stream_path = this->directory / this->end_of_stream_filename;
     this->loop = settings.loop;
     if (settings.erase_read_files && settings.loop) {
@@ -143,10 +193,24 @@ absl::Status FileStreamVideoSource::Initialize(const VideoSourceSettings& settin
             first_frame_path = this->loop_frame_filenames.begin()->second;
         }
     } else {
+        if (this->watch_directory) {
+            // start watching before the scan, so that files completed in between don't go unnoticed
+            auto watch_status = this->directory_watcher.Watch(this->directory);
+            if (!watch_status.ok()) {
+                LOG(WARNING) << watch_status.message() << " Rescanning " << this->directory << " for frames instead.";
+            }
+        }
         auto file_paths = ScanInputDirectory();
         if (!file_paths.empty()) {
             first_frame_path = file_paths.begin()->second;
         }
+        this->IndexScannedFrameFiles(file_paths);
+        if (settings.file_stream_prefetch_depth > 0) {
+            this->frame_prefetcher = std::make_unique<FramePrefetcher>(
+                settings.file_stream_prefetch_thread_count, settings.file_stream_prefetch_depth,
+                static_cast<size_t>(std::max(settings.file_stream_prefetch_memory_cap_mb, 0)) * 1024 * 1024
+            );
+        }
     }
 
     if (!first_frame_path.empty()) {
@@ -163,20 +227,20 @@ std::map<int64_t, std::filesystem::path> FileStreamVideoSource::ScanInputDirecto
     // Iterate over files in directory,
     // guarantee frame sorting by frame timestamp & check for end of stream token via map
     for (auto const& entry: std::filesystem::directory_iterator{this->directory}) {
-        std::smatch match;
         std::string filename = entry.path().filename().string();
         if (!this->end_of_stream_encountered && filename == this->end_of_stream_filename) {
             this->end_of_stream_encountered = true;
             continue;
         }
-        if (entry.is_regular_file() && std::regex_match(filename, match, this->frame_filename_regex)) {
-            int64_t i_frame = std::stoll(match[1].str());
-            file_paths[i_frame] = entry.path();
+        if (auto timestamp = this->frame_filename_matcher.Match(filename);
+            timestamp.has_value() && entry.is_regular_file()) {
+            file_paths[*timestamp] = entry.path();
         }
     }
     return file_paths;
 }
 
+
 int FileStreamVideoSource::GetWidth() {
     return this->first_frame_width;
 }
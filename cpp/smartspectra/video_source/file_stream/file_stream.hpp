@@ -6,19 +6,31 @@
 #pragma once
 // === standard library includes (if any) ===
 #include <string>
-#include <regex>
 #include <filesystem>
 #include <map>
+#include <memory>
+#include <optional>
 // === third-party includes (if any) ===
 #include <absl/status/statusor.h>
 #include <mediapipe/framework/port/opencv_core_inc.h>
 #include <mediapipe/framework/port/opencv_imgcodecs_inc.h>
 // === local includes (if any) ===
 #include <smartspectra/video_source/video_source.hpp>
+#include <smartspectra/video_source/file_stream/directory_watcher.hpp>
+#include <smartspectra/video_source/file_stream/frame_filename_matcher.hpp>
+#include <smartspectra/video_source/file_stream/frame_index.hpp>
+#include <smartspectra/video_source/file_stream/frame_prefetcher.hpp>
 
 
 namespace presage::smartspectra::video_source::file_stream {
 
+/**
+ * Streams frames from image files written into a directory by another process, in frame timestamp order.
+ * @details Outside of loop mode, the directory is scanned once at startup; after that, new frames (and the
+ * end-of-stream marker) are picked up from directory change notifications (see DirectoryWatcher) and kept in an
+ * incrementally updated FrameIndex. Where notifications aren't available, the directory is rescanned periodically.
+ * Frames that are safe to read are decoded ahead of consumption by a FramePrefetcher (unless prefetching is off).
+ */
 class FileStreamVideoSource : public VideoSource {
 public:
     absl::Status Initialize(const VideoSourceSettings& settings);
@@ -31,26 +43,44 @@ public:
     int GetHeight() override;
 protected:
     void ProducePreTransformFrame(cv::Mat& frame) override;
+
+    // matching frame files in the input directory, keyed (and therefore sorted) by frame timestamp
+    std::map<int64_t, std::filesystem::path> ScanInputDirectory();
+    // (re-)indexes scanned frame files, e.g. after directory change notifications were missed
+    void IndexScannedFrameFiles(const std::map<int64_t, std::filesystem::path>& file_paths);
 private:
     const int64_t kTimestampNotYetSet = -1;
 
-    // static
-    static absl::StatusOr<std::regex> BuildFrameFileNameRegex(const std::string& wildcard_filename_mask);
-
-    std::map<int64_t, std::filesystem::path> ScanInputDirectory();
+    void IndexFrameFile(int64_t timestamp, const std::filesystem::path& path, bool known_complete);
+    /**
+     * Picks up frame files (and the end-of-stream marker) that came in since the last update.
+     * @param wait whether to block until there might be news for the frame index (or a timeout elapses)
+     */
+    void UpdateFrameIndex(bool wait);
+    // hands the frames that are safe to read over to the prefetcher, as far as it has room for them
+    void ScheduleFramePrefetching();
+    // next frame, if there is one that's safe to read (or, with prefetching, scheduled already)
+    bool PopNextFrame(cv::Mat& frame);
+    void EraseReadFrameFile(const std::filesystem::path& path);
 
     // parameters
-    std::regex frame_filename_regex;
+    FrameFilenameMatcher frame_filename_matcher;
     std::filesystem::path directory;
     std::string end_of_stream_filename;
     int retry_delay_ms = 10;
     bool erase_read_files;
     bool loop;
+    bool watch_directory = true;
 
     // state
     int64_t  i_frame = 0;
     int64_t current_frame_timestamp = kTimestampNotYetSet;
     bool end_of_stream_encountered = false;
+    FrameIndex frame_index;
+    DirectoryWatcher directory_watcher;
+    // null when prefetching is off
+    std::unique_ptr<FramePrefetcher> frame_prefetcher;
+    std::filesystem::path last_read_frame_path;
     // only used in loop mode
     std::map<int64_t, std::filesystem::path> loop_frame_filenames;
     std::map<int64_t, std::filesystem::path>::iterator current_frame_data;
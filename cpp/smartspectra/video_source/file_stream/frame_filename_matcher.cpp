@@ -0,0 +1,76 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <charconv>
+#include <system_error>
+#include <utility>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "frame_filename_matcher.hpp"
+
+namespace presage::smartspectra::video_source::file_stream {
+
+namespace {
+
+bool IsDigit(char character) {
+    return character >= '0' && character <= '9';
+}
+
+} // anonymous namespace
+
+FrameFilenameMatcher::FrameFilenameMatcher(std::string prefix, size_t digit_count, std::string suffix)
+    : prefix(std::move(prefix)), digit_count(digit_count), suffix(std::move(suffix)) {}
+
+absl::StatusOr<FrameFilenameMatcher> FrameFilenameMatcher::FromMask(const std::string& wildcard_filename_mask) {
+    const auto invalid_mask_error = absl::InvalidArgumentError(
+        "Invalid wildcard filename mask: " + wildcard_filename_mask +
+        ". Expected the filename mask to be in following form: <optional_prefix>0[0...]<optional_postfix>.<extension>"
+    );
+    const std::string& mask = wildcard_filename_mask;
+    // prefix: everything up to the first digit
+    size_t digits_begin = 0;
+    while (digits_begin < mask.size() && !IsDigit(mask[digits_begin])) digits_begin++;
+    size_t digits_end = digits_begin;
+    while (digits_end < mask.size() && IsDigit(mask[digits_end])) digits_end++;
+    if (digits_begin == digits_end) {
+        return invalid_mask_error;
+    }
+    // postfix: digit-free, up to the last dot within the digit-free stretch that still leaves a non-empty extension
+    size_t postfix_end = digits_end;
+    while (postfix_end < mask.size() && !IsDigit(mask[postfix_end])) postfix_end++;
+    size_t dot = std::string::npos;
+    for (size_t i_character = digits_end; i_character < postfix_end && i_character + 1 < mask.size(); i_character++) {
+        if (mask[i_character] == '.') dot = i_character;
+    }
+    if (dot == std::string::npos) {
+        return invalid_mask_error;
+    }
+    return FrameFilenameMatcher(mask.substr(0, digits_begin), digits_end - digits_begin, mask.substr(digits_end));
+}
+
+std::optional<int64_t> FrameFilenameMatcher::Match(std::string_view filename) const {
+    if (this->digit_count == 0 ||
+        filename.size() != this->prefix.size() + this->digit_count + this->suffix.size() ||
+        filename.compare(0, this->prefix.size(), this->prefix) != 0 ||
+        filename.compare(filename.size() - this->suffix.size(), this->suffix.size(), this->suffix) != 0) {
+        return std::nullopt;
+    }
+    const char* digits_begin = filename.data() + this->prefix.size();
+    const char* digits_end = digits_begin + this->digit_count;
+    for (const char* digit = digits_begin; digit < digits_end; digit++) {
+        // from_chars would accept a leading minus sign
+        if (!IsDigit(*digit)) return std::nullopt;
+    }
+    int64_t timestamp;
+    auto [parse_end, error] = std::from_chars(digits_begin, digits_end, timestamp);
+    if (error != std::errc() || parse_end != digits_end) {
+        return std::nullopt;
+    }
+    return timestamp;
+}
+
+} // namespace presage::smartspectra::video_source::file_stream
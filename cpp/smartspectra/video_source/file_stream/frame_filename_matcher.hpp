@@ -0,0 +1,49 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+// === third-party includes (if any) ===
+#include <absl/status/statusor.h>
+// === local includes (if any) ===
+
+namespace presage::smartspectra::video_source::file_stream {
+
+/**
+ * Matches frame filenames against a file stream's wildcard filename mask, e.g. "frame0000000000000.png", and extracts
+ * the frame timestamp from matching ones.
+ * @details The mask is broken down once, into a fixed prefix, a digit count and a fixed postfix + extension. Matching
+ * then only compares lengths & bytes and parses the digits in place, without regular expressions or allocations.
+ */
+class FrameFilenameMatcher {
+public:
+    // matches nothing
+    FrameFilenameMatcher() = default;
+
+    /**
+     * @param wildcard_filename_mask <optional_prefix>0[0...]<optional_postfix>.<extension>, where the prefix & postfix
+     * contain no digits, and the number of zeros is the number of digits in frame timestamps
+     */
+    static absl::StatusOr<FrameFilenameMatcher> FromMask(const std::string& wildcard_filename_mask);
+
+    // frame timestamp, if the filename matches the mask
+    [[nodiscard]] std::optional<int64_t> Match(std::string_view filename) const;
+
+private:
+    FrameFilenameMatcher(std::string prefix, size_t digit_count, std::string suffix);
+
+    std::string prefix;
+    size_t digit_count = 0;
+    // postfix, dot & extension
+    std::string suffix;
+};
+
+} // namespace presage::smartspectra::video_source::file_stream
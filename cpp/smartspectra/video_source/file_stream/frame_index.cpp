@@ -0,0 +1,59 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <utility>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "frame_index.hpp"
+
+namespace presage::smartspectra::video_source::file_stream {
+
+bool FrameIndex::Add(int64_t timestamp, const std::filesystem::path& path, bool known_complete) {
+    if (timestamp <= this->last_popped_timestamp) {
+        return false;
+    }
+    auto [pending_frame, inserted] = this->pending_frames.try_emplace(timestamp, PendingFrame{path, known_complete});
+    if (!inserted) {
+        // e.g. found by a directory scan first, then reported complete by the writer closing it
+        pending_frame->second.known_complete = pending_frame->second.known_complete || known_complete;
+    }
+    return true;
+}
+
+void FrameIndex::MarkEndOfStream() {
+    this->end_of_stream_marked = true;
+}
+
+bool FrameIndex::IsEndOfStreamMarked() const {
+    return this->end_of_stream_marked;
+}
+
+bool FrameIndex::IsExhausted() const {
+    return this->end_of_stream_marked && this->pending_frames.empty();
+}
+
+std::optional<FrameIndex::Frame> FrameIndex::PopNextReadableFrame() {
+    if (this->pending_frames.empty()) {
+        return std::nullopt;
+    }
+    auto next_frame = this->pending_frames.begin();
+    const bool later_frame_exists = this->pending_frames.size() > 1;
+    if (!next_frame->second.known_complete && !later_frame_exists && !this->end_of_stream_marked) {
+        // might still be being written
+        return std::nullopt;
+    }
+    Frame frame{next_frame->first, std::move(next_frame->second.path)};
+    this->last_popped_timestamp = frame.timestamp;
+    this->pending_frames.erase(next_frame);
+    return frame;
+}
+
+size_t FrameIndex::Size() const {
+    return this->pending_frames.size();
+}
+
+} // namespace presage::smartspectra::video_source::file_stream
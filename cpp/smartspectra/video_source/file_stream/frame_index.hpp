@@ -0,0 +1,64 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <optional>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+
+namespace presage::smartspectra::video_source::file_stream {
+
+/**
+ * Frame files of a file stream that haven't been consumed yet, sorted by frame timestamp and updated incrementally as
+ * files show up, rather than rebuilt from a directory listing for every frame.
+ * @details A frame is safe to read once it is known to be complete: either the writer is done with it (e.g. a
+ * close-after-write or move-into-directory notification came in for it), a later frame exists (writers produce frames
+ * in order), or the end-of-stream marker was seen.
+ */
+class FrameIndex {
+public:
+    struct Frame {
+        int64_t timestamp;
+        std::filesystem::path path;
+    };
+
+    /**
+     * Adds (or updates) a frame file.
+     * @param known_complete whether the file is known to have been written entirely
+     * @return false if the frame isn't newer than the last frame popped, i.e. showed up too late to be streamed
+     */
+    bool Add(int64_t timestamp, const std::filesystem::path& path, bool known_complete);
+
+    void MarkEndOfStream();
+
+    [[nodiscard]] bool IsEndOfStreamMarked() const;
+
+    // true once the end-of-stream marker was seen & every frame before it was popped
+    [[nodiscard]] bool IsExhausted() const;
+
+    // removes & returns the earliest frame if it's safe to read (see class description), nothing otherwise
+    std::optional<Frame> PopNextReadableFrame();
+
+    [[nodiscard]] size_t Size() const;
+
+private:
+    struct PendingFrame {
+        std::filesystem::path path;
+        bool known_complete;
+    };
+
+    std::map<int64_t, PendingFrame> pending_frames;
+    int64_t last_popped_timestamp = std::numeric_limits<int64_t>::min();
+    bool end_of_stream_marked = false;
+};
+
+} // namespace presage::smartspectra::video_source::file_stream
@@ -0,0 +1,141 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <fstream>
+#include <utility>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/opencv_imgcodecs_inc.h>
+// === local includes (if any) ===
+#include "frame_prefetcher.hpp"
+
+namespace presage::smartspectra::video_source::file_stream {
+
+namespace {
+
+constexpr size_t kExtraPooledBufferCount = 4;
+
+bool ReadFileContents(const std::filesystem::path& path, std::vector<uint8_t>& contents) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    const std::streamoff size = file.tellg();
+    if (size <= 0) return false;
+    contents.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(contents.data()), size));
+}
+
+} // anonymous namespace
+
+FramePrefetcher::FramePrefetcher(int thread_count, int depth, size_t memory_cap_bytes)
+    : depth(static_cast<size_t>(std::max(depth, 1))),
+      memory_cap_bytes(memory_cap_bytes),
+      max_pooled_buffer_count(this->depth + kExtraPooledBufferCount) {
+    for (int i_thread = 0; i_thread < std::max(thread_count, 1); i_thread++) {
+        this->workers.emplace_back(&FramePrefetcher::RunWorker, this);
+    }
+}
+
+FramePrefetcher::~FramePrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->frame_pending.notify_all();
+    for (std::thread& worker: this->workers) {
+        worker.join();
+    }
+}
+
+bool FramePrefetcher::CanSchedule() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    const size_t scheduled_frame_count = this->scheduled_frames.size();
+    return scheduled_frame_count < this->depth && (
+        scheduled_frame_count == 0 ||
+        (scheduled_frame_count + 1) * this->largest_frame_byte_count <= this->memory_cap_bytes
+    );
+}
+
+void FramePrefetcher::Schedule(FrameIndex::Frame frame) {
+    auto scheduled_frame = std::make_unique<ScheduledFrame>();
+    scheduled_frame->frame.timestamp = frame.timestamp;
+    scheduled_frame->frame.path = std::move(frame.path);
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->scheduled_frames.push_back(std::move(scheduled_frame));
+    }
+    this->frame_pending.notify_one();
+}
+
+bool FramePrefetcher::HasScheduledFrames() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return !this->scheduled_frames.empty();
+}
+
+PrefetchedFrame FramePrefetcher::PopNextFrame() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->frame_decoded.wait(lock, [this]() {
+        return this->scheduled_frames.front()->state == DecodeState::Decoded;
+    });
+    PrefetchedFrame frame = std::move(this->scheduled_frames.front()->frame);
+    this->scheduled_frames.pop_front();
+    return frame;
+}
+
+void FramePrefetcher::RunWorker() {
+    // compressed file contents, reused from frame to frame
+    std::vector<uint8_t> file_contents;
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true) {
+        ScheduledFrame* scheduled_frame = nullptr;
+        this->frame_pending.wait(lock, [this, &scheduled_frame]() {
+            auto pending_frame = std::find_if(
+                this->scheduled_frames.begin(), this->scheduled_frames.end(),
+                [](const auto& frame) { return frame->state == DecodeState::Pending; }
+            );
+            if (pending_frame != this->scheduled_frames.end()) scheduled_frame = pending_frame->get();
+            return this->stopping || scheduled_frame != nullptr;
+        });
+        if (this->stopping) return;
+        // stays put until handed out, which won't happen before it's decoded
+        scheduled_frame->state = DecodeState::Decoding;
+        cv::Mat image = this->AcquireBuffer();
+        const std::filesystem::path path = scheduled_frame->frame.path;
+        const bool pooled = !image.empty();
+
+        lock.unlock();
+        if (ReadFileContents(path, file_contents)) {
+            // decodes into the recycled buffer when the size & type match
+            cv::imdecode(file_contents, cv::IMREAD_UNCHANGED, &image);
+        } else {
+            image.release();
+        }
+        lock.lock();
+
+        if (!image.empty()) {
+            this->largest_frame_byte_count = std::max(this->largest_frame_byte_count, image.total() * image.elemSize());
+            if (!pooled && this->buffer_pool.size() < this->max_pooled_buffer_count) {
+                this->buffer_pool.push_back(image);
+            }
+        }
+        scheduled_frame->frame.image = std::move(image);
+        scheduled_frame->state = DecodeState::Decoded;
+        this->frame_decoded.notify_all();
+    }
+}
+
+cv::Mat FramePrefetcher::AcquireBuffer() {
+    for (cv::Mat& buffer: this->buffer_pool) {
+        // the pool's own reference is the only one left
+        if (buffer.u != nullptr && buffer.u->refcount == 1) {
+            return buffer;
+        }
+    }
+    return {};
+}
+
+} // namespace presage::smartspectra::video_source::file_stream
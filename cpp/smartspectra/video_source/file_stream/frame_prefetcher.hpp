@@ -0,0 +1,98 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/video_source/file_stream/frame_index.hpp>
+
+namespace presage::smartspectra::video_source::file_stream {
+
+struct PrefetchedFrame {
+    int64_t timestamp;
+    std::filesystem::path path;
+    // empty if the file couldn't be read or decoded
+    cv::Mat image;
+};
+
+/**
+ * Decodes file stream frames ahead of consumption on a small pool of worker threads, so that reading a frame doesn't
+ * wait on the image codec. Frames are handed out in the order they were scheduled, however the decoding interleaves.
+ * @details At most `depth` frames are scheduled (i.e. decoding or decoded, but not handed out yet) at a time, fewer
+ * if that many decoded frames would exceed the memory cap (estimated from the largest frame decoded so far). Decoded
+ * pixel buffers are recycled once whoever they were handed out to lets go of them, as are the workers' file buffers.
+ */
+class FramePrefetcher {
+public:
+    /**
+     * @param thread_count number of decoding threads
+     * @param depth maximum number of frames scheduled ahead of consumption
+     * @param memory_cap_bytes maximum (estimated) memory taken up by scheduled frames; at least one frame is always
+     * allowed, whatever its size
+     */
+    FramePrefetcher(int thread_count, int depth, size_t memory_cap_bytes);
+
+    // waits for frames being decoded, drops the remaining scheduled frames
+    ~FramePrefetcher();
+
+    FramePrefetcher(const FramePrefetcher&) = delete;
+
+    FramePrefetcher& operator=(const FramePrefetcher&) = delete;
+
+    // whether another frame fits within the depth & memory cap
+    [[nodiscard]] bool CanSchedule() const;
+
+    // starts decoding the frame in the background
+    void Schedule(FrameIndex::Frame frame);
+
+    [[nodiscard]] bool HasScheduledFrames() const;
+
+    // blocks until the earliest scheduled frame is decoded, then hands it out; requires HasScheduledFrames()
+    PrefetchedFrame PopNextFrame();
+
+private:
+    enum class DecodeState {
+        Pending,
+        Decoding,
+        Decoded
+    };
+
+    struct ScheduledFrame {
+        PrefetchedFrame frame;
+        DecodeState state = DecodeState::Pending;
+    };
+
+    void RunWorker();
+    // pooled pixel buffer that nobody outside the pool references anymore, or an empty cv::Mat; mutex must be held
+    cv::Mat AcquireBuffer();
+
+    const size_t depth;
+    const size_t memory_cap_bytes;
+    // don't keep more buffers than the scheduled frames plus a few handed-out ones still in use downstream need
+    const size_t max_pooled_buffer_count;
+
+    mutable std::mutex mutex;
+    std::condition_variable frame_pending;
+    std::condition_variable frame_decoded;
+    std::deque<std::unique_ptr<ScheduledFrame>> scheduled_frames;
+    std::vector<cv::Mat> buffer_pool;
+    size_t largest_frame_byte_count = 0;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+};
+
+} // namespace presage::smartspectra::video_source::file_stream
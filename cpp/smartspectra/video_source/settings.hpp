@@ -54,6 +54,10 @@ struct VideoSourceSettings {
     std::string file_stream_path;
 
     std::string end_of_stream_filename = "end_of_stream";
+    /**
+     * how long to wait before rescanning the file stream directory for new frames, when new frames can't be waited
+     * for via directory change notifications (see watch_file_stream_directory)
+     */
     int rescan_retry_delay_ms = 10;
     /**
      * erase file(s) that have already been read in as soon as a newer file appears
@@ -64,6 +68,46 @@ struct VideoSourceSettings {
      * @details loop=true is incompatible with erase_read_files=true argument.
      */
     bool loop = false;
+
+    // === native V4L2 camera capture, Linux only (kept last: the samples aggregate-initialize these settings in order)
+    /**
+     * capture straight from the V4L2 driver, with mmap'd streaming buffers & driver timestamps, instead of
+     * going through OpenCV's VideoCapture (see camera/v4l2_streaming_video_source.hpp).
+     */
+    bool use_native_v4l2_capture = false;
+    /**
+     * number of capture buffers to request from the V4L2 driver for native capture (the driver may adjust it). Fewer
+     * buffers keep latency low, more buffers tolerate longer processing hiccups without dropped frames.
+     */
+    int v4l2_buffer_count = 4;
+    /**
+     * smallest frame size needed downstream, e.g. the graph's (scaled) input size. When set and native capture
+     * delivers MJPEG frames at least twice as large, they get decoded at 1/2, 1/4 or 1/8 scale (whichever still covers
+     * this size) in the DCT domain, which costs a fraction of a full-resolution decode. Non-positive: full resolution,
+     * unless the foreground container fills in its graph's input scaling size (when scale_input is set).
+     */
+    int mjpeg_decode_min_width_px = -1;
+    int mjpeg_decode_min_height_px = -1;
+
+    // === file stream, continued
+    /**
+     * wait for new file stream frames via directory change notifications (inotify, Linux only) instead of rescanning
+     * the directory every rescan_retry_delay_ms. The directory is still scanned once at startup. Turn this off for
+     * directories that don't deliver such notifications, e.g. network filesystems written to from other machines.
+     */
+    bool watch_file_stream_directory = true;
+    /**
+     * number of file stream frames to decode ahead of consumption, on background threads, so that the image codec
+     * doesn't hold up the frame loop. 0: decode each frame synchronously when it's requested. Not used in loop mode.
+     */
+    int file_stream_prefetch_depth = 4;
+    // number of threads decoding file stream frames ahead (see file_stream_prefetch_depth)
+    int file_stream_prefetch_thread_count = 2;
+    /**
+     * cap on memory taken up by file stream frames decoded ahead, in megabytes; limits the prefetch depth further for
+     * large frames (at least one frame is always decoded ahead)
+     */
+    int file_stream_prefetch_memory_cap_mb = 256;
 };
 
 } // namespace presage::smartspectra::video_source
@@ -58,6 +58,26 @@ VideoSource& VideoSource::operator>>(cv::Mat& frame) {
     return *this;
 }
 
+void VideoSource::ProduceUntransformedFrame(cv::Mat& frame) {
+    this->ProducePreTransformFrame(frame);
+}
+
+InputTransformMode VideoSource::GetInputTransformMode() const {
+    return this->input_transformer.mode;
+}
+
+absl::Status VideoSource::SetFrameChannelOrder(FrameChannelOrder order) {
+    if (order != FrameChannelOrder::Bgr) {
+        return absl::UnimplementedError("RGB frames are not supported for this VideoSource.");
+    }
+    this->frame_channel_order = order;
+    return absl::OkStatus();
+}
+
+FrameChannelOrder VideoSource::GetFrameChannelOrder() const {
+    return this->frame_channel_order;
+}
+
 absl::Status VideoSource::Initialize(const VideoSourceSettings& settings) {
     if (settings.input_transform_mode == InputTransformMode::Unspecified_EnumEnd) {
         this->input_transformer.mode = this->GetDefaultInputTransformMode();
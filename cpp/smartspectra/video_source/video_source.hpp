@@ -36,10 +36,31 @@ const int64_t microsecond_epoch_at_start =
         std::chrono::high_resolution_clock::now().time_since_epoch()
     ).count();
 
+enum class FrameChannelOrder {
+    Bgr,
+    Rgb
+};
+
 class VideoSource {
 public:
     VideoSource& operator>>(cv::Mat& frame);
 
+    /**
+     * Produces the next frame exactly as captured, i.e. *without* applying the input transform.
+     * Meant for consumers that fuse the transform into their own pass over the pixels (see GetInputTransformMode).
+     */
+    void ProduceUntransformedFrame(cv::Mat& frame);
+
+    InputTransformMode GetInputTransformMode() const;
+
+    /**
+     * Asks the source to produce frames with the given channel order. All sources produce BGR; sources that can decode
+     * or convert straight to RGB (sparing consumers of RGB, like the graph, a separate channel swap) also accept RGB.
+     */
+    virtual absl::Status SetFrameChannelOrder(FrameChannelOrder order);
+
+    FrameChannelOrder GetFrameChannelOrder() const;
+
     virtual absl::Status Initialize(const VideoSourceSettings& settings);
 
     virtual ~VideoSource() = default;
@@ -78,6 +99,7 @@ public:
     bool HasFrameDimensions();
 protected:
     InputTransformer input_transformer;
+    FrameChannelOrder frame_channel_order = FrameChannelOrder::Bgr;
     virtual void ProducePreTransformFrame(cv::Mat& frame) = 0;
 };
 
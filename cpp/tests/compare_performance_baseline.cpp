@@ -0,0 +1,73 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+// === third-party includes (if any) ===
+#include <absl/flags/flag.h>
+#include <absl/flags/parse.h>
+#include <absl/flags/usage.h>
+// === local includes (if any) ===
+#include <test_utilities/performance_baseline.hpp>
+
+namespace pb = presage::smartspectra::test::performance_baseline;
+
+ABSL_FLAG(std::string, baseline, "", "Path to the performance baseline JSON file.");
+ABSL_FLAG(
+    std::string, results, "",
+    "Path to the results to check: a performance baseline JSON file (e.g. as written by test_container_overhead) "
+    "or Google Benchmark JSON output (--benchmark_out=<file> --benchmark_out_format=json)."
+);
+ABSL_FLAG(
+    bool, record, false,
+    "Instead of comparing, (re-)record the baseline from the results. Tolerances of metrics already in the baseline "
+    "are kept; new metrics get the tolerances from the results (10% relative for Google Benchmark output)."
+);
+
+int main(int argc, char** argv) {
+    absl::SetProgramUsageMessage(
+        "Compares performance results against a baseline and exits with a non-zero code when any metric regresses "
+        "beyond the baseline's tolerances, or is missing from the results.\n"
+        "Usage: compare_performance_baseline --baseline=<baseline.json> --results=<results.json> [--record]"
+    );
+    absl::ParseCommandLine(argc, argv);
+    const std::filesystem::path baseline_path = absl::GetFlag(FLAGS_baseline);
+    const std::filesystem::path results_path = absl::GetFlag(FLAGS_results);
+    if (baseline_path.empty() || results_path.empty()) {
+        std::cerr << "Both --baseline and --results are required." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto results = pb::ReadBaseline(results_path);
+    if (!results.ok()) {
+        std::cerr << results.status() << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (absl::GetFlag(FLAGS_record)) {
+        auto status = pb::RecordBaseline(results.value(), baseline_path);
+        if (!status.ok()) {
+            std::cerr << status << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Recorded " << results->metrics.size() << " metrics to " << baseline_path << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    auto baseline = pb::ReadBaseline(baseline_path);
+    if (!baseline.ok()) {
+        std::cerr << baseline.status() << std::endl;
+        return EXIT_FAILURE;
+    }
+    const auto comparison = pb::CompareToBaseline(baseline.value(), results.value());
+    std::cout << pb::FormatComparisonResult(comparison);
+    std::cout << (comparison.within_tolerance ? "PASSED" : "FAILED") << ": " << baseline->metrics.size()
+              << " baseline metrics, " << comparison.regressions.size() << " regressed, "
+              << comparison.missing_metrics.size() << " missing." << std::endl;
+    return comparison.within_tolerance ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,533 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/container/background_container.hpp>
+#include <smartspectra/container/memory_telemetry.hpp>
+#include <smartspectra/container/yuv_conversion.hpp>
+#include <test_utilities/stand_in_graph.hpp>
+#include <test_utilities/test_utilities.hpp>
+
+namespace spc = presage::smartspectra::container;
+namespace test = presage::smartspectra::test;
+namespace stand_in = presage::smartspectra::test::stand_in_graph;
+
+namespace {
+
+using StandInBackgroundContainer = stand_in::StandInGraphContainer<spc::CpuSpotRestBackgroundContainer>;
+
+std::unique_ptr<StandInBackgroundContainer> StartStandInContainer(
+    std::atomic<int>& frames_sent_through,
+    spc::settings::FrameInputSettings frame_input_settings = {}
+) {
+    StandInBackgroundContainer::SettingsType settings{};
+    settings.binary_graph = false;
+    settings.spot.spot_duration_s = 30.0;
+    settings.frame_input = frame_input_settings;
+    auto container = std::make_unique<StandInBackgroundContainer>(
+        settings, std::filesystem::path(test::generated_test_data_directory.ToString())
+    );
+    REQUIRE(container->Initialize().ok());
+    REQUIRE(container->SetOnStatusChange([](presage::physiology::StatusCode) { return absl::OkStatus(); }).ok());
+    REQUIRE(container->SetOnCoreMetricsOutput(
+        [](const presage::physiology::MetricsBuffer&, int64_t) { return absl::OkStatus(); }
+    ).ok());
+    REQUIRE(container->SetOnVideoOutput([](cv::Mat&, int64_t) { return absl::OkStatus(); }).ok());
+    REQUIRE(container->SetOnFrameSentThrough([&frames_sent_through](bool, int64_t) {
+        frames_sent_through++;
+        return absl::OkStatus();
+    }).ok());
+    REQUIRE(container->StartGraph().ok());
+    return container;
+}
+
+// small frames, so that per-frame overhead isn't drowned out by pixel copies
+constexpr int kFrameWidth = 64;
+constexpr int kFrameHeight = 48;
+constexpr int kBatchSize = 64;
+constexpr int64_t kFrameIntervalμs = 33'333;
+
+std::vector<cv::Mat> MakeFrames(int frame_count, const cv::Size& frame_size = cv::Size(kFrameWidth, kFrameHeight)) {
+    std::vector<cv::Mat> frames;
+    for (int i_frame = 0; i_frame < frame_count; i_frame++) {
+        frames.emplace_back(frame_size, CV_8UC3, cv::Scalar::all(i_frame % 256));
+    }
+    return frames;
+}
+
+struct SteadyStateChurn {
+    spc::memory_telemetry::MemoryTelemetrySnapshot first_period;
+    spc::memory_telemetry::MemoryTelemetrySnapshot second_period;
+};
+
+// heap churn of a fresh stand-in container fed frames of the given size, over two consecutive periods after warm-up
+SteadyStateChurn MeasureSteadyStateChurn(const cv::Size& frame_size) {
+    constexpr int kMeasuredBatchCount = 8;
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartStandInContainer(frames_sent_through);
+    const auto frames = MakeFrames(kBatchSize, frame_size);
+    int64_t next_timestamp = 0;
+    auto feed_batches = [&](int batch_count) {
+        for (int i_batch = 0; i_batch < batch_count; i_batch++) {
+            for (const auto& frame: frames) {
+                REQUIRE(container->AddFrameWithTimestamp(frame, next_timestamp).ok());
+                next_timestamp += kFrameIntervalμs;
+            }
+            REQUIRE(container->WaitUntilGraphIsIdle().ok());
+        }
+    };
+    // warm up: frame pool, graph queues, etc. reach their steady-state sizes
+    feed_batches(2);
+
+    SteadyStateChurn churn;
+    container->ResetMemoryTelemetry();
+    feed_batches(kMeasuredBatchCount);
+    churn.first_period = container->GetMemoryTelemetrySnapshot();
+    container->ResetMemoryTelemetry();
+    feed_batches(kMeasuredBatchCount);
+    churn.second_period = container->GetMemoryTelemetrySnapshot();
+    REQUIRE(container->StopGraph().ok());
+    REQUIRE(churn.first_period.frame_count == kMeasuredBatchCount * kBatchSize);
+    return churn;
+}
+
+constexpr int kMaxFramesInFlight = 2;
+
+std::unique_ptr<StandInBackgroundContainer> StartCappedStandInContainer(
+    std::atomic<int>& frames_sent_through,
+    spc::settings::BackpressurePolicy backpressure_policy
+) {
+    spc::settings::FrameInputSettings frame_input_settings;
+    frame_input_settings.max_frames_in_flight = kMaxFramesInFlight;
+    frame_input_settings.backpressure_policy = backpressure_policy;
+    return StartStandInContainer(frames_sent_through, frame_input_settings);
+}
+
+// externally-owned RGB frame for the zero-copy raw pointer overload; counts how often its release callback fires
+struct ExternalFrame {
+    std::vector<uint8_t> pixels = std::vector<uint8_t>(kFrameWidth * kFrameHeight * 3, 128);
+    std::atomic<int> release_count{0};
+
+    absl::Status AddTo(StandInBackgroundContainer& container, int64_t frame_timestamp_μs) {
+        return container.AddFrameWithTimestamp(
+            pixels.data(), kFrameWidth, kFrameHeight, kFrameWidth * 3, frame_timestamp_μs,
+            [this]() { release_count++; }
+        );
+    }
+};
+
+// fills all frame slots of a capped container with (held) frames
+void FillFrameSlots(StandInBackgroundContainer& container, int64_t& next_timestamp) {
+    const auto frames = MakeFrames(kMaxFramesInFlight);
+    for (const auto& frame: frames) {
+        REQUIRE(container.AddFrameWithTimestamp(frame, next_timestamp).ok());
+        next_timestamp += kFrameIntervalμs;
+    }
+    REQUIRE(container.GetFramesInFlight() == kMaxFramesInFlight);
+}
+
+} // anonymous namespace
+
+TEST_CASE("Batch frame ingestion feeds every frame through the graph", "[background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartStandInContainer(frames_sent_through);
+    const auto frames = MakeFrames(kBatchSize);
+    std::vector<int64_t> timestamps;
+    for (int i_frame = 0; i_frame < kBatchSize; i_frame++) {
+        timestamps.push_back(i_frame * kFrameIntervalμs);
+    }
+    REQUIRE(container->AddFramesWithTimestamps(absl::MakeConstSpan(frames), absl::MakeConstSpan(timestamps)).ok());
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(frames_sent_through == kBatchSize);
+    REQUIRE(container->GetFramesInFlight() == 0);
+
+    SECTION("invalid batches are rejected as a whole") {
+        std::vector<int64_t> out_of_order_timestamps{
+            kBatchSize * kFrameIntervalμs, (kBatchSize + 2) * kFrameIntervalμs, (kBatchSize + 1) * kFrameIntervalμs
+        };
+        auto status = container->AddFramesWithTimestamps(
+            absl::MakeConstSpan(frames.data(), 3), absl::MakeConstSpan(out_of_order_timestamps)
+        );
+        REQUIRE(absl::IsInvalidArgument(status));
+        auto mismatched_status = container->AddFramesWithTimestamps(
+            absl::MakeConstSpan(frames.data(), 2), absl::MakeConstSpan(out_of_order_timestamps)
+        );
+        REQUIRE(absl::IsInvalidArgument(mismatched_status));
+        REQUIRE(container->WaitUntilGraphIsIdle().ok());
+        REQUIRE(frames_sent_through == kBatchSize);
+    }
+    REQUIRE(container->StopGraph().ok());
+}
+
+TEST_CASE("Frames in flight gauge follows frames through the graph", "[background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartCappedStandInContainer(frames_sent_through, spc::settings::BackpressurePolicy::Block);
+    const auto frames = MakeFrames(kMaxFramesInFlight);
+    {
+        stand_in::ScopedFrameHold frame_hold;
+        for (int i_frame = 0; i_frame < kMaxFramesInFlight; i_frame++) {
+            REQUIRE(container->AddFrameWithTimestamp(frames[i_frame], i_frame * kFrameIntervalμs).ok());
+            REQUIRE(container->GetFramesInFlight() == static_cast<size_t>(i_frame + 1));
+        }
+    }
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(frames_sent_through == kMaxFramesInFlight);
+    REQUIRE(container->GetFramesInFlight() == 0);
+    REQUIRE(container->StopGraph().ok());
+}
+
+TEST_CASE("Frames in flight aren't tracked without a limit", "[background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartStandInContainer(frames_sent_through);
+    const auto frames = MakeFrames(3);
+    {
+        stand_in::ScopedFrameHold frame_hold;
+        for (int i_frame = 0; i_frame < 3; i_frame++) {
+            REQUIRE(container->AddFrameWithTimestamp(frames[i_frame], i_frame * kFrameIntervalμs).ok());
+        }
+        REQUIRE(container->GetFramesInFlight() == 0);
+    }
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(frames_sent_through == 3);
+    REQUIRE(container->StopGraph().ok());
+}
+
+TEST_CASE("Frames the graph refuses don't take up a frame slot", "[background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartCappedStandInContainer(frames_sent_through, spc::settings::BackpressurePolicy::Block);
+    const auto frames = MakeFrames(1);
+    stand_in::ScopedFrameHold frame_hold;
+    REQUIRE(container->AddFrameWithTimestamp(frames[0], kFrameIntervalμs).ok());
+    // refused by the graph for its out-of-order timestamp
+    REQUIRE_FALSE(container->AddFrameWithTimestamp(frames[0], 0).ok());
+    REQUIRE(container->GetFramesInFlight() == 1);
+    frame_hold.Release();
+    // the refusal may have put the graph into an error state, so the stop status is beside the point here
+    container->StopGraph().IgnoreError();
+}
+
+TEST_CASE("Block backpressure policy waits for a free frame slot", "[background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartCappedStandInContainer(frames_sent_through, spc::settings::BackpressurePolicy::Block);
+    const auto frames = MakeFrames(kMaxFramesInFlight + 1);
+    stand_in::ScopedFrameHold frame_hold;
+    for (int i_frame = 0; i_frame < kMaxFramesInFlight; i_frame++) {
+        REQUIRE(container->AddFrameWithTimestamp(frames[i_frame], i_frame * kFrameIntervalμs).ok());
+    }
+    REQUIRE(container->GetFramesInFlight() == kMaxFramesInFlight);
+
+    std::atomic<bool> blocked_frame_added{false};
+    absl::Status blocked_frame_status;
+    std::thread producer([&]() {
+        blocked_frame_status = container->AddFrameWithTimestamp(
+            frames[kMaxFramesInFlight], kMaxFramesInFlight * kFrameIntervalμs
+        );
+        blocked_frame_added = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE_FALSE(blocked_frame_added);
+
+    frame_hold.Release();
+    producer.join();
+    REQUIRE(blocked_frame_status.ok());
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(frames_sent_through == kMaxFramesInFlight + 1);
+    REQUIRE(container->GetFramesInFlight() == 0);
+    REQUIRE(container->StopGraph().ok());
+}
+
+TEST_CASE("Reject backpressure policy refuses frames past the cap", "[background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartCappedStandInContainer(frames_sent_through, spc::settings::BackpressurePolicy::Reject);
+    const auto frames = MakeFrames(kMaxFramesInFlight + 2);
+    int64_t next_timestamp = 0;
+    {
+        stand_in::ScopedFrameHold frame_hold;
+        for (int i_frame = 0; i_frame < kMaxFramesInFlight; i_frame++) {
+            REQUIRE(container->AddFrameWithTimestamp(frames[i_frame], next_timestamp).ok());
+            next_timestamp += kFrameIntervalμs;
+        }
+        auto status = container->AddFrameWithTimestamp(frames[kMaxFramesInFlight], next_timestamp);
+        next_timestamp += kFrameIntervalμs;
+        REQUIRE(absl::IsResourceExhausted(status));
+        REQUIRE(container->GetFramesInFlight() == kMaxFramesInFlight);
+    }
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(frames_sent_through == kMaxFramesInFlight);
+    // slots are free again
+    REQUIRE(container->AddFrameWithTimestamp(frames[kMaxFramesInFlight + 1], next_timestamp).ok());
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(frames_sent_through == kMaxFramesInFlight + 1);
+    REQUIRE(container->StopGraph().ok());
+}
+
+TEST_CASE("Reject backpressure policy takes a batch in full or not at all", "[background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartCappedStandInContainer(frames_sent_through, spc::settings::BackpressurePolicy::Reject);
+    const auto frames = MakeFrames(kMaxFramesInFlight + 1);
+    std::vector<int64_t> timestamps;
+    for (int i_frame = 0; i_frame < kMaxFramesInFlight + 1; i_frame++) {
+        timestamps.push_back(i_frame * kFrameIntervalμs);
+    }
+    {
+        stand_in::ScopedFrameHold frame_hold;
+        // one frame over the cap: none of the batch goes in
+        auto status = container->AddFramesWithTimestamps(absl::MakeConstSpan(frames), absl::MakeConstSpan(timestamps));
+        REQUIRE(absl::IsResourceExhausted(status));
+        REQUIRE(container->GetFramesInFlight() == 0);
+        // a batch that fits goes in whole
+        REQUIRE(container->AddFramesWithTimestamps(
+            absl::MakeConstSpan(frames).subspan(0, kMaxFramesInFlight),
+            absl::MakeConstSpan(timestamps).subspan(0, kMaxFramesInFlight)
+        ).ok());
+        REQUIRE(container->GetFramesInFlight() == kMaxFramesInFlight);
+    }
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(frames_sent_through == kMaxFramesInFlight);
+    REQUIRE(container->StopGraph().ok());
+}
+
+TEST_CASE("ReplaceOldest backpressure policy keeps only the newest frame past the cap", "[background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartCappedStandInContainer(
+        frames_sent_through, spc::settings::BackpressurePolicy::ReplaceOldest
+    );
+    constexpr int kFrameCount = kMaxFramesInFlight + 3;
+    const auto frames = MakeFrames(kFrameCount);
+    {
+        stand_in::ScopedFrameHold frame_hold;
+        for (int i_frame = 0; i_frame < kFrameCount; i_frame++) {
+            REQUIRE(container->AddFrameWithTimestamp(frames[i_frame], i_frame * kFrameIntervalμs).ok());
+        }
+        REQUIRE(container->GetFramesInFlight() == kMaxFramesInFlight);
+        // of the three frames past the cap, only the last one is still held back
+        REQUIRE(container->GetReplacedFrameCount() == 2);
+    }
+    // feeds the held-back frame once a slot frees up
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(frames_sent_through == kMaxFramesInFlight + 1);
+    REQUIRE(container->GetFramesInFlight() == 0);
+    REQUIRE(container->StopGraph().ok());
+}
+
+TEST_CASE("External frames are released once the graph is done with them", "[background_container]") {
+    ExternalFrame external_frame;
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartStandInContainer(frames_sent_through);
+    {
+        stand_in::ScopedFrameHold frame_hold;
+        REQUIRE(external_frame.AddTo(*container, 0).ok());
+        // still in the graph
+        REQUIRE(external_frame.release_count == 0);
+    }
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(container->StopGraph().ok());
+    REQUIRE(frames_sent_through == 1);
+    REQUIRE(external_frame.release_count == 1);
+}
+
+TEST_CASE("External frames with invalid arguments are released right away", "[background_container]") {
+    ExternalFrame external_frame;
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartStandInContainer(frames_sent_through);
+    auto add_frame = [&](uint8_t* pixel_data, int width, int height, int width_step) {
+        return container->AddFrameWithTimestamp(
+            pixel_data, width, height, width_step, 0, [&external_frame]() { external_frame.release_count++; }
+        );
+    };
+    uint8_t* pixel_data = external_frame.pixels.data();
+
+    REQUIRE(absl::IsInvalidArgument(add_frame(nullptr, kFrameWidth, kFrameHeight, kFrameWidth * 3)));
+    REQUIRE(external_frame.release_count == 1);
+    REQUIRE(absl::IsInvalidArgument(add_frame(pixel_data, 0, kFrameHeight, kFrameWidth * 3)));
+    REQUIRE(external_frame.release_count == 2);
+    REQUIRE(absl::IsInvalidArgument(add_frame(pixel_data, kFrameWidth, -1, kFrameWidth * 3)));
+    REQUIRE(external_frame.release_count == 3);
+    // row stride shorter than a row of RGB pixels
+    REQUIRE(absl::IsInvalidArgument(add_frame(pixel_data, kFrameWidth, kFrameHeight, kFrameWidth * 3 - 1)));
+    REQUIRE(external_frame.release_count == 4);
+
+    REQUIRE(container->StopGraph().ok());
+    REQUIRE(frames_sent_through == 0);
+    REQUIRE(external_frame.release_count == 4);
+}
+
+TEST_CASE("External frames rejected at the cap are released right away", "[background_container]") {
+    ExternalFrame external_frame;
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartCappedStandInContainer(frames_sent_through, spc::settings::BackpressurePolicy::Reject);
+    int64_t next_timestamp = 0;
+    {
+        stand_in::ScopedFrameHold frame_hold;
+        FillFrameSlots(*container, next_timestamp);
+        REQUIRE(absl::IsResourceExhausted(external_frame.AddTo(*container, next_timestamp)));
+        REQUIRE(external_frame.release_count == 1);
+    }
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(container->StopGraph().ok());
+    REQUIRE(frames_sent_through == kMaxFramesInFlight);
+    REQUIRE(external_frame.release_count == 1);
+}
+
+TEST_CASE("External frames replaced under ReplaceOldest are released right away", "[background_container]") {
+    ExternalFrame replaced_frame;
+    ExternalFrame replacing_frame;
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartCappedStandInContainer(
+        frames_sent_through, spc::settings::BackpressurePolicy::ReplaceOldest
+    );
+    int64_t next_timestamp = 0;
+    {
+        stand_in::ScopedFrameHold frame_hold;
+        FillFrameSlots(*container, next_timestamp);
+        REQUIRE(replaced_frame.AddTo(*container, next_timestamp).ok());
+        next_timestamp += kFrameIntervalμs;
+        // held back, not released
+        REQUIRE(replaced_frame.release_count == 0);
+        REQUIRE(replacing_frame.AddTo(*container, next_timestamp).ok());
+        REQUIRE(container->GetReplacedFrameCount() == 1);
+        REQUIRE(replaced_frame.release_count == 1);
+        REQUIRE(replacing_frame.release_count == 0);
+    }
+    // the replacing frame goes through once a slot frees up
+    REQUIRE(container->WaitUntilGraphIsIdle().ok());
+    REQUIRE(container->StopGraph().ok());
+    REQUIRE(frames_sent_through == kMaxFramesInFlight + 1);
+    REQUIRE(replaced_frame.release_count == 1);
+    REQUIRE(replacing_frame.release_count == 1);
+}
+
+TEST_CASE("External frames held back when the graph stops are released", "[background_container]") {
+    ExternalFrame pending_frame;
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartCappedStandInContainer(
+        frames_sent_through, spc::settings::BackpressurePolicy::ReplaceOldest
+    );
+    int64_t next_timestamp = 0;
+    stand_in::ScopedFrameHold frame_hold;
+    FillFrameSlots(*container, next_timestamp);
+    REQUIRE(pending_frame.AddTo(*container, next_timestamp).ok());
+    REQUIRE(pending_frame.release_count == 0);
+
+    // StopGraph drops the pending frame first, then waits for the graph to finish the held frames
+    absl::Status stop_status;
+    std::thread stopper([&]() { stop_status = container->StopGraph(); });
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pending_frame.release_count == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    frame_hold.Release();
+    stopper.join();
+    REQUIRE(stop_status.ok());
+    REQUIRE(pending_frame.release_count == 1);
+    // never made it into the graph
+    REQUIRE(frames_sent_through == kMaxFramesInFlight);
+}
+
+// Per-frame heap churn of the whole pipeline (container + stand-in graph), as seen by the allocation hooks linked into
+// this test: operator new as well as cv::Mat buffers (see allocation_hooks.cpp). Absolute figures depend on MediaPipe &
+// standard library internals, so the budget is measured in the same run instead: the same pipeline fed small & large
+// frames. Input pixel buffers are pooled & the BGR output frame is reused, so nothing allocated per frame depends on the
+// frame size: large frames must cost as many allocations, and any per-frame pixel copy (at least one large frame's
+// worth of bytes) shows up in the difference of bytes per frame. Per-frame churn also must not grow with the number of
+// frames processed.
+TEST_CASE("Frame input is refused before any conversion once the graph has stopped", "[background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartStandInContainer(frames_sent_through);
+    REQUIRE(container->StopGraph().ok());
+    const auto pool_statistics_before = container->GetImageFramePoolStatistics();
+
+    const std::vector<uint8_t> yuyv_pixels(kFrameWidth * kFrameHeight * 2, 128);
+    const auto frame_yuv = spc::yuv_conversion::YuvFrameView::Yuyv(
+        yuyv_pixels.data(), kFrameWidth * 2, kFrameWidth, kFrameHeight
+    );
+    REQUIRE(absl::IsFailedPrecondition(container->AddFrameWithTimestamp(frame_yuv, 0)));
+    REQUIRE(absl::IsFailedPrecondition(container->AddFrameWithTimestamp(MakeFrames(1)[0], 0)));
+    // no input frame got taken from the pool for a conversion
+    const auto pool_statistics_after = container->GetImageFramePoolStatistics();
+    REQUIRE(pool_statistics_after.hit_count == pool_statistics_before.hit_count);
+    REQUIRE(pool_statistics_after.miss_count == pool_statistics_before.miss_count);
+
+    ExternalFrame external_frame;
+    REQUIRE(absl::IsFailedPrecondition(external_frame.AddTo(*container, 0)));
+    REQUIRE(external_frame.release_count == 1);
+}
+
+TEST_CASE("Frames that aren't 8-bit RGB are refused", "[background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartStandInContainer(frames_sent_through);
+    const cv::Mat frame_bgra(kFrameHeight, kFrameWidth, CV_8UC4, cv::Scalar::all(128));
+    REQUIRE(absl::IsInvalidArgument(container->AddFrameWithTimestamp(frame_bgra, 0)));
+    REQUIRE(absl::IsInvalidArgument(container->AddFrameWithTimestamp(cv::Mat(), 0)));
+    REQUIRE(container->StopGraph().ok());
+    REQUIRE(frames_sent_through == 0);
+}
+
+TEST_CASE("Steady-state frame ingestion allocates nothing per frame that scales with frame size",
+          "[background_container]") {
+    REQUIRE(spc::memory_telemetry::IsAllocationTrackingAvailable());
+    const cv::Size small_frame_size(kFrameWidth, kFrameHeight);
+    const cv::Size large_frame_size(640, 480);
+    const SteadyStateChurn small_frame_churn = MeasureSteadyStateChurn(small_frame_size);
+    const SteadyStateChurn large_frame_churn = MeasureSteadyStateChurn(large_frame_size);
+
+    const auto& small = small_frame_churn.first_period;
+    const auto& large = large_frame_churn.first_period;
+    INFO("allocations per frame: " << small.allocations_per_frame << " (" << small_frame_size.width << "x"
+         << small_frame_size.height << "), " << large.allocations_per_frame << " (" << large_frame_size.width << "x"
+         << large_frame_size.height << "); bytes per frame: " << small.bytes_per_frame << ", "
+         << large.bytes_per_frame);
+    REQUIRE(large.allocations_per_frame <= small.allocations_per_frame * 1.1 + 1.0);
+    const double large_frame_byte_count = static_cast<double>(large_frame_size.area()) * 3.0;
+    REQUIRE(large.bytes_per_frame - small.bytes_per_frame < large_frame_byte_count / 2.0);
+    // steady state: per-frame churn must not grow with the number of frames processed
+    for (const SteadyStateChurn* churn: {&small_frame_churn, &large_frame_churn}) {
+        INFO("allocations per frame: " << churn->first_period.allocations_per_frame << ", then "
+             << churn->second_period.allocations_per_frame);
+        REQUIRE(churn->second_period.allocations_per_frame <= churn->first_period.allocations_per_frame * 1.1 + 1.0);
+        REQUIRE(churn->second_period.peak_resident_set_size_bytes > 0);
+    }
+}
+
+// run explicitly, e.g. `test_background_container "[benchmark]"`
+TEST_CASE("Single-frame vs. batch frame ingestion overhead", "[.][benchmark][background_container]") {
+    std::atomic<int> frames_sent_through{0};
+    auto container = StartStandInContainer(frames_sent_through);
+    const auto frames = MakeFrames(kBatchSize);
+    int64_t next_timestamp = 0;
+    std::vector<int64_t> timestamps(kBatchSize);
+
+    // each benchmark run covers kBatchSize frames; divide by it for the per-frame figure
+    BENCHMARK("AddFrameWithTimestamp, " + std::to_string(kBatchSize) + " frames") {
+        for (const auto& frame: frames) {
+            REQUIRE(container->AddFrameWithTimestamp(frame, next_timestamp).ok());
+            next_timestamp += kFrameIntervalμs;
+        }
+        return container->WaitUntilGraphIsIdle().ok();
+    };
+    BENCHMARK("AddFramesWithTimestamps, " + std::to_string(kBatchSize) + " frames") {
+        for (auto& timestamp: timestamps) {
+            timestamp = next_timestamp;
+            next_timestamp += kFrameIntervalμs;
+        }
+        REQUIRE(container->AddFramesWithTimestamps(absl::MakeConstSpan(frames), absl::MakeConstSpan(timestamps)).ok());
+        return container->WaitUntilGraphIsIdle().ok();
+    };
+    REQUIRE(container->StopGraph().ok());
+}
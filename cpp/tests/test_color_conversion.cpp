@@ -0,0 +1,142 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <string>
+#include <vector>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/opencv_core_inc.h>
+#include <mediapipe/framework/port/opencv_imgproc_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/container/color_conversion.hpp>
+#include <smartspectra/video_source/input_transform.hpp>
+
+namespace cc = presage::smartspectra::container::color_conversion;
+namespace vs = presage::smartspectra::video_source;
+
+namespace {
+
+// none of the dimensions (other than 64) are multiples of the 32-pixel tile size, so that partial tiles & bands at
+// the right & bottom edges get exercised; 1x1 is the degenerate case
+const std::vector<cv::Size> kFrameSizes{{1, 1}, {31, 17}, {64, 45}, {67, 64}, {130, 97}};
+
+cv::Mat MakeRandomMat(const cv::Size& size, int type) {
+    cv::Mat random_mat(size, type);
+    cv::randu(random_mat, cv::Scalar::all(0), cv::Scalar::all(256));
+    return random_mat;
+}
+
+std::vector<vs::InputTransformMode> GetAllInputTransformModes() {
+    std::vector<vs::InputTransformMode> modes;
+    for (int mode = static_cast<int>(vs::InputTransformMode::None);
+         mode < static_cast<int>(vs::InputTransformMode::Unspecified_EnumEnd); mode++) {
+        modes.push_back(static_cast<vs::InputTransformMode>(mode));
+    }
+    return modes;
+}
+
+// reference implementation: the same OpenCV calls the video sources' InputTransformer makes
+cv::Mat ApplyReferenceTransform(const cv::Mat& frame, vs::InputTransformMode mode) {
+    cv::Mat transformed;
+    switch (mode) {
+        case vs::InputTransformMode::Clockwise90:
+            cv::rotate(frame, transformed, cv::ROTATE_90_CLOCKWISE);
+            break;
+        case vs::InputTransformMode::Counterclockwise90:
+            cv::rotate(frame, transformed, cv::ROTATE_90_COUNTERCLOCKWISE);
+            break;
+        case vs::InputTransformMode::Rotate180:
+            cv::rotate(frame, transformed, cv::ROTATE_180);
+            break;
+        case vs::InputTransformMode::MirrorHorizontal:
+            cv::flip(frame, transformed, 1);
+            break;
+        case vs::InputTransformMode::MirrorVertical:
+            cv::flip(frame, transformed, 0);
+            break;
+        default:
+            transformed = frame.clone();
+            break;
+    }
+    return transformed;
+}
+
+bool AreIdentical(const cv::Mat& a, const cv::Mat& b) {
+    return a.size() == b.size() && a.type() == b.type() && cv::norm(a, b, cv::NORM_INF) == 0.0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("BGR to RGB conversion with input transform matches cvtColor followed by rotate / flip",
+          "[color_conversion]") {
+    const int source_type = GENERATE(CV_8UC3, CV_8UC4);
+    const int cv_conversion_code = source_type == CV_8UC4 ? cv::COLOR_BGRA2RGB : cv::COLOR_BGR2RGB;
+    for (const cv::Size& size: kFrameSizes) {
+        const cv::Mat source_bgr = MakeRandomMat(size, source_type);
+        cv::Mat source_rgb;
+        cv::cvtColor(source_bgr, source_rgb, cv_conversion_code);
+        for (vs::InputTransformMode mode: GetAllInputTransformModes()) {
+            INFO("size: " << size.width << "x" << size.height << ", channels: " << source_bgr.channels() <<
+                 ", mode: " << vs::AbslUnparseFlag(mode));
+            const cv::Mat expected = ApplyReferenceTransform(source_rgb, mode);
+            REQUIRE(cc::GetTransformedSize(size, mode) == expected.size());
+
+            cv::Mat destination_rgb(expected.size(), CV_8UC3, cv::Scalar::all(0));
+            REQUIRE(cc::ConvertBgrToRgb(source_bgr, destination_rgb, mode).ok());
+            REQUIRE(AreIdentical(destination_rgb, expected));
+        }
+    }
+}
+
+TEST_CASE("RGB input transform matches rotate / flip", "[color_conversion]") {
+    for (const cv::Size& size: kFrameSizes) {
+        const cv::Mat source_rgb = MakeRandomMat(size, CV_8UC3);
+        for (vs::InputTransformMode mode: GetAllInputTransformModes()) {
+            INFO("size: " << size.width << "x" << size.height << ", mode: " << vs::AbslUnparseFlag(mode));
+            const cv::Mat expected = ApplyReferenceTransform(source_rgb, mode);
+            cv::Mat destination_rgb(expected.size(), CV_8UC3, cv::Scalar::all(0));
+            REQUIRE(cc::TransformRgb(source_rgb, destination_rgb, mode).ok());
+            REQUIRE(AreIdentical(destination_rgb, expected));
+        }
+    }
+}
+
+TEST_CASE("Color conversion handles padded rows on both ends", "[color_conversion]") {
+    const cv::Size size(67, 45);
+    constexpr int kPadding = 5;
+    // sub-views of larger frames, so that neither source nor destination rows are contiguous
+    const cv::Mat padded_source = MakeRandomMat(cv::Size(size.width + kPadding, size.height), CV_8UC3);
+    const cv::Mat source_bgr = padded_source(cv::Rect(cv::Point(kPadding, 0), size));
+    cv::Mat source_rgb;
+    cv::cvtColor(source_bgr, source_rgb, cv::COLOR_BGR2RGB);
+    for (vs::InputTransformMode mode: GetAllInputTransformModes()) {
+        INFO("mode: " << vs::AbslUnparseFlag(mode));
+        const cv::Mat expected = ApplyReferenceTransform(source_rgb, mode);
+        cv::Mat padded_destination(expected.rows, expected.cols + kPadding, CV_8UC3, cv::Scalar::all(0));
+        cv::Mat destination_rgb = padded_destination(cv::Rect(cv::Point(0, 0), expected.size()));
+        REQUIRE(cc::ConvertBgrToRgb(source_bgr, destination_rgb, mode).ok());
+        REQUIRE(AreIdentical(destination_rgb, expected));
+        // padding is left alone
+        REQUIRE(cv::countNonZero(
+            padded_destination(cv::Rect(expected.cols, 0, kPadding, expected.rows)).reshape(1)
+        ) == 0);
+    }
+}
+
+TEST_CASE("Color conversion rejects unsupported frames", "[color_conversion]") {
+    const cv::Mat source_bgr = MakeRandomMat(cv::Size(31, 17), CV_8UC3);
+    SECTION("source type") {
+        cv::Mat destination_rgb(source_bgr.size(), CV_8UC3);
+        REQUIRE_FALSE(cc::ConvertBgrToRgb(MakeRandomMat(source_bgr.size(), CV_8UC1), destination_rgb).ok());
+        REQUIRE_FALSE(cc::TransformRgb(MakeRandomMat(source_bgr.size(), CV_8UC4), destination_rgb).ok());
+    }
+    SECTION("destination size") {
+        // not transposed for a rotation
+        cv::Mat destination_rgb(source_bgr.size(), CV_8UC3);
+        REQUIRE_FALSE(cc::ConvertBgrToRgb(source_bgr, destination_rgb, vs::InputTransformMode::Clockwise90).ok());
+    }
+}
@@ -0,0 +1,432 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sys/resource.h>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+#include <mediapipe/framework/port/status_macros.h>
+// === local includes (if any) ===
+#include <smartspectra/container/background_container.hpp>
+#include <smartspectra/container/foreground_container.hpp>
+#include <smartspectra/container/latency_histogram.hpp>
+#include <smartspectra/container/memory_telemetry.hpp>
+#include <smartspectra/video_source/video_source.hpp>
+#include <test_utilities/performance_baseline.hpp>
+#include <test_utilities/stand_in_graph.hpp>
+#include <test_utilities/test_utilities.hpp>
+
+namespace spc = presage::smartspectra::container;
+namespace vs = presage::smartspectra::video_source;
+namespace pi = presage::platform_independence;
+namespace test = presage::smartspectra::test;
+namespace stand_in = presage::smartspectra::test::stand_in_graph;
+namespace pb = presage::smartspectra::test::performance_baseline;
+namespace mt = presage::smartspectra::container::memory_telemetry;
+
+namespace {
+
+constexpr int64_t kFrameIntervalμs = 33'333;
+
+using Clock = std::chrono::steady_clock;
+
+struct HarnessSettings {
+    int width = 640;
+    int height = 480;
+    int frame_count = 300;
+    // when true, frames come in at kFrameIntervalμs (real time, like a camera); otherwise, as fast as accepted
+    bool paced = false;
+};
+
+struct OverheadReport {
+    std::string container;
+    HarnessSettings harness_settings;
+    int64_t frames_left_graph = 0;
+    int64_t metrics_buffer_count = 0;
+    // input frames per wall-clock second, from the first frame in until the pipeline is done with the last one
+    double frames_per_second = 0.0;
+    // capture (or AddFrame* call) to the frame leaving the graph
+    double p99_latency_ms = 0.0;
+    // process CPU time (all threads, including the graph's) per input frame
+    double cpu_time_per_frame_μs = 0.0;
+    // process-wide heap allocations (all threads) per input frame
+    double allocations_per_frame = 0.0;
+};
+
+std::ostream& operator<<(std::ostream& stream, const OverheadReport& report) {
+    const HarnessSettings& harness_settings = report.harness_settings;
+    return stream << report.container << ", " << harness_settings.width << "x" << harness_settings.height << ", "
+                  << (harness_settings.paced ? "paced" : "unpaced") << ": " << harness_settings.frame_count
+                  << " frames (" << report.frames_left_graph << " left graph, " << report.metrics_buffer_count
+                  << " metrics buffers), " << report.frames_per_second << " frames/s, p99 latency "
+                  << report.p99_latency_ms << " ms, CPU " << report.cpu_time_per_frame_μs << " μs/frame, "
+                  << report.allocations_per_frame << " allocations/frame";
+}
+
+double GetProcessCpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+// wall clock, process CPU time & heap allocation count when the first frame comes in
+struct MeasurementStart {
+    Clock::time_point time;
+    double cpu_seconds = 0.0;
+    uint64_t allocation_count = 0;
+
+    static MeasurementStart Now() {
+        return {Clock::now(), GetProcessCpuSeconds(), mt::GetAllocationCounters().allocation_count};
+    }
+};
+
+/**
+ * Times frames from capture until they leave the graph. Frame i is expected to have timestamp i * kFrameIntervalμs.
+ * @details RecordCapture & RecordFrameLeftGraph may be called from different threads, as long as a frame's capture is
+ * recorded before it's handed to the container. RecordFrameLeftGraph calls must not overlap.
+ */
+class FrameLatencyTracker {
+public:
+    explicit FrameLatencyTracker(int frame_count) : capture_times(frame_count) {}
+
+    void RecordCapture(int64_t frame_timestamp) {
+        this->capture_times[frame_timestamp / kFrameIntervalμs] = Clock::now();
+    }
+
+    void RecordFrameLeftGraph(int64_t frame_timestamp) {
+        const auto latency = Clock::now() - this->capture_times[frame_timestamp / kFrameIntervalμs];
+        this->latency_histogram.Add(std::chrono::duration<double>(latency).count());
+    }
+
+    [[nodiscard]] int64_t GetFramesLeftGraph() const { return static_cast<int64_t>(this->latency_histogram.Count()); }
+
+    [[nodiscard]] double GetP99LatencySeconds() const { return this->latency_histogram.Quantile(0.99); }
+
+private:
+    std::vector<Clock::time_point> capture_times;
+    spc::latency_histogram::LatencyHistogram latency_histogram;
+};
+
+cv::Mat MakeSyntheticFrame(int width, int height) {
+    cv::Mat frame(height, width, CV_8UC3);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+    return frame;
+}
+
+void FinishReport(OverheadReport& report, const FrameLatencyTracker& tracker, const MeasurementStart& start) {
+    const double wall_seconds = std::chrono::duration<double>(Clock::now() - start.time).count();
+    const double cpu_seconds = GetProcessCpuSeconds() - start.cpu_seconds;
+    const auto allocation_count = mt::GetAllocationCounters().allocation_count - start.allocation_count;
+    const int frame_count = report.harness_settings.frame_count;
+    report.frames_left_graph = tracker.GetFramesLeftGraph();
+    report.frames_per_second = wall_seconds > 0.0 ? frame_count / wall_seconds : 0.0;
+    report.p99_latency_ms = tracker.GetP99LatencySeconds() * 1e3;
+    report.cpu_time_per_frame_μs = frame_count > 0 ? cpu_seconds * 1e6 / frame_count : 0.0;
+    report.allocations_per_frame = frame_count > 0 ? static_cast<double>(allocation_count) / frame_count : 0.0;
+}
+
+// Adds the report's metrics, named "<container>/<width>x<height>/<paced|unpaced>/<metric>", to the given results.
+void AddToPerformanceResults(pb::PerformanceBaseline& results, const OverheadReport& report) {
+    const HarnessSettings& harness_settings = report.harness_settings;
+    const std::string prefix = report.container + "/" + std::to_string(harness_settings.width) + "x" +
+                               std::to_string(harness_settings.height) + "/" +
+                               (harness_settings.paced ? "paced" : "unpaced") + "/";
+    // wall-clock metrics are noisier than CPU time & allocation counts, hence the wider tolerances
+    results.AddMetric(prefix + "frames_per_second", report.frames_per_second, pb::MetricDirection::HigherIsBetter, 0.2);
+    results.AddMetric(prefix + "p99_latency_ms", report.p99_latency_ms, pb::MetricDirection::LowerIsBetter, 0.5, 1.0);
+    results.AddMetric(
+        prefix + "cpu_time_per_frame_μs", report.cpu_time_per_frame_μs, pb::MetricDirection::LowerIsBetter, 0.25
+    );
+    results.AddMetric(
+        prefix + "allocations_per_frame", report.allocations_per_frame, pb::MetricDirection::LowerIsBetter, 0.1, 1.0
+    );
+}
+
+// region ======================================== background ==========================================================
+using StandInBackgroundContainer = stand_in::StandInGraphContainer<
+    spc::BackgroundContainer<pi::DeviceType::Cpu, spc::settings::OperationMode::Continuous,
+                             spc::settings::IntegrationMode::Rest>
+>;
+
+OverheadReport RunBackgroundContainer(const HarnessSettings& harness_settings) {
+    OverheadReport report{"background", harness_settings};
+    FrameLatencyTracker tracker(harness_settings.frame_count);
+    StandInBackgroundContainer::SettingsType settings{};
+    settings.binary_graph = false;
+    StandInBackgroundContainer container(settings, test::generated_test_data_directory.ToString());
+    REQUIRE(container.Initialize().ok());
+    REQUIRE(container.SetOnStatusChange([](presage::physiology::StatusCode) { return absl::OkStatus(); }).ok());
+    REQUIRE(container.SetOnCoreMetricsOutput(
+        [&report](const presage::physiology::MetricsBuffer&, int64_t) {
+            report.metrics_buffer_count++;
+            return absl::OkStatus();
+        }
+    ).ok());
+    REQUIRE(container.SetOnVideoOutput([](cv::Mat&, int64_t) { return absl::OkStatus(); }).ok());
+    REQUIRE(container.SetOnFrameSentThrough([&tracker](bool, int64_t frame_timestamp) {
+        tracker.RecordFrameLeftGraph(frame_timestamp);
+        return absl::OkStatus();
+    }).ok());
+    REQUIRE(container.StartGraph().ok());
+    REQUIRE(container.SetRecording(true).ok());
+
+    const cv::Mat frame = MakeSyntheticFrame(harness_settings.width, harness_settings.height);
+    const auto start = MeasurementStart::Now();
+    absl::Status add_frame_status;
+    for (int i_frame = 0; i_frame < harness_settings.frame_count && add_frame_status.ok(); i_frame++) {
+        if (harness_settings.paced) {
+            std::this_thread::sleep_until(start.time + std::chrono::microseconds(i_frame * kFrameIntervalμs));
+        }
+        const int64_t frame_timestamp = i_frame * kFrameIntervalμs;
+        tracker.RecordCapture(frame_timestamp);
+        add_frame_status = container.AddFrameWithTimestamp(frame, frame_timestamp);
+    }
+    REQUIRE(add_frame_status.ok());
+    REQUIRE(container.WaitUntilGraphIsIdle().ok());
+    FinishReport(report, tracker, start);
+    REQUIRE(container.StopGraph().ok());
+    return report;
+}
+// endregion ===========================================================================================================
+// region ======================================== foreground ==========================================================
+// Produces the same (random) frame over & over with evenly-spaced timestamps, then signals the end of the stream.
+class SyntheticVideoSource : public vs::VideoSource {
+public:
+    SyntheticVideoSource(const HarnessSettings& harness_settings, FrameLatencyTracker& tracker) :
+        harness_settings(harness_settings), tracker(tracker),
+        frame(MakeSyntheticFrame(harness_settings.width, harness_settings.height)) {}
+
+    [[nodiscard]] bool SupportsExactFrameTimestamp() const override { return true; }
+
+    [[nodiscard]] int64_t GetFrameTimestamp() const override { return this->frame_timestamp; }
+
+    int GetWidth() override { return this->harness_settings.width; }
+
+    int GetHeight() override { return this->harness_settings.height; }
+
+    [[nodiscard]] const MeasurementStart& GetMeasurementStart() const { return this->measurement_start; }
+
+    [[nodiscard]] int64_t GetCapturedFrameCount() const { return this->i_frame; }
+
+protected:
+    void ProducePreTransformFrame(cv::Mat& output_frame) override {
+        if (this->i_frame == this->harness_settings.frame_count) {
+            output_frame = cv::Mat();
+            return;
+        }
+        if (this->i_frame == 0) {
+            this->measurement_start = MeasurementStart::Now();
+        } else if (this->harness_settings.paced) {
+            const auto frame_due_time =
+                this->measurement_start.time + std::chrono::microseconds(this->i_frame * kFrameIntervalμs);
+            std::this_thread::sleep_until(frame_due_time);
+        }
+        // the container converts (i.e. copies) the frame before it goes into the graph, so no need for a fresh one
+        output_frame = this->frame;
+        this->frame_timestamp = this->i_frame * kFrameIntervalμs;
+        this->tracker.RecordCapture(this->frame_timestamp);
+        this->i_frame++;
+    }
+
+private:
+    const HarnessSettings harness_settings;
+    FrameLatencyTracker& tracker;
+    const cv::Mat frame;
+    int64_t i_frame = 0;
+    int64_t frame_timestamp = 0;
+    MeasurementStart measurement_start;
+};
+
+class StandInForegroundContainer
+    : public stand_in::StandInGraphContainer<spc::CpuContinuousRestForegroundContainer> {
+public:
+    StandInForegroundContainer(
+        SettingsType settings, const HarnessSettings& harness_settings, FrameLatencyTracker& tracker
+    ) : StandInGraphContainer(std::move(settings), test::generated_test_data_directory.ToString()),
+        harness_settings(harness_settings), tracker(tracker) {}
+
+    [[nodiscard]] const SyntheticVideoSource* GetSyntheticVideoSource() const { return this->synthetic_video_source; }
+
+protected:
+    absl::StatusOr<std::unique_ptr<vs::VideoSource>> BuildVideoSource() override {
+        auto source = std::make_unique<SyntheticVideoSource>(this->harness_settings, this->tracker);
+        MP_RETURN_IF_ERROR(source->Initialize(this->settings.video_source));
+        this->synthetic_video_source = source.get();
+        return source;
+    }
+
+private:
+    const HarnessSettings harness_settings;
+    FrameLatencyTracker& tracker;
+    const SyntheticVideoSource* synthetic_video_source = nullptr;
+};
+
+OverheadReport RunForegroundContainer(
+    const HarnessSettings& harness_settings,
+    spc::settings::FramePipelineMode pipeline_mode = spc::settings::FramePipelineMode::Serial
+) {
+    OverheadReport report{
+        "foreground (" + spc::settings::AbslUnparseFlag(pipeline_mode) + ")", harness_settings
+    };
+    FrameLatencyTracker tracker(harness_settings.frame_count);
+    StandInForegroundContainer::SettingsType settings{};
+    settings.binary_graph = false;
+    settings.headless = true;
+    settings.start_with_recording_on = true;
+    settings.video_source.auto_lock = false;
+    settings.frame_pipeline.mode = pipeline_mode;
+    StandInForegroundContainer container(settings, harness_settings, tracker);
+    REQUIRE(container.SetOnStatusChange([](presage::physiology::StatusCode) { return absl::OkStatus(); }).ok());
+    REQUIRE(container.SetOnCoreMetricsOutput(
+        [&report](const presage::physiology::MetricsBuffer&, int64_t) {
+            report.metrics_buffer_count++;
+            return absl::OkStatus();
+        }
+    ).ok());
+    REQUIRE(container.SetOnVideoOutput([](cv::Mat&, int64_t) { return absl::OkStatus(); }).ok());
+    REQUIRE(container.SetOnFrameSentThrough([&tracker](bool, int64_t frame_timestamp) {
+        tracker.RecordFrameLeftGraph(frame_timestamp);
+        return absl::OkStatus();
+    }).ok());
+    REQUIRE(container.Initialize().ok());
+    REQUIRE(container.GetSyntheticVideoSource() != nullptr);
+
+    // Run() covers graph startup & shutdown as well; the video source starts measuring at the first frame
+    REQUIRE(container.Run().ok());
+    FinishReport(report, tracker, container.GetSyntheticVideoSource()->GetMeasurementStart());
+    return report;
+}
+// endregion ===========================================================================================================
+
+} // anonymous namespace
+
+TEST_CASE("Stand-in graph runs the background container end to end", "[container_overhead]") {
+    const HarnessSettings harness_settings{320, 240, 150, false};
+    const OverheadReport report = RunBackgroundContainer(harness_settings);
+    INFO(report);
+    REQUIRE(report.frames_left_graph == harness_settings.frame_count);
+    REQUIRE(report.metrics_buffer_count == harness_settings.frame_count / stand_in::kMetricsBufferFrameInterval);
+    REQUIRE(report.frames_per_second > 0.0);
+    REQUIRE(report.p99_latency_ms > 0.0);
+}
+
+TEST_CASE("Stand-in graph runs the foreground container end to end", "[container_overhead]") {
+    const HarnessSettings harness_settings{320, 240, 150, false};
+    const OverheadReport report = RunForegroundContainer(harness_settings);
+    INFO(report);
+    // outputs still queued up when the video source runs dry are never polled
+    REQUIRE(report.frames_left_graph > harness_settings.frame_count - stand_in::kMetricsBufferFrameInterval);
+    REQUIRE(report.frames_left_graph <= harness_settings.frame_count);
+    REQUIRE(report.metrics_buffer_count >= harness_settings.frame_count / stand_in::kMetricsBufferFrameInterval - 1);
+    REQUIRE(report.p99_latency_ms > 0.0);
+}
+
+TEST_CASE("Offline frame pipeline overlaps frames in the graph without dropping any", "[container_overhead]") {
+    const HarnessSettings harness_settings{160, 120, 90, false};
+    constexpr int kMaxFramesInFlight = 4;
+    FrameLatencyTracker tracker(harness_settings.frame_count);
+    StandInForegroundContainer::SettingsType settings{};
+    settings.binary_graph = false;
+    settings.headless = true;
+    settings.video_source.auto_lock = false;
+    // offline mode only takes video files; the synthetic video source stands in for one
+    settings.video_source.input_video_path = "synthetic_video.avi";
+    settings.frame_pipeline.mode = spc::settings::FramePipelineMode::Offline;
+    settings.frame_pipeline.queue_depth = kMaxFramesInFlight;
+    StandInForegroundContainer container(settings, harness_settings, tracker);
+    int video_output_count = 0;
+    int64_t captured_frame_count_when_first_frame_left = -1;
+    REQUIRE(container.SetOnStatusChange([](presage::physiology::StatusCode) { return absl::OkStatus(); }).ok());
+    REQUIRE(container.SetOnCoreMetricsOutput(
+        [](const presage::physiology::MetricsBuffer&, int64_t) { return absl::OkStatus(); }
+    ).ok());
+    REQUIRE(container.SetOnVideoOutput([&video_output_count](cv::Mat&, int64_t) {
+        video_output_count++;
+        return absl::OkStatus();
+    }).ok());
+    REQUIRE(container.SetOnFrameSentThrough([&](bool, int64_t frame_timestamp) {
+        if (captured_frame_count_when_first_frame_left < 0) {
+            captured_frame_count_when_first_frame_left = container.GetSyntheticVideoSource()->GetCapturedFrameCount();
+        }
+        tracker.RecordFrameLeftGraph(frame_timestamp);
+        return absl::OkStatus();
+    }).ok());
+    REQUIRE(container.Initialize().ok());
+
+    absl::Status run_status;
+    {
+        // hold the first frames in the graph for a while, so that the loop runs up against the in-flight cap
+        stand_in::ScopedFrameHold frame_hold;
+        std::thread hold_releaser([&frame_hold]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            frame_hold.Release();
+        });
+        run_status = container.Run();
+        hold_releaser.join();
+    }
+    REQUIRE(run_status.ok());
+    REQUIRE(tracker.GetFramesLeftGraph() == harness_settings.frame_count);
+    REQUIRE(video_output_count == harness_settings.frame_count);
+    // frames kept going in while the first one was still in the graph, up to the cap (plus the one captured next)
+    REQUIRE(captured_frame_count_when_first_frame_left == kMaxFramesInFlight + 1);
+}
+
+// Container overhead in isolation from model & network costs. Run explicitly, e.g.
+// `test_container_overhead "[benchmark]"`; results go to stdout, one line per configuration, and to
+// container_overhead_results.json in the generated test data directory. The results are compared against the baseline
+// at $SMARTSPECTRA_CONTAINER_OVERHEAD_BASELINE (default: container_overhead_baseline.json next to the results); the
+// test fails on regressions beyond the baseline's tolerances, or when there is no baseline. To (re-)record the baseline
+// from the results instead, set $SMARTSPECTRA_RECORD_CONTAINER_OVERHEAD_BASELINE=1.
+TEST_CASE("Container overhead with the stand-in graph", "[.][benchmark][container_overhead]") {
+    pb::PerformanceBaseline results;
+    results.description = "container overhead with the stand-in graph (test_container_overhead)";
+    const auto run_and_record = [&results](const OverheadReport& report) {
+        std::cout << report << std::endl;
+        AddToPerformanceResults(results, report);
+    };
+    for (const auto& [width, height]: {std::pair{640, 480}, std::pair{1280, 720}}) {
+        // unpaced runs show throughput; paced (real-time) runs show the latency a live camera would see
+        for (const auto& [frame_count, paced]: {std::pair{600, false}, std::pair{150, true}}) {
+            const HarnessSettings harness_settings{width, height, frame_count, paced};
+            run_and_record(RunBackgroundContainer(harness_settings));
+            run_and_record(RunForegroundContainer(harness_settings, spc::settings::FramePipelineMode::Serial));
+            run_and_record(RunForegroundContainer(harness_settings, spc::settings::FramePipelineMode::Pipelined));
+        }
+    }
+
+    const std::filesystem::path generated_directory = test::generated_test_data_directory.ToString();
+    REQUIRE(pb::WriteBaseline(results, generated_directory / "container_overhead_results.json").ok());
+    const char* baseline_path_variable = std::getenv("SMARTSPECTRA_CONTAINER_OVERHEAD_BASELINE");
+    const std::filesystem::path baseline_path = baseline_path_variable != nullptr ?
+                                                std::filesystem::path(baseline_path_variable) :
+                                                generated_directory / "container_overhead_baseline.json";
+    const char* record_variable = std::getenv("SMARTSPECTRA_RECORD_CONTAINER_OVERHEAD_BASELINE");
+    if (record_variable != nullptr && std::string(record_variable) == "1") {
+        REQUIRE(pb::RecordBaseline(results, baseline_path).ok());
+        WARN("Recorded the baseline at " << baseline_path << "; nothing was compared.");
+        return;
+    }
+    auto baseline = pb::ReadBaseline(baseline_path);
+    INFO("No usable baseline at " << baseline_path << " (set SMARTSPECTRA_RECORD_CONTAINER_OVERHEAD_BASELINE=1 to "
+         "record one): " << baseline.status());
+    REQUIRE(baseline.ok());
+    const auto comparison = pb::CompareToBaseline(baseline.value(), results);
+    INFO(pb::FormatComparisonResult(comparison));
+    REQUIRE(comparison.within_tolerance);
+}
@@ -0,0 +1,140 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <cstdint>
+#include <random>
+#include <vector>
+// === third-party includes (if any) ===
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+// === local includes (if any) ===
+#include <smartspectra/container/core_performance_window.hpp>
+
+namespace cpw = presage::smartspectra::container::core_performance_window;
+
+namespace {
+
+constexpr int64_t kWindowDurationμs = 3'000'000;
+
+/**
+ * The window as the container computed it before it was made incremental: every buffer is appended to a vector, stale
+ * buffers are erased only when there are at least two of them, and the statistics are recomputed from scratch.
+ */
+class RecomputedWindow {
+public:
+    void Add(const cpw::MetricsBufferSample& sample, int64_t window_duration_μs) {
+        this->samples.push_back(sample);
+        auto sample_location = this->samples.begin();
+        const int64_t window_start = sample.last_timestamp - window_duration_μs;
+        while (sample_location != this->samples.end() && sample_location->last_timestamp < window_start) {
+            sample_location++;
+        }
+        if (sample_location > this->samples.begin() + 1) {
+            this->samples.erase(this->samples.begin(), sample_location);
+        }
+    }
+
+    [[nodiscard]] size_t GetBufferCount() const { return this->samples.size(); }
+
+    [[nodiscard]] int64_t GetFrameCount() const {
+        int64_t frame_count = 0;
+        for (const auto& sample: this->samples) frame_count += sample.frame_count;
+        return frame_count;
+    }
+
+    [[nodiscard]] double GetEffectiveFps() const {
+        const int64_t window_span_μs = this->samples.back().last_timestamp - this->samples.front().first_timestamp;
+        return static_cast<double>(this->GetFrameCount() - 1) * 1000000.0 / static_cast<double>(window_span_μs);
+    }
+
+    [[nodiscard]] double GetMeanLatencySeconds() const {
+        double latency_sum_seconds = 0.0;
+        for (const auto& sample: this->samples) latency_sum_seconds += static_cast<double>(sample.latency_μs) * 1e-6;
+        return latency_sum_seconds / static_cast<double>(this->samples.size());
+    }
+
+private:
+    std::vector<cpw::MetricsBufferSample> samples;
+};
+
+// metrics buffers of 30 frames at 30 fps, back to back
+cpw::MetricsBufferSample MakeSample(int64_t i_buffer, int64_t latency_μs = 200'000) {
+    constexpr int64_t kBufferDurationμs = 1'000'000;
+    return {
+        i_buffer * kBufferDurationμs, i_buffer * kBufferDurationμs + 966'667, 30, latency_μs
+    };
+}
+
+} // anonymous namespace
+
+TEST_CASE("Core performance window trims only once two buffers fell out of it", "[core_performance_window]") {
+    cpw::CorePerformanceWindow window;
+    // buffers 0..3 end within 3 s of buffer 3
+    for (int64_t i_buffer = 0; i_buffer < 4; i_buffer++) {
+        window.Add(MakeSample(i_buffer), kWindowDurationμs);
+    }
+    REQUIRE(window.GetBufferCount() == 4);
+    // buffer 0 falls out of the window, but it's the only one, so it stays
+    window.Add(MakeSample(4), kWindowDurationμs);
+    REQUIRE(window.GetBufferCount() == 5);
+    // buffers 0 & 1 fall out now, and both go
+    window.Add(MakeSample(5), kWindowDurationμs);
+    REQUIRE(window.GetBufferCount() == 4);
+    REQUIRE(window.GetFrameCount() == 4 * 30);
+
+    SECTION("the newest buffer always stays") {
+        window.Add(MakeSample(100), kWindowDurationμs);
+        REQUIRE(window.GetBufferCount() == 1);
+        REQUIRE(window.GetFrameCount() == 30);
+        REQUIRE(window.GetEffectiveFps() > 0.0);
+    }
+}
+
+TEST_CASE("Core performance window matches recomputing the statistics from scratch", "[core_performance_window]") {
+    cpw::CorePerformanceWindow window;
+    RecomputedWindow recomputed_window;
+    std::mt19937 random_engine(7);
+    std::uniform_int_distribution<int64_t> gap_distribution(0, 2'500'000);
+    std::uniform_int_distribution<int32_t> frame_count_distribution(1, 60);
+    std::uniform_int_distribution<int64_t> latency_distribution(1, 2'000'000);
+    int64_t timestamp = 0;
+    for (int i_buffer = 0; i_buffer < 5000; i_buffer++) {
+        const int32_t frame_count = frame_count_distribution(random_engine);
+        cpw::MetricsBufferSample sample{
+            timestamp, timestamp + frame_count * 33'333, frame_count, latency_distribution(random_engine)
+        };
+        timestamp = sample.last_timestamp + gap_distribution(random_engine);
+        window.Add(sample, kWindowDurationμs);
+        recomputed_window.Add(sample, kWindowDurationμs);
+
+        INFO("buffer " << i_buffer);
+        REQUIRE(window.GetBufferCount() == recomputed_window.GetBufferCount());
+        REQUIRE(window.GetFrameCount() == recomputed_window.GetFrameCount());
+        REQUIRE_THAT(window.GetEffectiveFps(), Catch::Matchers::WithinRel(recomputed_window.GetEffectiveFps(), 1e-12));
+        REQUIRE_THAT(
+            window.GetMeanLatencySeconds(),
+            Catch::Matchers::WithinRel(recomputed_window.GetMeanLatencySeconds(), 1e-12)
+        );
+    }
+}
+
+TEST_CASE("Core performance window doesn't drift over long runs", "[core_performance_window]") {
+    cpw::CorePerformanceWindow window;
+    // latencies that aren't exactly representable in seconds, added & removed a million times over
+    for (int64_t i_buffer = 0; i_buffer < 1'000'000; i_buffer++) {
+        window.Add(MakeSample(i_buffer, 100'001 + i_buffer % 7), kWindowDurationμs);
+    }
+    // latencies of the buffers left in the window, i.e. the last few
+    int64_t expected_latency_sum_μs = 0;
+    const auto buffer_count = static_cast<int64_t>(window.GetBufferCount());
+    for (int64_t i_buffer = 1'000'000 - buffer_count; i_buffer < 1'000'000; i_buffer++) {
+        expected_latency_sum_μs += 100'001 + i_buffer % 7;
+    }
+    REQUIRE(window.GetMeanLatencySeconds() ==
+            static_cast<double>(expected_latency_sum_μs) * 1e-6 / static_cast<double>(buffer_count));
+    REQUIRE(window.GetFrameCount() == buffer_count * 30);
+}
@@ -0,0 +1,279 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/opencv_core_inc.h>
+#include <mediapipe/framework/port/opencv_imgcodecs_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/video_source/file_stream/file_stream.hpp>
+#include <smartspectra/video_source/file_stream/frame_filename_matcher.hpp>
+#include <smartspectra/video_source/file_stream/frame_index.hpp>
+#include <smartspectra/video_source/file_stream/frame_prefetcher.hpp>
+#include <smartspectra/video_source/settings.hpp>
+#include <test_utilities/test_utilities.hpp>
+
+namespace vs = presage::smartspectra::video_source;
+namespace vs_fs = presage::smartspectra::video_source::file_stream;
+namespace test = presage::smartspectra::test;
+
+namespace {
+
+constexpr int64_t kFrameIntervalμs = 33'333;
+
+std::filesystem::path MakeEmptyDirectory(const std::string& name) {
+    const std::filesystem::path directory = std::filesystem::path(test::generated_test_data_directory.ToString()) / name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+std::filesystem::path GetFramePath(const std::filesystem::path& directory, int64_t i_frame) {
+    char filename[32];
+    std::snprintf(filename, sizeof(filename), "frame%013ld.png", static_cast<long>(i_frame * kFrameIntervalμs));
+    return directory / filename;
+}
+
+// tiny frames with the frame index as pixel value, so that frames can be told apart after reading them back in
+void WriteFrame(const std::filesystem::path& directory, int64_t i_frame) {
+    cv::imwrite(GetFramePath(directory, i_frame).string(), cv::Mat(6, 8, CV_8UC3, cv::Scalar::all(10 + i_frame)));
+}
+
+void WriteEndOfStream(const std::filesystem::path& directory) {
+    std::ofstream(directory / "end_of_stream");
+}
+
+vs::VideoSourceSettings MakeSettings(
+    const std::filesystem::path& directory,
+    bool watch_directory,
+    int prefetch_depth = 4
+) {
+    vs::VideoSourceSettings settings;
+    settings.file_stream_path = (directory / "frame0000000000000.png").string();
+    settings.input_transform_mode = vs::InputTransformMode::None;
+    settings.erase_read_files = true;
+    settings.loop = false;
+    settings.watch_file_stream_directory = watch_directory;
+    settings.file_stream_prefetch_depth = prefetch_depth;
+    return settings;
+}
+
+void RequireFrame(vs_fs::FileStreamVideoSource& source, int64_t i_frame) {
+    cv::Mat frame;
+    source >> frame;
+    REQUIRE_FALSE(frame.empty());
+    REQUIRE(frame.at<cv::Vec3b>(0, 0)[0] == 10 + i_frame);
+    REQUIRE(source.GetFrameTimestamp() == i_frame * kFrameIntervalμs);
+}
+
+// lets tests force a directory rescan, as happens when directory change notifications get lost
+class RescannableFileStreamVideoSource : public vs_fs::FileStreamVideoSource {
+public:
+    void Rescan() {
+        this->IndexScannedFrameFiles(this->ScanInputDirectory());
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("Frame filename matcher extracts timestamps from filenames that match the mask", "[file_stream]") {
+    auto matcher = vs_fs::FrameFilenameMatcher::FromMask("frame0000000000000.png");
+    REQUIRE(matcher.ok());
+    REQUIRE(matcher->Match("frame0000000033333.png") == 33333);
+    REQUIRE(matcher->Match("frame9999999999999.png") == 9'999'999'999'999);
+    // wrong digit count, non-digits in place of digits, wrong prefix, wrong extension
+    REQUIRE_FALSE(matcher->Match("frame000000033333.png").has_value());
+    REQUIRE_FALSE(matcher->Match("frame000000-033333.png").has_value());
+    REQUIRE_FALSE(matcher->Match("Frame0000000033333.png").has_value());
+    REQUIRE_FALSE(matcher->Match("frame0000000033333.jpg").has_value());
+    REQUIRE_FALSE(matcher->Match("frame0000000033333.png.tmp").has_value());
+    REQUIRE_FALSE(matcher->Match("end_of_stream").has_value());
+
+    SECTION("postfixes & multi-part extensions") {
+        auto postfix_matcher = vs_fs::FrameFilenameMatcher::FromMask("cam_0000_left.raw.gz");
+        REQUIRE(postfix_matcher.ok());
+        REQUIRE(postfix_matcher->Match("cam_0042_left.raw.gz") == 42);
+        REQUIRE_FALSE(postfix_matcher->Match("cam_0042_right.raw.gz").has_value());
+        // dots are literal
+        REQUIRE_FALSE(postfix_matcher->Match("cam_0042_left_raw_gz").has_value());
+    }
+    SECTION("timestamps that don't fit 64 bits don't match") {
+        auto wide_matcher = vs_fs::FrameFilenameMatcher::FromMask("f00000000000000000000.png");
+        REQUIRE(wide_matcher.ok());
+        REQUIRE_FALSE(wide_matcher->Match("f99999999999999999999.png").has_value());
+    }
+    SECTION("masks without digits or extension are rejected") {
+        REQUIRE(absl::IsInvalidArgument(vs_fs::FrameFilenameMatcher::FromMask("frame.png").status()));
+        REQUIRE(absl::IsInvalidArgument(vs_fs::FrameFilenameMatcher::FromMask("frame0000").status()));
+        REQUIRE(absl::IsInvalidArgument(vs_fs::FrameFilenameMatcher::FromMask("frame0000.").status()));
+    }
+}
+
+TEST_CASE("Frame index only hands out frames that are known to be complete", "[file_stream]") {
+    vs_fs::FrameIndex index;
+    REQUIRE(index.Add(200, "200.png", false));
+    // may still be being written
+    REQUIRE_FALSE(index.PopNextReadableFrame().has_value());
+    // out of order, but sorted by timestamp
+    REQUIRE(index.Add(100, "100.png", false));
+    REQUIRE(index.PopNextReadableFrame()->timestamp == 100);
+    REQUIRE_FALSE(index.PopNextReadableFrame().has_value());
+    // writer reported it's done with the frame
+    REQUIRE(index.Add(200, "200.png", true));
+    REQUIRE(index.PopNextReadableFrame()->path == "200.png");
+    // too late to be streamed
+    REQUIRE_FALSE(index.Add(150, "150.png", true));
+    REQUIRE(index.Size() == 0);
+
+    REQUIRE(index.Add(300, "300.png", false));
+    REQUIRE_FALSE(index.IsExhausted());
+    index.MarkEndOfStream();
+    REQUIRE(index.PopNextReadableFrame()->timestamp == 300);
+    REQUIRE(index.IsExhausted());
+}
+
+TEST_CASE("File stream picks up frames written while streaming", "[file_stream]") {
+    const bool watch_directory = GENERATE(true, false);
+    const int prefetch_depth = GENERATE(0, 4);
+    const std::filesystem::path directory = MakeEmptyDirectory(
+        std::string(watch_directory ? "file_stream_watched" : "file_stream_rescanned") + "_prefetch_" +
+        std::to_string(prefetch_depth)
+    );
+    vs_fs::FileStreamVideoSource source;
+    REQUIRE(source.Initialize(MakeSettings(directory, watch_directory, prefetch_depth)).ok());
+
+    constexpr int64_t kFrameCount = 5;
+    std::thread writer([&directory] {
+        for (int64_t i_frame = 0; i_frame < kFrameCount; i_frame++) {
+            WriteFrame(directory, i_frame);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        WriteEndOfStream(directory);
+    });
+    for (int64_t i_frame = 0; i_frame < kFrameCount; i_frame++) {
+        RequireFrame(source, i_frame);
+        if (i_frame > 0) {
+            REQUIRE_FALSE(std::filesystem::exists(GetFramePath(directory, i_frame - 1)));
+        }
+    }
+    writer.join();
+
+    cv::Mat frame;
+    source >> frame;
+    REQUIRE(frame.empty());
+    // everything erased, end-of-stream marker included
+    REQUIRE(std::filesystem::is_empty(directory));
+}
+
+TEST_CASE("File stream streams frames present at startup", "[file_stream]") {
+    const std::filesystem::path directory = MakeEmptyDirectory("file_stream_prepopulated");
+    for (int64_t i_frame = 0; i_frame < 3; i_frame++) {
+        WriteFrame(directory, i_frame);
+    }
+    vs_fs::FileStreamVideoSource source;
+    REQUIRE(source.Initialize(MakeSettings(directory, true)).ok());
+    REQUIRE(source.GetWidth() == 8);
+    REQUIRE(source.GetHeight() == 6);
+
+    RequireFrame(source, 0);
+    RequireFrame(source, 1);
+    // the last frame found by the startup scan may still have been being written: it is read once the end-of-stream
+    // marker shows up
+    WriteEndOfStream(directory);
+    RequireFrame(source, 2);
+    cv::Mat frame;
+    source >> frame;
+    REQUIRE(frame.empty());
+}
+
+TEST_CASE("File stream rescans leave frames scheduled for prefetching alone", "[file_stream]") {
+    const std::filesystem::path directory = MakeEmptyDirectory("file_stream_rescan_while_prefetching");
+    constexpr int64_t kFrameCount = 8;
+    for (int64_t i_frame = 0; i_frame < kFrameCount; i_frame++) {
+        WriteFrame(directory, i_frame);
+    }
+    RescannableFileStreamVideoSource source;
+    REQUIRE(source.Initialize(MakeSettings(directory, true, 4)).ok());
+
+    // frames 1-4 are scheduled for prefetching now, and no longer in the frame index
+    RequireFrame(source, 0);
+    source.Rescan();
+    for (int64_t i_frame = 0; i_frame < kFrameCount; i_frame++) {
+        REQUIRE(std::filesystem::exists(GetFramePath(directory, i_frame)));
+    }
+
+    WriteEndOfStream(directory);
+    for (int64_t i_frame = 1; i_frame < kFrameCount; i_frame++) {
+        RequireFrame(source, i_frame);
+    }
+    cv::Mat frame;
+    source >> frame;
+    REQUIRE(frame.empty());
+    REQUIRE(std::filesystem::is_empty(directory));
+}
+
+TEST_CASE("Frame prefetcher hands out decoded frames in scheduling order", "[file_stream]") {
+    const std::filesystem::path directory = MakeEmptyDirectory("frame_prefetcher");
+    constexpr int64_t kFrameCount = 8;
+    for (int64_t i_frame = 0; i_frame < kFrameCount; i_frame++) {
+        WriteFrame(directory, i_frame);
+    }
+    auto get_frame = [&directory](int64_t i_frame) {
+        return vs_fs::FrameIndex::Frame{i_frame * kFrameIntervalμs, GetFramePath(directory, i_frame)};
+    };
+
+    SECTION("decoding on several threads") {
+        vs_fs::FramePrefetcher prefetcher(3, 4, 64 * 1024 * 1024);
+        int64_t scheduled_frame_count = 0;
+        for (int64_t i_frame = 0; i_frame < kFrameCount; i_frame++) {
+            while (prefetcher.CanSchedule() && scheduled_frame_count < kFrameCount) {
+                prefetcher.Schedule(get_frame(scheduled_frame_count++));
+            }
+            REQUIRE(scheduled_frame_count - i_frame <= 4);
+            vs_fs::PrefetchedFrame frame = prefetcher.PopNextFrame();
+            REQUIRE(frame.timestamp == i_frame * kFrameIntervalμs);
+            REQUIRE(frame.path == GetFramePath(directory, i_frame));
+            REQUIRE(frame.image.at<cv::Vec3b>(0, 0)[0] == 10 + i_frame);
+        }
+        REQUIRE_FALSE(prefetcher.HasScheduledFrames());
+    }
+    SECTION("pixel buffers are recycled once released") {
+        vs_fs::FramePrefetcher prefetcher(1, 2, 64 * 1024 * 1024);
+        prefetcher.Schedule(get_frame(0));
+        vs_fs::PrefetchedFrame first_frame = prefetcher.PopNextFrame();
+        const uint8_t* first_frame_data = first_frame.image.data;
+        first_frame.image.release();
+        prefetcher.Schedule(get_frame(1));
+        vs_fs::PrefetchedFrame second_frame = prefetcher.PopNextFrame();
+        REQUIRE(second_frame.image.data == first_frame_data);
+        REQUIRE(second_frame.image.at<cv::Vec3b>(0, 0)[0] == 11);
+        // still in use: the next frame gets a buffer of its own
+        prefetcher.Schedule(get_frame(2));
+        REQUIRE(prefetcher.PopNextFrame().image.data != second_frame.image.data);
+    }
+    SECTION("the memory cap limits the depth, down to one frame") {
+        vs_fs::FramePrefetcher prefetcher(1, 4, 1);
+        prefetcher.Schedule(get_frame(0));
+        REQUIRE(prefetcher.PopNextFrame().image.total() == 6 * 8);
+        // now that the frame size is known
+        REQUIRE(prefetcher.CanSchedule());
+        prefetcher.Schedule(get_frame(1));
+        REQUIRE_FALSE(prefetcher.CanSchedule());
+    }
+    SECTION("unreadable files come out as empty frames") {
+        vs_fs::FramePrefetcher prefetcher(1, 4, 64 * 1024 * 1024);
+        prefetcher.Schedule({0, directory / "missing.png"});
+        REQUIRE(prefetcher.PopNextFrame().image.empty());
+    }
+}
@@ -0,0 +1,61 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <vector>
+// === third-party includes (if any) ===
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+// === local includes (if any) ===
+#include <smartspectra/container/frame_accounting.hpp>
+
+namespace fa = presage::smartspectra::container::frame_accounting;
+
+namespace {
+constexpr int64_t kFrameIntervalμs = 10'000;
+} // anonymous namespace
+
+TEST_CASE("Frame accounting aggregates drops per window", "[frame_accounting]") {
+    // 10 frames per window
+    fa::FrameAccounting accounting(9 * kFrameIntervalμs);
+    REQUIRE_FALSE(accounting.GetLastSummary().has_value());
+
+    // window 1: frames 2, 3 and 6 dropped; window 2: frames 10-12 dropped
+    const std::vector<bool> sent_through = {
+        true, true, false, false, true, true, false, true, true, true,
+        false, false, false, true, true, true, true, true, true, true
+    };
+    std::vector<fa::FrameAccountingSummary> summaries;
+    for (size_t i_frame = 0; i_frame < sent_through.size(); i_frame++) {
+        auto summary = accounting.Record(sent_through[i_frame], static_cast<int64_t>(i_frame) * kFrameIntervalμs);
+        if (summary.has_value()) summaries.push_back(summary.value());
+    }
+    REQUIRE(summaries.size() == 2);
+
+    const auto& first = summaries[0];
+    REQUIRE(first.window_start_timestamp == 0);
+    REQUIRE(first.window_end_timestamp == 9 * kFrameIntervalμs);
+    REQUIRE(first.sent_through_count == 7);
+    REQUIRE(first.dropped_count == 3);
+    REQUIRE(first.drop_run_count == 2);
+    REQUIRE(first.longest_drop_run == 2);
+    REQUIRE(first.longest_gap_μs == 3 * kFrameIntervalμs);
+    REQUIRE_THAT(first.drop_rate, Catch::Matchers::WithinAbs(0.3, 1e-12));
+
+    const auto& second = summaries[1];
+    REQUIRE(second.dropped_count == 3);
+    REQUIRE(second.drop_run_count == 1);
+    REQUIRE(second.longest_drop_run == 3);
+    // the gap spans the window boundary: last sent-through frame was frame 9
+    REQUIRE(second.longest_gap_μs == 4 * kFrameIntervalμs);
+    REQUIRE(second.total_dropped_count == 6);
+    REQUIRE(second.total_sent_through_count == 14);
+    REQUIRE_THAT(accounting.GetDropRate(), Catch::Matchers::WithinAbs(0.3, 1e-12));
+
+    accounting.Reset();
+    REQUIRE_FALSE(accounting.GetLastSummary().has_value());
+    REQUIRE(accounting.GetDropRate() == 0.0);
+}
@@ -0,0 +1,80 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <filesystem>
+#include <fstream>
+// === third-party includes (if any) ===
+#include <nlohmann/json.hpp>
+// === local includes (if any) ===
+#include <smartspectra/container/frame_tracer.hpp>
+#include <test_utilities/test_utilities.hpp>
+
+namespace ft = presage::smartspectra::container::frame_tracer;
+namespace test = presage::smartspectra::test;
+
+TEST_CASE("Frame tracer records nothing while disabled", "[frame_tracer]") {
+    ft::FrameTracer tracer;
+    {
+        ft::ScopedTraceSpan span(tracer, "FeedFrameToGraph", 1000);
+    }
+    tracer.RecordAsyncBegin("Graph", 1000);
+    REQUIRE(tracer.GetEventCount() == 0);
+}
+
+TEST_CASE("Frame tracer exports trace-event JSON linked by frame timestamp", "[frame_tracer]") {
+    ft::FrameTracer tracer;
+    tracer.SetEnabled(true);
+    {
+        ft::ScopedTraceSpan span(tracer, "CaptureFrame");
+        span.SetFrameTimestamp(33333);
+    }
+    tracer.RecordAsyncBegin("Graph", 33333);
+    tracer.RecordAsyncEnd("Graph", 33333);
+    tracer.RecordInstant("FrameDropped", 66666);
+
+    const auto trace = nlohmann::json::parse(tracer.ExportJson());
+    const auto& events = trace["traceEvents"];
+    REQUIRE(events.size() == 4);
+    REQUIRE(events[0]["name"] == "CaptureFrame");
+    REQUIRE(events[0]["ph"] == "X");
+    REQUIRE(events[0]["dur"].get<int64_t>() >= 0);
+    REQUIRE(events[0]["args"]["frame_timestamp"] == 33333);
+    REQUIRE(events[1]["ph"] == "b");
+    REQUIRE(events[2]["ph"] == "e");
+    REQUIRE(events[1]["id"] == events[2]["id"]);
+    REQUIRE(events[3]["ph"] == "i");
+
+    SECTION("flushing writes the file & empties the buffer") {
+        const auto trace_path =
+            std::filesystem::path(test::generated_test_data_directory.ToString()) / "frame_trace.json";
+        REQUIRE(tracer.Flush(trace_path.string()).ok());
+        REQUIRE(tracer.GetEventCount() == 0);
+        std::ifstream trace_file(trace_path);
+        REQUIRE(nlohmann::json::parse(trace_file)["traceEvents"].size() == 4);
+
+        // a later flush to the same path (e.g. the automatic one at shutdown) leaves the first file alone
+        tracer.RecordInstant("FrameDropped", 99999);
+        REQUIRE(tracer.Flush(trace_path.string()).ok());
+        std::ifstream first_trace_file(trace_path);
+        REQUIRE(nlohmann::json::parse(first_trace_file)["traceEvents"].size() == 4);
+        std::ifstream second_trace_file(trace_path.parent_path() / "frame_trace.1.json");
+        REQUIRE(nlohmann::json::parse(second_trace_file)["traceEvents"].size() == 1);
+    }
+}
+
+TEST_CASE("Frame tracer overwrites the oldest events when full", "[frame_tracer]") {
+    ft::FrameTracer tracer(3);
+    tracer.SetEnabled(true);
+    for (int64_t frame_timestamp = 0; frame_timestamp < 5; frame_timestamp++) {
+        tracer.RecordInstant("Frame", frame_timestamp);
+    }
+    REQUIRE(tracer.GetEventCount() == 3);
+    REQUIRE(tracer.GetOverwrittenEventCount() == 2);
+    const auto trace = nlohmann::json::parse(tracer.ExportJson());
+    REQUIRE(trace["traceEvents"][0]["args"]["frame_timestamp"] == 2);
+}
@@ -0,0 +1,112 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include <smartspectra/container/graph_config_cache.hpp>
+#include <test_utilities/stand_in_graph.hpp>
+#include <test_utilities/test_utilities.hpp>
+
+namespace gcc = presage::smartspectra::container::graph_config_cache;
+namespace test = presage::smartspectra::test;
+namespace stand_in = presage::smartspectra::test::stand_in_graph;
+
+namespace {
+
+std::filesystem::path WriteTextGraph(const std::string& file_name, const std::string& output_stream_name) {
+    std::filesystem::path graph_path = std::filesystem::path(test::generated_test_data_directory.ToString()) / file_name;
+    std::ofstream graph_file(graph_path);
+    graph_file << "input_stream: \"input\"\n"
+                  "output_stream: \"" << output_stream_name << "\"\n"
+                  "node {\n"
+                  "  calculator: \"PassThroughCalculator\"\n"
+                  "  input_stream: \"input\"\n"
+                  "  output_stream: \"" << output_stream_name << "\"\n"
+                  "}\n";
+    return graph_path;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Graph config cache parses each graph file once", "[graph_config_cache]") {
+    gcc::ClearGraphConfigCache();
+    const auto graph_path = WriteTextGraph("cached_graph.pbtxt", "output");
+
+    auto first = gcc::GetGraphConfig(graph_path.string(), true, false);
+    REQUIRE(first.ok());
+    REQUIRE((*first)->output_stream(0) == "output");
+    auto second = gcc::GetGraphConfig(graph_path.string(), true, false);
+    REQUIRE(second.ok());
+    REQUIRE(second->get() == first->get());
+    REQUIRE(gcc::GetGraphConfigCacheStatistics().hit_count == 1);
+    REQUIRE(gcc::GetGraphConfigCacheStatistics().miss_count == 1);
+
+    SECTION("settings that affect parsing get separate entries") {
+        auto unscaled = gcc::GetGraphConfig(graph_path.string(), false, false);
+        REQUIRE(unscaled.ok());
+        REQUIRE(unscaled->get() != first->get());
+        REQUIRE(gcc::GetGraphConfigCacheStatistics().entry_count == 2);
+    }
+
+    SECTION("modified files get reloaded") {
+        WriteTextGraph("cached_graph.pbtxt", "modified_output");
+        // make sure the modification time changes even on file systems with coarse timestamps
+        std::filesystem::last_write_time(
+            graph_path, std::filesystem::last_write_time(graph_path) + std::chrono::seconds(2)
+        );
+        auto reloaded = gcc::GetGraphConfig(graph_path.string(), true, false);
+        REQUIRE(reloaded.ok());
+        REQUIRE((*reloaded)->output_stream(0) == "modified_output");
+        // the stale entry is evicted
+        REQUIRE(gcc::GetGraphConfigCacheStatistics().entry_count == 1);
+    }
+}
+
+TEST_CASE("Graph config cache reports missing & malformed files", "[graph_config_cache]") {
+    gcc::ClearGraphConfigCache();
+    REQUIRE_FALSE(gcc::GetGraphConfig("/nonexistent/graph.pbtxt", true, false).ok());
+
+    const auto graph_path =
+        std::filesystem::path(test::generated_test_data_directory.ToString()) / "malformed_graph.pbtxt";
+    std::ofstream(graph_path) << "node { calculator: ";
+    REQUIRE_FALSE(gcc::GetGraphConfig(graph_path.string(), true, false).ok());
+    REQUIRE_FALSE(gcc::GetGraphConfig(graph_path.string(), true, true).ok());
+    REQUIRE(gcc::GetGraphConfigCacheStatistics().entry_count == 0);
+}
+
+TEST_CASE("Stand-in graph file is only rewritten when it changes, so it stays cached", "[graph_config_cache]") {
+    gcc::ClearGraphConfigCache();
+    const std::filesystem::path directory(test::generated_test_data_directory.ToString());
+    const auto graph_path = stand_in::WriteStandInGraph(directory, false);
+    REQUIRE(graph_path.ok());
+    REQUIRE(gcc::GetGraphConfig(graph_path->string(), true, false).ok());
+    const auto modification_time = std::filesystem::last_write_time(*graph_path);
+
+    // what every stand-in container does on initialization
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    const auto rewritten_graph_path = stand_in::WriteStandInGraph(directory, false);
+    REQUIRE(rewritten_graph_path.ok());
+    REQUIRE(*rewritten_graph_path == *graph_path);
+    REQUIRE(std::filesystem::last_write_time(*graph_path) == modification_time);
+    REQUIRE(gcc::GetGraphConfig(graph_path->string(), true, false).ok());
+    REQUIRE(gcc::GetGraphConfigCacheStatistics().hit_count == 1);
+    REQUIRE(gcc::GetGraphConfigCacheStatistics().miss_count == 1);
+
+    SECTION("stale files get replaced") {
+        std::ofstream(*graph_path) << "# outdated\n";
+        REQUIRE(stand_in::WriteStandInGraph(directory, false).ok());
+        auto config = gcc::GetGraphConfig(graph_path->string(), true, false);
+        REQUIRE(config.ok());
+        REQUIRE((*config)->node_size() > 0);
+    }
+}
@@ -0,0 +1,76 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <vector>
+// === third-party includes (if any) ===
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <mediapipe/framework/calculator.pb.h>
+#include <mediapipe/framework/calculator_profile.pb.h>
+// === local includes (if any) ===
+#include <smartspectra/container/graph_profiling.hpp>
+
+namespace gp = presage::smartspectra::container::graph_profiling;
+namespace settings = presage::smartspectra::container::settings;
+
+namespace {
+
+// interval_size_usec-wide buckets with the given counts
+void FillHistogram(mediapipe::TimeHistogram& histogram, int64_t interval_size_μs, const std::vector<int64_t>& counts) {
+    histogram.set_interval_size_usec(interval_size_μs);
+    histogram.set_num_intervals(static_cast<int64_t>(counts.size()));
+    int64_t total_μs = 0;
+    for (size_t i_interval = 0; i_interval < counts.size(); i_interval++) {
+        histogram.add_count(counts[i_interval]);
+        // assume samples sit at the middle of their interval
+        total_μs += counts[i_interval] * (static_cast<int64_t>(i_interval) * interval_size_μs + interval_size_μs / 2);
+    }
+    histogram.set_total(total_μs);
+}
+
+} // anonymous namespace
+
+TEST_CASE("Graph profiler settings are injected into the config", "[graph_profiling]") {
+    mediapipe::CalculatorGraphConfig config;
+    settings::GraphProfilerSettings profiler_settings;
+    gp::ApplyGraphProfilerSettings(config, profiler_settings);
+    REQUIRE_FALSE(config.has_profiler_config());
+
+    profiler_settings.enable = true;
+    profiler_settings.histogram_interval_size_μs = 500;
+    profiler_settings.histogram_interval_count = 20;
+    profiler_settings.trace_log_path = "/tmp/smartspectra_trace_";
+    gp::ApplyGraphProfilerSettings(config, profiler_settings);
+    REQUIRE(config.profiler_config().enable_profiler());
+    REQUIRE(config.profiler_config().histogram_interval_size_usec() == 500);
+    REQUIRE(config.profiler_config().num_histogram_intervals() == 20);
+    REQUIRE(config.profiler_config().trace_enabled());
+    REQUIRE(config.profiler_config().trace_log_path() == "/tmp/smartspectra_trace_");
+}
+
+TEST_CASE("Calculator profiles are summarized & sorted by total process time", "[graph_profiling]") {
+    std::vector<mediapipe::CalculatorProfile> profiles(2);
+    profiles[0].set_name("FastCalculator");
+    FillHistogram(*profiles[0].mutable_process_runtime(), 1000, {100});
+    profiles[1].set_name("SlowCalculator");
+    // 90 calls in [0, 1) ms, 10 calls in [4, 5) ms
+    FillHistogram(*profiles[1].mutable_process_runtime(), 1000, {90, 0, 0, 0, 10});
+    FillHistogram(*profiles[1].mutable_process_input_latency(), 1000, {50, 50});
+
+    const auto summaries = gp::SummarizeCalculatorProfiles(profiles);
+    REQUIRE(summaries.size() == 2);
+    REQUIRE(summaries[0].calculator_name == "SlowCalculator");
+    REQUIRE(summaries[0].process_call_count == 100);
+    REQUIRE_THAT(summaries[0].mean_process_time_μs, Catch::Matchers::WithinAbs(900.0, 1e-9));
+    // the p95 call falls into the last (open-ended) interval, so it's reported at its lower bound
+    REQUIRE_THAT(summaries[0].p95_process_time_μs, Catch::Matchers::WithinAbs(4000.0, 1e-9));
+    REQUIRE_THAT(summaries[0].mean_queue_time_μs, Catch::Matchers::WithinAbs(1000.0, 1e-9));
+    REQUIRE_THAT(summaries[0].p95_queue_time_μs, Catch::Matchers::WithinAbs(1000.0, 1e-9));
+    REQUIRE(summaries[1].calculator_name == "FastCalculator");
+    REQUIRE(summaries[1].mean_queue_time_μs == 0.0);
+    REQUIRE_FALSE(gp::FormatCalculatorTimingSummaries(summaries).empty());
+}
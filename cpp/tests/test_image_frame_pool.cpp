@@ -0,0 +1,135 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <cstring>
+#include <memory>
+#include <vector>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/formats/image_frame.h>
+// === local includes (if any) ===
+#include <smartspectra/container/image_frame_pool.hpp>
+
+namespace ifp = presage::smartspectra::container::image_frame_pool;
+
+namespace {
+
+constexpr int kWidth = 33;
+constexpr int kHeight = 17;
+
+// SRGB rows are padded up to the default alignment boundary
+size_t GetSrgbByteCount(int width, int height) {
+    const size_t alignment_boundary = mediapipe::ImageFrame::kDefaultAlignmentBoundary;
+    const size_t width_step = (static_cast<size_t>(width) * 3 + alignment_boundary - 1) / alignment_boundary *
+                              alignment_boundary;
+    return width_step * static_cast<size_t>(height);
+}
+
+} // anonymous namespace
+
+TEST_CASE("Image frame pool recycles buffers of released frames", "[image_frame_pool]") {
+    ifp::ImageFramePool pool;
+    auto frame = pool.Acquire(mediapipe::ImageFormat::SRGB, kWidth, kHeight);
+    REQUIRE(frame->Width() == kWidth);
+    REQUIRE(frame->Height() == kHeight);
+    REQUIRE(frame->Format() == mediapipe::ImageFormat::SRGB);
+    REQUIRE(frame->WidthStep() % mediapipe::ImageFrame::kDefaultAlignmentBoundary == 0);
+    // the whole buffer is writable
+    std::memset(frame->MutablePixelData(), 0xAB, static_cast<size_t>(frame->WidthStep()) * kHeight);
+    const uint8_t* first_buffer = frame->PixelData();
+
+    auto statistics = pool.GetStatistics();
+    REQUIRE(statistics.miss_count == 1);
+    REQUIRE(statistics.hit_count == 0);
+    REQUIRE(statistics.outstanding_buffer_count == 1);
+    REQUIRE(statistics.idle_buffer_count == 0);
+    REQUIRE(statistics.allocated_byte_count == GetSrgbByteCount(kWidth, kHeight));
+
+    frame.reset();
+    statistics = pool.GetStatistics();
+    REQUIRE(statistics.outstanding_buffer_count == 0);
+    REQUIRE(statistics.idle_buffer_count == 1);
+    // idle buffers are retained, not freed
+    REQUIRE(statistics.allocated_byte_count == GetSrgbByteCount(kWidth, kHeight));
+
+    auto recycled_frame = pool.Acquire(mediapipe::ImageFormat::SRGB, kWidth, kHeight);
+    REQUIRE(recycled_frame->PixelData() == first_buffer);
+    statistics = pool.GetStatistics();
+    REQUIRE(statistics.hit_count == 1);
+    REQUIRE(statistics.miss_count == 1);
+    REQUIRE(statistics.outstanding_buffer_count == 1);
+    REQUIRE(statistics.idle_buffer_count == 0);
+
+    SECTION("Clear frees idle buffers only") {
+        auto another_frame = pool.Acquire(mediapipe::ImageFormat::SRGB, kWidth, kHeight);
+        another_frame.reset();
+        REQUIRE(pool.GetStatistics().idle_buffer_count == 1);
+        pool.Clear();
+        statistics = pool.GetStatistics();
+        REQUIRE(statistics.idle_buffer_count == 0);
+        REQUIRE(statistics.outstanding_buffer_count == 1);
+        REQUIRE(statistics.allocated_byte_count == GetSrgbByteCount(kWidth, kHeight));
+    }
+}
+
+TEST_CASE("Image frame pool only recycles buffers of the same size & format", "[image_frame_pool]") {
+    ifp::ImageFramePool pool;
+    pool.Acquire(mediapipe::ImageFormat::SRGB, kWidth, kHeight).reset();
+    REQUIRE(pool.GetStatistics().idle_buffer_count == 1);
+
+    // each of these differs from the idle buffer in one part of the key
+    std::vector<std::unique_ptr<mediapipe::ImageFrame>> frames;
+    frames.push_back(pool.Acquire(mediapipe::ImageFormat::SRGBA, kWidth, kHeight));
+    frames.push_back(pool.Acquire(mediapipe::ImageFormat::SRGB, kWidth + 1, kHeight));
+    frames.push_back(pool.Acquire(mediapipe::ImageFormat::SRGB, kWidth, kHeight + 1));
+    frames.push_back(pool.Acquire(mediapipe::ImageFormat::SRGB, kWidth, kHeight, 1));
+    auto statistics = pool.GetStatistics();
+    REQUIRE(statistics.hit_count == 0);
+    REQUIRE(statistics.miss_count == 5);
+    REQUIRE(statistics.idle_buffer_count == 1);
+    REQUIRE(frames[0]->Format() == mediapipe::ImageFormat::SRGBA);
+    REQUIRE(frames[1]->Width() == kWidth + 1);
+    REQUIRE(frames[2]->Height() == kHeight + 1);
+    REQUIRE(frames[3]->WidthStep() == kWidth * 3);
+
+    // the matching request still gets the idle buffer
+    auto frame = pool.Acquire(mediapipe::ImageFormat::SRGB, kWidth, kHeight);
+    REQUIRE(pool.GetStatistics().hit_count == 1);
+}
+
+TEST_CASE("Image frame pool retains at most the maximum of idle buffers per size & format", "[image_frame_pool]") {
+    constexpr size_t kMaxIdleBuffers = 2;
+    constexpr size_t kFrameCount = kMaxIdleBuffers + 3;
+    ifp::ImageFramePool pool(kMaxIdleBuffers);
+    std::vector<std::unique_ptr<mediapipe::ImageFrame>> frames;
+    for (size_t i_frame = 0; i_frame < kFrameCount; i_frame++) {
+        frames.push_back(pool.Acquire(mediapipe::ImageFormat::SRGB, kWidth, kHeight));
+    }
+    REQUIRE(pool.GetStatistics().allocated_byte_count == kFrameCount * GetSrgbByteCount(kWidth, kHeight));
+    frames.clear();
+
+    auto statistics = pool.GetStatistics();
+    REQUIRE(statistics.outstanding_buffer_count == 0);
+    REQUIRE(statistics.idle_buffer_count == kMaxIdleBuffers);
+    REQUIRE(statistics.discard_count == kFrameCount - kMaxIdleBuffers);
+    REQUIRE(statistics.allocated_byte_count == kMaxIdleBuffers * GetSrgbByteCount(kWidth, kHeight));
+
+    // the limit is per size & format
+    pool.Acquire(mediapipe::ImageFormat::SRGBA, kWidth, kHeight).reset();
+    REQUIRE(pool.GetStatistics().idle_buffer_count == kMaxIdleBuffers + 1);
+}
+
+TEST_CASE("Image frames outlive the pool that handed them out", "[image_frame_pool]") {
+    auto pool = std::make_unique<ifp::ImageFramePool>();
+    auto frame = pool->Acquire(mediapipe::ImageFormat::SRGB, kWidth, kHeight);
+    pool->Acquire(mediapipe::ImageFormat::SRGB, kWidth, kHeight).reset();
+    pool.reset();
+    // the buffer is still valid; releasing it afterwards frees it instead of returning it to the destroyed pool
+    std::memset(frame->MutablePixelData(), 0xCD, static_cast<size_t>(frame->WidthStep()) * kHeight);
+    REQUIRE(frame->PixelData()[0] == 0xCD);
+    frame.reset();
+}
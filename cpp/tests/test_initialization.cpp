@@ -0,0 +1,84 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <string>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/calculator.pb.h>
+#include <mediapipe/framework/port/parse_text_proto.h>
+// === local includes (if any) ===
+#include <smartspectra/container/initialization.hpp>
+
+namespace init = presage::smartspectra::container::initialization;
+
+namespace {
+
+mediapipe::CalculatorGraphConfig ParseGraph(const std::string& contents) {
+    mediapipe::CalculatorGraphConfig config;
+    REQUIRE(mediapipe::ParseTextProto(contents, &config));
+    return config;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Input scaling size comes from the transformation consuming the input stream", "[initialization]") {
+    // a transformation further down the graph (e.g. a face crop) mustn't be mistaken for the input scaling
+    const std::string crop_node =
+        "node {\n"
+        "  calculator: \"ImageTransformationCalculator\"\n"
+        "  input_stream: \"IMAGE:face_crop\"\n"
+        "  output_stream: \"IMAGE:scaled_face_crop\"\n"
+        "  options: { [mediapipe.ImageTransformationCalculatorOptions.ext] { output_width: 32 output_height: 32 } }\n"
+        "}\n";
+
+    SECTION("legacy options") {
+        auto config = ParseGraph(
+            crop_node +
+            "node {\n"
+            "  calculator: \"ImageTransformationCalculator\"\n"
+            "  input_stream: \"IMAGE:input_video\"\n"
+            "  output_stream: \"IMAGE:scaled_video\"\n"
+            "  options: { [mediapipe.ImageTransformationCalculatorOptions.ext] { output_width: 640 output_height: 360 } }\n"
+            "}\n"
+        );
+        auto size = init::GetInputScalingSize(config, "input_video");
+        REQUIRE(size.has_value());
+        REQUIRE(*size == cv::Size(640, 360));
+    }
+
+    SECTION("node options") {
+        auto config = ParseGraph(
+            "node {\n"
+            "  calculator: \"ImageTransformationCalculator\"\n"
+            "  input_stream: \"IMAGE:input_video\"\n"
+            "  output_stream: \"IMAGE:scaled_video\"\n"
+            "  node_options: {\n"
+            "    [type.googleapis.com/mediapipe.ImageTransformationCalculatorOptions] {\n"
+            "      output_width: 320 output_height: 240\n"
+            "    }\n"
+            "  }\n"
+            "}\n"
+        );
+        auto size = init::GetInputScalingSize(config, "input_video");
+        REQUIRE(size.has_value());
+        REQUIRE(*size == cv::Size(320, 240));
+    }
+
+    SECTION("no input scaling") {
+        // e.g. stripped out with scale_input off
+        auto config = ParseGraph(
+            crop_node +
+            "node {\n"
+            "  calculator: \"ImageTransformationCalculator\"\n"
+            "  input_stream: \"IMAGE:input_video\"\n"
+            "  output_stream: \"IMAGE:scaled_video\"\n"
+            "  options: { [mediapipe.ImageTransformationCalculatorOptions.ext] { output_width: 0 output_height: 0 } }\n"
+            "}\n"
+        );
+        REQUIRE_FALSE(init::GetInputScalingSize(config, "input_video").has_value());
+    }
+}
@@ -0,0 +1,91 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <thread>
+#include <vector>
+// === third-party includes (if any) ===
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+// === local includes (if any) ===
+#include <smartspectra/container/latency_histogram.hpp>
+#include <smartspectra/container/ring_buffer.hpp>
+
+namespace lh = presage::smartspectra::container::latency_histogram;
+namespace rb = presage::smartspectra::container::ring_buffer;
+
+TEST_CASE("Latency histogram quantiles stay within relative precision", "[latency_histogram]") {
+    lh::LatencyHistogram histogram(1e-5, 1e3, 0.01);
+    REQUIRE(histogram.Quantile(0.5) == 0.0);
+    // 1 ms .. 1000 ms
+    for (int value_ms = 1; value_ms <= 1000; value_ms++) {
+        histogram.Add(value_ms * 0.001);
+    }
+    REQUIRE(histogram.Count() == 1000);
+    REQUIRE_THAT(histogram.Quantile(0.50), Catch::Matchers::WithinRel(0.500, 0.011));
+    REQUIRE_THAT(histogram.Quantile(0.95), Catch::Matchers::WithinRel(0.950, 0.011));
+    REQUIRE_THAT(histogram.Quantile(0.99), Catch::Matchers::WithinRel(0.990, 0.011));
+
+    SECTION("removed values no longer count") {
+        for (int value_ms = 501; value_ms <= 1000; value_ms++) {
+            histogram.Remove(value_ms * 0.001);
+        }
+        REQUIRE(histogram.Count() == 500);
+        REQUIRE_THAT(histogram.Quantile(0.99), Catch::Matchers::WithinRel(0.495, 0.011));
+    }
+}
+
+TEST_CASE("Atomic latency histogram matches the single-threaded one", "[latency_histogram]") {
+    lh::LatencyHistogram histogram(1e-5, 1e3, 0.01);
+    lh::AtomicLatencyHistogram atomic_histogram(1e-5, 1e3, 0.01);
+    REQUIRE(atomic_histogram.Snapshot().Count() == 0);
+    for (int value_ms = 1; value_ms <= 1000; value_ms++) {
+        histogram.Add(value_ms * 0.001);
+        atomic_histogram.Add(value_ms * 0.001);
+    }
+    const lh::LatencyHistogram snapshot = atomic_histogram.Snapshot();
+    REQUIRE(snapshot.Count() == histogram.Count());
+    for (double quantile: {0.0, 0.5, 0.95, 0.99, 1.0}) {
+        REQUIRE(snapshot.Quantile(quantile) == histogram.Quantile(quantile));
+    }
+
+    atomic_histogram.Clear();
+    REQUIRE(atomic_histogram.Snapshot().Count() == 0);
+}
+
+TEST_CASE("Atomic latency histogram supports concurrent adding", "[latency_histogram]") {
+    lh::AtomicLatencyHistogram atomic_histogram;
+    constexpr int kThreadCount = 4;
+    constexpr int kValuesPerThread = 10000;
+    std::vector<std::thread> threads;
+    for (int i_thread = 0; i_thread < kThreadCount; i_thread++) {
+        threads.emplace_back([&atomic_histogram]() {
+            for (int i_value = 0; i_value < kValuesPerThread; i_value++) {
+                atomic_histogram.Add(i_value * 1e-4);
+            }
+        });
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    REQUIRE(atomic_histogram.Snapshot().Count() == kThreadCount * kValuesPerThread);
+}
+
+TEST_CASE("Ring buffer overwrites oldest elements when full", "[ring_buffer]") {
+    rb::RingBuffer<int> buffer(3);
+    int evicted = -1;
+    REQUIRE_FALSE(buffer.PushBack(1, &evicted));
+    REQUIRE_FALSE(buffer.PushBack(2, &evicted));
+    REQUIRE_FALSE(buffer.PushBack(3, &evicted));
+    REQUIRE(buffer.Full());
+    REQUIRE(buffer.PushBack(4, &evicted));
+    REQUIRE(evicted == 1);
+    REQUIRE(buffer.Front() == 2);
+    REQUIRE(buffer.Back() == 4);
+    REQUIRE(buffer.PopFront() == 2);
+    REQUIRE(buffer.Size() == 2);
+    REQUIRE(buffer[1] == 4);
+}
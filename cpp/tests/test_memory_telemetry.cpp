@@ -0,0 +1,160 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/container/frame_accounting.hpp>
+#include <smartspectra/container/frame_tracer.hpp>
+#include <smartspectra/container/latency_histogram.hpp>
+#include <smartspectra/container/memory_telemetry.hpp>
+#include <smartspectra/container/pipeline_stage_telemetry.hpp>
+#include <smartspectra/container/ring_buffer.hpp>
+
+namespace spc = presage::smartspectra::container;
+namespace mt = presage::smartspectra::container::memory_telemetry;
+
+namespace {
+
+constexpr int kFrameCount = 1000;
+constexpr int64_t kFrameIntervalμs = 33'333;
+
+template<typename TFunction>
+uint64_t CountAllocations(TFunction&& function) {
+    const uint64_t allocation_count_before = mt::GetAllocationCounters().allocation_count;
+    function();
+    return mt::GetAllocationCounters().allocation_count - allocation_count_before;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Allocation hooks count heap allocations", "[memory_telemetry]") {
+    // this test executable links SmartSpectra::AllocationHooks
+    REQUIRE(mt::IsAllocationTrackingAvailable());
+    const mt::AllocationCounters before = mt::GetAllocationCounters();
+    auto values = std::make_unique<std::vector<int64_t>>(256);
+    const mt::AllocationCounters after = mt::GetAllocationCounters();
+    REQUIRE(after.allocation_count - before.allocation_count == 2);
+    REQUIRE(after.allocated_bytes - before.allocated_bytes >= 256 * sizeof(int64_t));
+}
+
+TEST_CASE("Allocation hooks count cv::Mat pixel buffers", "[memory_telemetry]") {
+    REQUIRE(mt::IsAllocationTrackingAvailable());
+    constexpr int kRows = 120;
+    constexpr int kColumns = 160;
+    const mt::AllocationCounters before = mt::GetAllocationCounters();
+    cv::Mat mat(kRows, kColumns, CV_8UC3);
+    const mt::AllocationCounters after = mt::GetAllocationCounters();
+    // the pixel buffer (via cv::fastMalloc) & its header (via operator new)
+    REQUIRE(after.allocation_count - before.allocation_count >= 2);
+    REQUIRE(after.allocated_bytes - before.allocated_bytes >= static_cast<uint64_t>(kRows * kColumns * 3));
+
+    // wrapping external data doesn't allocate a buffer
+    std::vector<uint8_t> external_pixels(kRows * kColumns * 3);
+    const mt::AllocationCounters before_wrapping = mt::GetAllocationCounters();
+    cv::Mat wrapping_mat(kRows, kColumns, CV_8UC3, external_pixels.data());
+    REQUIRE(mt::GetAllocationCounters().allocated_bytes - before_wrapping.allocated_bytes <
+            static_cast<uint64_t>(kRows * kColumns * 3));
+}
+
+TEST_CASE("Memory telemetry reports allocations per frame", "[memory_telemetry]") {
+    mt::MemoryTelemetry telemetry;
+    std::vector<std::unique_ptr<int64_t>> allocations;
+    allocations.reserve(kFrameCount);
+    telemetry.Reset();
+    for (int i_frame = 0; i_frame < kFrameCount; i_frame++) {
+        telemetry.RecordFrame();
+        allocations.push_back(std::make_unique<int64_t>(i_frame));
+    }
+    const mt::MemoryTelemetrySnapshot snapshot = telemetry.Snapshot();
+    REQUIRE(snapshot.allocation_tracking_available);
+    REQUIRE(snapshot.frame_count == kFrameCount);
+    REQUIRE(snapshot.allocation_count == kFrameCount);
+    REQUIRE(snapshot.allocations_per_frame == 1.0);
+    REQUIRE(snapshot.bytes_per_frame >= sizeof(int64_t));
+
+    telemetry.Reset();
+    REQUIRE(telemetry.Snapshot().frame_count == 0);
+    REQUIRE(telemetry.Snapshot().allocations_per_frame == 0.0);
+}
+
+TEST_CASE("Resident set size sampler", "[memory_telemetry]") {
+#if defined(__linux__) || defined(__APPLE__)
+    const int64_t current_resident_set_size = mt::GetCurrentResidentSetSizeBytes();
+    const int64_t peak_resident_set_size = mt::GetPeakResidentSetSizeBytes();
+    REQUIRE(current_resident_set_size > 0);
+    REQUIRE(peak_resident_set_size >= current_resident_set_size);
+
+    // touch every page, so that the buffer actually becomes resident
+    constexpr size_t kBufferSize = 64 * 1024 * 1024;
+    std::vector<uint8_t> buffer(kBufferSize, 1);
+    REQUIRE(mt::GetPeakResidentSetSizeBytes() >= static_cast<int64_t>(kBufferSize));
+#endif
+}
+
+// the per-frame bookkeeping the containers do on the hot path must not allocate once it's warmed up
+TEST_CASE("Container hot-path bookkeeping doesn't allocate in steady state", "[memory_telemetry]") {
+    SECTION("ring buffer") {
+        spc::ring_buffer::RingBuffer<int64_t> ring_buffer(64);
+        int64_t evicted = 0;
+        REQUIRE(CountAllocations([&] {
+            for (int64_t i_frame = 0; i_frame < kFrameCount; i_frame++) {
+                ring_buffer.PushBack(i_frame, &evicted);
+            }
+        }) == 0);
+    }
+    SECTION("latency histogram") {
+        spc::latency_histogram::LatencyHistogram histogram;
+        double quantile = 0.0;
+        REQUIRE(CountAllocations([&] {
+            for (int i_frame = 0; i_frame < kFrameCount; i_frame++) {
+                histogram.Add(0.001 * i_frame);
+                if (i_frame >= 100) histogram.Remove(0.001 * (i_frame - 100));
+            }
+            quantile = histogram.Quantile(0.99);
+        }) == 0);
+        REQUIRE(quantile > 0.0);
+    }
+    SECTION("pipeline stage telemetry") {
+        spc::pipeline_stage_telemetry::PipelineStageTelemetry telemetry;
+        telemetry.SetEnabled(true);
+        REQUIRE(CountAllocations([&] {
+            for (int i_frame = 0; i_frame < kFrameCount; i_frame++) {
+                telemetry.Record(
+                    spc::pipeline_stage_telemetry::PipelineStage::GraphFeed, std::chrono::microseconds(i_frame)
+                );
+            }
+        }) == 0);
+    }
+    SECTION("frame tracer") {
+        spc::frame_tracer::FrameTracer tracer(256);
+        tracer.SetEnabled(true);
+        // first use assigns the thread its trace id
+        tracer.RecordInstant("WarmUp", 0);
+        REQUIRE(CountAllocations([&] {
+            for (int64_t i_frame = 0; i_frame < kFrameCount; i_frame++) {
+                const int64_t now_μs = spc::frame_tracer::FrameTracer::NowMicroseconds();
+                tracer.RecordSpan("Frame", now_μs, now_μs + 1, i_frame * kFrameIntervalμs);
+                tracer.RecordAsyncBegin("Graph", i_frame * kFrameIntervalμs);
+                tracer.RecordAsyncEnd("Graph", i_frame * kFrameIntervalμs);
+            }
+        }) == 0);
+    }
+    SECTION("frame accounting") {
+        spc::frame_accounting::FrameAccounting accounting(1'000'000);
+        REQUIRE(CountAllocations([&] {
+            for (int i_frame = 0; i_frame < kFrameCount; i_frame++) {
+                accounting.Record(i_frame % 10 != 0, i_frame * kFrameIntervalμs);
+            }
+        }) == 0);
+    }
+}
@@ -0,0 +1,141 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include <smartspectra/container/metrics_exporter.hpp>
+#include <test_utilities/test_utilities.hpp>
+
+namespace me = presage::smartspectra::container::metrics_exporter;
+namespace test = presage::smartspectra::test;
+
+namespace {
+
+bool Contains(const std::string& text, const std::string& line) {
+    return text.find(line) != std::string::npos;
+}
+
+std::shared_ptr<me::RuntimeMetrics> MakeRecordedMetrics() {
+    auto metrics = std::make_shared<me::RuntimeMetrics>();
+    for (int i_frame = 0; i_frame < 9; i_frame++) {
+        metrics->RecordFrameLeftGraph(true);
+    }
+    metrics->RecordFrameLeftGraph(false);
+    metrics->RecordFramesDroppedBeforeGraph(2);
+    metrics->SetFramesInFlight(3);
+    metrics->RecordMetricsBuffer(15);
+    metrics->RecordCorePerformance(29.5, 0.3);
+    metrics->RecordCorePerformance(29.5, 0.05);
+    metrics->RecordStatusChange(3);
+    metrics->RecordStatusChange(0);
+    metrics->RecordStatusChange(3);
+    return metrics;
+}
+
+std::string HttpGet(uint16_t port, const std::string& method = "GET") {
+    const int client_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    REQUIRE(::connect(client_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+    const std::string request = method + " /metrics HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    REQUIRE(::send(client_socket, request.data(), request.size(), 0) == static_cast<ssize_t>(request.size()));
+    std::string response;
+    char buffer[1024];
+    ssize_t received_byte_count;
+    while ((received_byte_count = ::recv(client_socket, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<size_t>(received_byte_count));
+    }
+    ::close(client_socket);
+    return response;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Runtime metrics render in OpenMetrics text format", "[metrics_exporter]") {
+    const std::string text = MakeRecordedMetrics()->FormatOpenMetrics("test");
+    REQUIRE(Contains(text, "# TYPE test_frames_sent_through counter\n"));
+    REQUIRE(Contains(text, "test_frames_sent_through_total 9\n"));
+    REQUIRE(Contains(text, "test_frames_dropped_in_graph_total 1\n"));
+    REQUIRE(Contains(text, "test_frames_dropped_before_graph_total 2\n"));
+    REQUIRE(Contains(text, "test_frame_drop_ratio 0.1\n"));
+    REQUIRE(Contains(text, "test_frames_in_flight 3\n"));
+    REQUIRE(Contains(text, "test_metrics_buffer_frames_total 15\n"));
+    REQUIRE(Contains(text, "test_effective_core_fps 29.5\n"));
+    // histogram buckets are cumulative, with canonical float bounds
+    REQUIRE(Contains(text, "test_core_latency_seconds_bucket{le=\"0.05\"} 1\n"));
+    REQUIRE(Contains(text, "test_core_latency_seconds_bucket{le=\"0.25\"} 1\n"));
+    REQUIRE(Contains(text, "test_core_latency_seconds_bucket{le=\"0.5\"} 2\n"));
+    REQUIRE(Contains(text, "test_core_latency_seconds_bucket{le=\"1.0\"} 2\n"));
+    REQUIRE(Contains(text, "test_core_latency_seconds_bucket{le=\"+Inf\"} 2\n"));
+    REQUIRE(Contains(text, "test_core_latency_seconds_count 2\n"));
+    REQUIRE(Contains(text, "test_core_latency_seconds_sum 0.35\n"));
+    REQUIRE(Contains(text, "test_status_code 3\n"));
+    REQUIRE(Contains(text, "test_status_changes_total{code=\"0\"} 1\n"));
+    REQUIRE(Contains(text, "test_status_changes_total{code=\"3\"} 2\n"));
+    REQUIRE(text.size() >= 6);
+    REQUIRE(text.substr(text.size() - 6) == "# EOF\n");
+}
+
+TEST_CASE("Metrics exporter serves metrics over loopback HTTP", "[metrics_exporter]") {
+    auto metrics = MakeRecordedMetrics();
+    me::MetricsExporter exporter(metrics);
+    REQUIRE(exporter.StartHttpServer(0).ok());
+    const uint16_t port = exporter.GetHttpPort();
+    REQUIRE(port != 0);
+    REQUIRE_FALSE(exporter.StartHttpServer(0).ok());
+
+    const std::string response = HttpGet(port);
+    REQUIRE(response.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+    REQUIRE(Contains(response, "Content-Type: application/openmetrics-text"));
+    REQUIRE(Contains(response, "smartspectra_frames_sent_through_total 9\n"));
+
+    SECTION("scrapes see live values") {
+        metrics->RecordFrameLeftGraph(true);
+        REQUIRE(Contains(HttpGet(port), "smartspectra_frames_sent_through_total 10\n"));
+    }
+    SECTION("only GET is supported") {
+        REQUIRE(HttpGet(port, "POST").rfind("HTTP/1.1 405", 0) == 0);
+    }
+    exporter.Stop();
+    REQUIRE(exporter.GetHttpPort() == 0);
+}
+
+TEST_CASE("Metrics exporter writes metrics to a file periodically", "[metrics_exporter]") {
+    auto metrics = MakeRecordedMetrics();
+    const auto output_path =
+        std::filesystem::path(test::generated_test_data_directory.ToString()) / "runtime_metrics.prom";
+    std::filesystem::remove(output_path);
+    me::MetricsExporter exporter(metrics);
+    REQUIRE_FALSE(exporter.StartFileExport(output_path.string(), std::chrono::milliseconds(0)).ok());
+    REQUIRE(exporter.StartFileExport(output_path.string(), std::chrono::milliseconds(10)).ok());
+    // the first write happens right away
+    REQUIRE(std::filesystem::exists(output_path));
+
+    metrics->RecordFrameLeftGraph(false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    exporter.Stop();
+    std::stringstream contents;
+    contents << std::ifstream(output_path).rdbuf();
+    REQUIRE(Contains(contents.str(), "smartspectra_frames_dropped_in_graph_total 2\n"));
+    REQUIRE_FALSE(std::filesystem::exists(output_path.string() + ".tmp"));
+
+    REQUIRE_FALSE(exporter.WriteToFile("/nonexistent/directory/metrics.prom").ok());
+}
@@ -0,0 +1,86 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/opencv_core_inc.h>
+#include <mediapipe/framework/port/opencv_imgcodecs_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/video_source/camera/mjpeg_decoder.hpp>
+
+namespace vs = presage::smartspectra::video_source;
+namespace mjpeg = presage::smartspectra::video_source::mjpeg;
+
+namespace {
+
+// flat color, so that every pixel survives (lossy) compression & DCT scaling nearly unchanged
+const cv::Vec3b kBgrColor(40, 120, 200);
+
+std::vector<uint8_t> EncodeSolidFrame(int width, int height) {
+    const cv::Mat frame(height, width, CV_8UC3, cv::Scalar(kBgrColor[0], kBgrColor[1], kBgrColor[2]));
+    std::vector<uint8_t> encoded_frame;
+    cv::imencode(".jpg", frame, encoded_frame, {cv::IMWRITE_JPEG_QUALITY, 95});
+    return encoded_frame;
+}
+
+bool IsCloseTo(const cv::Vec3b& actual, const cv::Vec3b& expected) {
+    for (int i_channel = 0; i_channel < 3; i_channel++) {
+        if (std::abs(actual[i_channel] - expected[i_channel]) > 3) return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+TEST_CASE("MJPEG scaling picks the coarsest scale that still covers the minimum size", "[mjpeg]") {
+    const cv::Size capture_size(1920, 1080);
+    REQUIRE(mjpeg::ChooseScaleDenominator(capture_size, {-1, -1}) == 1);
+    REQUIRE(mjpeg::ChooseScaleDenominator(capture_size, {0, 0}) == 1);
+    REQUIRE(mjpeg::ChooseScaleDenominator(capture_size, {1920, 1080}) == 1);
+    REQUIRE(mjpeg::ChooseScaleDenominator(capture_size, {1280, 720}) == 1);
+    REQUIRE(mjpeg::ChooseScaleDenominator(capture_size, {960, 540}) == 2);
+    REQUIRE(mjpeg::ChooseScaleDenominator(capture_size, {480, 270}) == 4);
+    // the height decides here: 1/8 would be 135 rows
+    REQUIRE(mjpeg::ChooseScaleDenominator(capture_size, {200, 200}) == 4);
+    REQUIRE(mjpeg::ChooseScaleDenominator(capture_size, {160, 120}) == 8);
+    REQUIRE(mjpeg::ChooseScaleDenominator(capture_size, {16, 16}) == 8);
+
+    REQUIRE(mjpeg::GetScaledSize(capture_size, 8) == cv::Size(240, 135));
+    // rounds up, like libjpeg
+    REQUIRE(mjpeg::GetScaledSize({1000, 750}, 8) == cv::Size(125, 94));
+}
+
+TEST_CASE("MJPEG decoder decodes to BGR or RGB at the requested scale", "[mjpeg]") {
+    const std::vector<uint8_t> encoded_frame = EncodeSolidFrame(64, 48);
+    mjpeg::MjpegDecoder decoder;
+    const int scale_denominator = GENERATE(1, 2, 4, 8);
+    const auto channel_order = GENERATE(vs::FrameChannelOrder::Bgr, vs::FrameChannelOrder::Rgb);
+    const cv::Vec3b expected_color = channel_order == vs::FrameChannelOrder::Rgb ?
+                                     cv::Vec3b(kBgrColor[2], kBgrColor[1], kBgrColor[0]) : kBgrColor;
+
+    cv::Mat frame;
+    REQUIRE(decoder.Decode(encoded_frame.data(), encoded_frame.size(), scale_denominator, channel_order, frame).ok());
+    REQUIRE(frame.size() == mjpeg::GetScaledSize({64, 48}, scale_denominator));
+    REQUIRE(frame.type() == CV_8UC3);
+    REQUIRE(IsCloseTo(frame.at<cv::Vec3b>(0, 0), expected_color));
+    REQUIRE(IsCloseTo(frame.at<cv::Vec3b>(frame.rows - 1, frame.cols - 1), expected_color));
+}
+
+TEST_CASE("MJPEG decoder rejects corrupt frames & unsupported scales", "[mjpeg]") {
+    mjpeg::MjpegDecoder decoder;
+    cv::Mat frame;
+    const std::vector<uint8_t> garbage(256, 0x5a);
+    REQUIRE_FALSE(decoder.Decode(garbage.data(), garbage.size(), 1, vs::FrameChannelOrder::Bgr, frame).ok());
+
+    const std::vector<uint8_t> encoded_frame = EncodeSolidFrame(64, 48);
+    REQUIRE(absl::IsInvalidArgument(
+        decoder.Decode(encoded_frame.data(), encoded_frame.size(), 3, vs::FrameChannelOrder::Bgr, frame)
+    ));
+}
@@ -0,0 +1,199 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <mediapipe/framework/port/opencv_core_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/container/multi_stream_host.hpp>
+#include <test_utilities/stand_in_graph.hpp>
+#include <test_utilities/test_utilities.hpp>
+
+namespace spc = presage::smartspectra::container;
+namespace pi = presage::platform_independence;
+namespace msh = presage::smartspectra::container::multi_stream_host;
+namespace test = presage::smartspectra::test;
+namespace stand_in = presage::smartspectra::test::stand_in_graph;
+
+namespace {
+
+using CpuSpotRestMultiStreamHost =
+    msh::MultiStreamHost<pi::DeviceType::Cpu, spc::settings::OperationMode::Spot, spc::settings::IntegrationMode::Rest>;
+
+// host whose streams run the stand-in graph
+class StandInMultiStreamHost : public CpuSpotRestMultiStreamHost {
+public:
+    using CpuSpotRestMultiStreamHost::CpuSpotRestMultiStreamHost;
+
+protected:
+    std::unique_ptr<ContainerType> CreateContainer(SettingsType stream_settings) override {
+        return std::make_unique<stand_in::StandInGraphContainer<ContainerType>>(
+            std::move(stream_settings), std::filesystem::path(test::generated_test_data_directory.ToString())
+        );
+    }
+};
+
+constexpr int kStreamCount = 2;
+constexpr int kFrameWidth = 64;
+constexpr int kFrameHeight = 48;
+constexpr int64_t kFrameIntervalμs = 33'333;
+
+StandInMultiStreamHost::SettingsType MakeStreamSettings() {
+    StandInMultiStreamHost::SettingsType settings{};
+    settings.binary_graph = false;
+    settings.spot.spot_duration_s = 30.0;
+    return settings;
+}
+
+// adds a stream with no-op callbacks (except for video output, which returns the given status)
+size_t AddStream(StandInMultiStreamHost& host, absl::Status video_output_status = absl::OkStatus()) {
+    auto stream_index = host.AddStream(MakeStreamSettings());
+    REQUIRE(stream_index.ok());
+    auto stream = host.GetStream(stream_index.value());
+    REQUIRE(stream.ok());
+    auto* container = stream.value();
+    REQUIRE(container->SetOnStatusChange([](presage::physiology::StatusCode) { return absl::OkStatus(); }).ok());
+    REQUIRE(container->SetOnCoreMetricsOutput(
+        [](const presage::physiology::MetricsBuffer&, int64_t) { return absl::OkStatus(); }
+    ).ok());
+    REQUIRE(container->SetOnVideoOutput(
+        [video_output_status](cv::Mat&, int64_t) { return video_output_status; }
+    ).ok());
+    REQUIRE(container->SetOnFrameSentThrough([](bool, int64_t) { return absl::OkStatus(); }).ok());
+    return stream_index.value();
+}
+
+msh::MultiStreamHostSettings MakeHostSettings(spc::settings::BackpressurePolicy backpressure_policy) {
+    msh::MultiStreamHostSettings host_settings;
+    host_settings.executor_thread_count = 2;
+    host_settings.max_frames_in_flight_per_stream = 1;
+    host_settings.backpressure_policy = backpressure_policy;
+    return host_settings;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Multi-stream host runs every stream to completion on the shared executor", "[multi_stream_host]") {
+    StandInMultiStreamHost host(MakeHostSettings(spc::settings::BackpressurePolicy::Block));
+    for (int i_stream = 0; i_stream < kStreamCount; i_stream++) {
+        REQUIRE(AddStream(host) == static_cast<size_t>(i_stream));
+    }
+    REQUIRE(host.GetStreamCount() == kStreamCount);
+    REQUIRE(host.StartAll().ok());
+
+    constexpr int kFrameCount = 30;
+    const cv::Mat frame(kFrameHeight, kFrameWidth, CV_8UC3, cv::Scalar::all(128));
+    // interleave the streams, so that both have frames on the executor at the same time
+    for (int i_frame = 0; i_frame < kFrameCount; i_frame++) {
+        for (size_t i_stream = 0; i_stream < kStreamCount; i_stream++) {
+            REQUIRE(host.AddFrameWithTimestamp(i_stream, frame, i_frame * kFrameIntervalμs).ok());
+        }
+    }
+    for (size_t i_stream = 0; i_stream < kStreamCount; i_stream++) {
+        REQUIRE(host.GetStream(i_stream).value()->WaitUntilGraphIsIdle().ok());
+    }
+
+    const std::vector<msh::StreamThroughput> report = host.GetThroughputReport();
+    REQUIRE(report.size() == kStreamCount);
+    for (size_t i_stream = 0; i_stream < kStreamCount; i_stream++) {
+        const msh::StreamThroughput& throughput = report[i_stream];
+        REQUIRE(throughput.stream_index == i_stream);
+        REQUIRE(throughput.frames_submitted == kFrameCount);
+        REQUIRE(throughput.frames_sent_through == kFrameCount);
+        REQUIRE(throughput.frames_rejected == 0);
+        REQUIRE(throughput.frames_replaced == 0);
+        REQUIRE(throughput.frames_dropped_in_graph == 0);
+        REQUIRE(throughput.frames_in_flight == 0);
+        REQUIRE(throughput.sent_through_fps > 0.0);
+    }
+    // the rate only covers frames since the previous report
+    for (const msh::StreamThroughput& throughput: host.GetThroughputReport()) {
+        REQUIRE(throughput.frames_sent_through == kFrameCount);
+        REQUIRE(throughput.sent_through_fps == 0.0);
+    }
+    REQUIRE(host.StopAll().ok());
+}
+
+TEST_CASE("Multi-stream host counts frames rejected at a stream's cap", "[multi_stream_host]") {
+    StandInMultiStreamHost host(MakeHostSettings(spc::settings::BackpressurePolicy::Reject));
+    for (int i_stream = 0; i_stream < kStreamCount; i_stream++) {
+        AddStream(host);
+    }
+    REQUIRE(host.StartAll().ok());
+    const cv::Mat frame(kFrameHeight, kFrameWidth, CV_8UC3, cv::Scalar::all(128));
+    {
+        stand_in::ScopedFrameHold frame_hold;
+        REQUIRE(host.AddFrameWithTimestamp(0, frame, 0).ok());
+        REQUIRE(absl::IsResourceExhausted(host.AddFrameWithTimestamp(0, frame, kFrameIntervalμs)));
+        // the other stream has a cap of its own
+        REQUIRE(host.AddFrameWithTimestamp(1, frame, 0).ok());
+
+        const auto report = host.GetThroughputReport();
+        REQUIRE(report[0].frames_submitted == 1);
+        REQUIRE(report[0].frames_rejected == 1);
+        REQUIRE(report[0].frames_in_flight == 1);
+        REQUIRE(report[1].frames_submitted == 1);
+        REQUIRE(report[1].frames_rejected == 0);
+    }
+    for (size_t i_stream = 0; i_stream < kStreamCount; i_stream++) {
+        REQUIRE(host.GetStream(i_stream).value()->WaitUntilGraphIsIdle().ok());
+    }
+    for (const msh::StreamThroughput& throughput: host.GetThroughputReport()) {
+        REQUIRE(throughput.frames_sent_through == 1);
+        REQUIRE(throughput.frames_in_flight == 0);
+    }
+    REQUIRE(host.StopAll().ok());
+}
+
+TEST_CASE("Multi-stream host enforces its call order", "[multi_stream_host]") {
+    StandInMultiStreamHost host(MakeHostSettings(spc::settings::BackpressurePolicy::Block));
+    const cv::Mat frame(kFrameHeight, kFrameWidth, CV_8UC3, cv::Scalar::all(128));
+
+    REQUIRE(absl::IsFailedPrecondition(host.StartAll()));
+    REQUIRE(absl::IsOutOfRange(host.GetStream(0).status()));
+    AddStream(host);
+    REQUIRE(absl::IsFailedPrecondition(host.AddFrameWithTimestamp(0, frame, 0)));
+
+    REQUIRE(host.StartAll().ok());
+    // starting again is a no-op
+    REQUIRE(host.StartAll().ok());
+    REQUIRE(absl::IsFailedPrecondition(host.AddStream(MakeStreamSettings()).status()));
+    REQUIRE(host.GetStreamCount() == 1);
+    REQUIRE(absl::IsOutOfRange(host.AddFrameWithTimestamp(1, frame, 0)));
+
+    REQUIRE(host.StopAll().ok());
+    REQUIRE(absl::IsFailedPrecondition(host.AddFrameWithTimestamp(0, frame, 0)));
+    // stopping again is a no-op
+    REQUIRE(host.StopAll().ok());
+}
+
+TEST_CASE("Multi-stream host stops every stream & reports the first failure", "[multi_stream_host]") {
+    StandInMultiStreamHost host(MakeHostSettings(spc::settings::BackpressurePolicy::Block));
+    AddStream(host, absl::InternalError("Failing video output."));
+    AddStream(host);
+    REQUIRE(host.StartAll().ok());
+
+    const cv::Mat frame(kFrameHeight, kFrameWidth, CV_8UC3, cv::Scalar::all(128));
+    REQUIRE(host.AddFrameWithTimestamp(0, frame, 0).ok());
+    REQUIRE(host.AddFrameWithTimestamp(1, frame, 0).ok());
+    // the first stream's graph fails on its output; the second one isn't affected
+    host.GetStream(0).value()->WaitUntilGraphIsIdle().IgnoreError();
+    REQUIRE(host.GetStream(1).value()->WaitUntilGraphIsIdle().ok());
+
+    auto status = host.StopAll();
+    REQUIRE_FALSE(status.ok());
+    REQUIRE(status.message().find("Failing video output.") != std::string::npos);
+    // the host is stopped regardless
+    REQUIRE(absl::IsFailedPrecondition(host.AddFrameWithTimestamp(1, frame, kFrameIntervalμs)));
+    REQUIRE(host.GetThroughputReport()[1].frames_sent_through == 1);
+    REQUIRE(host.StopAll().ok());
+}
@@ -0,0 +1,147 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <filesystem>
+// === third-party includes (if any) ===
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <nlohmann/json.hpp>
+// === local includes (if any) ===
+#include <test_utilities/performance_baseline.hpp>
+#include <test_utilities/test_utilities.hpp>
+
+namespace test = presage::smartspectra::test;
+namespace pb = presage::smartspectra::test::performance_baseline;
+
+namespace {
+
+pb::PerformanceBaseline BuildBaseline() {
+    pb::PerformanceBaseline baseline;
+    baseline.description = "test baseline";
+    baseline.AddMetric("frames_per_second", 100.0, pb::MetricDirection::HigherIsBetter, 0.1);
+    baseline.AddMetric("p99_latency_ms", 20.0, pb::MetricDirection::LowerIsBetter, 0.25);
+    baseline.AddMetric("allocations_per_frame", 0.0, pb::MetricDirection::LowerIsBetter, 0.1, 1.0);
+    return baseline;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Performance metrics within tolerance pass the baseline comparison", "[performance_baseline]") {
+    const auto baseline = BuildBaseline();
+    pb::PerformanceBaseline measured;
+    measured.AddMetric("frames_per_second", 91.0, pb::MetricDirection::HigherIsBetter);
+    measured.AddMetric("p99_latency_ms", 24.0, pb::MetricDirection::LowerIsBetter);
+    measured.AddMetric("allocations_per_frame", 0.5, pb::MetricDirection::LowerIsBetter);
+    // not in the baseline: ignored
+    measured.AddMetric("new_metric", 1e9, pb::MetricDirection::LowerIsBetter);
+
+    const auto result = pb::CompareToBaseline(baseline, measured);
+    REQUIRE(result.within_tolerance);
+    REQUIRE(result.regressions.empty());
+    REQUIRE(result.missing_metrics.empty());
+
+    SECTION("regressions right at the tolerance pass") {
+        measured.AddMetric("frames_per_second", 90.0, pb::MetricDirection::HigherIsBetter);
+        measured.AddMetric("allocations_per_frame", 1.0, pb::MetricDirection::LowerIsBetter);
+        REQUIRE(pb::CompareToBaseline(baseline, measured).within_tolerance);
+    }
+
+    SECTION("improvements of any size pass") {
+        measured.AddMetric("frames_per_second", 1000.0, pb::MetricDirection::HigherIsBetter);
+        measured.AddMetric("p99_latency_ms", 1.0, pb::MetricDirection::LowerIsBetter);
+        REQUIRE(pb::CompareToBaseline(baseline, measured).within_tolerance);
+    }
+}
+
+TEST_CASE("Performance metrics beyond tolerance fail the baseline comparison", "[performance_baseline]") {
+    const auto baseline = BuildBaseline();
+    pb::PerformanceBaseline measured;
+    measured.AddMetric("frames_per_second", 80.0, pb::MetricDirection::HigherIsBetter);
+    measured.AddMetric("p99_latency_ms", 30.0, pb::MetricDirection::LowerIsBetter);
+    measured.AddMetric("allocations_per_frame", 2.0, pb::MetricDirection::LowerIsBetter);
+
+    const auto result = pb::CompareToBaseline(baseline, measured);
+    REQUIRE_FALSE(result.within_tolerance);
+    REQUIRE(result.regressions.size() == 3);
+    // regressions are listed in metric name order
+    REQUIRE(result.regressions[0].name == "allocations_per_frame");
+    REQUIRE(result.regressions[1].name == "frames_per_second");
+    REQUIRE_THAT(result.regressions[1].relative_regression, Catch::Matchers::WithinRel(0.2, 1e-9));
+    REQUIRE(result.regressions[1].mismatch.element1 == 100.0);
+    REQUIRE(result.regressions[1].mismatch.element2 == 80.0);
+    REQUIRE(result.regressions[2].name == "p99_latency_ms");
+    REQUIRE_THAT(result.regressions[2].relative_regression, Catch::Matchers::WithinRel(0.5, 1e-9));
+    const std::string summary = pb::FormatComparisonResult(result);
+    REQUIRE(summary.find("Regression in frames_per_second") != std::string::npos);
+
+    SECTION("metrics missing from the measurements fail as well") {
+        pb::PerformanceBaseline partial;
+        partial.AddMetric("frames_per_second", 100.0, pb::MetricDirection::HigherIsBetter);
+        const auto partial_result = pb::CompareToBaseline(baseline, partial);
+        REQUIRE_FALSE(partial_result.within_tolerance);
+        REQUIRE(partial_result.regressions.empty());
+        REQUIRE(partial_result.missing_metrics.size() == 2);
+    }
+}
+
+TEST_CASE("Performance baselines round-trip through versioned JSON files", "[performance_baseline]") {
+    const auto baseline = BuildBaseline();
+    const auto baseline_path =
+        std::filesystem::path(test::generated_test_data_directory.ToString()) / "performance_baseline.json";
+    REQUIRE(pb::WriteBaseline(baseline, baseline_path).ok());
+
+    auto read_baseline = pb::ReadBaseline(baseline_path);
+    REQUIRE(read_baseline.ok());
+    REQUIRE(read_baseline->schema_version == pb::kBaselineSchemaVersion);
+    REQUIRE(read_baseline->description == baseline.description);
+    REQUIRE(read_baseline->metrics.size() == baseline.metrics.size());
+    const auto& latency = read_baseline->metrics.at("p99_latency_ms");
+    REQUIRE(latency.value == 20.0);
+    REQUIRE(latency.direction == pb::MetricDirection::LowerIsBetter);
+    REQUIRE(latency.relative_tolerance == 0.25);
+    REQUIRE(read_baseline->metrics.at("allocations_per_frame").absolute_tolerance == 1.0);
+
+    SECTION("baselines with another schema version are rejected") {
+        auto baseline_json = pb::ToJson(baseline);
+        baseline_json["schema_version"] = pb::kBaselineSchemaVersion + 1;
+        auto status_or_baseline = pb::FromJson(baseline_json);
+        REQUIRE(absl::IsFailedPrecondition(status_or_baseline.status()));
+    }
+    SECTION("missing files are reported") {
+        REQUIRE(absl::IsNotFound(pb::ReadBaseline(baseline_path.parent_path() / "no_such_baseline.json").status()));
+    }
+}
+
+TEST_CASE("Google Benchmark output converts to performance metrics", "[performance_baseline]") {
+    const auto results_json = nlohmann::json::parse(R"({
+        "context": {"date": "2026-10-16T12:00:00+00:00"},
+        "benchmarks": [
+            {"name": "BM_Transform/640/480", "run_name": "BM_Transform/640/480", "run_type": "iteration",
+             "real_time": 2.0, "cpu_time": 1.5, "time_unit": "us", "items_per_second": 500000.0},
+            {"name": "BM_Transform/640/480", "run_name": "BM_Transform/640/480", "run_type": "iteration",
+             "real_time": 4.0, "cpu_time": 3.5, "time_unit": "us", "items_per_second": 250000.0},
+            {"name": "BM_Transform/640/480_median", "run_name": "BM_Transform/640/480", "run_type": "aggregate",
+             "aggregate_name": "median", "real_time": 3.0, "cpu_time": 2.5, "time_unit": "us",
+             "items_per_second": 333333.0},
+            {"name": "BM_Transform/640/480_stddev", "run_name": "BM_Transform/640/480", "run_type": "aggregate",
+             "aggregate_name": "stddev", "real_time": 1.0, "cpu_time": 1.0, "time_unit": "us"},
+            {"name": "BM_Render", "run_type": "iteration", "real_time": 1.0, "cpu_time": 1.0, "time_unit": "ms"},
+            {"name": "BM_Broken", "run_type": "iteration", "error_occurred": true, "error_message": "failed"}
+        ]
+    })");
+    auto results = pb::ImportGoogleBenchmarkResults(results_json, 0.2);
+    REQUIRE(results.ok());
+    REQUIRE(results->metrics.size() == 5);
+    const auto& real_time = results->metrics.at("BM_Transform/640/480/real_time_ns");
+    REQUIRE(real_time.value == 3000.0);
+    REQUIRE(real_time.direction == pb::MetricDirection::LowerIsBetter);
+    REQUIRE(real_time.relative_tolerance == 0.2);
+    REQUIRE(results->metrics.at("BM_Transform/640/480/items_per_second").direction ==
+            pb::MetricDirection::HigherIsBetter);
+    REQUIRE(results->metrics.at("BM_Render/cpu_time_ns").value == 1e6);
+    REQUIRE(results->metrics.count("BM_Render/items_per_second") == 0);
+}
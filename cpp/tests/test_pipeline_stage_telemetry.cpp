@@ -0,0 +1,88 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <chrono>
+#include <thread>
+#include <vector>
+// === third-party includes (if any) ===
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+// === local includes (if any) ===
+#include <smartspectra/container/pipeline_stage_telemetry.hpp>
+
+namespace pst = presage::smartspectra::container::pipeline_stage_telemetry;
+
+TEST_CASE("Stage latency histogram quantiles are precise from nanoseconds to minutes", "[pipeline_stage_telemetry]") {
+    for (uint64_t duration_ns = 2; duration_ns < (uint64_t{1} << 40); duration_ns += duration_ns / 16 + 1) {
+        pst::StageLatencyHistogram histogram;
+        // the neighbors keep the median off of the (exact) min & max it gets clamped to
+        histogram.Record(duration_ns / 2);
+        histogram.Record(duration_ns);
+        histogram.Record(duration_ns * 2);
+        REQUIRE_THAT(
+            histogram.Summarize().p50_seconds,
+            Catch::Matchers::WithinRel(static_cast<double>(duration_ns) * 1e-9, 0.016)
+        );
+    }
+}
+
+TEST_CASE("Pipeline stage telemetry records only while enabled", "[pipeline_stage_telemetry]") {
+    pst::PipelineStageTelemetry telemetry;
+    {
+        pst::ScopedStageTimer timer(telemetry, pst::PipelineStage::Capture);
+    }
+    REQUIRE(telemetry.Snapshot()[pst::PipelineStage::Capture].count == 0);
+
+    telemetry.SetEnabled(true);
+    for (int duration_μs = 1; duration_μs <= 1000; duration_μs++) {
+        telemetry.Record(pst::PipelineStage::GraphFeed, std::chrono::microseconds(duration_μs));
+    }
+    const auto graph_feed = telemetry.Snapshot()[pst::PipelineStage::GraphFeed];
+    REQUIRE(graph_feed.count == 1000);
+    REQUIRE_THAT(graph_feed.min_seconds, Catch::Matchers::WithinRel(1e-6, 1e-9));
+    REQUIRE_THAT(graph_feed.max_seconds, Catch::Matchers::WithinRel(1e-3, 1e-9));
+    REQUIRE_THAT(graph_feed.mean_seconds, Catch::Matchers::WithinRel(500.5e-6, 1e-9));
+    REQUIRE_THAT(graph_feed.p50_seconds, Catch::Matchers::WithinRel(500e-6, 0.035));
+    REQUIRE_THAT(graph_feed.p99_seconds, Catch::Matchers::WithinRel(990e-6, 0.035));
+    REQUIRE(telemetry.Snapshot()[pst::PipelineStage::Display].count == 0);
+
+    telemetry.Reset();
+    REQUIRE(telemetry.Snapshot()[pst::PipelineStage::GraphFeed].count == 0);
+}
+
+TEST_CASE("Pipeline stage telemetry supports concurrent recording", "[pipeline_stage_telemetry]") {
+    pst::PipelineStageTelemetry telemetry;
+    telemetry.SetEnabled(true);
+    constexpr int kThreadCount = 4;
+    constexpr int kRecordsPerThread = 10000;
+    std::vector<std::thread> threads;
+    for (int i_thread = 0; i_thread < kThreadCount; i_thread++) {
+        threads.emplace_back([&telemetry]() {
+            for (int i_record = 0; i_record < kRecordsPerThread; i_record++) {
+                telemetry.Record(pst::PipelineStage::UserCallback, std::chrono::nanoseconds(i_record));
+            }
+        });
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    REQUIRE(telemetry.Snapshot()[pst::PipelineStage::UserCallback].count == kThreadCount * kRecordsPerThread);
+}
+
+// run explicitly, e.g. `test_pipeline_stage_telemetry "[benchmark]"`
+TEST_CASE("Pipeline stage timer overhead", "[.][benchmark][pipeline_stage_telemetry]") {
+    pst::PipelineStageTelemetry telemetry;
+    BENCHMARK("disabled") {
+        pst::ScopedStageTimer timer(telemetry, pst::PipelineStage::GraphFeed);
+        return telemetry.IsEnabled();
+    };
+    telemetry.SetEnabled(true);
+    BENCHMARK("enabled") {
+        pst::ScopedStageTimer timer(telemetry, pst::PipelineStage::GraphFeed);
+        return telemetry.IsEnabled();
+    };
+}
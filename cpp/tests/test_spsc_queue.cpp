@@ -0,0 +1,205 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include <smartspectra/container/spsc_queue.hpp>
+
+namespace sq = presage::smartspectra::container::spsc_queue;
+
+TEST_CASE("SPSC queue pushes and pops in FIFO order up to its capacity", "[spsc_queue]") {
+    sq::SpscQueue<int> queue(3);
+    REQUIRE(queue.Capacity() == 3);
+    REQUIRE(queue.Empty());
+
+    int value = 1;
+    REQUIRE(queue.TryPush(std::move(value)));
+    value = 2;
+    REQUIRE(queue.TryPush(std::move(value)));
+    value = 3;
+    REQUIRE(queue.TryPush(std::move(value)));
+    REQUIRE(queue.Size() == 3);
+    value = 4;
+    REQUIRE_FALSE(queue.TryPush(std::move(value)));
+
+    int popped = 0;
+    REQUIRE(queue.TryPop(popped));
+    REQUIRE(popped == 1);
+    // wrap around the end of the ring
+    value = 4;
+    REQUIRE(queue.TryPush(std::move(value)));
+    for (int expected = 2; expected <= 4; expected++) {
+        REQUIRE(queue.TryPop(popped));
+        REQUIRE(popped == expected);
+    }
+    REQUIRE(queue.Empty());
+    REQUIRE_FALSE(queue.TryPop(popped));
+}
+
+TEST_CASE("SPSC queue leaves the element untouched when full", "[spsc_queue]") {
+    sq::SpscQueue<std::unique_ptr<int>> queue(1);
+    auto first = std::make_unique<int>(1);
+    REQUIRE(queue.TryPush(std::move(first)));
+    auto second = std::make_unique<int>(2);
+    REQUIRE_FALSE(queue.TryPush(std::move(second)));
+    REQUIRE(second != nullptr);
+    REQUIRE(*second == 2);
+}
+
+TEST_CASE("SPSC queue pops the latest element and counts the skipped ones", "[spsc_queue]") {
+    sq::SpscQueue<int> queue(8);
+    int popped = -1;
+    size_t skipped_count = 42;
+    REQUIRE_FALSE(queue.TryPopLatest(popped, skipped_count));
+    REQUIRE(skipped_count == 0);
+
+    for (int i = 0; i < 5; i++) {
+        int value = i;
+        REQUIRE(queue.TryPush(std::move(value)));
+    }
+    REQUIRE(queue.TryPopLatest(popped, skipped_count));
+    REQUIRE(popped == 4);
+    REQUIRE(skipped_count == 4);
+    REQUIRE(queue.Empty());
+
+    int value = 5;
+    REQUIRE(queue.TryPush(std::move(value)));
+    REQUIRE(queue.TryPopLatest(popped, skipped_count));
+    REQUIRE(popped == 5);
+    REQUIRE(skipped_count == 0);
+}
+
+TEST_CASE("SPSC queue waiting push and pop hand over every element across threads", "[spsc_queue]") {
+    constexpr int kElementCount = 10'000;
+    // small capacity, so that both sides have to wait on each other
+    sq::SpscQueue<int> queue(4);
+    auto keep_waiting = []() { return true; };
+
+    // Catch2 assertions aren't thread-safe, so the producer only counts its failures
+    std::atomic<int> failed_push_count(0);
+    std::thread producer([&]() {
+        for (int i = 0; i < kElementCount; i++) {
+            int value = i;
+            if (!queue.PushWaiting(std::move(value), keep_waiting)) failed_push_count++;
+        }
+    });
+    std::vector<int> popped_values;
+    popped_values.reserve(kElementCount);
+    for (int i = 0; i < kElementCount; i++) {
+        int value = -1;
+        REQUIRE(queue.PopWaiting(value, keep_waiting));
+        popped_values.push_back(value);
+    }
+    producer.join();
+
+    REQUIRE(failed_push_count == 0);
+    REQUIRE(queue.Empty());
+    for (int i = 0; i < kElementCount; i++) {
+        REQUIRE(popped_values[i] == i);
+    }
+}
+
+TEST_CASE("SPSC queue waits are abandoned once the predicate says so", "[spsc_queue]") {
+    sq::SpscQueue<int> queue(1);
+    std::atomic<bool> running(true);
+    auto keep_waiting = [&]() { return running.load(); };
+
+    SECTION("pop on an empty queue") {
+        std::atomic<bool> pop_result(true);
+        std::thread consumer([&]() {
+            int value;
+            pop_result = queue.PopWaiting(value, keep_waiting);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        running = false;
+        consumer.join();
+        REQUIRE_FALSE(pop_result);
+    }
+    SECTION("push into a full queue") {
+        int value = 1;
+        REQUIRE(queue.TryPush(std::move(value)));
+        std::atomic<bool> push_result(true);
+        std::thread producer([&]() {
+            int another_value = 2;
+            push_result = queue.PushWaiting(std::move(another_value), keep_waiting);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        running = false;
+        producer.join();
+        REQUIRE_FALSE(push_result);
+        REQUIRE(queue.Size() == 1);
+    }
+    SECTION("predicate already false") {
+        int value;
+        REQUIRE_FALSE(queue.PopWaiting(value, []() { return false; }));
+    }
+}
+
+TEST_CASE("SPSC latest slot keeps only the element pushed last", "[spsc_queue]") {
+    sq::SpscLatestSlot<std::unique_ptr<int>> slot;
+    std::unique_ptr<int> popped;
+    REQUIRE(slot.Empty());
+    REQUIRE_FALSE(slot.TryPop(popped));
+
+    REQUIRE_FALSE(slot.Push(std::make_unique<int>(1)));
+    // replaces the element that wasn't taken yet
+    REQUIRE(slot.Push(std::make_unique<int>(2)));
+    REQUIRE(slot.Push(std::make_unique<int>(3)));
+    REQUIRE_FALSE(slot.Empty());
+    REQUIRE(slot.TryPop(popped));
+    REQUIRE(*popped == 3);
+    REQUIRE(slot.Empty());
+    REQUIRE_FALSE(slot.TryPop(popped));
+
+    REQUIRE_FALSE(slot.Push(std::make_unique<int>(4)));
+    REQUIRE(slot.TryPop(popped));
+    REQUIRE(*popped == 4);
+}
+
+TEST_CASE("SPSC latest slot never makes the producer wait", "[spsc_queue]") {
+    constexpr int kElementCount = 100'000;
+    sq::SpscLatestSlot<int> slot;
+    std::atomic<bool> producer_done(false);
+    auto keep_waiting = [&]() { return !producer_done.load(); };
+
+    int replaced_count = 0;
+    std::thread producer([&]() {
+        for (int i = 0; i < kElementCount; i++) {
+            int value = i;
+            if (slot.Push(std::move(value))) replaced_count++;
+        }
+        producer_done = true;
+    });
+    // a slow consumer: takes what's there now & then
+    int popped_count = 0;
+    int last_popped = -1;
+    bool popped_in_order = true;
+    int value;
+    while (slot.PopWaiting(value, keep_waiting)) {
+        popped_in_order = popped_in_order && value > last_popped;
+        last_popped = value;
+        popped_count++;
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    producer.join();
+    if (slot.TryPop(value)) {
+        popped_in_order = popped_in_order && value > last_popped;
+        last_popped = value;
+        popped_count++;
+    }
+
+    REQUIRE(popped_in_order);
+    // the newest element always makes it through; every other one was either taken or replaced
+    REQUIRE(last_popped == kElementCount - 1);
+    REQUIRE(popped_count + replaced_count == kElementCount);
+}
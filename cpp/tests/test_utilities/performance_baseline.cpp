@@ -0,0 +1,247 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+// === third-party includes (if any) ===
+// === local includes (if any) ===
+#include "performance_baseline.hpp"
+#include "test_utilities_impl.hpp"
+
+namespace presage::smartspectra::test::performance_baseline {
+
+namespace {
+
+constexpr char kHigherIsBetter[] = "higher_is_better";
+constexpr char kLowerIsBetter[] = "lower_is_better";
+
+absl::StatusOr<double> GetNanosecondsPerTimeUnit(const std::string& time_unit) {
+    if (time_unit == "ns") return 1.0;
+    if (time_unit == "us") return 1e3;
+    if (time_unit == "ms") return 1e6;
+    if (time_unit == "s") return 1e9;
+    return absl::InvalidArgumentError("Unknown benchmark time unit: " + time_unit);
+}
+
+// how much worse measured is than baseline, relative to baseline (positive = worse)
+double GetRelativeRegression(const PerformanceMetric& baseline_metric, double measured_value) {
+    const double worsening = baseline_metric.direction == MetricDirection::HigherIsBetter ?
+                             baseline_metric.value - measured_value : measured_value - baseline_metric.value;
+    if (baseline_metric.value == 0.0) {
+        return worsening > 0.0 ? std::numeric_limits<double>::infinity() : 0.0;
+    }
+    return worsening / std::abs(baseline_metric.value);
+}
+
+// improvements don't count against the tolerances: they're clamped to the baseline value
+double GetWorsenedValue(const PerformanceMetric& baseline_metric, double measured_value) {
+    return baseline_metric.direction == MetricDirection::HigherIsBetter ?
+           std::min(measured_value, baseline_metric.value) : std::max(measured_value, baseline_metric.value);
+}
+
+} // anonymous namespace
+
+void PerformanceBaseline::AddMetric(
+    const std::string& name,
+    double value,
+    MetricDirection direction,
+    double relative_tolerance,
+    double absolute_tolerance
+) {
+    this->metrics[name] = PerformanceMetric{value, direction, relative_tolerance, absolute_tolerance};
+}
+
+nlohmann::json ToJson(const PerformanceBaseline& baseline) {
+    nlohmann::json metrics_json = nlohmann::json::object();
+    for (const auto& [name, metric]: baseline.metrics) {
+        metrics_json[name] = {
+            {"value", metric.value},
+            {"direction", metric.direction == MetricDirection::HigherIsBetter ? kHigherIsBetter : kLowerIsBetter},
+            {"relative_tolerance", metric.relative_tolerance},
+            {"absolute_tolerance", metric.absolute_tolerance}
+        };
+    }
+    return {
+        {"schema_version", baseline.schema_version},
+        {"description", baseline.description},
+        {"metrics", metrics_json}
+    };
+}
+
+absl::StatusOr<PerformanceBaseline> FromJson(const nlohmann::json& baseline_json) {
+    if (!baseline_json.is_object() || !baseline_json.contains("schema_version") ||
+        !baseline_json.contains("metrics") || !baseline_json["metrics"].is_object()) {
+        return absl::InvalidArgumentError("Not a performance baseline: expecting \"schema_version\" & \"metrics\".");
+    }
+    PerformanceBaseline baseline;
+    try {
+        baseline.schema_version = baseline_json["schema_version"].get<int>();
+        if (baseline.schema_version != kBaselineSchemaVersion) {
+            return absl::FailedPreconditionError(
+                "Performance baseline has schema version " + std::to_string(baseline.schema_version) + ", expected " +
+                std::to_string(kBaselineSchemaVersion) + ". Please re-record the baseline."
+            );
+        }
+        baseline.description = baseline_json.value("description", "");
+        for (const auto& [name, metric_json]: baseline_json["metrics"].items()) {
+            PerformanceMetric metric;
+            metric.value = metric_json.at("value").get<double>();
+            const auto direction = metric_json.at("direction").get<std::string>();
+            if (direction == kHigherIsBetter) {
+                metric.direction = MetricDirection::HigherIsBetter;
+            } else if (direction == kLowerIsBetter) {
+                metric.direction = MetricDirection::LowerIsBetter;
+            } else {
+                return absl::InvalidArgumentError("Unknown direction \"" + direction + "\" for metric " + name);
+            }
+            metric.relative_tolerance = metric_json.value("relative_tolerance", kDefaultRelativeTolerance);
+            metric.absolute_tolerance = metric_json.value("absolute_tolerance", 0.0);
+            baseline.metrics[name] = metric;
+        }
+    } catch (const nlohmann::json::exception& exception) {
+        return absl::InvalidArgumentError(std::string("Malformed performance baseline: ") + exception.what());
+    }
+    return baseline;
+}
+
+absl::StatusOr<PerformanceBaseline> ImportGoogleBenchmarkResults(
+    const nlohmann::json& results_json,
+    double relative_tolerance
+) {
+    if (!results_json.is_object() || !results_json.contains("benchmarks") || !results_json["benchmarks"].is_array()) {
+        return absl::InvalidArgumentError("Not Google Benchmark JSON output: expecting a \"benchmarks\" array.");
+    }
+    PerformanceBaseline baseline;
+    if (results_json.contains("context") && results_json["context"].contains("date")) {
+        baseline.description = "Google Benchmark results from " + results_json["context"]["date"].get<std::string>();
+    }
+    try {
+        for (const auto& benchmark_json: results_json["benchmarks"]) {
+            if (benchmark_json.value("error_occurred", false)) continue;
+            // iterations come before aggregates, so the median (if any) overrides individual repetitions
+            if (benchmark_json.value("run_type", "iteration") == "aggregate" &&
+                benchmark_json.value("aggregate_name", "") != "median") {
+                continue;
+            }
+            const std::string run_name = benchmark_json.value("run_name", benchmark_json.at("name").get<std::string>());
+            auto nanoseconds_per_unit = GetNanosecondsPerTimeUnit(benchmark_json.value("time_unit", "ns"));
+            if (!nanoseconds_per_unit.ok()) return nanoseconds_per_unit.status();
+            baseline.AddMetric(
+                run_name + "/real_time_ns", benchmark_json.at("real_time").get<double>() * nanoseconds_per_unit.value(),
+                MetricDirection::LowerIsBetter, relative_tolerance
+            );
+            baseline.AddMetric(
+                run_name + "/cpu_time_ns", benchmark_json.at("cpu_time").get<double>() * nanoseconds_per_unit.value(),
+                MetricDirection::LowerIsBetter, relative_tolerance
+            );
+            if (benchmark_json.contains("items_per_second")) {
+                baseline.AddMetric(
+                    run_name + "/items_per_second", benchmark_json["items_per_second"].get<double>(),
+                    MetricDirection::HigherIsBetter, relative_tolerance
+                );
+            }
+        }
+    } catch (const nlohmann::json::exception& exception) {
+        return absl::InvalidArgumentError(std::string("Malformed Google Benchmark output: ") + exception.what());
+    }
+    return baseline;
+}
+
+absl::Status WriteBaseline(const PerformanceBaseline& baseline, const std::filesystem::path& path) {
+    std::ofstream file(path);
+    if (!file) {
+        return absl::UnavailableError("Could not open " + path.string() + " for writing.");
+    }
+    file << ToJson(baseline).dump(4) << std::endl;
+    if (!file) {
+        return absl::DataLossError("Could not write performance baseline to " + path.string());
+    }
+    return absl::OkStatus();
+}
+
+absl::Status RecordBaseline(const PerformanceBaseline& results, const std::filesystem::path& path) {
+    PerformanceBaseline baseline = results;
+    auto previous_baseline = ReadBaseline(path);
+    if (previous_baseline.ok()) {
+        for (auto& [name, metric]: baseline.metrics) {
+            auto previous_metric = previous_baseline->metrics.find(name);
+            if (previous_metric != previous_baseline->metrics.end()) {
+                metric.relative_tolerance = previous_metric->second.relative_tolerance;
+                metric.absolute_tolerance = previous_metric->second.absolute_tolerance;
+            }
+        }
+    }
+    return WriteBaseline(baseline, path);
+}
+
+absl::StatusOr<PerformanceBaseline> ReadBaseline(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return absl::NotFoundError("Could not open " + path.string());
+    }
+    const nlohmann::json file_json = nlohmann::json::parse(file, nullptr, /*allow_exceptions=*/false);
+    if (file_json.is_discarded()) {
+        return absl::InvalidArgumentError(path.string() + " is not valid JSON.");
+    }
+    if (file_json.is_object() && file_json.contains("benchmarks")) {
+        return ImportGoogleBenchmarkResults(file_json);
+    }
+    return FromJson(file_json);
+}
+
+BaselineComparisonResult CompareToBaseline(const PerformanceBaseline& baseline, const PerformanceBaseline& measured) {
+    BaselineComparisonResult result;
+    long metric_index = 0;
+    for (const auto& [name, baseline_metric]: baseline.metrics) {
+        const long linear_index = metric_index++;
+        auto measured_metric = measured.metrics.find(name);
+        if (measured_metric == measured.metrics.end()) {
+            result.missing_metrics.push_back(name);
+            continue;
+        }
+        const double measured_value = measured_metric->second.value;
+        if (!ElementsMatch(
+            baseline_metric.value, GetWorsenedValue(baseline_metric, measured_value),
+            baseline_metric.absolute_tolerance, baseline_metric.relative_tolerance
+        )) {
+            result.regressions.push_back(MetricRegressionInformation{
+                name,
+                ArrayElementMismatchInformation<double>{
+                    {linear_index}, linear_index, baseline_metric.value, measured_value,
+                    static_cast<float>(baseline_metric.absolute_tolerance),
+                    static_cast<float>(baseline_metric.relative_tolerance)
+                },
+                GetRelativeRegression(baseline_metric, measured_value)
+            });
+        }
+    }
+    result.within_tolerance = result.regressions.empty() && result.missing_metrics.empty();
+    return result;
+}
+
+std::string FormatComparisonResult(const BaselineComparisonResult& result) {
+    std::ostringstream summary;
+    for (const auto& regression: result.regressions) {
+        const auto& mismatch = regression.mismatch;
+        summary << "Regression in " << regression.name << ": baseline " << mismatch.element1
+                << ", measured " << mismatch.element2 << " (" << regression.relative_regression * 100.0
+                << "% worse; tolerance " << mismatch.relative_tolerance * 100.0 << "%";
+        if (mismatch.absolute_tolerance != 0.0f) {
+            summary << " + " << mismatch.absolute_tolerance;
+        }
+        summary << ")\n";
+    }
+    for (const auto& name: result.missing_metrics) {
+        summary << "Missing metric: " << name << "\n";
+    }
+    return summary.str();
+}
+
+} // namespace presage::smartspectra::test::performance_baseline
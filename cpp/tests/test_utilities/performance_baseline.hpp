@@ -0,0 +1,109 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+// === third-party includes (if any) ===
+#include <absl/status/status.h>
+#include <absl/status/statusor.h>
+#include <nlohmann/json.hpp>
+// === local includes (if any) ===
+#include "test_utilities.hpp"
+
+namespace presage::smartspectra::test::performance_baseline {
+
+// Bump on incompatible changes to the baseline file layout: files with a different version are rejected, so that
+// stale baselines get re-recorded instead of silently compared against.
+constexpr int kBaselineSchemaVersion = 1;
+constexpr double kDefaultRelativeTolerance = 0.1;
+
+enum class MetricDirection {
+    HigherIsBetter, // e.g. throughput
+    LowerIsBetter   // e.g. latency, CPU time, allocations
+};
+
+struct PerformanceMetric {
+    double value = 0.0;
+    MetricDirection direction = MetricDirection::LowerIsBetter;
+    // regression allowed relative to the baseline value, e.g. 0.1 lets throughput drop / latency grow by 10%
+    double relative_tolerance = kDefaultRelativeTolerance;
+    // regression allowed on top of the relative one, in the metric's own units (for metrics at or near zero)
+    double absolute_tolerance = 0.0;
+};
+
+/**
+ * A set of named performance metrics (benchmark & harness results), as recorded in / compared against a versioned
+ * baseline JSON file. The tolerances recorded in the baseline are the ones comparisons use.
+ */
+struct PerformanceBaseline {
+    int schema_version = kBaselineSchemaVersion;
+    // free-form notes on what was measured where, e.g. build type & machine
+    std::string description;
+    // keyed by metric name, e.g. "background/640x480/unpaced/frames_per_second"
+    std::map<std::string, PerformanceMetric> metrics;
+
+    void AddMetric(
+        const std::string& name,
+        double value,
+        MetricDirection direction,
+        double relative_tolerance = kDefaultRelativeTolerance,
+        double absolute_tolerance = 0.0
+    );
+};
+
+[[nodiscard]] nlohmann::json ToJson(const PerformanceBaseline& baseline);
+
+absl::StatusOr<PerformanceBaseline> FromJson(const nlohmann::json& baseline_json);
+
+/**
+ * Converts Google Benchmark JSON output (--benchmark_out_format=json) to metrics: real & CPU time per iteration (in
+ * nanoseconds) and, where reported, items per second, for every benchmark that ran without error. When repetitions
+ * were run, the median aggregate is used.
+ */
+absl::StatusOr<PerformanceBaseline> ImportGoogleBenchmarkResults(
+    const nlohmann::json& results_json, double relative_tolerance = kDefaultRelativeTolerance
+);
+
+absl::Status WriteBaseline(const PerformanceBaseline& baseline, const std::filesystem::path& path);
+
+/**
+ * (Re-)records the baseline at path from the results. Tolerances of metrics already in the baseline are kept, so that
+ * hand-tuned ones survive re-recording; new metrics get the tolerances from the results.
+ */
+absl::Status RecordBaseline(const PerformanceBaseline& results, const std::filesystem::path& path);
+
+// reads a baseline file, or Google Benchmark JSON output (see ImportGoogleBenchmarkResults)
+absl::StatusOr<PerformanceBaseline> ReadBaseline(const std::filesystem::path& path);
+
+struct MetricRegressionInformation {
+    std::string name;
+    // element1 is the baseline value, element2 the measured one; linear_index is the metric's index in the baseline
+    ArrayElementMismatchInformation<double> mismatch;
+    // how much worse the measured value is, relative to the baseline one (positive = worse)
+    double relative_regression;
+};
+
+struct BaselineComparisonResult {
+    bool within_tolerance = true;
+    std::vector<MetricRegressionInformation> regressions;
+    // metrics in the baseline that weren't measured at all (these fail the comparison as well)
+    std::vector<std::string> missing_metrics;
+};
+
+// Metrics that were measured, but aren't in the baseline, are ignored. Improvements of any size pass; worsening is
+// checked with ElementsMatch against the baseline's tolerances.
+[[nodiscard]] BaselineComparisonResult CompareToBaseline(
+    const PerformanceBaseline& baseline, const PerformanceBaseline& measured
+);
+
+// human-readable summary of regressions & missing metrics, one per line
+[[nodiscard]] std::string FormatComparisonResult(const BaselineComparisonResult& result);
+
+} // namespace presage::smartspectra::test::performance_baseline
@@ -0,0 +1,214 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+// === standard library includes (if any) ===
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+// === third-party includes (if any) ===
+#include <absl/strings/str_cat.h>
+#include <google/protobuf/text_format.h>
+#include <mediapipe/framework/calculator_framework.h>
+#include <mediapipe/framework/formats/image_frame.h>
+#include <physiology/graph/stream_and_packet_names.h>
+#include <physiology/modules/messages/metrics.h>
+#include <physiology/modules/messages/status.h>
+// === local includes (if any) ===
+#include "stand_in_graph.hpp"
+
+namespace presage::smartspectra::test::stand_in_graph {
+
+namespace pe = ::physiology::edge;
+
+namespace {
+
+constexpr char kVideoTag[] = "VIDEO";
+constexpr char kRecordingTag[] = "RECORDING";
+constexpr char kFrameSentThroughTag[] = "FRAME_SENT_THROUGH";
+constexpr char kStatusCodeTag[] = "STATUS_CODE";
+constexpr char kMetricsBufferTag[] = "METRICS_BUFFER";
+constexpr char kEdgeMetricsTag[] = "EDGE_METRICS";
+constexpr char kBlueToothTag[] = "BLUE_TOOTH";
+constexpr char kTimeLeftTag[] = "TIME_LEFT";
+
+// breathing-like & pulse-like frequencies for the synthetic traces, in Hz
+constexpr double kSyntheticBreathingFrequency = 0.25;
+constexpr double kSyntheticPulseFrequency = 1.2;
+
+// see ScopedFrameHold
+std::mutex frame_hold_mutex;
+std::condition_variable frame_hold_released;
+bool frames_held = false;
+
+// serializes WriteStandInGraph calls, e.g. from containers initializing on different threads
+std::mutex graph_file_mutex;
+
+/**
+ * Echoes input frames & reports them as sent through, reports status OK on every frame, and while recording, emits a
+ * synthetic metrics buffer (pulse & breathing traces covering the buffer's frames) every kMetricsBufferFrameInterval
+ * recorded frames.
+ */
+class StandInPhysiologyCalculator : public mediapipe::CalculatorBase {
+public:
+    static absl::Status GetContract(mediapipe::CalculatorContract* cc) {
+        cc->Inputs().Tag(kVideoTag).Set<mediapipe::ImageFrame>();
+        cc->Inputs().Tag(kRecordingTag).Set<bool>();
+        cc->Outputs().Tag(kVideoTag).Set<mediapipe::ImageFrame>();
+        cc->Outputs().Tag(kFrameSentThroughTag).Set<bool>();
+        cc->Outputs().Tag(kStatusCodeTag).Set<presage::physiology::StatusValue>();
+        cc->Outputs().Tag(kMetricsBufferTag).Set<presage::physiology::MetricsBuffer>();
+        // never emitted, only there so that containers find every stream they poll or observe
+        cc->Outputs().Tag(kEdgeMetricsTag).Set<presage::physiology::Metrics>();
+        cc->Outputs().Tag(kBlueToothTag).Set<double>();
+        cc->Outputs().Tag(kTimeLeftTag).Set<double>();
+        return absl::OkStatus();
+    }
+
+    absl::Status Open(mediapipe::CalculatorContext* cc) override {
+        cc->SetOffset(mediapipe::TimestampDiff(0));
+        this->status_value.set_value(presage::physiology::StatusCode::OK);
+        return absl::OkStatus();
+    }
+
+    absl::Status Process(mediapipe::CalculatorContext* cc) override {
+        const mediapipe::Packet& video_packet = cc->Inputs().Tag(kVideoTag).Value();
+        if (video_packet.IsEmpty()) {
+            return absl::OkStatus();
+        }
+        {
+            std::unique_lock<std::mutex> lock(frame_hold_mutex);
+            frame_hold_released.wait(lock, []() { return !frames_held; });
+        }
+        const mediapipe::Timestamp timestamp = cc->InputTimestamp();
+        cc->Outputs().Tag(kVideoTag).AddPacket(video_packet);
+        cc->Outputs().Tag(kFrameSentThroughTag).AddPacket(mediapipe::MakePacket<bool>(true).At(timestamp));
+        cc->Outputs().Tag(kStatusCodeTag).AddPacket(
+            mediapipe::MakePacket<presage::physiology::StatusValue>(this->status_value).At(timestamp)
+        );
+
+        const mediapipe::Packet& recording_packet = cc->Inputs().Tag(kRecordingTag).Value();
+        if (recording_packet.IsEmpty() || !recording_packet.Get<bool>()) {
+            this->recorded_frame_count = 0;
+            return absl::OkStatus();
+        }
+        if (this->recorded_frame_count == 0) {
+            this->recording_start_timestamp = timestamp.Value();
+            this->metrics_buffer.Clear();
+        }
+        this->recorded_frame_count++;
+        const double time_s = static_cast<double>(timestamp.Value() - this->recording_start_timestamp) * 1e-6;
+        auto* pulse_sample = this->metrics_buffer.mutable_pulse()->add_trace();
+        pulse_sample->set_time(static_cast<float>(time_s));
+        pulse_sample->set_value(static_cast<float>(std::sin(2.0 * M_PI * kSyntheticPulseFrequency * time_s)));
+        auto* breathing_sample = this->metrics_buffer.mutable_breathing()->add_upper_trace();
+        breathing_sample->set_time(static_cast<float>(time_s));
+        breathing_sample->set_value(static_cast<float>(std::sin(2.0 * M_PI * kSyntheticBreathingFrequency * time_s)));
+
+        if (this->recorded_frame_count % kMetricsBufferFrameInterval == 0) {
+            this->metrics_buffer.mutable_metadata()->set_frame_timestamp(timestamp.Value());
+            this->metrics_buffer.mutable_metadata()->set_frame_count(kMetricsBufferFrameInterval);
+            cc->Outputs().Tag(kMetricsBufferTag).AddPacket(
+                mediapipe::MakePacket<presage::physiology::MetricsBuffer>(this->metrics_buffer).At(timestamp)
+            );
+            this->metrics_buffer.Clear();
+        }
+        return absl::OkStatus();
+    }
+
+private:
+    presage::physiology::StatusValue status_value;
+    presage::physiology::MetricsBuffer metrics_buffer;
+    int64_t recorded_frame_count = 0;
+    int64_t recording_start_timestamp = 0;
+};
+
+REGISTER_CALCULATOR(StandInPhysiologyCalculator);
+
+} // anonymous namespace
+
+mediapipe::CalculatorGraphConfig BuildStandInGraphConfig() {
+    mediapipe::CalculatorGraphConfig config;
+    config.add_input_stream(pe::graph::input_streams::kInputVideo);
+    config.add_input_stream(pe::graph::input_streams::kRecording);
+    auto* node = config.add_node();
+    node->set_calculator("StandInPhysiologyCalculator");
+    node->add_input_stream(absl::StrCat(kVideoTag, ":", pe::graph::input_streams::kInputVideo));
+    node->add_input_stream(absl::StrCat(kRecordingTag, ":", pe::graph::input_streams::kRecording));
+    const std::pair<const char*, const char*> outputs[] = {
+        {kVideoTag, pe::graph::output_streams::kOutputVideo},
+        {kFrameSentThroughTag, pe::graph::output_streams::kFrameSentThrough},
+        {kStatusCodeTag, pe::graph::output_streams::kStatusCode},
+        {kMetricsBufferTag, pe::graph::output_streams::kMetricsBuffer},
+        {kEdgeMetricsTag, pe::graph::output_streams::kEdgeMetrics},
+        {kBlueToothTag, pe::graph::output_streams::kBlueTooth},
+        {kTimeLeftTag, pe::graph::output_streams::spot::kTimeLeft},
+    };
+    for (const auto& [tag, stream_name]: outputs) {
+        config.add_output_stream(stream_name);
+        node->add_output_stream(absl::StrCat(tag, ":", stream_name));
+    }
+    return config;
+}
+
+absl::StatusOr<std::filesystem::path> WriteStandInGraph(const std::filesystem::path& directory, bool binary_graph) {
+    const mediapipe::CalculatorGraphConfig config = BuildStandInGraphConfig();
+    const std::filesystem::path graph_path =
+        directory / (binary_graph ? "stand_in_graph.binarypb" : "stand_in_graph.pbtxt");
+    std::string contents;
+    if (binary_graph) {
+        if (!config.SerializeToString(&contents)) {
+            return absl::InternalError("Could not serialize the stand-in graph.");
+        }
+    } else if (!google::protobuf::TextFormat::PrintToString(config, &contents)) {
+        return absl::InternalError("Could not print the stand-in graph as text.");
+    }
+
+    // Leave an up-to-date file alone: rewriting it would bump its modification time, and with it, invalidate the
+    // graph config cache entry for it on every container initialization.
+    std::lock_guard<std::mutex> lock(graph_file_mutex);
+    {
+        std::ifstream existing_file(graph_path, std::ios::binary);
+        if (existing_file) {
+            const std::string existing_contents(
+                (std::istreambuf_iterator<char>(existing_file)), std::istreambuf_iterator<char>()
+            );
+            if (existing_contents == contents) {
+                return graph_path;
+            }
+        }
+    }
+    std::ofstream graph_file(graph_path, std::ios::binary | std::ios::trunc);
+    if (!graph_file) {
+        return absl::UnavailableError("Could not open " + graph_path.string() + " for writing.");
+    }
+    graph_file << contents;
+    if (!graph_file.flush()) {
+        return absl::UnavailableError("Could not write the stand-in graph to " + graph_path.string());
+    }
+    return graph_path;
+}
+
+ScopedFrameHold::ScopedFrameHold() {
+    std::lock_guard<std::mutex> lock(frame_hold_mutex);
+    frames_held = true;
+}
+
+ScopedFrameHold::~ScopedFrameHold() {
+    this->Release();
+}
+
+void ScopedFrameHold::Release() {
+    {
+        std::lock_guard<std::mutex> lock(frame_hold_mutex);
+        frames_held = false;
+    }
+    frame_hold_released.notify_all();
+}
+
+} // namespace presage::smartspectra::test::stand_in_graph
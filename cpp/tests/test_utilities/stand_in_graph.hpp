@@ -0,0 +1,75 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+// === standard library includes (if any) ===
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+// === third-party includes (if any) ===
+#include <absl/status/statusor.h>
+#include <mediapipe/framework/calculator.pb.h>
+// === local includes (if any) ===
+
+namespace presage::smartspectra::test::stand_in_graph {
+
+// while recording, the stand-in graph emits one synthetic metrics buffer per this many input frames
+constexpr int kMetricsBufferFrameInterval = 30;
+
+/**
+ * Test-only stand-in for the Physiology Edge graph. It has the same input & output streams the containers use
+ * (see physiology/graph/stream_and_packet_names.h), but no models and no Physiology Core connection: input frames are
+ * echoed to the output video stream (without copying), every frame is reported as sent through with status OK, and
+ * while recording, a synthetic metrics buffer comes out every kMetricsBufferFrameInterval frames. Edge metrics,
+ * bluetooth & spot time-left streams exist, but stay idle.
+ * @details Runs the containers end to end on any machine, so that their own overhead can be measured & tested in
+ * isolation from model & network costs. CPU (ImageFrame) input only.
+ */
+mediapipe::CalculatorGraphConfig BuildStandInGraphConfig();
+
+/**
+ * Writes the stand-in graph config to the given directory.
+ * @return path to the written file, "stand_in_graph.binarypb" or "stand_in_graph.pbtxt", depending on binary_graph
+ */
+absl::StatusOr<std::filesystem::path> WriteStandInGraph(const std::filesystem::path& directory, bool binary_graph);
+
+/**
+ * While an instance is alive (and not released), stand-in graphs hold on to incoming frames: they are neither echoed
+ * nor reported as sent through, so tests can keep frames in flight deterministically. Affects all stand-in graphs in
+ * the process; at most one instance should exist at a time.
+ */
+class ScopedFrameHold {
+public:
+    ScopedFrameHold();
+    ~ScopedFrameHold();
+    ScopedFrameHold(const ScopedFrameHold&) = delete;
+    ScopedFrameHold& operator=(const ScopedFrameHold&) = delete;
+
+    // lets the held frames (and all later ones) through
+    void Release();
+};
+
+/**
+ * Container that runs the stand-in graph instead of the Physiology Edge graph.
+ * @tparam TContainer a background or foreground container type (CPU)
+ */
+template<typename TContainer>
+class StandInGraphContainer : public TContainer {
+public:
+    StandInGraphContainer(typename TContainer::SettingsType settings, std::filesystem::path graph_directory) :
+        TContainer(std::move(settings)), graph_directory(std::move(graph_directory)) {}
+
+protected:
+    absl::StatusOr<std::filesystem::path> GetGraphFilePath(bool binary_graph) const override {
+        // the argument defaults to a binary graph; the format that actually gets parsed follows the settings
+        return WriteStandInGraph(this->graph_directory, this->settings.binary_graph);
+    }
+
+private:
+    const std::filesystem::path graph_directory;
+};
+
+} // namespace presage::smartspectra::test::stand_in_graph
@@ -41,4 +41,7 @@ std::vector<long> UnravelIndex(long linear_index, const std::vector<long>& dimen
     return position;
 }
 
+template bool ElementsMatch<float>(float, float, double, double);
+template bool ElementsMatch<double>(double, double, double, double);
+
 }  // namespace presage::smartspectra::test
@@ -70,4 +70,8 @@ struct ArrayComparisonResult{
     std::shared_ptr<ArrayElementMismatchInformation<TElement>> element_mismatch_information;
 };
 
+// whether element2 is within absolute_tolerance + relative_tolerance * |element1| of element1 (the reference)
+template<typename TElement>
+bool ElementsMatch(TElement element1, TElement element2, double absolute_tolerance, double relative_tolerance);
+
 } // namespace presage::smartspectra::test
@@ -19,8 +19,19 @@
 
 #pragma once
 // === standard library includes (if any) ===
+#include <cmath>
 // === third-party includes (if any) ===
 // === local includes (if any) ===
 #include "test_utilities.hpp"
 
 // private header for template implementations (if any)
+
+namespace presage::smartspectra::test {
+
+template<typename TElement>
+bool ElementsMatch(TElement element1, TElement element2, double absolute_tolerance, double relative_tolerance) {
+    const double difference = std::abs(static_cast<double>(element2) - static_cast<double>(element1));
+    return difference <= absolute_tolerance + relative_tolerance * std::abs(static_cast<double>(element1));
+}
+
+} // namespace presage::smartspectra::test
@@ -0,0 +1,350 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+// === third-party includes (if any) ===
+#include <linux/videodev2.h>
+#include <mediapipe/framework/port/opencv_imgproc_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/video_source/camera/v4l2_streaming_video_source.hpp>
+
+namespace vs = presage::smartspectra::video_source;
+namespace vs_v4l2 = presage::smartspectra::video_source::v4l2;
+
+namespace {
+
+constexpr int kFileDescriptor = 42;
+constexpr int64_t kFirstDriverTimestampμs = 1'000'000;
+constexpr int64_t kFrameIntervalμs = 33'333;
+
+/**
+ * In-memory stand-in for a UYVY V4L2 capture device: buffers are plain vectors, "mapped" by handing out their memory.
+ * Every dequeued frame is a flat image (gray, unless the chroma is configured) whose luma grows with the frame index, stamped with a monotonic driver
+ * timestamp kFrameIntervalμs after the previous one. Row padding (if configured) is filled with 0xFF. Dequeuing fails
+ * once frames_left runs out.
+ */
+class FakeV4l2Device : public vs_v4l2::V4l2Device {
+public:
+    int Open(const std::string& path, int) override {
+        this->opened_path = path;
+        this->open = true;
+        return kFileDescriptor;
+    }
+
+    int Close(int) override {
+        this->open = false;
+        return 0;
+    }
+
+    int Ioctl(int file_descriptor, unsigned long request, void* argument) override {
+        if (file_descriptor != kFileDescriptor || !this->open) {
+            errno = EBADF;
+            return -1;
+        }
+        switch (request) {
+            case VIDIOC_QUERYCAP: {
+                auto* capability = static_cast<v4l2_capability*>(argument);
+                *capability = {};
+                std::strcpy(reinterpret_cast<char*>(capability->card), "Fake Camera");
+                capability->capabilities = this->capabilities;
+                return 0;
+            }
+            case VIDIOC_S_FMT: {
+                auto* format = static_cast<v4l2_format*>(argument);
+                // like real drivers, adjust to what's supported rather than fail
+                format->fmt.pix.pixelformat = V4L2_PIX_FMT_UYVY;
+                format->fmt.pix.width = this->width;
+                format->fmt.pix.height = this->height;
+                format->fmt.pix.bytesperline = this->GetBytesPerLine();
+                format->fmt.pix.sizeimage = this->GetImageSize();
+                return 0;
+            }
+            case VIDIOC_REQBUFS: {
+                auto* request_buffers = static_cast<v4l2_requestbuffers*>(argument);
+                this->requested_buffer_count = static_cast<int>(request_buffers->count);
+                request_buffers->count = std::min(request_buffers->count, this->maximum_buffer_count);
+                this->buffers.assign(request_buffers->count, std::vector<uint8_t>(this->GetImageSize()));
+                this->queued_buffers.clear();
+                return 0;
+            }
+            case VIDIOC_QUERYBUF: {
+                auto* buffer = static_cast<v4l2_buffer*>(argument);
+                buffer->length = this->GetImageSize();
+                buffer->m.offset = buffer->index * this->GetImageSize();
+                return 0;
+            }
+            case VIDIOC_QBUF:
+                this->queued_buffers.push_back(static_cast<v4l2_buffer*>(argument)->index);
+                return 0;
+            case VIDIOC_STREAMON:
+                this->streaming = true;
+                return 0;
+            case VIDIOC_STREAMOFF:
+                this->streaming = false;
+                this->queued_buffers.clear();
+                return 0;
+            case VIDIOC_DQBUF:
+                return this->DequeueBuffer(*static_cast<v4l2_buffer*>(argument));
+            default:
+                errno = EINVAL;
+                return -1;
+        }
+    }
+
+    void* MemoryMap(size_t, int, int, int, off_t offset) override {
+        this->mapped_buffer_count++;
+        return this->buffers.at(offset / this->GetImageSize()).data();
+    }
+
+    int MemoryUnmap(void*, size_t) override {
+        this->mapped_buffer_count--;
+        return 0;
+    }
+
+    static uint8_t GetFrameLuma(int64_t i_frame) { return static_cast<uint8_t>(32 + 16 * i_frame); }
+
+    // configuration
+    uint32_t capabilities = V4L2_CAP_VIDEO_CAPTURE | V4L2_CAP_STREAMING;
+    uint32_t width = 64;
+    uint32_t height = 48;
+    uint32_t maximum_buffer_count = 32;
+    int64_t frames_left = 100;
+    uint8_t chroma_u = 128;
+    uint8_t chroma_v = 128;
+    uint32_t row_padding_bytes = 0;
+    // dequeued buffers report an index past the mapped ones, like a misbehaving driver
+    bool report_bad_buffer_index = false;
+    // the next this many dequeued buffers report only half of a frame as used, like a driver cut short mid-frame
+    int truncated_frame_count = 0;
+
+    // state
+    std::string opened_path;
+    bool open = false;
+    bool streaming = false;
+    int requested_buffer_count = 0;
+    int mapped_buffer_count = 0;
+    std::vector<std::vector<uint8_t>> buffers;
+    std::deque<uint32_t> queued_buffers;
+    int64_t dequeued_frame_count = 0;
+
+private:
+    [[nodiscard]] uint32_t GetBytesPerLine() const { return this->width * 2 + this->row_padding_bytes; }
+
+    [[nodiscard]] uint32_t GetImageSize() const { return this->GetBytesPerLine() * this->height; }
+
+    int DequeueBuffer(v4l2_buffer& buffer) {
+        if (!this->streaming || this->queued_buffers.empty() || this->frames_left == 0) {
+            errno = EIO;
+            return -1;
+        }
+        buffer.index = this->queued_buffers.front();
+        this->queued_buffers.pop_front();
+        std::vector<uint8_t>& data = this->buffers[buffer.index];
+        const uint8_t luma = GetFrameLuma(this->dequeued_frame_count);
+        std::fill(data.begin(), data.end(), 0xFF);
+        for (size_t i_row = 0; i_row < this->height; i_row++) {
+            uint8_t* row = data.data() + i_row * this->GetBytesPerLine();
+            for (size_t i_byte = 0; i_byte < this->width * 2; i_byte += 4) {
+                row[i_byte] = this->chroma_u;
+                row[i_byte + 1] = luma;
+                row[i_byte + 2] = this->chroma_v;
+                row[i_byte + 3] = luma;
+            }
+        }
+        if (this->report_bad_buffer_index) {
+            buffer.index = static_cast<uint32_t>(this->buffers.size());
+        }
+        const int64_t timestamp_μs = kFirstDriverTimestampμs + this->dequeued_frame_count * kFrameIntervalμs;
+        buffer.timestamp.tv_sec = timestamp_μs / 1'000'000;
+        buffer.timestamp.tv_usec = timestamp_μs % 1'000'000;
+        buffer.flags = V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC;
+        buffer.bytesused = this->GetImageSize();
+        if (this->truncated_frame_count > 0) {
+            buffer.bytesused /= 2;
+            this->truncated_frame_count--;
+        }
+        buffer.sequence = static_cast<uint32_t>(this->dequeued_frame_count);
+        this->dequeued_frame_count++;
+        this->frames_left--;
+        return 0;
+    }
+};
+
+vs::VideoSourceSettings MakeSettings(int buffer_count) {
+    vs::VideoSourceSettings settings;
+    settings.device_index = 3;
+    settings.resolution_selection_mode = vs::ResolutionSelectionMode::Exact;
+    settings.capture_width_px = 64;
+    settings.capture_height_px = 48;
+    settings.codec = presage::camera::CaptureCodec::UYVY;
+    settings.input_transform_mode = vs::InputTransformMode::None;
+    settings.use_native_v4l2_capture = true;
+    settings.v4l2_buffer_count = buffer_count;
+    return settings;
+}
+
+cv::Vec3b ConvertUyvyPixel(
+    uint8_t luma,
+    uint8_t chroma_u = 128,
+    uint8_t chroma_v = 128,
+    int conversion_code = cv::COLOR_YUV2BGR_UYVY
+) {
+    const uint8_t uyvy_data[] = {chroma_u, luma, chroma_v, luma};
+    const cv::Mat uyvy(1, 2, CV_8UC2, const_cast<uint8_t*>(uyvy_data));
+    cv::Mat converted;
+    cv::cvtColor(uyvy, converted, conversion_code);
+    return converted.at<cv::Vec3b>(0, 0);
+}
+
+} // anonymous namespace
+
+TEST_CASE("V4L2 streaming source captures from mmap'd buffers with driver timestamps", "[v4l2_streaming]") {
+    auto device = std::make_shared<FakeV4l2Device>();
+    vs_v4l2::V4l2StreamingVideoSource source(device);
+    REQUIRE(source.Initialize(MakeSettings(3)).ok());
+    REQUIRE(device->opened_path == "/dev/video3");
+    REQUIRE(device->requested_buffer_count == 3);
+    REQUIRE(source.GetBufferCount() == 3);
+    REQUIRE(device->mapped_buffer_count == 3);
+    REQUIRE(device->streaming);
+    REQUIRE(device->queued_buffers.size() == 3);
+    REQUIRE(source.GetWidth() == 64);
+    REQUIRE(source.GetHeight() == 48);
+    REQUIRE(source.SupportsExactFrameTimestamp());
+
+    int64_t first_frame_timestamp = 0;
+    for (int64_t i_frame = 0; i_frame < 5; i_frame++) {
+        cv::Mat frame;
+        source.ProduceUntransformedFrame(frame);
+        REQUIRE(frame.rows == 48);
+        REQUIRE(frame.cols == 64);
+        REQUIRE(frame.type() == CV_8UC3);
+        REQUIRE(frame.at<cv::Vec3b>(47, 63) == ConvertUyvyPixel(FakeV4l2Device::GetFrameLuma(i_frame)));
+        if (i_frame == 0) {
+            first_frame_timestamp = source.GetFrameTimestamp();
+        } else {
+            // the driver's capture times, not the time frames got dequeued
+            REQUIRE(source.GetFrameTimestamp() - first_frame_timestamp == i_frame * kFrameIntervalμs);
+        }
+        // the buffer goes back into the driver queue as soon as the frame is out
+        REQUIRE(device->queued_buffers.size() == 3);
+    }
+}
+
+TEST_CASE("V4L2 streaming source produces RGB frames on request", "[v4l2_streaming]") {
+    auto device = std::make_shared<FakeV4l2Device>();
+    device->chroma_u = 90;
+    device->chroma_v = 200;
+    vs_v4l2::V4l2StreamingVideoSource source(device);
+    REQUIRE(source.Initialize(MakeSettings(3)).ok());
+    REQUIRE(source.SetFrameChannelOrder(vs::FrameChannelOrder::Rgb).ok());
+    REQUIRE(source.GetFrameChannelOrder() == vs::FrameChannelOrder::Rgb);
+    cv::Mat frame;
+    source.ProduceUntransformedFrame(frame);
+    const uint8_t luma = FakeV4l2Device::GetFrameLuma(0);
+    const cv::Vec3b rgb = ConvertUyvyPixel(luma, 90, 200, cv::COLOR_YUV2RGB_UYVY);
+    REQUIRE(frame.at<cv::Vec3b>(0, 0) == rgb);
+    // i.e. the channels are actually swapped, compared to the default BGR frames
+    const cv::Vec3b bgr = ConvertUyvyPixel(luma, 90, 200);
+    REQUIRE(rgb == cv::Vec3b(bgr[2], bgr[1], bgr[0]));
+    REQUIRE(rgb[0] != rgb[2]);
+}
+
+TEST_CASE("V4L2 streaming source uses the queue depth the driver grants", "[v4l2_streaming]") {
+    auto device = std::make_shared<FakeV4l2Device>();
+    device->maximum_buffer_count = 2;
+    vs_v4l2::V4l2StreamingVideoSource source(device);
+    REQUIRE(source.Initialize(MakeSettings(8)).ok());
+    REQUIRE(device->requested_buffer_count == 8);
+    REQUIRE(source.GetBufferCount() == 2);
+
+    SECTION("a single buffer is not enough to stream") {
+        auto starved_device = std::make_shared<FakeV4l2Device>();
+        starved_device->maximum_buffer_count = 1;
+        vs_v4l2::V4l2StreamingVideoSource starved_source(starved_device);
+        REQUIRE(absl::IsResourceExhausted(starved_source.Initialize(MakeSettings(4))));
+    }
+}
+
+TEST_CASE("V4L2 streaming source ends the stream when the device fails", "[v4l2_streaming]") {
+    auto device = std::make_shared<FakeV4l2Device>();
+    device->frames_left = 2;
+    {
+        vs_v4l2::V4l2StreamingVideoSource source(device);
+        REQUIRE(source.Initialize(MakeSettings(4)).ok());
+        cv::Mat frame;
+        source.ProduceUntransformedFrame(frame);
+        REQUIRE_FALSE(frame.empty());
+        source.ProduceUntransformedFrame(frame);
+        REQUIRE_FALSE(frame.empty());
+        source.ProduceUntransformedFrame(frame);
+        REQUIRE(frame.empty());
+    }
+    // torn down: streaming stopped, buffers unmapped & released, device closed
+    REQUIRE_FALSE(device->streaming);
+    REQUIRE(device->mapped_buffer_count == 0);
+    REQUIRE(device->buffers.empty());
+    REQUIRE_FALSE(device->open);
+}
+
+TEST_CASE("V4L2 streaming source honors the row stride the driver reports", "[v4l2_streaming]") {
+    auto device = std::make_shared<FakeV4l2Device>();
+    device->row_padding_bytes = 32;
+    vs_v4l2::V4l2StreamingVideoSource source(device);
+    REQUIRE(source.Initialize(MakeSettings(3)).ok());
+    cv::Mat frame;
+    source.ProduceUntransformedFrame(frame);
+    REQUIRE(frame.rows == 48);
+    REQUIRE(frame.cols == 64);
+    // padding bytes would show up as bright pixels on every row but the first
+    const cv::Vec3b expected_pixel = ConvertUyvyPixel(FakeV4l2Device::GetFrameLuma(0));
+    for (int i_row = 0; i_row < frame.rows; i_row++) {
+        REQUIRE(frame.at<cv::Vec3b>(i_row, 0) == expected_pixel);
+        REQUIRE(frame.at<cv::Vec3b>(i_row, frame.cols - 1) == expected_pixel);
+    }
+}
+
+TEST_CASE("V4L2 streaming source ends the stream on a buffer index it didn't map", "[v4l2_streaming]") {
+    auto device = std::make_shared<FakeV4l2Device>();
+    vs_v4l2::V4l2StreamingVideoSource source(device);
+    REQUIRE(source.Initialize(MakeSettings(3)).ok());
+    device->report_bad_buffer_index = true;
+    cv::Mat frame;
+    source.ProduceUntransformedFrame(frame);
+    REQUIRE(frame.empty());
+}
+
+TEST_CASE("V4L2 streaming source drops UYVY frames shorter than the negotiated format", "[v4l2_streaming]") {
+    auto device = std::make_shared<FakeV4l2Device>();
+    device->row_padding_bytes = 32;
+    vs_v4l2::V4l2StreamingVideoSource source(device);
+    REQUIRE(source.Initialize(MakeSettings(3)).ok());
+    device->truncated_frame_count = 2;
+    cv::Mat frame;
+    source.ProduceUntransformedFrame(frame);
+    // the two truncated frames got skipped, and their buffers went back into the queue
+    REQUIRE(device->dequeued_frame_count == 3);
+    REQUIRE(device->queued_buffers.size() == 3);
+    REQUIRE(frame.rows == 48);
+    REQUIRE(frame.cols == 64);
+    REQUIRE(frame.at<cv::Vec3b>(47, 63) == ConvertUyvyPixel(FakeV4l2Device::GetFrameLuma(2)));
+}
+
+TEST_CASE("V4L2 streaming source rejects devices without streaming I/O", "[v4l2_streaming]") {
+    auto device = std::make_shared<FakeV4l2Device>();
+    device->capabilities = V4L2_CAP_VIDEO_CAPTURE | V4L2_CAP_READWRITE;
+    vs_v4l2::V4l2StreamingVideoSource source(device);
+    REQUIRE(absl::IsFailedPrecondition(source.Initialize(MakeSettings(4))));
+    REQUIRE(device->mapped_buffer_count == 0);
+}
@@ -0,0 +1,135 @@
+//
+// Created by greg on 10/16/26.
+// Copyright (c) 2026 Presage Technologies
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_main.hpp"
+// === standard library includes (if any) ===
+#include <string>
+#include <vector>
+// === third-party includes (if any) ===
+#include <mediapipe/framework/port/opencv_core_inc.h>
+#include <mediapipe/framework/port/opencv_imgproc_inc.h>
+// === local includes (if any) ===
+#include <smartspectra/container/yuv_conversion.hpp>
+
+namespace yc = presage::smartspectra::container::yuv_conversion;
+
+namespace {
+
+// not a multiple of the SIMD block width, so that both vector & scalar tail code paths get exercised
+constexpr int kWidth = 1920 + 18;
+constexpr int kHeight = 1080;
+
+cv::Mat MakeRandomMat(int rows, int cols, int type) {
+    cv::Mat random_mat(rows, cols, type);
+    cv::randu(random_mat, cv::Scalar::all(0), cv::Scalar::all(256));
+    return random_mat;
+}
+
+std::vector<yc::InstructionSet> GetSupportedInstructionSets() {
+    std::vector<yc::InstructionSet> instruction_sets;
+    for (auto instruction_set: {yc::InstructionSet::Scalar, yc::InstructionSet::Sse41, yc::InstructionSet::Avx2}) {
+        if (yc::IsInstructionSetSupported(instruction_set)) {
+            instruction_sets.push_back(instruction_set);
+        }
+    }
+    return instruction_sets;
+}
+
+struct YuvTestFrame {
+    cv::Mat data;
+    yc::YuvFrameView view;
+    int cv_conversion_code;
+};
+
+YuvTestFrame MakeNv12TestFrame() {
+    // OpenCV layout: Y rows followed by interleaved UV rows, all in one single-channel Mat
+    cv::Mat nv12 = MakeRandomMat(kHeight * 3 / 2, kWidth, CV_8UC1);
+    auto view = yc::YuvFrameView::Nv12(
+        nv12.ptr(0), static_cast<int>(nv12.step), nv12.ptr(kHeight), static_cast<int>(nv12.step), kWidth, kHeight
+    );
+    return {nv12, view, cv::COLOR_YUV2RGB_NV12};
+}
+
+YuvTestFrame MakeI420TestFrame() {
+    // OpenCV layout: Y plane, followed by tightly-packed U, then V planes
+    cv::Mat i420 = MakeRandomMat(kHeight * 3 / 2, kWidth, CV_8UC1);
+    const uint8_t* y = i420.ptr(0);
+    const uint8_t* u = y + kWidth * kHeight;
+    const uint8_t* v = u + (kWidth / 2) * (kHeight / 2);
+    auto view = yc::YuvFrameView::I420(y, kWidth, u, kWidth / 2, v, kWidth / 2, kWidth, kHeight);
+    return {i420, view, cv::COLOR_YUV2RGB_I420};
+}
+
+YuvTestFrame MakeYuyvTestFrame() {
+    cv::Mat yuyv = MakeRandomMat(kHeight, kWidth, CV_8UC2);
+    auto view = yc::YuvFrameView::Yuyv(yuyv.ptr(0), static_cast<int>(yuyv.step), kWidth, kHeight);
+    return {yuyv, view, cv::COLOR_YUV2RGB_YUYV};
+}
+
+void CheckMatchesOpenCv(const YuvTestFrame& test_frame) {
+    cv::Mat expected_rgb;
+    cv::cvtColor(test_frame.data, expected_rgb, test_frame.cv_conversion_code);
+    for (auto instruction_set: GetSupportedInstructionSets()) {
+        DYNAMIC_SECTION("instruction set: " << yc::AbslUnparseFlag(instruction_set)) {
+            // padded rows, like those of an aligned ImageFrame
+            cv::Mat padded_rgb(kHeight, kWidth * 3 + 16, CV_8UC1, cv::Scalar(0));
+            cv::Mat actual_rgb = padded_rgb(cv::Rect(0, 0, kWidth * 3, kHeight)).reshape(3);
+            auto status = yc::ConvertYuvToRgb(
+                test_frame.view, actual_rgb.data, static_cast<int>(actual_rgb.step), instruction_set
+            );
+            REQUIRE(status.ok());
+            // same fixed-point arithmetic as OpenCV, allow for off-by-one in case of different rounding in its SIMD path
+            REQUIRE(cv::norm(actual_rgb, expected_rgb, cv::NORM_INF) <= 1.0);
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("NV12 to RGB conversion matches cv::cvtColor", "[yuv_conversion]") {
+    CheckMatchesOpenCv(MakeNv12TestFrame());
+}
+
+TEST_CASE("I420 to RGB conversion matches cv::cvtColor", "[yuv_conversion]") {
+    CheckMatchesOpenCv(MakeI420TestFrame());
+}
+
+TEST_CASE("YUYV to RGB conversion matches cv::cvtColor", "[yuv_conversion]") {
+    CheckMatchesOpenCv(MakeYuyvTestFrame());
+}
+
+TEST_CASE("YUV frame validation rejects malformed frames", "[yuv_conversion]") {
+    std::vector<uint8_t> buffer(64 * 64 * 2);
+    REQUIRE(yc::ValidateYuvFrame(yc::YuvFrameView::Yuyv(buffer.data(), 128, 64, 64)).ok());
+    // odd width
+    REQUIRE_FALSE(yc::ValidateYuvFrame(yc::YuvFrameView::Yuyv(buffer.data(), 128, 63, 64)).ok());
+    // stride too small
+    REQUIRE_FALSE(yc::ValidateYuvFrame(yc::YuvFrameView::Yuyv(buffer.data(), 64, 64, 64)).ok());
+    // odd height for 4:2:0
+    REQUIRE_FALSE(yc::ValidateYuvFrame(
+        yc::YuvFrameView::Nv12(buffer.data(), 64, buffer.data() + 64 * 63, 64, 64, 63)
+    ).ok());
+    // missing plane
+    REQUIRE_FALSE(yc::ValidateYuvFrame(yc::YuvFrameView::Nv12(buffer.data(), 64, nullptr, 64, 64, 64)).ok());
+}
+
+// run explicitly, e.g. `test_yuv_conversion "[benchmark]"`
+TEST_CASE("YUV to RGB conversion throughput", "[.][benchmark][yuv_conversion]") {
+    const std::vector<YuvTestFrame> test_frames{MakeNv12TestFrame(), MakeI420TestFrame(), MakeYuyvTestFrame()};
+    cv::Mat rgb(kHeight, kWidth, CV_8UC3);
+    for (const auto& test_frame: test_frames) {
+        const std::string format_name = yc::AbslUnparseFlag(test_frame.view.format);
+        BENCHMARK("cv::cvtColor, " + format_name) {
+            cv::cvtColor(test_frame.data, rgb, test_frame.cv_conversion_code);
+            return rgb.data[0];
+        };
+        for (auto instruction_set: GetSupportedInstructionSets()) {
+            BENCHMARK("ConvertYuvToRgb, " + format_name + ", " + yc::AbslUnparseFlag(instruction_set)) {
+                return yc::ConvertYuvToRgb(test_frame.view, rgb.data, static_cast<int>(rgb.step), instruction_set).ok();
+            };
+        }
+    }
+}